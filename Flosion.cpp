@@ -27,7 +27,7 @@
 
 // Priorities:
 // TODO: turn on conformance mode in MSVC (add "/permisive-" to compiler flags)
-// TODO: actually use flo::Network
+// TODO: actually use flo::Network in the UI (see Network::addSoundNode)
 // Option 1: every object is created and owned by Network as in Network::create<WaveGenerator>(...)
 // and is used via reference
 // - similar to tims-gui interface
@@ -50,13 +50,6 @@
 //       - Existing serialization mapping could be adapted for this
 // Option 2: every object must explicitly be added to a Network
 // - I don't like this
-// TODO: find a safe way and clean to delay the initial state allocation
-//       by Uncontrolled (monostate) objects. State should not be allocated
-//       until the most-derived class has been constructed, since states may
-//       refer to this class (i.e. MelodyState, when querying note overlap).
-//       Two-phase initialization (see isocpp.org) could be used in conjunction
-//       with some sort of Network::create<ObjectType>(args...) factory method 
-//       which calls an initPhaseTwo() method or similar
 // TODO: find a safe and clean way to ensure that sound/number sources
 //       contained by UI objects are constructed before base classes are given
 //       pointers to these from a derived class that is not yet fully constructed.
@@ -76,36 +69,6 @@
 //     );
 // ---------------------------------------------------
 
-// TODO: try to eliminate uses of virtual methods and replace them with template
-// based dispatching, for example in:
-// * SoundSource::getNextChunkFor, which defers to:
-//   * UncontrolledSoundSource::renderNextChunk
-//   * ControlledSoundSource::renderNextChunk
-// * NumberSource::evaluate, which defers to:
-//   * BorrowingNumberSourceTemplate::evaluate
-//   * SoundNumberSource::evaluate
-// An alternative approach:
-//   This additional virtual function call can probably be replaced with some kind of CRTP method like
-//   struct SoundSource {
-//       virtual void getNextChunkFor(...) = 0; // needed
-//   };
-//   
-//   template<typename Derived, typename StateTypeWhatever>
-//   struct SoundSourceImpl {
-//       virtual void getNextChunkFor(...) override final {
-//           // do stuff, maybe some compile-time logic based on template parameters
-//           static_cast<Derived*>(this)->renderNextChunk(...); // Derived must supply this method (static_assert could help)
-//           // finish up
-//       }
-//   };
-//
-//   struct MySoundSource : SoundSourceImpl<MySoundSource, MyStateType> {
-//       void renderNextChunk(...) {
-//           // do something, anything at all
-//       }
-//   };
-
-
 // TODO: use std::byte instead of unsigned char in StateTable
 
 // TODO: use propert library tools in StateTable implementation like:
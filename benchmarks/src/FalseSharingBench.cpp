@@ -0,0 +1,106 @@
+#include <Flosion/Core/SoundNode.hpp>
+#include <Flosion/Core/SoundChunk.hpp>
+#include <Flosion/Core/SoundSource.hpp>
+#include <Flosion/Objects/Accumulator.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+
+using namespace flo;
+
+namespace {
+
+    // Like SoundResult, owns a single state regardless of its dependents
+    class RootNode : public Realtime<Uncontrolled<SoundNode, EmptySoundState>> {
+    public:
+        RootNode(){
+            enableMonostate();
+        }
+    };
+
+    // One state per key, each of which is rendered by its own thread. The
+    // node's own state holds nothing but the time, and lends a single number
+    // accumulator, so that every slot is smaller than two cache lines but
+    // not a multiple of one. Both are written every sample, as by most nodes.
+    class KeyedNode : public Realtime<Divergent<SoundSource, EmptySoundState, int>> {
+    public:
+        KeyedNode(StateTable::SlotPadding padding, int numKeys)
+            : input(this) {
+            setSlotPadding(padding);
+            for (int k = 0; k < numKeys; ++k){
+                addKey(k);
+            }
+        }
+
+        SoundNumberInput input;
+
+        // NOTE: the states are rendered directly by render() below
+        void getNextChunkFor(SoundChunk& chunk, const SoundInput*, const SoundState*) override {
+            chunk.silence();
+        }
+
+        void render(SoundChunk& chunk, EmptySoundState* state) const noexcept {
+            for (size_t i = 0; i < SoundChunk::size; ++i){
+                state->adjustTime(static_cast<std::uint32_t>(i));
+                const auto v = static_cast<float>(input.getValue(state));
+                chunk.l(i) = v;
+                chunk.r(i) = v;
+            }
+        }
+    };
+
+    struct KeyedNetwork {
+        KeyedNetwork(StateTable::SlotPadding padding, int numKeys)
+            : node(padding, numKeys) {
+            accumulator.input.setDefaultValue(Number{0.001});
+            accumulator.borrowFrom(&node);
+            node.input.setSource(&accumulator);
+            root.addDependency(&node);
+        }
+
+        ~KeyedNetwork(){
+            root.removeDependency(&node);
+            node.input.setSource(nullptr);
+            accumulator.borrowFrom(nullptr);
+        }
+
+        RootNode root;
+        KeyedNode node;
+        Accumulator accumulator;
+    };
+
+    std::unique_ptr<KeyedNetwork> theNetwork;
+
+    // Every thread repeatedly renders chunks for its own key. Without padding,
+    // the states of neighbouring keys share cache lines.
+    void renderKeysConcurrently(benchmark::State& bstate, StateTable::SlotPadding padding){
+        if (bstate.thread_index() == 0){
+            theNetwork = std::make_unique<KeyedNetwork>(padding, bstate.threads());
+        }
+        auto chunk = SoundChunk{};
+        for (auto _ : bstate){
+            // NOTE: the network is complete once all threads enter the loop
+            auto s = theNetwork->node.getState(static_cast<size_t>(bstate.thread_index()));
+            theNetwork->node.render(chunk, s);
+            benchmark::DoNotOptimize(chunk);
+        }
+        if (bstate.thread_index() == 0){
+            bstate.counters["slotSize"] = static_cast<double>(theNetwork->node.slotSize());
+            theNetwork.reset();
+        }
+    }
+
+    void BM_ConcurrentKeys_Packed(benchmark::State& bstate){
+        renderKeysConcurrently(bstate, StateTable::SlotPadding::None);
+    }
+
+    void BM_ConcurrentKeys_CacheLinePadded(benchmark::State& bstate){
+        renderKeysConcurrently(bstate, StateTable::SlotPadding::CacheLine);
+    }
+
+} // anonymous namespace
+
+BENCHMARK(BM_ConcurrentKeys_Packed)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_ConcurrentKeys_CacheLinePadded)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,99 @@
+#include <Flosion/Core/SoundResult.hpp>
+#include <Flosion/Core/SoundSourceTemplate.hpp>
+#include <Flosion/Objects/Functions.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+using namespace flo;
+
+namespace {
+
+    // Fills every chunk with the value of its input, evaluated per sample,
+    // and offers a number source which depends on its own state
+    class ValueSource : public Realtime<ControlledSoundSource<ValueSource, EmptySoundState>> {
+    public:
+        ValueSource()
+            : value(this)
+            , level(this) {
+
+        }
+
+        SoundNumberInput value;
+
+        class Level : public SoundNumberSource<Level, ValueSource> {
+        public:
+            using SoundNumberSource::SoundNumberSource;
+
+            Number evaluate(const EmptySoundState*, const SoundState*) const noexcept {
+                return 0.5;
+            }
+        } level;
+
+        void renderNextChunk(SoundChunk& chunk, EmptySoundState* state){
+            auto dst = chunk.channel(0);
+            for (size_t i = 0; i < SoundChunk::size; ++i){
+                dst[i] = static_cast<float>(value.getValue(state));
+            }
+            chunk.spreadChannel(0);
+        }
+    };
+
+    // A chain of additions feeding the input of a value source,
+    // optionally starting from the value source's own number source
+    struct NumberChain {
+        NumberChain(std::size_t length, bool stateful){
+            result.setSource(&source);
+            for (std::size_t i = 0; i < length; ++i){
+                adds.push_back(std::make_unique<Add>());
+                adds.back()->input2.setDefaultValue(0.001);
+            }
+            for (std::size_t i = 0; i + 1 < length; ++i){
+                adds[i]->input1.setSource(adds[i + 1].get());
+            }
+            if (stateful){
+                adds.back()->input1.setSource(&source.level);
+            }
+            source.value.setSource(adds.front().get());
+        }
+
+        ~NumberChain(){
+            source.value.setSource(nullptr);
+            for (auto& a : adds){
+                a->input1.setSource(nullptr);
+            }
+            result.setSource(nullptr);
+        }
+
+        SoundResult result;
+        ValueSource source;
+        std::vector<std::unique_ptr<Add>> adds;
+    };
+
+    void renderNumberChain(benchmark::State& bstate, bool stateful){
+        auto chain = NumberChain{static_cast<std::size_t>(bstate.range(0)), stateful};
+        auto chunk = SoundChunk{};
+        for (auto _ : bstate){
+            chain.result.getNextChunk(chunk);
+            benchmark::DoNotOptimize(chunk);
+        }
+        bstate.SetItemsProcessed(bstate.iterations() * static_cast<std::int64_t>(SoundChunk::size));
+    }
+
+    // Evaluates a chain of pure functions for every sample
+    void BM_NumberChain_Stateless(benchmark::State& bstate){
+        renderNumberChain(bstate, false);
+    }
+
+    // Evaluates a chain of pure functions for every sample, at the end
+    // of which is a number source which needs the state of its owner
+    void BM_NumberChain_Stateful(benchmark::State& bstate){
+        renderNumberChain(bstate, true);
+    }
+
+} // anonymous namespace
+
+BENCHMARK(BM_NumberChain_Stateless)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(BM_NumberChain_Stateful)->RangeMultiplier(4)->Range(1, 64);
@@ -0,0 +1,126 @@
+#include <Flosion/Core/SoundResult.hpp>
+#include <Flosion/Objects/Ensemble.hpp>
+#include <Flosion/Objects/LiveSequencer.hpp>
+#include <Flosion/Objects/Lowpass.hpp>
+#include <Flosion/Objects/Melody.hpp>
+#include <Flosion/Objects/Mixer.hpp>
+#include <Flosion/Objects/WaveForms.hpp>
+#include <Flosion/Objects/WaveGenerator.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+using namespace flo;
+
+// NOTE: these benchmarks render representative networks and report the
+// realtime factor, which is the number of seconds of sound rendered per
+// second of wall time. Anything below 1 can't be played back live.
+
+namespace {
+
+    // A sine wave generator
+    struct Sine {
+        Sine(double frequency){
+            sine.input.setSource(&waveGen.phase);
+            waveGen.waveFunction.setSource(&sine);
+            waveGen.frequency.setDefaultValue(frequency);
+        }
+
+        WaveGenerator waveGen;
+        SineWave sine;
+    };
+
+    void renderPatch(benchmark::State& bstate, SoundResult& result){
+        result.enableDeterministicMode(1);
+        auto chunk = SoundChunk{};
+        for (auto _ : bstate){
+            result.getNextChunk(chunk);
+            benchmark::DoNotOptimize(chunk);
+        }
+        bstate.counters["realtime_factor"] = benchmark::Counter(
+            static_cast<double>(bstate.iterations() * SoundChunk::size) / Sample::frequency,
+            benchmark::Counter::kIsRate
+        );
+    }
+
+    // Melody -> Ensemble -> WaveGenerator -> Lowpass, with up to four
+    // notes playing at once
+    void BM_Patch_MelodyEnsemble(benchmark::State& bstate){
+        auto result = SoundResult{};
+        auto lowpass = Lowpass{};
+        auto melody = Melody{};
+        auto ensemble = Ensemble{};
+        auto osc = Sine{0.0};
+
+        melody.setLength(Sample::frequency);
+        melody.setLooping(true);
+        // NOTE: notes may not wrap around the end of the melody
+        for (std::size_t i = 0; i < 4; ++i){
+            melody.addNote(i * Sample::frequency / 8, Sample::frequency / 2, 220.0 * (i + 1));
+        }
+
+        ensemble.input.setSource(&osc.waveGen);
+        melody.input.setSource(&ensemble);
+        lowpass.input.setSource(&melody);
+        result.setSource(&lowpass);
+
+        osc.waveGen.frequency.setSource(&ensemble.input.frequencyOut);
+        ensemble.frequencyIn.setSource(&melody.input.noteFrequency);
+        lowpass.cutoff.setDefaultValue(2000.0);
+
+        renderPatch(bstate, result);
+
+        result.setSource(nullptr);
+        lowpass.input.setSource(nullptr);
+        melody.input.setSource(nullptr);
+        ensemble.input.setSource(nullptr);
+    }
+
+    // A Mixer with a sine wave generator on each of its 32 inputs
+    void BM_Patch_Mixer32(benchmark::State& bstate){
+        auto result = SoundResult{};
+        auto mixer = Mixer{};
+        auto oscs = std::vector<std::unique_ptr<Sine>>{};
+        for (std::size_t i = 0; i < 32; ++i){
+            oscs.push_back(std::make_unique<Sine>(110.0 * (i + 1)));
+            mixer.addInput()->setSource(&oscs.back()->waveGen);
+        }
+        result.setSource(&mixer);
+
+        renderPatch(bstate, result);
+
+        result.setSource(nullptr);
+        for (const auto& i : mixer.getInputs()){
+            mixer.removeInput(i);
+        }
+    }
+
+    // A LiveSequencer with 8 tracks, half of which are recording
+    // a sine wave generator while the others play back
+    void BM_Patch_LiveSequencer8(benchmark::State& bstate){
+        auto result = SoundResult{};
+        auto sequencer = LiveSequencer{};
+        auto oscs = std::vector<std::unique_ptr<Sine>>{};
+        for (std::size_t i = 0; i < 8; ++i){
+            oscs.push_back(std::make_unique<Sine>(110.0 * (i + 1)));
+            auto t = sequencer.addTrack();
+            t->input.setSource(&oscs.back()->waveGen);
+            t->setNextMode(i % 2 == 0 ? Track::Mode::LiveOngoing : Track::Mode::RecordedInput);
+        }
+        result.setSource(&sequencer);
+
+        renderPatch(bstate, result);
+
+        result.setSource(nullptr);
+        for (const auto& t : sequencer.getTracks()){
+            sequencer.removeTrack(t);
+        }
+    }
+
+} // anonymous namespace
+
+BENCHMARK(BM_Patch_MelodyEnsemble)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Patch_Mixer32)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Patch_LiveSequencer8)->UseRealTime()->Unit(benchmark::kMicrosecond);
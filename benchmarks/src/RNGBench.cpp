@@ -0,0 +1,78 @@
+#include <Flosion/Util/RNG.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+    constexpr std::size_t blockSize = 1024;
+
+    // Draws one uniform number at a time from a shared engine,
+    // the way stochastic nodes used to
+    void BM_Uniform_DefaultEngine(benchmark::State& bstate){
+        auto eng = std::default_random_engine{1};
+        auto dist = std::uniform_real_distribution<double>{0.0, 1.0};
+        auto out = std::vector<float>(blockSize);
+        for (auto _ : bstate){
+            for (auto& x : out){
+                x = static_cast<float>(dist(eng));
+            }
+            benchmark::DoNotOptimize(out.data());
+        }
+        bstate.SetItemsProcessed(bstate.iterations() * static_cast<std::int64_t>(blockSize));
+    }
+
+    void BM_Uniform_CounterRNG(benchmark::State& bstate){
+        auto rng = util::CounterRNG{util::CounterRNG::keyFor(1, 0)};
+        auto out = std::vector<float>(blockSize);
+        for (auto _ : bstate){
+            for (auto& x : out){
+                x = static_cast<float>(rng.uniform());
+            }
+            benchmark::DoNotOptimize(out.data());
+        }
+        bstate.SetItemsProcessed(bstate.iterations() * static_cast<std::int64_t>(blockSize));
+    }
+
+    void BM_Uniform_CounterRNGBlock(benchmark::State& bstate){
+        auto rng = util::CounterRNG{util::CounterRNG::keyFor(1, 0)};
+        auto out = std::vector<float>(blockSize);
+        for (auto _ : bstate){
+            rng.fillUniform(out.data(), blockSize);
+            benchmark::DoNotOptimize(out.data());
+        }
+        bstate.SetItemsProcessed(bstate.iterations() * static_cast<std::int64_t>(blockSize));
+    }
+
+    void BM_Normal_DefaultEngine(benchmark::State& bstate){
+        auto eng = std::default_random_engine{1};
+        auto dist = std::normal_distribution<double>{0.0, 1.0};
+        auto out = std::vector<float>(blockSize);
+        for (auto _ : bstate){
+            for (auto& x : out){
+                x = static_cast<float>(dist(eng));
+            }
+            benchmark::DoNotOptimize(out.data());
+        }
+        bstate.SetItemsProcessed(bstate.iterations() * static_cast<std::int64_t>(blockSize));
+    }
+
+    void BM_Normal_CounterRNGBlock(benchmark::State& bstate){
+        auto rng = util::CounterRNG{util::CounterRNG::keyFor(1, 0)};
+        auto out = std::vector<float>(blockSize);
+        for (auto _ : bstate){
+            rng.fillNormal(out.data(), blockSize);
+            benchmark::DoNotOptimize(out.data());
+        }
+        bstate.SetItemsProcessed(bstate.iterations() * static_cast<std::int64_t>(blockSize));
+    }
+
+} // anonymous namespace
+
+BENCHMARK(BM_Uniform_DefaultEngine);
+BENCHMARK(BM_Uniform_CounterRNG);
+BENCHMARK(BM_Uniform_CounterRNGBlock);
+BENCHMARK(BM_Normal_DefaultEngine);
+BENCHMARK(BM_Normal_CounterRNGBlock);
@@ -0,0 +1,65 @@
+#include <Flosion/Core/SampleFormat.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace flo;
+
+namespace {
+
+    // Fills a chunk with arbitrary values, some of which need clamping
+    void fill(SoundChunk& chunk){
+        for (std::size_t c = 0; c < chunk.numChannels(); ++c){
+            auto v = 0.1f * static_cast<float>(c);
+            for (std::size_t i = 0; i < SoundChunk::size; ++i){
+                chunk.channel(c)[i] = v;
+                v = v * -1.01f + 0.001f;
+            }
+        }
+    }
+
+    // Converts a stereo chunk to int16 the way DAC used to,
+    // clamping and then truncating one sample at a time
+    void BM_EncodeInt16_Scalar(benchmark::State& bstate){
+        auto chunk = SoundChunk{channels::stereo};
+        fill(chunk);
+        auto buffer = std::vector<std::int16_t>(2 * SoundChunk::size);
+        constexpr auto k = static_cast<float>(std::numeric_limits<std::int16_t>::max());
+        for (auto _ : bstate){
+            benchmark::DoNotOptimize(chunk);
+            chunk.clamp(-1.0f, 1.0f);
+            for (std::size_t c = 0; c < 2; ++c){
+                const auto src = chunk.channel(c);
+                for (std::size_t i = 0; i < SoundChunk::size; ++i){
+                    buffer[2 * i + c] = static_cast<std::int16_t>(k * src[i]);
+                }
+            }
+            benchmark::DoNotOptimize(buffer.data());
+        }
+        bstate.SetItemsProcessed(bstate.iterations() * static_cast<std::int64_t>(2 * SoundChunk::size));
+    }
+
+    // Converts the same chunk with SampleEncoder and the given dither
+    void BM_EncodeInt16(benchmark::State& bstate){
+        auto chunk = SoundChunk{channels::stereo};
+        fill(chunk);
+        auto buffer = std::vector<std::int16_t>(2 * SoundChunk::size);
+        auto encoder = SampleEncoder{SampleFormat::Int16, static_cast<Dither>(bstate.range(0))};
+        for (auto _ : bstate){
+            benchmark::DoNotOptimize(chunk);
+            encoder.encode(chunk, 0, SoundChunk::size, buffer.data());
+            benchmark::DoNotOptimize(buffer.data());
+        }
+        bstate.SetItemsProcessed(bstate.iterations() * static_cast<std::int64_t>(2 * SoundChunk::size));
+    }
+
+} // anonymous namespace
+
+BENCHMARK(BM_EncodeInt16_Scalar);
+BENCHMARK(BM_EncodeInt16)
+    ->Arg(static_cast<int>(Dither::None))
+    ->Arg(static_cast<int>(Dither::Triangular))
+    ->Arg(static_cast<int>(Dither::NoiseShaped));
@@ -0,0 +1,340 @@
+#include <Flosion/Core/MultiSoundInput.hpp>
+#include <Flosion/Core/SingleSoundInput.hpp>
+#include <Flosion/Core/SoundResult.hpp>
+#include <Flosion/Core/SoundSourceTemplate.hpp>
+#include <Flosion/Objects/Ensemble.hpp>
+#include <Flosion/Objects/Melody.hpp>
+#include <Flosion/Objects/WaveForms.hpp>
+#include <Flosion/Objects/WaveGenerator.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+using namespace flo;
+
+// NOTE: these benchmarks sweep one size of a network at a time and fit the
+// measured times to a complexity (see the _BigO and _RMS rows of the output).
+// Every benchmark also reports its time per unit of the swept size, which
+// stays flat where scaling is linear, and the memory used by the states of
+// the nodes involved.
+
+namespace {
+
+    std::size_t stateBytes(std::initializer_list<const StateTable*> tables){
+        std::size_t n = 0;
+        for (const auto t : tables){
+            n += t->numSlots() * t->slotSize();
+        }
+        return n;
+    }
+
+    void setCounters(benchmark::State& bstate, std::size_t n, std::size_t bytes){
+        bstate.SetComplexityN(static_cast<std::int64_t>(n));
+        bstate.counters["per_unit"] = benchmark::Counter(
+            static_cast<double>(n),
+            benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert
+        );
+        bstate.counters["state_bytes"] = benchmark::Counter(
+            static_cast<double>(bytes),
+            benchmark::Counter::kDefaults,
+            benchmark::Counter::kIs1024
+        );
+    }
+
+    void renderChunks(benchmark::State& bstate, SoundResult& result){
+        auto chunk = SoundChunk{};
+        for (auto _ : bstate){
+            result.getNextChunk(chunk);
+            benchmark::DoNotOptimize(chunk);
+        }
+    }
+
+    // A sine wave generator
+    struct Sine {
+        Sine(){
+            sine.input.setSource(&waveGen.phase);
+            waveGen.waveFunction.setSource(&sine);
+        }
+
+        WaveGenerator waveGen;
+        SineWave sine;
+    };
+
+    // Mixes every key of its input, like an Ensemble with any number of voices
+    class KeyedMixer : public Realtime<ControlledSoundSource<KeyedMixer, EmptySoundState>> {
+    public:
+        KeyedMixer()
+            : input(this) {
+
+        }
+
+        MultiSoundInput<EmptySoundState, std::size_t> input;
+
+        void renderNextChunk(SoundChunk& chunk, EmptySoundState* state){
+            chunk.silence();
+            m_buffer.setNumChannels(chunk.numChannels());
+            for (std::size_t i = 0; i < input.numKeys(); ++i){
+                input.getNextChunkFor(m_buffer, this, state, input.getKey(i));
+                chunk.mixAdd(m_buffer, 0.05f);
+            }
+        }
+
+    private:
+        // NOTE: this is only rendered by one thread at a time here
+        SoundChunk m_buffer;
+    };
+
+    // Passes its input through unchanged
+    class PassThrough : public Realtime<ControlledSoundSource<PassThrough, EmptySoundState>> {
+    public:
+        PassThrough()
+            : input(this) {
+
+        }
+
+        SingleSoundInput input;
+
+        void renderNextChunk(SoundChunk& chunk, EmptySoundState* state){
+            input.getNextChunkFor(chunk, this, state);
+        }
+    };
+
+    // Fills every chunk with the value of its input, evaluated per sample,
+    // and offers a number source which depends on its own state
+    class ValueSource : public Realtime<ControlledSoundSource<ValueSource, EmptySoundState>> {
+    public:
+        ValueSource()
+            : value(this)
+            , level(this) {
+
+        }
+
+        SoundNumberInput value;
+
+        class Level : public SoundNumberSource<Level, ValueSource> {
+        public:
+            using SoundNumberSource::SoundNumberSource;
+
+            Number evaluate(const EmptySoundState*, const SoundState*) const noexcept {
+                return 0.001;
+            }
+        } level;
+
+        void renderNextChunk(SoundChunk& chunk, EmptySoundState* state){
+            auto dst = chunk.channel(0);
+            for (size_t i = 0; i < SoundChunk::size; ++i){
+                dst[i] = static_cast<float>(value.getValue(state));
+            }
+            chunk.spreadChannel(0);
+        }
+    };
+
+    // Adds up any number of inputs
+    class Sum : public NumberSource {
+    public:
+        Sum(std::size_t numInputs){
+            for (std::size_t i = 0; i < numInputs; ++i){
+                inputs.push_back(std::make_unique<NumberSourceInput>(this));
+            }
+        }
+
+        std::vector<std::unique_ptr<NumberSourceInput>> inputs;
+
+    private:
+        Number evaluate(const SoundState* context) const noexcept override {
+            auto x = Number{0.0};
+            for (const auto& i : inputs){
+                x += i->getValue(context);
+            }
+            return x;
+        }
+    };
+
+    // Melody -> Ensemble -> WaveGenerator, with the given number of notes,
+    // all of which play at the same time
+    struct MelodyPatch {
+        MelodyPatch(std::size_t numNotes){
+            melody.setLength(2 * Sample::frequency);
+            melody.setLooping(true);
+            for (std::size_t i = 0; i < numNotes; ++i){
+                addNote(i);
+            }
+            ensemble.input.setSource(&osc.waveGen);
+            melody.input.setSource(&ensemble);
+            result.setSource(&melody);
+            osc.waveGen.frequency.setSource(&ensemble.input.frequencyOut);
+            ensemble.frequencyIn.setSource(&melody.input.noteFrequency);
+        }
+
+        ~MelodyPatch(){
+            result.setSource(nullptr);
+            melody.input.setSource(nullptr);
+            ensemble.input.setSource(nullptr);
+        }
+
+        MelodyNote* addNote(std::size_t i){
+            // NOTE: notes may not wrap around the end of the melody
+            return melody.addNote(0, melody.length() - SoundChunk::size, 110.0 * (i + 1));
+        }
+
+        std::size_t bytes() const noexcept {
+            return stateBytes({&result, &melody, &melody.input, &ensemble, &ensemble.input, &osc.waveGen});
+        }
+
+        SoundResult result;
+        Melody melody;
+        Ensemble ensemble;
+        Sine osc;
+    };
+
+    // Renders a melody of n notes, each of which is played by an
+    // ensemble of Ensemble::numVoices sine waves
+    void BM_Scaling_MelodyNotes(benchmark::State& bstate){
+        const auto n = static_cast<std::size_t>(bstate.range(0));
+        auto p = MelodyPatch{n};
+        renderChunks(bstate, p.result);
+        setCounters(bstate, n, p.bytes());
+    }
+
+    // Adds and removes a note of a melody of n notes
+    void BM_Scaling_MelodyAddNote(benchmark::State& bstate){
+        const auto n = static_cast<std::size_t>(bstate.range(0));
+        auto p = MelodyPatch{n};
+        for (auto _ : bstate){
+            p.melody.removeNote(p.addNote(n));
+        }
+        setCounters(bstate, n, p.bytes());
+    }
+
+    // A mixer of n keys of the same sine wave generator
+    struct KeysPatch {
+        KeysPatch(std::size_t numKeys){
+            // NOTE: the keys are added before the result is connected, since
+            // a source can't be given the states of an input without keys
+            mixer.input.setSource(&osc.waveGen);
+            for (std::size_t k = 0; k < numKeys; ++k){
+                mixer.input.addKey(k);
+            }
+            result.setSource(&mixer);
+        }
+
+        ~KeysPatch(){
+            result.setSource(nullptr);
+            mixer.input.setSource(nullptr);
+        }
+
+        std::size_t bytes() const noexcept {
+            return stateBytes({&result, &mixer, &mixer.input, &osc.waveGen});
+        }
+
+        SoundResult result;
+        KeyedMixer mixer;
+        Sine osc;
+    };
+
+    // Renders n keys of a MultiSoundInput, as would be done by an
+    // Ensemble with n voices
+    void BM_Scaling_Keys(benchmark::State& bstate){
+        const auto n = static_cast<std::size_t>(bstate.range(0));
+        auto p = KeysPatch{n};
+        renderChunks(bstate, p.result);
+        setCounters(bstate, n, p.bytes());
+    }
+
+    // Adds and removes a key of a MultiSoundInput with n keys
+    void BM_Scaling_AddKey(benchmark::State& bstate){
+        const auto n = static_cast<std::size_t>(bstate.range(0));
+        auto p = KeysPatch{n};
+        for (auto _ : bstate){
+            p.mixer.input.addKey(n);
+            p.mixer.input.removeKey(n);
+        }
+        setCounters(bstate, n, p.bytes());
+    }
+
+    // A chain of n sound sources ending in a sine wave generator
+    struct DepthPatch {
+        DepthPatch(std::size_t depth){
+            for (std::size_t i = 0; i < depth; ++i){
+                links.push_back(std::make_unique<PassThrough>());
+            }
+            for (std::size_t i = 0; i + 1 < depth; ++i){
+                links[i]->input.setSource(links[i + 1].get());
+            }
+            result.setSource(links.front().get());
+        }
+
+        ~DepthPatch(){
+            result.setSource(nullptr);
+            for (auto& l : links){
+                l->input.setSource(nullptr);
+            }
+        }
+
+        std::size_t bytes() const noexcept {
+            auto n = stateBytes({&result, &osc.waveGen});
+            for (const auto& l : links){
+                n += stateBytes({l.get(), &l->input});
+            }
+            return n;
+        }
+
+        SoundResult result;
+        std::vector<std::unique_ptr<PassThrough>> links;
+        Sine osc;
+    };
+
+    // Renders a chain of n sound sources
+    void BM_Scaling_Depth(benchmark::State& bstate){
+        const auto n = static_cast<std::size_t>(bstate.range(0));
+        auto p = DepthPatch{n};
+        p.links.back()->input.setSource(&p.osc.waveGen);
+        renderChunks(bstate, p.result);
+        setCounters(bstate, n, p.bytes());
+    }
+
+    // Connects and disconnects a sound source at the end of a chain of n
+    void BM_Scaling_AddDependency(benchmark::State& bstate){
+        const auto n = static_cast<std::size_t>(bstate.range(0));
+        auto p = DepthPatch{n};
+        for (auto _ : bstate){
+            p.links.back()->input.setSource(&p.osc.waveGen);
+            p.links.back()->input.setSource(nullptr);
+        }
+        setCounters(bstate, n, p.bytes());
+    }
+
+    // Evaluates the sum of n inputs for every sample, all of which
+    // are connected to a number source which needs a sound state
+    void BM_Scaling_NumberFanIn(benchmark::State& bstate){
+        const auto n = static_cast<std::size_t>(bstate.range(0));
+        auto result = SoundResult{};
+        auto source = ValueSource{};
+        auto sum = Sum{n};
+        result.setSource(&source);
+        for (auto& i : sum.inputs){
+            i->setSource(&source.level);
+        }
+        source.value.setSource(&sum);
+        renderChunks(bstate, result);
+        setCounters(bstate, n, stateBytes({&result, &source}));
+        source.value.setSource(nullptr);
+        for (auto& i : sum.inputs){
+            i->setSource(nullptr);
+        }
+        result.setSource(nullptr);
+    }
+
+} // anonymous namespace
+
+BENCHMARK(BM_Scaling_MelodyNotes)->RangeMultiplier(4)->Range(1, 256)->Unit(benchmark::kMicrosecond)->Complexity();
+BENCHMARK(BM_Scaling_MelodyAddNote)->RangeMultiplier(4)->Range(1, 256)->Unit(benchmark::kMicrosecond)->Complexity();
+BENCHMARK(BM_Scaling_Keys)->RangeMultiplier(4)->Range(1, 1024)->Unit(benchmark::kMicrosecond)->Complexity();
+BENCHMARK(BM_Scaling_AddKey)->RangeMultiplier(4)->Range(1, 1024)->Unit(benchmark::kMicrosecond)->Complexity();
+BENCHMARK(BM_Scaling_Depth)->RangeMultiplier(4)->Range(1, 1024)->Unit(benchmark::kMicrosecond)->Complexity();
+BENCHMARK(BM_Scaling_AddDependency)->RangeMultiplier(4)->Range(1, 1024)->Unit(benchmark::kMicrosecond)->Complexity();
+BENCHMARK(BM_Scaling_NumberFanIn)->RangeMultiplier(4)->Range(1, 1024)->Unit(benchmark::kMicrosecond)->Complexity();
@@ -0,0 +1,58 @@
+#include <Flosion/Core/SoundChunk.hpp>
+
+#include <benchmark/benchmark.h>
+
+using namespace flo;
+
+namespace {
+
+    // Fills a chunk with arbitrary but non-denormal values
+    void fill(SoundChunk& chunk, float v){
+        for (size_t i = 0; i < SoundChunk::size; ++i){
+            chunk.l(i) = v;
+            chunk.r(i) = -v;
+            v = v * 0.999f + 0.001f;
+        }
+    }
+
+    // Mixes a number of input chunks the way objects used to,
+    // through a temporary sample proxy for every sample
+    void BM_MixChunks_Proxy(benchmark::State& bstate){
+        const auto numInputs = static_cast<size_t>(bstate.range(0));
+        auto input = SoundChunk{};
+        auto output = SoundChunk{};
+        fill(input, 0.5f);
+        for (auto _ : bstate){
+            output.silence();
+            for (size_t k = 0; k < numInputs; ++k){
+                benchmark::DoNotOptimize(input);
+                for (size_t i = 0; i < SoundChunk::size; ++i){
+                    output[i] += input[i] * 0.1f;
+                }
+            }
+            benchmark::DoNotOptimize(output);
+        }
+        bstate.SetItemsProcessed(bstate.iterations() * static_cast<std::int64_t>(numInputs * SoundChunk::size));
+    }
+
+    // Mixes the same chunks with the bulk operations on planar channels
+    void BM_MixChunks_Planar(benchmark::State& bstate){
+        const auto numInputs = static_cast<size_t>(bstate.range(0));
+        auto input = SoundChunk{};
+        auto output = SoundChunk{};
+        fill(input, 0.5f);
+        for (auto _ : bstate){
+            output.silence();
+            for (size_t k = 0; k < numInputs; ++k){
+                benchmark::DoNotOptimize(input);
+                output.mixAdd(input, 0.1f);
+            }
+            benchmark::DoNotOptimize(output);
+        }
+        bstate.SetItemsProcessed(bstate.iterations() * static_cast<std::int64_t>(numInputs * SoundChunk::size));
+    }
+
+} // anonymous namespace
+
+BENCHMARK(BM_MixChunks_Proxy)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(BM_MixChunks_Planar)->RangeMultiplier(4)->Range(1, 64);
@@ -0,0 +1,113 @@
+#include <Flosion/Core/SingleSoundInput.hpp>
+#include <Flosion/Core/SoundResult.hpp>
+#include <Flosion/Core/SoundSourceTemplate.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+using namespace flo;
+
+namespace {
+
+    // Passes its input through unchanged, so that a chain of links
+    // measures nothing but the overhead of rendering a chunk
+    class ChainLink : public Realtime<ControlledSoundSource<ChainLink, EmptySoundState>> {
+    public:
+        ChainLink()
+            : input(this)
+            , level(this) {
+
+        }
+
+        SingleSoundInput input;
+
+        class Level : public SoundNumberSource<Level, ChainLink> {
+        public:
+            using SoundNumberSource::SoundNumberSource;
+
+            Number evaluate(const EmptySoundState*, const SoundState*) const noexcept {
+                return 0.5;
+            }
+        } level;
+
+        void renderNextChunk(SoundChunk& chunk, EmptySoundState* state){
+            input.getNextChunkFor(chunk, this, state);
+        }
+    };
+
+    // Produces a constant sound, whose value is optionally obtained
+    // from a number input for every sample
+    class ChainEnd : public Realtime<ControlledSoundSource<ChainEnd, EmptySoundState>> {
+    public:
+        ChainEnd()
+            : level(this, 0.5) {
+
+        }
+
+        SoundNumberInput level;
+
+        void renderNextChunk(SoundChunk& chunk, EmptySoundState* state){
+            auto dst = chunk.channel(0);
+            for (size_t i = 0; i < SoundChunk::size; ++i){
+                dst[i] = static_cast<float>(level.getValue(state));
+            }
+            chunk.spreadChannel(0);
+        }
+    };
+
+    struct Chain {
+        Chain(std::size_t length){
+            for (std::size_t i = 0; i < length; ++i){
+                links.push_back(std::make_unique<ChainLink>());
+            }
+            for (std::size_t i = 0; i + 1 < length; ++i){
+                links[i]->input.setSource(links[i + 1].get());
+            }
+            links.back()->input.setSource(&end);
+            result.setSource(links.front().get());
+        }
+
+        ~Chain(){
+            end.level.setSource(nullptr);
+            result.setSource(nullptr);
+            for (auto& l : links){
+                l->input.setSource(nullptr);
+            }
+        }
+
+        SoundResult result;
+        std::vector<std::unique_ptr<ChainLink>> links;
+        ChainEnd end;
+    };
+
+    // Renders chunks through a chain of sound sources
+    void BM_SoundSourceChain(benchmark::State& bstate){
+        auto chain = Chain{static_cast<std::size_t>(bstate.range(0))};
+        auto chunk = SoundChunk{};
+        for (auto _ : bstate){
+            chain.result.getNextChunk(chunk);
+            benchmark::DoNotOptimize(chunk);
+        }
+        bstate.SetItemsProcessed(bstate.iterations() * static_cast<std::int64_t>(SoundChunk::size));
+    }
+
+    // Renders chunks through a chain of sound sources, where the sound
+    // at the end of the chain depends for every sample on a number source
+    // belonging to the first link of the chain
+    void BM_SoundNumberSourceChain(benchmark::State& bstate){
+        auto chain = Chain{static_cast<std::size_t>(bstate.range(0))};
+        chain.end.level.setSource(&chain.links.front()->level);
+        auto chunk = SoundChunk{};
+        for (auto _ : bstate){
+            chain.result.getNextChunk(chunk);
+            benchmark::DoNotOptimize(chunk);
+        }
+        bstate.SetItemsProcessed(bstate.iterations() * static_cast<std::int64_t>(SoundChunk::size));
+    }
+
+} // anonymous namespace
+
+BENCHMARK(BM_SoundSourceChain)->Arg(50);
+BENCHMARK(BM_SoundNumberSourceChain)->Arg(50);
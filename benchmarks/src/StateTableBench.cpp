@@ -0,0 +1,247 @@
+#include <Flosion/Core/Network.hpp>
+#include <Flosion/Core/SoundResult.hpp>
+#include <Flosion/Objects/Ensemble.hpp>
+#include <Flosion/Objects/Melody.hpp>
+#include <Flosion/Objects/WaveGenerator.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+using namespace flo;
+
+namespace {
+
+    // SoundResult <- Melody <- Ensemble <- WaveGenerator, with one
+    // Ensemble state per note and one WaveGenerator state per voice
+    struct EnsembleUnderMelody {
+        EnsembleUnderMelody(size_t numNotes, StateTable::SlotStorage storage){
+            for (StateTable* st : std::initializer_list<StateTable*>{
+                &result, &result.getInput(), &melody, &melody.input,
+                &ensemble, &ensemble.input, &waveGen
+            }){
+                st->setSlotStorage(storage);
+            }
+
+            melody.setLength(numNotes * 1024);
+            for (size_t i = 0; i < numNotes; ++i){
+                // Notes all overlap so that the Melody needs one input key per note
+                melody.addNote(0, numNotes * 1024, 440.0);
+            }
+
+            ensemble.input.setSource(&waveGen);
+            melody.input.setSource(&ensemble);
+            result.setSource(&melody);
+        }
+
+        ~EnsembleUnderMelody(){
+            result.setSource(nullptr);
+            melody.input.setSource(nullptr);
+            ensemble.input.setSource(nullptr);
+        }
+
+        SoundResult result;
+        Melody melody;
+        Ensemble ensemble;
+        WaveGenerator waveGen;
+    };
+
+    // Adds and then removes one extra voice of the Ensemble, which inserts
+    // and erases one WaveGenerator state per Melody note
+    void addRemoveVoice(benchmark::State& bstate, StateTable::SlotStorage storage){
+        const auto numNotes = static_cast<size_t>(bstate.range(0));
+        auto network = EnsembleUnderMelody{numNotes, storage};
+        const auto extraVoice = Ensemble::numVoices;
+        for (auto _ : bstate){
+            network.ensemble.input.addKey(extraVoice);
+            network.ensemble.input.removeKey(extraVoice);
+        }
+        bstate.counters["states"] = static_cast<double>(network.waveGen.numSlots());
+    }
+
+    void BM_EnsembleVoiceEdit_Contiguous(benchmark::State& bstate){
+        addRemoveVoice(bstate, StateTable::SlotStorage::Contiguous);
+    }
+
+    void BM_EnsembleVoiceEdit_StableAddress(benchmark::State& bstate){
+        addRemoveVoice(bstate, StateTable::SlotStorage::StableAddress);
+    }
+
+
+    // Like SoundResult, owns a single state regardless of its dependents
+    class RootNode : public Realtime<Uncontrolled<SoundNode, EmptySoundState>> {
+    public:
+        RootNode(){
+            enableMonostate();
+        }
+    };
+
+    using KeyedNode = Realtime<Divergent<SoundNode, EmptySoundState, int>>;
+    using ChainNode = Realtime<Singular<SoundNode, EmptySoundState>>;
+
+    // Builds and tears down a divergent node followed by a long chain of
+    // singular nodes, with all states allocated either from a network's
+    // arena or from the system allocator
+    void loadAndTeardown(benchmark::State& bstate, bool useArena){
+        const auto numKeys = static_cast<int>(bstate.range(0));
+        const auto chainLength = size_t{32};
+        for (auto _ : bstate){
+            auto network = std::make_unique<Network>();
+            const auto networkPtr = useArena ? network.get() : nullptr;
+            {
+                auto root = RootNode{};
+                auto keyed = KeyedNode{networkPtr};
+                auto chain = std::vector<std::unique_ptr<ChainNode>>{};
+                for (size_t i = 0; i < chainLength; ++i){
+                    chain.push_back(std::make_unique<ChainNode>(networkPtr));
+                }
+
+                root.addDependency(&keyed);
+                for (int k = 0; k < numKeys; ++k){
+                    keyed.addKey(k);
+                }
+                keyed.addDependency(chain.front().get());
+                for (size_t i = 1; i < chainLength; ++i){
+                    chain[i - 1]->addDependency(chain[i].get());
+                }
+
+                // tear down in the opposite order
+                for (size_t i = chainLength - 1; i > 0; --i){
+                    chain[i - 1]->removeDependency(chain[i].get());
+                }
+                keyed.removeDependency(chain.front().get());
+                root.removeDependency(&keyed);
+            }
+            network.reset();
+        }
+    }
+
+    void BM_PatchLoadTeardown_SystemAllocator(benchmark::State& bstate){
+        loadAndTeardown(bstate, false);
+    }
+
+    void BM_PatchLoadTeardown_NetworkArena(benchmark::State& bstate){
+        loadAndTeardown(bstate, true);
+    }
+
+    // Builds a patch of 300 nodes in the order a project might be loaded:
+    // all connections are made first, after which the keys of the divergent
+    // node at the top are restored, either one edit at a time or all in
+    // one transaction. Only the loading is timed.
+    void loadPatch(benchmark::State& bstate, bool useTransaction){
+        const auto numKeys = static_cast<int>(bstate.range(0));
+        const auto chainLength = size_t{300};
+        for (auto _ : bstate){
+            auto network = Network{};
+            auto root = RootNode{};
+            auto keyed = std::make_unique<KeyedNode>(&network);
+            auto chain = std::vector<std::unique_ptr<ChainNode>>{};
+            for (size_t i = 0; i < chainLength; ++i){
+                chain.push_back(std::make_unique<ChainNode>(&network));
+            }
+
+            if (useTransaction){
+                network.beginTransaction();
+            }
+            root.addDependency(keyed.get());
+            keyed->addDependency(chain.front().get());
+            for (size_t i = 1; i < chainLength; ++i){
+                chain[i - 1]->addDependency(chain[i].get());
+            }
+            for (int k = 0; k < numKeys; ++k){
+                keyed->addKey(k);
+            }
+            if (useTransaction){
+                network.commitTransaction();
+            }
+            benchmark::DoNotOptimize(chain.back()->getState(0));
+
+            bstate.PauseTiming();
+            {
+                auto t = Network::Transaction{network};
+                root.removeDependency(keyed.get());
+                chain.clear();
+                keyed.reset();
+            }
+            bstate.ResumeTiming();
+        }
+    }
+
+    void BM_PatchLoad_Immediate(benchmark::State& bstate){
+        loadPatch(bstate, false);
+    }
+
+    void BM_PatchLoad_Transaction(benchmark::State& bstate){
+        loadPatch(bstate, true);
+    }
+
+    // Looks up the state of every key of a divergent node, as done by
+    // its dependent for every chunk
+    void BM_GetState(benchmark::State& bstate){
+        const auto numKeys = static_cast<int>(bstate.range(0));
+        auto root = RootNode{};
+        auto keyed = KeyedNode{};
+        root.addDependency(&keyed);
+        for (int k = 0; k < numKeys; ++k){
+            keyed.addKey(k);
+        }
+        const auto rootState = root.getMonoState();
+        for (auto _ : bstate){
+            for (int k = 0; k < numKeys; ++k){
+                benchmark::DoNotOptimize(keyed.getState(&root, rootState, static_cast<size_t>(k)));
+            }
+        }
+        bstate.SetItemsProcessed(bstate.iterations() * numKeys);
+        root.removeDependency(&keyed);
+    }
+
+    // Adds and then removes one key of a divergent node that has
+    // a number of keys already
+    void BM_InsertKeys(benchmark::State& bstate){
+        const auto numKeys = static_cast<int>(bstate.range(0));
+        auto root = RootNode{};
+        auto keyed = KeyedNode{};
+        root.addDependency(&keyed);
+        for (int k = 0; k < numKeys; ++k){
+            keyed.addKey(k);
+        }
+        for (auto _ : bstate){
+            keyed.addKey(numKeys);
+            keyed.removeKey(numKeys);
+        }
+        root.removeDependency(&keyed);
+    }
+
+    // Connects and then disconnects a singular node below a divergent node,
+    // which inserts and erases one of its states per key of the divergent node
+    void BM_InsertDependentStates(benchmark::State& bstate){
+        const auto numKeys = static_cast<int>(bstate.range(0));
+        auto root = RootNode{};
+        auto keyed = KeyedNode{};
+        auto below = ChainNode{};
+        root.addDependency(&keyed);
+        for (int k = 0; k < numKeys; ++k){
+            keyed.addKey(k);
+        }
+        for (auto _ : bstate){
+            keyed.addDependency(&below);
+            keyed.removeDependency(&below);
+        }
+        root.removeDependency(&keyed);
+    }
+
+} // anonymous namespace
+
+BENCHMARK(BM_EnsembleVoiceEdit_Contiguous)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_EnsembleVoiceEdit_StableAddress)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_PatchLoadTeardown_SystemAllocator)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PatchLoadTeardown_NetworkArena)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_PatchLoad_Immediate)->RangeMultiplier(4)->Range(4, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PatchLoad_Transaction)->RangeMultiplier(4)->Range(4, 64)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_GetState)->RangeMultiplier(8)->Range(8, 512);
+BENCHMARK(BM_InsertKeys)->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_InsertDependentStates)->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMicrosecond);
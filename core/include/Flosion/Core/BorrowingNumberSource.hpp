@@ -29,14 +29,20 @@ namespace flo {
         friend class StateTable;
     };
 
-    template<typename StateType>
+    /**
+     * BorrowingNumberSourceTemplate is a number source whose state of type
+     * StateType is borrowed from a sound source. Derived must provide the method
+     *
+     *     Number evaluate(StateType* state, const SoundState* context) const noexcept;
+     *
+     * which is called directly with the borrowed state, rather than through
+     * a second virtual call. The method is best kept private, in which case
+     * Derived must befriend BorrowingNumberSourceTemplate<Derived, StateType>.
+     */
+    template<typename Derived, typename StateType>
     class BorrowingNumberSourceTemplate : public BorrowingNumberSource {
-    public:
-
-        virtual double evaluate(StateType* state, const SoundState* context) const noexcept = 0;
-
     private:
-        double evaluate(const SoundState* context) const noexcept override final;
+        Number evaluate(const SoundState* context) const noexcept override final;
 
         std::unique_ptr<StateAllocator> makeAllocater() const override final;
     };
@@ -1,22 +1,21 @@
+#include <Flosion/Core/RenderContext.hpp>
 #include <Flosion/Core/SoundSource.hpp>
 
 namespace flo {
 
-    template<typename StateType>
-    inline double BorrowingNumberSourceTemplate<StateType>::evaluate(const SoundState* context) const noexcept {
+    template<typename Derived, typename StateType>
+    inline Number BorrowingNumberSourceTemplate<Derived, StateType>::evaluate(const SoundState* context) const noexcept {
         if (auto lender = getStateLender()){
-            while (context){
-                if (context->getOwner() == lender){
-                    return evaluate((lender->getBorrowedState<StateType>(context, this)), context);
-                }
-                context = context->getDependentState();
+            // NOTE: the lender is also the owner of the borrowed state
+            if (const auto lenderState = RenderContext::findState(getStateOwner(), context)){
+                return static_cast<const Derived*>(this)->evaluate(lender->getBorrowedState<StateType>(lenderState, this), context);
             }
         }
         return 0.0;
     }
 
-    template<typename StateType>
-    inline std::unique_ptr<StateAllocator> BorrowingNumberSourceTemplate<StateType>::makeAllocater() const {
+    template<typename Derived, typename StateType>
+    inline std::unique_ptr<StateAllocator> BorrowingNumberSourceTemplate<Derived, StateType>::makeAllocater() const {
         return std::make_unique<ConcreteStateAllocator<StateType>>();
     }
 
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <Flosion/Core/Profiler.hpp>
+#include <Flosion/Core/Signal.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace flo {
+
+    /**
+     * DeadlineMonitor keeps track of how long each chunk takes to render,
+     * compared to the duration of the chunk, which is the time available for
+     * rendering it if sound is to be played back in real time. A chunk that
+     * takes longer than that is a deadline miss, and unless enough chunks were
+     * rendered ahead, the device playing it back runs out of sound.
+     * Every SoundResult has a monitor, which is updated with every chunk.
+     */
+    class DeadlineMonitor {
+    public:
+        DeadlineMonitor();
+
+        DeadlineMonitor(const DeadlineMonitor&) = delete;
+        DeadlineMonitor& operator=(const DeadlineMonitor&) = delete;
+
+        /**
+         * The duration of one chunk of sound, in seconds.
+         */
+        static double getChunkPeriod() noexcept;
+
+        struct ChunkReport {
+            // The number of chunks rendered before this one since the last reset
+            std::size_t chunkIndex = 0;
+
+            // The wall time taken to render the chunk
+            double seconds = 0.0;
+
+            // The time taken as a fraction of the chunk period
+            double budgetShare = 0.0;
+
+            // When the chunk was finished
+            std::chrono::system_clock::time_point time;
+
+            // The nodes which took the most time to render the chunk, slowest
+            // first. This is only filled in if profiling is compiled in (see Profiler).
+            std::array<Profiler::NodeTime, Profiler::maxBreakdownSize> breakdown;
+            std::size_t breakdownSize = 0;
+        };
+
+        /**
+         * Called on the rendering thread after every chunk with the time
+         * it took. Never blocks or allocates.
+         */
+        void record(std::chrono::steady_clock::duration elapsed) noexcept;
+
+        /**
+         * Called by whoever plays back the sound when it ran out of sound,
+         * for example because a chunk rendered ahead wasn't ready in time.
+         */
+        void reportXrun() noexcept;
+
+        /**
+         * Chunks which took at least the given fraction of the chunk period are
+         * kept as slow chunks (see getSlowChunks). This is 0.8 by default.
+         */
+        void setSlowThreshold(double budgetShare) noexcept;
+        double getSlowThreshold() const noexcept;
+
+        static constexpr std::size_t maxSlowChunks = 32;
+
+        /**
+         * The most recent slow chunks, at most maxSlowChunks, oldest first.
+         */
+        std::vector<ChunkReport> getSlowChunks() const;
+
+        // The width of each bucket of the histogram, as a fraction of the chunk period
+        static constexpr double bucketWidth = 0.05;
+
+        // The last bucket also counts every chunk that took even longer
+        static constexpr std::size_t numBuckets = 40;
+
+        using Histogram = std::array<std::size_t, numBuckets>;
+
+        struct Stats {
+            std::size_t chunks = 0;
+            std::size_t deadlineMisses = 0;
+            std::size_t xruns = 0;
+
+            // The longest time taken by a chunk, as a fraction of the chunk period
+            double maxBudgetShare = 0.0;
+
+            // The number of chunks whose time was in each range of bucketWidth
+            // times the chunk period
+            Histogram histogram{};
+        };
+
+        /**
+         * May be called from any thread.
+         */
+        Stats getStats() const noexcept;
+
+        void reset() noexcept;
+
+        /**
+         * Broadcast with every chunk that takes longer than the chunk period.
+         * The events are deferred until deliverDeferredSignals() is called.
+         * While 16 of them are waiting to be delivered, further ones are dropped.
+         */
+        Signal<const ChunkReport&> onDeadlineMiss;
+
+    private:
+        std::atomic<std::size_t> m_chunks;
+        std::atomic<std::size_t> m_deadlineMisses;
+        std::atomic<std::size_t> m_xruns;
+        std::atomic<double> m_maxBudgetShare;
+        std::atomic<double> m_slowThreshold;
+        std::array<std::atomic<std::size_t>, numBuckets> m_histogram;
+
+        // NOTE: the rendering thread only tries to acquire the mutex, and
+        // forgets a slow chunk rather than waiting for a reader to finish
+        mutable std::mutex m_slowChunksMutex;
+        std::array<ChunkReport, maxSlowChunks> m_slowChunks;
+        std::size_t m_slowChunksBegin;
+        std::size_t m_slowChunksSize;
+    };
+
+} // namespace flo
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <Flosion/Core/SoundChunk.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace flo {
+
+    class SoundResult;
+
+    /**
+     * LookaheadRenderer renders a sound result on a thread of its own,
+     * staying a number of chunks ahead of whoever consumes them, so that
+     * a chunk which takes unusually long to render is absorbed by the
+     * chunks already queued instead of causing a dropout. This adds a
+     * latency of lookahead chunks.
+     * Chunks are handed over through a lock-free single-producer,
+     * single-consumer queue, so that getNextChunk() never blocks and is
+     * safe to call from an audio callback. If no chunk is ready in time,
+     * silence is returned instead and the chunk is counted as late; the
+     * sound then continues from where it left off, one chunk later.
+     */
+    class LookaheadRenderer {
+    public:
+        LookaheadRenderer(SoundResult& result, std::size_t lookahead = 2);
+        ~LookaheadRenderer() noexcept;
+
+        LookaheadRenderer(const LookaheadRenderer&) = delete;
+        LookaheadRenderer& operator=(const LookaheadRenderer&) = delete;
+
+        /**
+         * Starts rendering ahead. Chunks rendered before a previous
+         * call to stop() which were never consumed are discarded.
+         */
+        void start();
+
+        void stop() noexcept;
+
+        bool isRunning() const noexcept;
+
+        std::size_t getLookahead() const noexcept;
+
+        /**
+         * Takes the next rendered chunk, or silence if none is ready.
+         * Returns false in the latter case. Wait-free, and free of
+         * allocations as long as the number of channels of the sound
+         * result doesn't change.
+         */
+        bool getNextChunk(SoundChunk& chunk) noexcept;
+
+        struct Stats {
+            // The number of chunks that were requested by the consumer
+            std::size_t chunksRequested = 0;
+
+            // The number of chunks that weren't ready and were replaced by silence
+            std::size_t lateChunks = 0;
+
+            // The smallest number of chunks that were queued when one was requested,
+            // i.e. how close the renderer has come to being late
+            std::size_t minQueued = 0;
+        };
+
+        /**
+         * May be called from any thread.
+         */
+        Stats getStats() const noexcept;
+
+        void resetStats() noexcept;
+
+    private:
+        void run() noexcept;
+
+        SoundResult& m_result;
+
+        // One more slot than the lookahead, so that a full queue
+        // can be told apart from an empty one
+        std::vector<SoundChunk> m_slots;
+
+        // The next slot to be rendered into, written by the render thread only
+        alignas(64) std::atomic<std::size_t> m_writeIndex;
+
+        // The next slot to be consumed, written by the consumer only
+        alignas(64) std::atomic<std::size_t> m_readIndex;
+
+        alignas(64) std::atomic<std::size_t> m_chunksRequested;
+        std::atomic<std::size_t> m_lateChunks;
+        std::atomic<std::size_t> m_minQueued;
+
+        std::atomic<bool> m_running;
+        std::thread m_thread;
+    };
+
+} // namespace flo
@@ -1,4 +1,7 @@
 #include "MultiSoundInput.hpp"
+
+#include <Flosion/Core/RenderContext.hpp>
+
 namespace flo {
 
     template<typename StateType, typename KeyType>
@@ -12,7 +15,9 @@ namespace flo {
     inline void MultiSoundInput<StateType, KeyType>::getNextChunkFor(SoundChunk& chunk, const SoundNode* node, const SoundState* state, const KeyType& key){
         assert(node->hasDirectDependency(this));
         if (const auto src = this->getSource()){
-            src->getNextChunkFor(chunk, this, this->getState(node, state, key));
+            const auto ownState = this->getState(node, state, key);
+            auto scope = RenderContext::Scope{this, ownState};
+            src->getNextChunkFor(chunk, this, ownState);
         } else {
             chunk.silence();
         }
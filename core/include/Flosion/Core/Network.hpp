@@ -1,31 +1,169 @@
 #pragma once
 
 #include <Flosion/Core/Immovable.hpp>
+#include <Flosion/Core/NumberNode.hpp>
+#include <Flosion/Core/SoundNode.hpp>
+#include <Flosion/Core/StateArena.hpp>
 
+#include <cstddef>
+#include <memory>
 #include <vector>
 
 namespace flo {
-    
-    class SoundNode;
-    class NumberNode;
 
     class Network : private Immovable {
     public:
+        Network() noexcept;
 
+        // Destroys all nodes owned by the network, newest first
+        ~Network();
+
+        /**
+         * Creates a sound node which is owned by the network, passing the
+         * given arguments to its constructor. All other nodes constructed
+         * along with it, such as its inputs, join the network as well.
+         * Once they are all fully constructed, their initialization is run
+         * (see SoundNode::initLater), which is where their first states are
+         * allocated.
+         */
         template<typename SoundNodeType, typename... Args>
         SoundNodeType* addSoundNode(Args&&...);
 
+        /**
+         * Creates a number node which is owned by the network, like addSoundNode.
+         */
+        template<typename NumberNodeType, typename... Args>
+        NumberNodeType* addNumberNode(Args&&...);
+
+        /**
+         * Destroys a node which was created by the network.
+         */
+        void removeSoundNode(SoundNode*);
+        void removeNumberNode(NumberNode*);
+
+        /**
+         * The network whose addSoundNode or addNumberNode is constructing
+         * nodes on the calling thread, or null.
+         */
+        static Network* getConstructingNetwork() noexcept;
+
+        // All nodes in the network, in order of construction, including
+        // those which the network doesn't own
         std::vector<SoundNode*> getAllSoundNodes() noexcept;
         const std::vector<SoundNode*> getAllSoundNodes() const noexcept;
 
         std::vector<NumberNode*> getAllNumberNodes() noexcept;
         const std::vector<NumberNode*> getAllNumberNodes() const noexcept;
 
+        // The arena from which the states of all sound nodes in the network
+        // are allocated. All sound nodes must be destroyed before the network.
+        StateArena& getStateArena() noexcept;
+
+        /**
+         * Begins a batch of edits, such as loading or pasting a patch.
+         * Until the matching call to commitTransaction, changes to the states
+         * of sound nodes in the network are deferred: the first such change
+         * to a node discards all states of that node and of its dependencies,
+         * and committing allocates and constructs each of their state tables
+         * at once. Connections are still checked as they are made.
+         * While a transaction is open, the states of deferred nodes may not
+         * be accessed, and every sound result depending on them is suspended
+         * (see SoundResult::isSuspended) rather than locked, so that other
+         * threads rendering them aren't blocked by the edits. Sound results
+         * are only locked briefly to be suspended, and again at the commit
+         * to be resumed once all states are rebuilt.
+         * Deferred nodes start over from fresh states after the commit.
+         * Transactions may be nested, in which case only committing the
+         * outermost one has any effect.
+         */
+        void beginTransaction();
+
+        void commitTransaction();
+
+        bool isInTransaction() const noexcept;
+
+        /**
+         * Begins a transaction on construction and commits it on destruction.
+         * To be used just like std::lock_guard.
+         */
+        class Transaction : private Immovable {
+        public:
+            Transaction(Network&);
+            ~Transaction();
+
+        private:
+            Network& m_network;
+        };
+
         // TODO: ???
 
     private:
         std::vector<SoundNode*> m_soundNodes;
         std::vector<NumberNode*> m_numberNodes;
+
+        StateArena m_stateArena;
+
+        // NOTE: these are declared after the arena so that
+        // they're destroyed before it
+        std::vector<std::unique_ptr<SoundNode>> m_ownedSoundNodes;
+        std::vector<std::unique_ptr<NumberNode>> m_ownedNumberNodes;
+
+        // Sound nodes which were constructed by the network
+        // and haven't been initialized yet
+        std::vector<SoundNode*> m_uninitializedNodes;
+
+        // Makes the network the constructing network of the calling
+        // thread for its lifetime
+        class ConstructionScope : private Immovable {
+        public:
+            ConstructionScope(Network&) noexcept;
+            ~ConstructionScope() noexcept;
+
+        private:
+            Network* const m_previous;
+        };
+
+        // Called by every node in the network on construction and destruction
+        void addNode(SoundNode*);
+        void addNode(NumberNode*);
+        void removeNode(const SoundNode*) noexcept;
+        void removeNode(const NumberNode*) noexcept;
+
+        // Runs the initialization of every uninitialized node from the given index onwards
+        void initializeNodes(std::size_t first);
+
+        // The number of open transactions
+        std::size_t m_transactionDepth;
+
+        // Nodes whose states are discarded until the transaction is committed
+        std::vector<SoundNode*> m_deferredNodes;
+
+        // Sound results depending on deferred nodes
+        std::vector<SoundResult*> m_suspendedResults;
+
+        // Discards the states of the given node and of all its dependencies
+        // until the transaction is committed
+        void deferStates(SoundNode*);
+
+        // Suspends every sound result depending on the given node
+        // until the transaction is committed
+        void suspendResults(SoundNode*);
+
+        // Called when a deferred node is destroyed
+        void forgetDeferred(const SoundNode*) noexcept;
+
+        // Called when a suspended sound result is destroyed
+        void forgetSuspended(SoundResult*) noexcept;
+
+        // Rebuilds the states of the given node after those of its dependents
+        void rebuildStates(SoundNode*);
+
+        friend class NumberNode;
+        friend class SoundNode;
+        friend class SoundResult;
+        friend class StateTable;
     };
 
 } // namespace flo
+
+#include <Flosion/Core/Network.tpp>
@@ -0,0 +1,33 @@
+#include <type_traits>
+
+namespace flo {
+
+    template<typename SoundNodeType, typename... Args>
+    inline SoundNodeType* Network::addSoundNode(Args&&... args){
+        static_assert(std::is_base_of_v<SoundNode, SoundNodeType>, "SoundNodeType must derive from SoundNode");
+        const auto firstNew = m_uninitializedNodes.size();
+        auto node = [&](){
+            auto scope = ConstructionScope{*this};
+            return std::make_unique<SoundNodeType>(std::forward<Args>(args)...);
+        }();
+        const auto ret = node.get();
+        m_ownedSoundNodes.push_back(std::move(node));
+        initializeNodes(firstNew);
+        return ret;
+    }
+
+    template<typename NumberNodeType, typename... Args>
+    inline NumberNodeType* Network::addNumberNode(Args&&... args){
+        static_assert(std::is_base_of_v<NumberNode, NumberNodeType>, "NumberNodeType must derive from NumberNode");
+        const auto firstNew = m_uninitializedNodes.size();
+        auto node = [&](){
+            auto scope = ConstructionScope{*this};
+            return std::make_unique<NumberNodeType>(std::forward<Args>(args)...);
+        }();
+        const auto ret = node.get();
+        m_ownedNumberNodes.push_back(std::move(node));
+        initializeNodes(firstNew);
+        return ret;
+    }
+
+} // namespace flo
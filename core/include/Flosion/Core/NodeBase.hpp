@@ -3,7 +3,6 @@
 #include <Flosion/Core/Immovable.hpp>
 #include <Flosion/Core/Signal.hpp>
 
-#include <set>
 #include <vector>
 
 namespace flo {
@@ -15,10 +14,16 @@ namespace flo {
      * - void afterDependencyAdded(DerivedNode*);
      * - void beforeDependencyRemoved(DerivedNode*);
      * - [some type] acquireLock();
+     * The transitive dependencies and dependents of each node are cached and
+     * only recomputed after an edit has changed them, such that queries about
+     * indirect dependencies take logarithmic time between edits.
+     * NOTE: these caches are updated by queries, and so the graph may only
+     * be queried from the thread that edits it.
      */
     template<typename DerivedNode>
     class NodeBase : private Immovable {
     public:
+        NodeBase() noexcept;
         ~NodeBase();
 
         void addDependency(DerivedNode* node);
@@ -26,9 +31,15 @@ namespace flo {
 
         const std::vector<DerivedNode*>& getDirectDependencies() const noexcept;
         const std::vector<DerivedNode*>& getDirectDependents() const noexcept;
+
+        /**
+         * Returns this node and all nodes it depends on (directly or indirectly),
+         * or which depend on it, sorted by address. The result refers to a cache
+         * which remains valid until the next edit of the graph.
+         */
         // TODO: why is the constness different here?
-        std::set<const DerivedNode*> getAllDependencies() const noexcept;
-        std::set<const DerivedNode*> getAllDependents() const noexcept;
+        const std::vector<const DerivedNode*>& getAllDependencies() const noexcept;
+        const std::vector<const DerivedNode*>& getAllDependents() const noexcept;
 
         /**
          * Returns true if this node depends (directly or indirectly)
@@ -41,6 +52,19 @@ namespace flo {
     private:
         std::vector<DerivedNode*> m_dependencies;
         std::vector<DerivedNode*> m_dependents;
+
+        // NOTE: if a node's cache of all dependencies is invalid, so are those
+        // of all its dependents, and if its cache of all dependents is invalid,
+        // so are those of all its dependencies. Thus invalidating stops at nodes
+        // which are already invalid, and recomputing a cache reuses the valid
+        // caches of direct dependencies or dependents.
+        mutable std::vector<const DerivedNode*> m_allDependencies;
+        mutable std::vector<const DerivedNode*> m_allDependents;
+        mutable bool m_allDependenciesValid;
+        mutable bool m_allDependentsValid;
+
+        void invalidateAllDependencies() noexcept;
+        void invalidateAllDependents() noexcept;
     };
 
 
@@ -1,9 +1,18 @@
 #include <algorithm>
 #include <cassert>
+#include <functional>
+#include <iterator>
 #include <type_traits>
 
 namespace flo {
 
+    template<typename DerivedNode>
+    inline NodeBase<DerivedNode>::NodeBase() noexcept
+        : m_allDependenciesValid(false)
+        , m_allDependentsValid(false) {
+
+    }
+
     template<typename DerivedNode>
     inline NodeBase<DerivedNode>::~NodeBase(){
         while (m_dependencies.size() > 0){
@@ -24,6 +33,8 @@ namespace flo {
         }
         m_dependencies.push_back(node);
         node->m_dependents.push_back(static_cast<DerivedNode*>(this));
+        invalidateAllDependencies();
+        node->invalidateAllDependents();
         static_cast<DerivedNode*>(this)->afterDependencyAdded(node);
     }
 
@@ -44,6 +55,8 @@ namespace flo {
             std::remove(node->m_dependents.begin(), node->m_dependents.end(), this),
             node->m_dependents.end()
         );
+        invalidateAllDependencies();
+        node->invalidateAllDependents();
     }
 
     template<typename DerivedNode>
@@ -59,31 +72,47 @@ namespace flo {
     }
 
     template<typename DerivedNode>
-    inline std::set<const DerivedNode*> NodeBase<DerivedNode>::getAllDependencies() const noexcept {
-        std::set<const DerivedNode*> nodes;
-        std::function<void(const DerivedNode*)> search = [&](const DerivedNode* n){
-            assert(n);
-            nodes.insert(n);
-            for (const auto& d : n->getDirectDependencies()){
-                search(d);
+    inline const std::vector<const DerivedNode*>& NodeBase<DerivedNode>::getAllDependencies() const noexcept {
+        if (!m_allDependenciesValid){
+            auto nodes = std::vector<const DerivedNode*>{static_cast<const DerivedNode*>(this)};
+            auto merged = std::vector<const DerivedNode*>{};
+            for (const auto& d : m_dependencies){
+                const auto& dnodes = d->getAllDependencies();
+                merged.clear();
+                std::set_union(
+                    nodes.begin(), nodes.end(),
+                    dnodes.begin(), dnodes.end(),
+                    std::back_inserter(merged),
+                    std::less<const DerivedNode*>{}
+                );
+                nodes.swap(merged);
             }
-        };
-        search(static_cast<const DerivedNode*>(this));
-        return nodes;
+            m_allDependencies = std::move(nodes);
+            m_allDependenciesValid = true;
+        }
+        return m_allDependencies;
     }
 
     template<typename DerivedNode>
-    inline std::set<const DerivedNode*> NodeBase<DerivedNode>::getAllDependents() const noexcept {
-        std::set<const DerivedNode*> nodes;
-        const std::function<void(const DerivedNode*)> search = [&](const DerivedNode* n){
-            assert(n);
-            nodes.insert(n);
-            for (const auto& d : n->getDirectDependents()){
-                search(d);
+    inline const std::vector<const DerivedNode*>& NodeBase<DerivedNode>::getAllDependents() const noexcept {
+        if (!m_allDependentsValid){
+            auto nodes = std::vector<const DerivedNode*>{static_cast<const DerivedNode*>(this)};
+            auto merged = std::vector<const DerivedNode*>{};
+            for (const auto& d : m_dependents){
+                const auto& dnodes = d->getAllDependents();
+                merged.clear();
+                std::set_union(
+                    nodes.begin(), nodes.end(),
+                    dnodes.begin(), dnodes.end(),
+                    std::back_inserter(merged),
+                    std::less<const DerivedNode*>{}
+                );
+                nodes.swap(merged);
             }
-        };
-        search(static_cast<const DerivedNode*>(this));
-        return nodes;
+            m_allDependents = std::move(nodes);
+            m_allDependentsValid = true;
+        }
+        return m_allDependents;
     }
 
     template<typename DerivedNode>
@@ -91,12 +120,8 @@ namespace flo {
         if (this == node){
             return true;
         }
-        for (const auto& d : m_dependencies){
-            if (d->hasDependency(node)){
-                return true;
-            }
-        }
-        return false;
+        const auto& nodes = getAllDependencies();
+        return std::binary_search(nodes.begin(), nodes.end(), node, std::less<const DerivedNode*>{});
     }
 
     template<typename DerivedNode>
@@ -104,6 +129,28 @@ namespace flo {
         return std::find(m_dependencies.begin(), m_dependencies.end(), node) != m_dependencies.end();
     }
 
+    template<typename DerivedNode>
+    inline void NodeBase<DerivedNode>::invalidateAllDependencies() noexcept {
+        if (!m_allDependenciesValid){
+            return;
+        }
+        m_allDependenciesValid = false;
+        for (const auto& d : m_dependents){
+            d->invalidateAllDependencies();
+        }
+    }
+
+    template<typename DerivedNode>
+    inline void NodeBase<DerivedNode>::invalidateAllDependents() noexcept {
+        if (!m_allDependentsValid){
+            return;
+        }
+        m_allDependentsValid = false;
+        for (const auto& d : m_dependencies){
+            d->invalidateAllDependents();
+        }
+    }
+
 
 
     template<typename Traits>
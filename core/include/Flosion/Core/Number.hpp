@@ -0,0 +1,30 @@
+#pragma once
+
+namespace flo {
+
+    /**
+     * Number is the type of every value computed by the number graph, i.e.
+     * the values returned by number sources and number inputs.
+     * It is double by default. If FLOSION_SINGLE_PRECISION_NUMBERS is defined
+     * (see the CMake option of the same name), it is float instead, which
+     * halves the size of number-related state and doubles the number of
+     * values that fit in a SIMD register.
+     *
+     * Accuracy in single precision: pure functions of moderate arguments are
+     * accurate to within a few units in the last place, i.e. a relative error
+     * of about 1e-6, which is far below what can be heard in audio rendered
+     * as float anyway. Values that grow without bound lose absolute precision
+     * instead: a time in seconds is only resolved to about 0.25 milliseconds
+     * after one hour, and periodic functions of such values suffer accordingly.
+     *
+     * State that accumulates many small increments, such as phases and
+     * elapsed times, should therefore keep using double internally and only
+     * be converted to Number when it is handed to the number graph.
+     */
+#ifdef FLOSION_SINGLE_PRECISION_NUMBERS
+    using Number = float;
+#else
+    using Number = double;
+#endif
+
+} // namespace flo
@@ -6,6 +6,7 @@
 
 #include <atomic>
 #include <cassert>
+#include <cstdint>
 
 namespace flo {
 
@@ -40,9 +41,14 @@ namespace flo {
 
     class NumberNode : public NodeBase<NumberNode> {
     public:
+        // The node joins the network which is constructing it, if
+        // any (see Network::addNumberNode)
         NumberNode();
         virtual ~NumberNode();
 
+        // The network the node belongs to, or null
+        Network* getNetwork() const noexcept;
+
         bool canAddDependency(const NumberNode*) const noexcept;
 
         // TODO: hide these
@@ -58,6 +64,12 @@ namespace flo {
         NumberSource* toNumberSource() noexcept;
         virtual const NumberSource* toNumberSource() const noexcept;
 
+        /**
+         * Nodes with random behaviour override this to take the given seed,
+         * as done by SoundResult in deterministic mode. Does nothing by default.
+         */
+        virtual void reseed(std::uint64_t seed) noexcept;
+
     protected:
         void setStateOwner(SoundNode*);
 
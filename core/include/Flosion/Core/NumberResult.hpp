@@ -10,7 +10,7 @@ namespace flo {
     public:
         NumberResult() noexcept;
 
-        double getValue() const noexcept;
+        Number getValue() const noexcept;
 
         SoundNumberInput input;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Flosion/Core/Immovable.hpp>
+#include <Flosion/Core/Number.hpp>
 #include <Flosion/Core/NumberNode.hpp>
 #include <Flosion/Core/Signal.hpp>
 
@@ -27,20 +28,20 @@ namespace flo {
 
     class NumberInput : public InputNodeBase<NumberTraits> {
     public:
-        double getValue(const SoundState* context) const noexcept;
+        Number getValue(const SoundState* context) const noexcept;
 
-        double getDefaultValue() const noexcept;
-        void setDefaultValue(double) noexcept;
+        Number getDefaultValue() const noexcept;
+        void setDefaultValue(Number) noexcept;
 
-        Signal<double> onDefaultValueChanged;
+        Signal<Number> onDefaultValueChanged;
 
         // TODO: get a real lock
         std::lock_guard<std::mutex> acquireLock();
 
     private:
-        NumberInput(double defaultValue = 0.0) noexcept;
+        NumberInput(Number defaultValue = 0.0) noexcept;
 
-        double m_defaultValue;
+        Number m_defaultValue;
 
         // TODO: remove
         std::mutex m_uselessMutexPleaseRemove;
@@ -55,7 +56,7 @@ namespace flo {
 
     class NumberSource : public OutputNodeBase<NumberTraits> {
     public:
-        virtual double evaluate(const SoundState* context) const noexcept = 0;
+        virtual Number evaluate(const SoundState* context) const noexcept = 0;
 
     private:
         const NumberInput* toNumberInput() const noexcept override final;
@@ -64,23 +65,23 @@ namespace flo {
 
     class Constant : public NumberSource {
     public:
-        Constant(double value = 0.0) noexcept;
+        Constant(Number value = 0.0) noexcept;
 
-        double getValue() const noexcept;
-        void setValue(double) noexcept;
+        Number getValue() const noexcept;
+        void setValue(Number) noexcept;
 
-        Signal<double> onChangeValue;
+        Signal<Number> onChangeValue;
 
     private:
 
-        std::atomic<double> m_value;
+        std::atomic<Number> m_value;
 
-        double evaluate(const SoundState* context) const noexcept override final;
+        Number evaluate(const SoundState* context) const noexcept override final;
     };
 
     class NumberSourceInput : public NumberInput {
     public:
-        NumberSourceInput(NumberSource* owner, double defaultValue = 0.0);
+        NumberSourceInput(NumberSource* owner, Number defaultValue = 0.0);
     };
 
 
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <Flosion/Core/Immovable.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace flo {
+
+    class NumberSource;
+    class SoundNode;
+    class SoundState;
+
+    /**
+     * Profiler measures how long every node takes to render, for finding
+     * the nodes that are expensive in a given network.
+     * Profiling is compiled in only if FLOSION_PROFILING is defined (see the
+     * FLOSION_PROFILING CMake option). Otherwise, the scopes used to measure
+     * nodes are empty and optimized away, and no statistics are collected.
+     *
+     * Each sound source is timed once per chunk for each of its states.
+     * Number sources are evaluated once per sample, so the time spent in
+     * each of them is summed over every chunk rendered by the outermost
+     * sound source on the calling thread, and recorded as a single
+     * measurement per chunk, for all states together.
+     * Every measurement is of the time spent in the node itself, excluding
+     * the time spent in the nodes it depends on.
+     *
+     * Measurements are taken with the CPU's timestamp counter where available,
+     * and are written to a lock-free queue of the rendering thread, so that
+     * rendering is never blocked. They are aggregated by getStats().
+     * Only threads which were registered with registerCurrentThread() are
+     * measured.
+     */
+    class Profiler : private Immovable {
+    public:
+        static constexpr bool isCompiledIn() noexcept {
+#ifdef FLOSION_PROFILING
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /**
+         * Times the rendering of a chunk by a sound source for one of its states.
+         */
+        class SoundScope : private Immovable {
+        public:
+#ifdef FLOSION_PROFILING
+            SoundScope(const SoundNode* node, const SoundState* state) noexcept;
+            ~SoundScope() noexcept;
+        private:
+            const SoundNode* const m_node;
+            const SoundState* const m_state;
+            bool m_active;
+#else
+            SoundScope(const SoundNode*, const SoundState*) noexcept {}
+#endif
+        };
+
+        /**
+         * Times a single evaluation of a number source.
+         */
+        class NumberScope : private Immovable {
+        public:
+#ifdef FLOSION_PROFILING
+            NumberScope(const NumberSource* node) noexcept;
+            ~NumberScope() noexcept;
+        private:
+            const NumberSource* const m_node;
+            bool m_active;
+#else
+            NumberScope(const NumberSource*) noexcept {}
+#endif
+        };
+
+        /**
+         * Turns measurements on or off at runtime. Profiling is enabled by
+         * default when it is compiled in. Enabling it measures the rate of
+         * the timer if that wasn't done yet, which takes a moment.
+         */
+        static void setEnabled(bool enabled) noexcept;
+        static bool isEnabled() noexcept;
+
+        /**
+         * Allows the rendering done by the calling thread to be measured.
+         * This allocates, locks and measures the rate of the timer on first
+         * use, and is therefore meant to be called by each rendering thread
+         * before it starts rendering, such as when an audio stream starts,
+         * so that the scopes themselves never block. Calling it again on
+         * the same thread has no effect.
+         */
+        static void registerCurrentThread();
+
+        struct NodeStats {
+            // The sound source that was measured, or null for number sources
+            const SoundNode* soundNode = nullptr;
+
+            // The state of the sound source that was rendered
+            const SoundState* state = nullptr;
+
+            // The number source that was measured, or null for sound sources
+            const NumberSource* numberSource = nullptr;
+
+            // The number of measurements, i.e. of chunks rendered
+            std::size_t count = 0;
+
+            double meanSeconds = 0.0;
+
+            // NOTE: the 99th percentile is read from a histogram with
+            // eight buckets per doubling, and is accurate to within 10%
+            double p99Seconds = 0.0;
+
+            double maxSeconds = 0.0;
+
+            // The mean time taken as a fraction of the duration of one chunk
+            // of sound, i.e. of the time available for rendering one chunk
+            double budgetShare = 0.0;
+        };
+
+        /**
+         * The time a node took to render a single chunk.
+         */
+        struct NodeTime {
+            const SoundNode* soundNode = nullptr;
+            const SoundState* state = nullptr;
+            const NumberSource* numberSource = nullptr;
+            double seconds = 0.0;
+        };
+
+        static constexpr std::size_t maxBreakdownSize = 8;
+
+        /**
+         * Writes the nodes that took the most time to render the chunk last
+         * completed by the outermost sound source on the calling thread to
+         * out, which must have room for maxBreakdownSize entries, in
+         * descending order of time. Returns the number of entries written.
+         * This never blocks or allocates, and may thus be called while
+         * rendering, right after a chunk that took unusually long.
+         */
+        static std::size_t getLastChunkBreakdown(NodeTime* out) noexcept;
+
+        /**
+         * Returns the statistics of every node and state measured since the
+         * last call to reset(), in descending order of mean time.
+         * The nodes and states are identified by address only and are never
+         * dereferenced, and may thus have been destroyed in the meantime.
+         * May be called from any thread.
+         */
+        static std::vector<NodeStats> getStats();
+
+        /**
+         * Forgets all measurements taken so far.
+         */
+        static void reset();
+
+        /**
+         * The number of measurements that were discarded because they were
+         * not collected soon enough, since the last call to reset().
+         */
+        static std::size_t getDroppedCount();
+
+        /**
+         * The number of timer ticks per second.
+         */
+        static double ticksPerSecond() noexcept;
+
+        static std::uint64_t now() noexcept;
+    };
+
+} // namespace flo
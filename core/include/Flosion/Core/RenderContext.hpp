@@ -0,0 +1,108 @@
+#pragma once
+
+#include <Flosion/Core/Immovable.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace flo {
+
+    class SoundNode;
+    class SoundState;
+
+    /**
+     * RenderContext keeps track of the states whose chunks are currently
+     * being rendered on the calling thread, from the outermost sound source
+     * to the innermost one. It allows the state of any node along the chain
+     * of dependent states to be found in constant time, rather than by walking
+     * the chain one state at a time, which matters for number sources that are
+     * evaluated many levels below the node owning their state.
+     * Sound sources and sound inputs register their state with a Scope while
+     * they render a chunk.
+     */
+    class RenderContext : private Immovable {
+    public:
+        /**
+         * Registers the given state as the innermost state being rendered on
+         * the calling thread, for as long as the scope exists.
+         * Scopes must be destroyed in the reverse order of their creation.
+         */
+        class Scope : private Immovable {
+        public:
+            Scope(const SoundNode* owner, const SoundState* state) noexcept;
+            ~Scope() noexcept;
+        };
+
+        /**
+         * Returns the first state owned by the given node along the chain of
+         * dependent states starting at the given context, or nullptr if there
+         * is no such state.
+         * This takes constant time if the context is the innermost state
+         * being rendered on the calling thread and the owner's state was
+         * registered, and falls back to walking the chain otherwise.
+         */
+        static const SoundState* findState(const SoundNode* owner, const SoundState* context) noexcept;
+
+        /**
+         * The number of nested scopes that can be tracked. Deeper scopes
+         * are allowed, but lookups from within them walk the chain.
+         */
+        static constexpr std::size_t maxDepth = 64;
+
+    private:
+        // NOTE: the constructor is constexpr so that the per-thread context
+        // is constant-initialized and can be accessed without a guard
+        constexpr RenderContext() noexcept
+            : m_entries{}
+            , m_table{}
+            , m_depth(0) {
+
+        }
+
+        static RenderContext& current() noexcept;
+
+        void push(const SoundNode* owner, const SoundState* state) noexcept;
+        void pop() noexcept;
+
+        static std::size_t hash(const SoundNode* owner) noexcept;
+
+        static constexpr std::size_t tableBits = 7;
+        static constexpr std::size_t tableSize = std::size_t{1} << tableBits;
+        static constexpr std::size_t noEntry = static_cast<std::size_t>(-1);
+
+        static_assert(tableSize >= 2 * maxDepth);
+
+        struct Entry {
+            const SoundNode* owner;
+            const SoundState* state;
+
+            // The index of the outermost entry from which every entry
+            // up to this one depends directly on the previous one
+            std::size_t chainBase;
+
+            // Where this entry's owner is found in the table
+            std::size_t tableSlot;
+
+            // The previous entry with the same owner, if any, which is
+            // restored in the table when this entry is popped
+            std::size_t shadowedEntry;
+        };
+
+        // Open-addressed hash table from owners to their most recent entry.
+        // Slots without an owner are empty, regardless of their entry.
+        // Since entries are always removed in the reverse order of their
+        // insertion, removed slots can simply be emptied without disturbing
+        // the probe sequence of any other owner.
+        struct TableSlot {
+            const SoundNode* owner;
+            std::size_t entry;
+        };
+
+        std::array<Entry, maxDepth> m_entries;
+        std::array<TableSlot, tableSize> m_table;
+
+        // The number of active scopes, which may exceed maxDepth
+        std::size_t m_depth;
+    };
+
+} // namespace flo
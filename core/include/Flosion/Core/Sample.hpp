@@ -68,7 +68,10 @@ namespace flo {
 
     /**
      * SampleProxy acts just like a sample and represents the same thing,
-     * but its data is pointed to rather than owned.
+     * but its data is pointed to rather than owned. The left and right
+     * channels are pointed to separately, since they need not be adjacent.
+     * Both may point to the same mono sample, in which case assigning
+     * a sample through the proxy stores the average of its channels.
      * Beware of dangling references.
      */
     class SampleProxy final {
@@ -104,9 +107,12 @@ namespace flo {
         Sample operator/(float) const noexcept;
 
     private:
-        SampleProxy(float* ptr) noexcept;
+        SampleProxy(float* lPtr, float* rPtr) noexcept;
 
-        float* m_ptr;
+        void assign(float left, float right) noexcept;
+
+        float* m_lPtr;
+        float* m_rPtr;
 
         friend class SoundChunk;
         friend class Sample;
@@ -143,9 +149,10 @@ namespace flo {
         Sample operator/(float) const noexcept;
 
     private:
-        ConstSampleProxy(const float* ptr) noexcept;
+        ConstSampleProxy(const float* lPtr, const float* rPtr) noexcept;
 
-        const float* m_ptr;
+        const float* m_lPtr;
+        const float* m_rPtr;
 
         friend class SoundChunk;
         friend class Sample;
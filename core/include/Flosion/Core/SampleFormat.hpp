@@ -0,0 +1,125 @@
+#pragma once
+
+#include <Flosion/Core/SoundChunk.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace flo {
+
+    /**
+     * The formats in which samples are exchanged with devices and files.
+     * Integer samples are signed and span the full range of their type
+     * symmetrically, i.e. 1.0 becomes 32767 and -1.0 becomes -32767 in Int16.
+     * Int16 and Int32 samples are in native byte order, Int24 samples are
+     * packed into three bytes in little endian order.
+     */
+    enum class SampleFormat {
+        Float32,
+        Int16,
+        Int24,
+        Int32
+    };
+
+    constexpr std::size_t bytesPerSample(SampleFormat format) noexcept {
+        switch (format){
+        case SampleFormat::Float32: return 4;
+        case SampleFormat::Int16: return 2;
+        case SampleFormat::Int24: return 3;
+        case SampleFormat::Int32: return 4;
+        }
+        return 0;
+    }
+
+    /**
+     * Dither that is added before rounding samples to integers, which turns
+     * the distortion of low-level signals by quantization into a constant,
+     * signal-independent noise floor.
+     */
+    enum class Dither {
+        // Samples are only rounded
+        None,
+
+        // Triangular (TPDF) noise of +/-1 LSB is added
+        Triangular,
+
+        // As Triangular, but the quantization error is fed back with first
+        // order highpass shaping, moving the noise towards high frequencies
+        // where it is less audible
+        NoiseShaped
+    };
+
+    /**
+     * Writes numFrames frames of every channel of the chunk, starting at
+     * the given offset, to dst as interleaved floats.
+     */
+    void interleave(const SoundChunk& src, std::size_t offset, std::size_t numFrames, float* dst) noexcept;
+
+    /**
+     * Reads numFrames interleaved float frames with the same number of
+     * channels as the chunk into the chunk, starting at the given offset.
+     */
+    void deinterleave(const float* src, std::size_t numFrames, SoundChunk& dst, std::size_t offset) noexcept;
+
+    /**
+     * Converts count samples of the given format to floats.
+     */
+    void decodeSamples(const void* src, SampleFormat format, std::size_t count, float* dst) noexcept;
+
+    /**
+     * Reads numFrames interleaved frames of the given format with numChannels
+     * channels into the chunk, starting at the given offset. The first channel
+     * is written to the first channel of the chunk, and so on, and any other
+     * channels of either are ignored.
+     */
+    void decodeInterleaved(const void* src, SampleFormat format, std::size_t numChannels, std::size_t numFrames, SoundChunk& dst, std::size_t offset) noexcept;
+
+    /**
+     * SampleEncoder converts chunks to interleaved samples of any format,
+     * clamping them to [-1, 1] and optionally adding dither. The encoder
+     * keeps the state of the dither between calls, and should be reused for
+     * consecutive chunks of the same stream.
+     * Dither is only applied to Int16 and Int24, since the quantization
+     * error of the other formats is below the precision of float samples.
+     */
+    class SampleEncoder {
+    public:
+        SampleEncoder(SampleFormat format = SampleFormat::Int16, Dither dither = Dither::None) noexcept;
+
+        SampleFormat getFormat() const noexcept;
+
+        Dither getDither() const noexcept;
+
+        /**
+         * Writes numFrames frames of every channel of the chunk, starting at
+         * the given offset, to dst, which must have room for
+         * numFrames * numChannels * bytesPerSample(format) bytes.
+         */
+        void encode(const SoundChunk& src, std::size_t offset, std::size_t numFrames, void* dst) noexcept;
+
+        /**
+         * Restarts the dither noise sequence and forgets the error fed back
+         * by noise shaping, making the output reproducible.
+         */
+        void reset() noexcept;
+
+    private:
+        // Rounds one channel to integers of the given full scale, adding dither
+        void quantize(const float* src, std::size_t count, float fullScale, std::size_t channel, std::int32_t* dst) noexcept;
+
+        // The position in the dither noise sequence of the given channel
+        std::uint32_t seed(std::size_t channel) const noexcept;
+
+        SampleFormat m_format;
+        Dither m_dither;
+
+        // The position in the dither noise sequence
+        std::uint32_t m_counter;
+
+        // The quantization error of the last sample of each channel,
+        // in units of the least significant bit, used by noise shaping
+        std::array<float, SoundChunk::maxChannels> m_error;
+    };
+
+} // namespace flo
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <functional>
 #include <iostream>
-#include <map>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 namespace flo {
 
@@ -37,11 +42,19 @@ namespace flo {
         SignalBase* m_signal;
 
         friend SignalBase;
-        
+
         template<typename... Args>
         friend class Signal;
     };
 
+    /**
+     * Broadcasts every event that was queued with Signal::broadcastDeferred()
+     * since the last call, on the calling thread, in the order in which each
+     * signal's events were queued. This is meant to be called regularly by
+     * the UI thread.
+     */
+    void deliverDeferredSignals();
+
     /**
      * SignalBase is an implementation detail. Look away.
      */
@@ -49,10 +62,56 @@ namespace flo {
     protected:
         virtual void moveConnection(Connection* from, Connection* to) = 0;
         virtual void removeConnection(Connection* c) = 0;
-        
+
+        // Broadcasts the events queued by broadcastDeferred()
+        virtual void deliverDeferred() = 0;
+
+        // Adds or removes the signal from those visited by deliverDeferredSignals()
+        static void registerDeferred(SignalBase* s);
+        static void unregisterDeferred(SignalBase* s);
+
         friend Connection;
+        friend void deliverDeferredSignals();
     };
 
+    namespace detail {
+
+        class DeferredQueueBase {
+        public:
+            virtual ~DeferredQueueBase() noexcept = default;
+        };
+
+        /**
+         * A bounded, lock-free queue with any number of producers
+         * and a single consumer.
+         */
+        template<typename T>
+        class DeferredQueue : public DeferredQueueBase {
+        public:
+            DeferredQueue(std::size_t capacity);
+
+            // Returns false if the queue is full
+            bool push(T&& value) noexcept;
+
+            // Returns false if the queue is empty
+            bool pop(T& out) noexcept;
+
+        private:
+            struct Slot {
+                // Equal to the position of the slot when it is ready to be
+                // written, and to one past that once it has been written
+                std::atomic<std::size_t> sequence;
+                T value;
+            };
+
+            std::unique_ptr<Slot[]> m_slots;
+            std::size_t m_mask;
+            alignas(64) std::atomic<std::size_t> m_enqueuePosition;
+            alignas(64) std::size_t m_dequeuePosition;
+        };
+
+    } // namespace detail
+
 
     /**
      * Signal represents an event which can be subscribed to and broadcast from.
@@ -62,6 +121,9 @@ namespace flo {
      * Connection for as long as you want to stay subscribed.
      * To notify all the subscribed Connection objects of an event, simply
      * call the broadcast() function with arguments of your choosing.
+     * Handlers may connect to and disconnect from the signal while it is
+     * being broadcast, including from within a handler. Handlers connected
+     * during a broadcast are first called by the next one.
      */
     template<typename... Args>
     class Signal : private SignalBase {
@@ -71,21 +133,62 @@ namespace flo {
         Signal(Signal&&);
         Signal& operator=(Signal&&);
         ~Signal();
-        
+
         Signal(const Signal&) = delete;
         Signal& operator=(const Signal&) = delete;
 
         using Handler = std::function<void(Args...)>;
 
         Connection connect(Handler);
-        
+
+        /**
+         * Calls every handler on the calling thread. This doesn't allocate,
+         * but the handlers may do anything at all, and so this should not be
+         * called from the audio thread. See broadcastDeferred() instead.
+         */
         void broadcast(Args...);
 
+        /**
+         * Allows events to be queued by broadcastDeferred(), up to the given
+         * number at a time. Must be called before the first such event,
+         * typically by the owner of the signal.
+         */
+        void enableDeferredBroadcast(std::size_t capacity = 16);
+
+        /**
+         * Queues the event to be broadcast by the next call to
+         * deliverDeferredSignals(), without blocking or allocating, which
+         * makes it safe to call from the audio thread. The arguments are
+         * copied. Returns false and drops the event if the queue is full.
+         */
+        bool broadcastDeferred(Args...) noexcept;
+
     private:
         void moveConnection(Connection* from, Connection* to) override;
         void removeConnection(Connection* c) override;
+        void deliverDeferred() override;
+
+        struct Entry {
+            // Null once the handler was removed during a broadcast, until
+            // the broadcast finishes and the entry can be erased
+            Connection* connection;
+
+            Handler handler;
+        };
+
+        // NOTE: entries are held by pointer, so that adding handlers
+        // during a broadcast never moves a handler that is being called
+        std::vector<std::unique_ptr<Entry>> m_entries;
+
+        // The number of broadcasts currently in progress on this signal
+        std::size_t m_broadcastDepth;
+
+        // Whether any entries were removed during the current broadcast
+        bool m_hasRemovedEntries;
+
+        using Event = std::tuple<std::decay_t<Args>...>;
 
-        std::map<Connection*, Handler> m_handlers;
+        std::unique_ptr<detail::DeferredQueueBase> m_deferred;
     };
 
 } // namespace flo
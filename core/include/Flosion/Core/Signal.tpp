@@ -1,40 +1,129 @@
+#include <algorithm>
 #include <cassert>
+#include <utility>
 
 namespace flo {
 
+    namespace detail {
+
+        template<typename T>
+        inline DeferredQueue<T>::DeferredQueue(std::size_t capacity)
+            : m_mask(0)
+            , m_enqueuePosition(0)
+            , m_dequeuePosition(0) {
+            assert(capacity > 0);
+            auto n = std::size_t{1};
+            while (n < capacity){
+                n *= 2;
+            }
+            m_mask = n - 1;
+            m_slots = std::make_unique<Slot[]>(n);
+            for (std::size_t i = 0; i < n; ++i){
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        template<typename T>
+        inline bool DeferredQueue<T>::push(T&& value) noexcept {
+            auto pos = m_enqueuePosition.load(std::memory_order_relaxed);
+            while (true){
+                auto& slot = m_slots[pos & m_mask];
+                const auto seq = slot.sequence.load(std::memory_order_acquire);
+                if (seq == pos){
+                    if (m_enqueuePosition.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                        slot.value = std::move(value);
+                        slot.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (seq < pos){
+                    // The slot still holds the event from one lap ago
+                    return false;
+                } else {
+                    pos = m_enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        template<typename T>
+        inline bool DeferredQueue<T>::pop(T& out) noexcept {
+            auto& slot = m_slots[m_dequeuePosition & m_mask];
+            if (slot.sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1){
+                return false;
+            }
+            out = std::move(slot.value);
+            slot.sequence.store(m_dequeuePosition + m_mask + 1, std::memory_order_release);
+            ++m_dequeuePosition;
+            return true;
+        }
+
+    } // namespace detail
+
     template<typename... Args>
-    Signal<Args...>::Signal(){
-        
+    Signal<Args...>::Signal()
+        : m_broadcastDepth(0)
+        , m_hasRemovedEntries(false) {
+
     }
 
     template<typename... Args>
     Signal<Args...>::Signal(Signal&& s)
-        : m_handlers(std::move(s.m_handlers)) {
-        for (auto [c, h] : m_handlers){
-            assert(c->m_signal == &s);
-            c->m_signal = this;
+        : m_entries(std::move(s.m_entries))
+        , m_broadcastDepth(0)
+        , m_hasRemovedEntries(s.m_hasRemovedEntries)
+        , m_deferred(std::move(s.m_deferred)) {
+        assert(s.m_broadcastDepth == 0);
+        for (auto& e : m_entries){
+            if (e->connection){
+                assert(e->connection->m_signal == &s);
+                e->connection->m_signal = this;
+            }
+        }
+        if (m_deferred){
+            unregisterDeferred(&s);
+            registerDeferred(this);
         }
     }
 
     template<typename... Args>
     Signal<Args...>& Signal<Args...>::operator=(Signal&& s){
-        for (auto [c, h] : m_handlers){
-            assert(c->m_signal == this);
-            c->m_signal = nullptr;
+        assert(m_broadcastDepth == 0);
+        assert(s.m_broadcastDepth == 0);
+        for (auto& e : m_entries){
+            if (e->connection){
+                assert(e->connection->m_signal == this);
+                e->connection->m_signal = nullptr;
+            }
+        }
+        if (m_deferred){
+            unregisterDeferred(this);
         }
-        m_handlers = std::move(s.m_handlers);
-        for (auto [c, h] : m_handlers){
-            assert(c->m_signal == &s);
-            c->m_signal = this;
+        m_entries = std::move(s.m_entries);
+        m_hasRemovedEntries = s.m_hasRemovedEntries;
+        m_deferred = std::move(s.m_deferred);
+        for (auto& e : m_entries){
+            if (e->connection){
+                assert(e->connection->m_signal == &s);
+                e->connection->m_signal = this;
+            }
+        }
+        if (m_deferred){
+            unregisterDeferred(&s);
+            registerDeferred(this);
         }
         return *this;
     }
 
     template<typename... Args>
     Signal<Args...>::~Signal(){
-        for (auto& [c, h] : m_handlers){
-            assert(c->m_signal == this);
-            c->m_signal = nullptr;
+        assert(m_broadcastDepth == 0);
+        for (auto& e : m_entries){
+            if (e->connection){
+                assert(e->connection->m_signal == this);
+                e->connection->m_signal = nullptr;
+            }
+        }
+        if (m_deferred){
+            unregisterDeferred(this);
         }
     }
 
@@ -42,33 +131,87 @@ namespace flo {
     Connection Signal<Args...>::connect(Signal<Args...>::Handler h){
         auto c = Connection{};
         c.m_signal = this;
-        m_handlers.try_emplace(&c, std::move(h));
+        m_entries.push_back(std::make_unique<Entry>(Entry{&c, std::move(h)}));
         return c;
     }
 
     template<typename... Args>
     void Signal<Args...>::broadcast(Args... args){
-        auto tempHandlers = m_handlers;
-        for (auto& [c, h] : tempHandlers){
-            h(args...);
+        // NOTE: handlers that are connected during the broadcast are
+        // added past the end and are not called, and handlers that are
+        // disconnected are only marked as such until the end
+        const auto n = m_entries.size();
+        ++m_broadcastDepth;
+        for (std::size_t i = 0; i < n; ++i){
+            auto& e = *m_entries[i];
+            if (e.connection){
+                e.handler(args...);
+            }
+        }
+        if (--m_broadcastDepth == 0 && m_hasRemovedEntries){
+            m_entries.erase(
+                std::remove_if(
+                    m_entries.begin(),
+                    m_entries.end(),
+                    [](const std::unique_ptr<Entry>& e){ return e->connection == nullptr; }
+                ),
+                m_entries.end()
+            );
+            m_hasRemovedEntries = false;
+        }
+    }
+
+    template<typename... Args>
+    void Signal<Args...>::enableDeferredBroadcast(std::size_t capacity){
+        if (m_deferred){
+            return;
+        }
+        m_deferred = std::make_unique<detail::DeferredQueue<Event>>(capacity);
+        registerDeferred(this);
+    }
+
+    template<typename... Args>
+    bool Signal<Args...>::broadcastDeferred(Args... args) noexcept {
+        assert(m_deferred);
+        if (!m_deferred){
+            return false;
+        }
+        auto q = static_cast<detail::DeferredQueue<Event>*>(m_deferred.get());
+        return q->push(Event{std::move(args)...});
+    }
+
+    template<typename... Args>
+    void Signal<Args...>::deliverDeferred(){
+        auto q = static_cast<detail::DeferredQueue<Event>*>(m_deferred.get());
+        auto e = Event{};
+        while (q->pop(e)){
+            std::apply([this](auto&... a){ broadcast(a...); }, e);
         }
     }
 
     template<typename... Args>
     void Signal<Args...>::moveConnection(Connection* from, Connection* to){
         assert(from != to);
-        auto it = m_handlers.find(from);
-        assert(it != m_handlers.end());
-        auto h = std::move(it->second);
-        m_handlers.erase(it);
-        m_handlers.try_emplace(to, std::move(h));
+        auto it = std::find_if(m_entries.begin(), m_entries.end(), [&](const std::unique_ptr<Entry>& e){
+            return e->connection == from;
+        });
+        assert(it != m_entries.end());
+        (*it)->connection = to;
     }
 
     template<typename... Args>
     void Signal<Args...>::removeConnection(Connection* c){
-        auto it = m_handlers.find(c);
-        assert(it != m_handlers.end());
-        m_handlers.erase(it);
+        auto it = std::find_if(m_entries.begin(), m_entries.end(), [&](const std::unique_ptr<Entry>& e){
+            return e->connection == c;
+        });
+        assert(it != m_entries.end());
+        if (m_broadcastDepth > 0){
+            // The handler may be the one being called
+            (*it)->connection = nullptr;
+            m_hasRemovedEntries = true;
+        } else {
+            m_entries.erase(it);
+        }
     }
 
 } // namespace flo
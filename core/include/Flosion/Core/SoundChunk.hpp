@@ -2,32 +2,147 @@
 
 #include <Flosion/Core/Sample.hpp>
 
-#include <array>
+#include <cstddef>
 
 namespace flo {
 
+    /**
+     * Common numbers of audio channels.
+     */
+    namespace channels {
+
+        inline constexpr std::size_t mono = 1;
+        inline constexpr std::size_t stereo = 2;
+        inline constexpr std::size_t quad = 4;
+        inline constexpr std::size_t surround51 = 6;
+        inline constexpr std::size_t surround71 = 8;
+
+        /**
+         * The number of channels of full-sphere ambisonics of the given order.
+         */
+        constexpr std::size_t ambisonic(std::size_t order) noexcept {
+            return (order + 1) * (order + 1);
+        }
+
+    } // namespace channels
+
+    /**
+     * SoundChunk is a fixed-size block of audio with any number of channels.
+     * The samples of each channel are stored contiguously (planar layout)
+     * and every channel begins on a 64-byte boundary, so that loops over
+     * a channel can be compiled to packed SIMD instructions.
+     * Mono and stereo chunks store their samples inline, and only chunks
+     * with more channels allocate them separately.
+     * The number of channels of the chunk passed to a sound source is
+     * decided by the SoundResult at the root of the graph, and sound
+     * sources are expected to fill every channel.
+     * Individual samples may be accessed through l(), r() and proxies, which
+     * refer to the first two channels only, or to the only channel of a mono
+     * chunk. Mixing should preferably be done with the bulk operations below.
+     */
     class SoundChunk {
     public:
-        SoundChunk() noexcept;
+        SoundChunk(std::size_t numChannels = channels::stereo);
+        SoundChunk(const SoundChunk&);
+        SoundChunk(SoundChunk&&) noexcept;
+        SoundChunk& operator=(const SoundChunk&);
+        SoundChunk& operator=(SoundChunk&&) noexcept;
+        ~SoundChunk() noexcept;
 
         static constexpr size_t size = 1024;
-        
+        static constexpr size_t maxChannels = channels::ambisonic(3);
+        static constexpr size_t maxInlineChannels = channels::stereo;
+        static constexpr size_t alignment = 64;
+
+        std::size_t numChannels() const noexcept;
+
+        /**
+         * Changes the number of channels. If the number changes, all
+         * samples are silenced. This allocates memory only if the number
+         * of channels changes, and should therefore be called on a
+         * chunk that is reused with its required number of channels
+         * before rendering into it, rather than on a fresh chunk.
+         */
+        void setNumChannels(std::size_t n);
+
         float& l(size_t i) noexcept;
         const float& l(size_t i) const noexcept;
 
         float& r(size_t i) noexcept;
         const float& r(size_t i) const noexcept;
-        
+
         SampleProxy operator[](size_t i) noexcept;
         ConstSampleProxy operator[](size_t i) const noexcept;
 
         SampleProxy at(size_t i);
         ConstSampleProxy at(size_t i) const;
 
+        /**
+         * Returns the first of the size samples of the given channel,
+         * which is aligned to SoundChunk::alignment bytes.
+         */
+        float* channel(size_t c) noexcept;
+        const float* channel(size_t c) const noexcept;
+
         void silence() noexcept;
 
+        /**
+         * Sets every sample to the matching sample of the other chunk,
+         * changing the number of channels to match if needed.
+         */
+        void copyFrom(const SoundChunk& other);
+
+        /**
+         * Sets every channel other than the given one to a copy of it.
+         * This allows sound sources whose output is the same in every channel
+         * to compute only one channel.
+         */
+        void spreadChannel(size_t c) noexcept;
+
+        /**
+         * Adds every sample of the other chunk, multiplied by the given gain,
+         * to the matching sample of this chunk.
+         * If the other chunk is mono, it is added to every channel. If this chunk
+         * is mono, the average of the other chunk's channels is added. Otherwise,
+         * only the channels that both chunks have are mixed.
+         */
+        void mixAdd(const SoundChunk& other, float gain) noexcept;
+
+        /**
+         * Adds count samples of the other chunk starting at srcOffset, multiplied
+         * by the given gain, to the samples of this chunk starting at dstOffset.
+         * Channels are matched as for mixAdd above.
+         */
+        void mixAdd(const SoundChunk& other, float gain, size_t srcOffset, size_t dstOffset, size_t count) noexcept;
+
+        /**
+         * Multiplies every sample by the given gain.
+         */
+        void scale(float gain) noexcept;
+
+        /**
+         * Limits every sample to the range [lo, hi].
+         */
+        void clamp(float lo, float hi) noexcept;
+
     private:
-        std::array<float, 2 * size> m_data;
+        static_assert((size * sizeof(float)) % alignment == 0);
+
+        static float* allocate(std::size_t numChannels);
+        static void deallocate(float* data) noexcept;
+
+        bool isInline() const noexcept;
+
+        // Releases the separately allocated samples, if any, and stores
+        // the given number of channels inline, leaving the samples as they are
+        void useInline(std::size_t numChannels) noexcept;
+
+        std::size_t m_numChannels;
+
+        // Points either to m_inline or to separately allocated storage
+        float* m_data;
+
+        alignas(alignment) float m_inline[maxInlineChannels * size];
     };
 
 } // namespace flo
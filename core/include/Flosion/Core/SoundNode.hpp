@@ -6,6 +6,7 @@
 #include <Flosion/Core/SoundState.hpp>
 #include <Flosion/Core/StateTable.hpp>
 
+#include <cstdint>
 #include <optional>
 #include <vector>
 
@@ -20,8 +21,13 @@ namespace flo {
     // basic sound node type
     class SoundNode : public StateTable, public NodeBase<SoundNode> {
     public:
+        // If the given network is null, the node joins the network which
+        // is constructing it, if any (see Network::addSoundNode)
         SoundNode(Network*);
-        virtual ~SoundNode() = default;
+        virtual ~SoundNode();
+
+        // The network the node belongs to, or null
+        Network* getNetwork() const noexcept;
         
         bool canAddDependency(const SoundNode*) const noexcept;
         bool canSafelyRemoveDependency(const SoundNode*) const noexcept;
@@ -50,10 +56,17 @@ namespace flo {
         virtual bool isUncontrolled() const noexcept = 0;
         virtual bool isOutOfSync() const noexcept = 0;
 
+        /**
+         * Sound nodes with random behaviour override this to take the given
+         * seed, as done by SoundResult in deterministic mode. Does nothing by default.
+         */
+        virtual void reseed(std::uint64_t seed) noexcept;
+
     protected:
 
         class Lock {
         public:
+            Lock(Lock&&) noexcept = default;
             ~Lock() noexcept = default;
 
         private:
@@ -71,7 +84,14 @@ namespace flo {
         Lock acquireLock() noexcept;
 
         virtual double getTimeSpeed(const SoundState* mainState) const noexcept = 0;
-        
+
+        /**
+         * Runs the given function once the node is fully constructed. This is
+         * where the first states should be allocated, e.g. by enableMonostate,
+         * since states may refer to the most-derived node.
+         * Nodes created by Network::addSoundNode run these functions after
+         * their construction is complete. All other nodes run them right away.
+         */
         void initLater(std::function<void()>);
 
     private:
@@ -81,6 +101,7 @@ namespace flo {
         void addNumberNode(NumberNode*);
         void removeNumberNode(NumberNode*);
 
+        friend class Network;
         friend class NumberNode;
 
     private:
@@ -213,7 +234,7 @@ namespace flo {
     private:
         SoundNode* const m_owner;
 
-        double evaluate(const SoundState*) const noexcept override;
+        Number evaluate(const SoundState*) const noexcept override;
     };
 
     // Convenient mix-in template for adding a CurrentTime SoundNumberSource
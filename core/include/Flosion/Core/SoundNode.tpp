@@ -142,7 +142,9 @@ namespace flo {
         : Singular<SoundNodeType, SoundStateType>(std::forward<Args>(args)...) {
         // TODO:
         // Calling this before the most-derived class has been constructed is dangerous!
-        // Find a reasonable work around.
+        // Deferring it with initLater() only helps for nodes created by a Network,
+        // since all other nodes are initialized right away. Until then, concrete
+        // nodes call this through initLater() themselves.
         // StateTable::enableMonostate();
     }
 
@@ -35,6 +35,9 @@ namespace flo {
         std::vector<Sample> m_data;
         std::size_t m_index;
         std::size_t m_front;
+
+        // stereo chunk which is reused for rendering the input
+        SoundChunk m_chunk;
     };
 
 } // namespace flo
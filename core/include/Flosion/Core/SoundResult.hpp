@@ -1,10 +1,15 @@
 #pragma once
 
+#include <Flosion/Core/DeadlineMonitor.hpp>
 #include <Flosion/Core/SingleSoundInput.hpp>
 #include <Flosion/Core/SoundNode.hpp>
 #include <Flosion/Core/SoundChunk.hpp>
 
+#include <atomic>
+#include <cstdint>
+#include <optional>
 #include <shared_mutex>
+#include <vector>
 
 namespace flo {
 
@@ -17,23 +22,89 @@ namespace flo {
     class SoundResult : public Realtime<Uncontrolled<SoundNode, EmptySoundState>> {
     public:
         SoundResult();
+        ~SoundResult();
 
+        /**
+         * Renders the next chunk of the sound stream. The chunk is given
+         * the number of channels of this sound result first.
+         */
         void getNextChunk(SoundChunk&);
 
+        /**
+         * The number of channels of every chunk rendered through this
+         * sound result, and thus of the entire network feeding it.
+         * This is stereo by default.
+         */
+        void setNumChannels(std::size_t n) noexcept;
+        std::size_t getNumChannels() const noexcept;
+
+        /**
+         * Resets the states of every node upstream. In deterministic mode,
+         * every node with random behaviour upstream is first reseeded.
+         */
         void reset();
 
+        /**
+         * Makes rendering reproducible. Every node upstream is given a seed
+         * derived from the given seed and its position in the network, as
+         * found by following its inputs in the order they were added, and
+         * then the states are reset. Every later reset does the same, such
+         * that the sound rendered after each reset is the same every time
+         * and in every process, as long as the network is built the same way.
+         * This includes the initial phases of unsynced wave generators.
+         */
+        void enableDeterministicMode(std::uint64_t seed);
+        void disableDeterministicMode() noexcept;
+        bool isDeterministic() const noexcept;
+
         void setSource(SoundSource*) noexcept;
 
         WithCurrentTime<SingleSoundInput>& getInput() noexcept;
         const WithCurrentTime<SingleSoundInput>& getInput() const noexcept;
 
+        /**
+         * Whether the network is in a transaction which changes the states
+         * of nodes this sound result depends on. While suspended, the sound
+         * result renders silence (see Network::beginTransaction).
+         */
+        bool isSuspended() const noexcept;
+
+        /**
+         * Keeps track of the time taken by getNextChunk(), including
+         * any time spent waiting for the network to be edited.
+         */
+        DeadlineMonitor& getDeadlineMonitor() noexcept;
+        const DeadlineMonitor& getDeadlineMonitor() const noexcept;
+
     private:
         WithCurrentTime<SingleSoundInput> m_input;
 
         RecursiveSharedMutex m_mutex;
 
+        std::atomic<std::size_t> m_numChannels;
+
+        DeadlineMonitor m_deadlineMonitor;
+
+        std::optional<std::uint64_t> m_deterministicSeed;
+
+        // Networks in a transaction which suspended the sound result,
+        // changed only while the mutex is locked
+        std::vector<Network*> m_suspendingNetworks;
+        std::atomic<bool> m_suspended;
+
+        // Set once destruction begins, after which nothing may render
+        // through the sound result and its mutex is no longer locked
+        bool m_destroying;
+
+        // Called by the network with the mutex locked
+        void suspend(Network*);
+        void resume(Network*) noexcept;
+
+        void reseedUpstream(std::uint64_t seed);
+
         virtual void findDependentSoundResults(std::vector<SoundResult*>& soundResults) noexcept override final;
 
+        friend class Network;
         friend class SoundNode;
     };
 
@@ -51,26 +51,34 @@ namespace flo {
     };
     
     
-    template<typename SoundNodeType>
+    /**
+     * SoundNumberSource is a number source whose value depends on the state
+     * of a sound node. Derived must provide the method
+     *
+     *     Number evaluate(const StateType* state, const SoundState* context) const noexcept;
+     *
+     * which is called directly with the owner's state, rather than through
+     * a second virtual call. The method is best kept private, in which case
+     * Derived must befriend SoundNumberSource<Derived, SoundNodeType>.
+     */
+    template<typename Derived, typename SoundNodeType>
     class SoundNumberSource : public NumberSource {
     public:
         SoundNumberSource(SoundNodeType* owner) noexcept;
 
         using StateType = typename SoundNodeType::StateType;
 
-        virtual double evaluate(const StateType* state, const SoundState* context) const noexcept = 0;
-
         SoundNodeType* getOwner() noexcept;
         const SoundNodeType* getOwner() const noexcept;
 
     private:
-        double evaluate(const SoundState* context) const noexcept override;
+        Number evaluate(const SoundState* context) const noexcept override final;
     };
 
 
     class SoundNumberInput : public NumberInput {
     public:
-        SoundNumberInput(SoundNode* owner, double defaultValue = 0.0) noexcept;
+        SoundNumberInput(SoundNode* owner, Number defaultValue = 0.0) noexcept;
     };
 
 } // namespace flo
@@ -1,12 +1,14 @@
+#include <Flosion/Core/RenderContext.hpp>
+
 namespace flo {
 
-    template<typename SoundNodeType>
-    inline SoundNumberSource<SoundNodeType>::SoundNumberSource(SoundNodeType* owner) noexcept {
+    template<typename Derived, typename SoundNodeType>
+    inline SoundNumberSource<Derived, SoundNodeType>::SoundNumberSource(SoundNodeType* owner) noexcept {
         setStateOwner(owner);
     }
 
-    template<typename SoundNodeType>
-    inline SoundNodeType* SoundNumberSource<SoundNodeType>::getOwner() noexcept {
+    template<typename Derived, typename SoundNodeType>
+    inline SoundNodeType* SoundNumberSource<Derived, SoundNodeType>::getOwner() noexcept {
         auto o = this->getStateOwner();
         assert(o);
         auto od = static_cast<SoundNodeType*>(o);
@@ -14,8 +16,8 @@ namespace flo {
         return od;
     }
 
-    template<typename SoundNodeType>
-    inline const SoundNodeType* SoundNumberSource<SoundNodeType>::getOwner() const noexcept {
+    template<typename Derived, typename SoundNodeType>
+    inline const SoundNodeType* SoundNumberSource<Derived, SoundNodeType>::getOwner() const noexcept {
         auto o = this->getStateOwner();
         assert(o);
         auto od = static_cast<const SoundNodeType*>(o);
@@ -23,17 +25,12 @@ namespace flo {
         return od;
     }
 
-    template<typename SoundNodeType>
-    inline double SoundNumberSource<SoundNodeType>::evaluate(const SoundState* context) const noexcept {
-        auto curr = context;
-        while (curr){
-            const auto owner = curr->getOwner();
-            if (owner == getStateOwner()){
-                auto d = static_cast<const StateType*>(curr);
-                assert(dynamic_cast<const StateType*>(curr) == d);
-                return evaluate(d, context);
-            }
-            curr = curr->getDependentState();
+    template<typename Derived, typename SoundNodeType>
+    inline Number SoundNumberSource<Derived, SoundNodeType>::evaluate(const SoundState* context) const noexcept {
+        if (const auto curr = RenderContext::findState(getStateOwner(), context)){
+            auto d = static_cast<const StateType*>(curr);
+            assert(dynamic_cast<const StateType*>(curr) == d);
+            return static_cast<const Derived*>(this)->evaluate(d, context);
         }
         assert(false);
         return 0.0;
@@ -7,32 +7,35 @@ namespace flo {
 
     class SoundInput;
 
-    template<typename SoundStateType>
-    class ControlledSoundSource : public Singular<SoundSource, SoundStateType> {
+    /**
+     * SoundSourceImpl implements the one virtual entry point of a sound source,
+     * getNextChunkFor, on behalf of the sound source Derived, using the
+     * curiously recurring template pattern. Derived must provide the method
+     *
+     *     void renderNextChunk(SoundChunk& chunk, SoundStateType* state);
+     *
+     * which is called directly rather than through a second virtual call,
+     * so that it and the lookup of the state it is passed can be inlined into
+     * getNextChunkFor. The method is best kept private, in which case Derived
+     * must befriend its base, e.g. ControlledSoundSource<Derived, SoundStateType>.
+     * SoundNodeType is the controllability of the sound source, and is
+     * normally chosen through ControlledSoundSource or UncontrolledSoundSource
+     * below.
+     */
+    template<typename Derived, typename SoundStateType, typename SoundNodeType>
+    class SoundSourceImpl : public SoundNodeType {
     public:
-
-        virtual void renderNextChunk(SoundChunk& chunk, SoundStateType* state) = 0;
-
         const SoundStateType* findOwnState(const SoundState* context) const noexcept;
 
     private:
         void getNextChunkFor(SoundChunk& chunk, const SoundInput* dependent, const SoundState* dependentState) override final;
-
     };
 
-    template<typename SoundStateType>
-    class UncontrolledSoundSource : public Uncontrolled<SoundSource, SoundStateType> {
-    public:
-
-        virtual void renderNextChunk(SoundChunk& chunk, SoundStateType* state) = 0;
-
-        const SoundStateType* findOwnState(const SoundState* context) const noexcept;
-
-    private:
-        void getNextChunkFor(SoundChunk& chunk, const SoundInput* dependent, const SoundState* dependentState) override final;
-
-    };
+    template<typename Derived, typename SoundStateType>
+    using ControlledSoundSource = SoundSourceImpl<Derived, SoundStateType, Singular<SoundSource, SoundStateType>>;
 
+    template<typename Derived, typename SoundStateType>
+    using UncontrolledSoundSource = SoundSourceImpl<Derived, SoundStateType, Uncontrolled<SoundSource, SoundStateType>>;
 
 } // namespace flo
 
@@ -1,54 +1,40 @@
 #pragma once
 
+#include <Flosion/Core/Profiler.hpp>
+#include <Flosion/Core/RenderContext.hpp>
 #include <Flosion/Core/SoundSource.hpp>
 #include <Flosion/Core/SoundState.hpp>
 
 #include <cassert>
+#include <type_traits>
 
 namespace flo {
 
-    template<typename SoundStateType>
-    inline const SoundStateType* ControlledSoundSource<SoundStateType>::findOwnState(const SoundState* context) const noexcept {
+    template<typename Derived, typename SoundStateType, typename SoundNodeType>
+    inline const SoundStateType* SoundSourceImpl<Derived, SoundStateType, SoundNodeType>::findOwnState(const SoundState* context) const noexcept {
         assert(context);
-        while (context->getOwner() != this){
-            context = context->getDependentState();
-        }
+        context = RenderContext::findState(this, context);
         assert(context);
         auto derived = static_cast<const SoundStateType*>(context);
         assert(dynamic_cast<const SoundStateType*>(context) == derived);
         return derived;
     }
 
-    template<typename SoundStateType>
-    inline void ControlledSoundSource<SoundStateType>::getNextChunkFor(SoundChunk& chunk, const SoundInput* dependent, const SoundState* dependentState){
-        assert(dependent->hasDirectDependency(this));
-		auto ownState = this->getState(dependent, dependentState);
-        this->renderNextChunk(chunk, ownState);
-        auto os = static_cast<SoundState*>(ownState);
-        os->m_coarseTime += SoundChunk::size;
-		os->m_fineTime = 0;
-    }
-
-    template<typename SoundStateType>
-    inline void UncontrolledSoundSource<SoundStateType>::getNextChunkFor(SoundChunk& chunk, const SoundInput* dependent, const SoundState* dependentState){
+    template<typename Derived, typename SoundStateType, typename SoundNodeType>
+    inline void SoundSourceImpl<Derived, SoundStateType, SoundNodeType>::getNextChunkFor(SoundChunk& chunk, const SoundInput* dependent, const SoundState* dependentState){
+        static_assert(std::is_base_of_v<SoundSourceImpl, Derived>, "Derived must derive from SoundSourceImpl<Derived, ...>");
         assert(dependent->hasDirectDependency(this));
         auto ownState = this->getState(dependent, dependentState);
-        this->renderNextChunk(chunk, ownState);
-		auto os = static_cast<SoundState*>(ownState);
-        os->m_coarseTime += SoundChunk::size;
-		os->m_fineTime = 0;
-    }
-
-    template<typename SoundStateType>
-    inline const SoundStateType* UncontrolledSoundSource<SoundStateType>::findOwnState(const SoundState* context) const noexcept {
-        assert(context);
-        while (context->getOwner() != this){
-            context = context->getDependentState();
+        {
+            auto scope = RenderContext::Scope{this, ownState};
+            [[maybe_unused]] auto timer = Profiler::SoundScope{this, ownState};
+            static_cast<Derived*>(this)->renderNextChunk(chunk, ownState);
         }
-        assert(context);
-        auto derived = static_cast<const SoundStateType*>(context);
-        assert(dynamic_cast<const SoundStateType*>(context) == derived);
-        return derived;
+        auto os = static_cast<SoundState*>(ownState);
+        os->m_coarseTime += SoundChunk::size;
+        os->m_fineTime = 0;
+        // NOTE: time speeds are sampled once per chunk
+        os->clearTimeCache();
     }
 
 } // namespace flo
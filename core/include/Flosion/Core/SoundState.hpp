@@ -2,6 +2,7 @@
 
 #include <Flosion/Core/State.hpp>
 
+#include <cstddef>
 #include <cstdint>
 
 namespace flo {
@@ -17,6 +18,14 @@ namespace flo {
         SoundNode* getOwner() noexcept;
         const SoundNode* getOwner() const noexcept;
 
+        /**
+         * Returns the time in seconds that has elapsed at the given node,
+         * which must own this state or one of its (indirect) dependent states.
+         * The product of time speeds along the chain of dependent states is
+         * cached for the most recently queried nodes and computed again only
+         * once per chunk, so repeated calls while rendering a chunk are cheap,
+         * even when they alternate between nodes.
+         */
         double getElapsedTimeAt(const SoundNode* node) const noexcept;
         
         void adjustTime(std::uint32_t offset);
@@ -24,18 +33,32 @@ namespace flo {
     private:
         void resetTime();
 
+        void setDependentState(const SoundState*) noexcept;
+
+        // The product of time speeds from this state up to the given node
+        double computeTimeSpeedTo(const SoundNode* node) const noexcept;
+
         SoundNode* m_owner;
         const SoundState* m_dependentState;
         std::uint32_t m_coarseTime;
         std::uint32_t m_fineTime;
 
-        friend class StateTable;
+        // Drops all cached time speeds
+        void clearTimeCache() noexcept;
 
-        template<typename SoundStateType>
-        friend class ControlledSoundSource;
+        // Cached results of computeTimeSpeedTo for the given nodes, most
+        // recently used first, which are cleared whenever the coarse time
+        // advances. Unused entries have no node.
+        // NOTE: two entries cover number sources which alternate between
+        // nodes, while keeping an empty sound state within one cache line
+        static constexpr std::size_t timeCacheSize = 2;
+        mutable const SoundNode* m_timeCacheNodes[timeCacheSize];
+        mutable double m_timeCacheSpeeds[timeCacheSize];
 
-        template<typename SoundStateType>
-        friend class UncontrolledSoundSource;
+        friend class StateTable;
+
+        template<typename Derived, typename SoundStateType, typename SoundNodeType>
+        friend class SoundSourceImpl;
     };
 
     class EmptySoundState final : public SoundState {
@@ -45,6 +68,9 @@ namespace flo {
         void reset() noexcept override final;
     };
 
+    template<>
+    struct IsTriviallyRelocatable<EmptySoundState> : std::true_type {};
+
     template<typename SoundSourceType>
     class ConcreteSoundState : public SoundState {
     public:
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <type_traits>
+
 namespace flo {
 
     class State {
@@ -8,6 +10,16 @@ namespace flo {
 
     };
 
+    /**
+     * Whether states of the given type may be relocated by copying their bytes
+     * to a new address, without calling their move constructor and without
+     * destroying the original. This holds for states which contain only plain
+     * values and pointers to things outside of themselves.
+     * Specialize this as std::true_type for such states so that state tables
+     * can move them in bulk.
+     */
+    template<typename StateType>
+    struct IsTriviallyRelocatable : std::is_trivially_copyable<StateType> {};
 
 
 } // namespace flo
@@ -3,6 +3,7 @@
 #include <Flosion/Core/State.hpp>
 
 #include <cstddef>
+#include <cstring>
 #include <type_traits>
 #include <utility>
 
@@ -19,6 +20,18 @@ namespace flo {
         virtual void moveConstruct(void* dst, void* src) noexcept = 0;
         virtual void destroy(void* dst) noexcept = 0;
 
+        // Bulk versions of the above, operating on count states which are
+        // placed stride bytes apart. These cost a single virtual call.
+
+        // Constructs count states which all share the same owner and dependent state
+        virtual void constructN(void* dst, std::size_t stride, std::size_t count, SoundNode* owner, const SoundState* dependentState);
+
+        // Relocates count states, i.e. move-constructs each state at its
+        // destination and then destroys the source
+        virtual void moveN(void* dst, void* src, std::size_t dstStride, std::size_t srcStride, std::size_t count) noexcept;
+
+        virtual void destroyN(void* dst, std::size_t stride, std::size_t count) noexcept;
+
         virtual std::size_t getSize() const noexcept = 0;
         virtual std::size_t getAlignment() const noexcept = 0;
     };
@@ -56,6 +69,66 @@ namespace flo {
         std::size_t getAlignment() const noexcept override final {
             return alignof(StateType);
         }
+
+        void constructN(void* dst, std::size_t stride, std::size_t count, SoundNode* owner, const SoundState* dependentState) override final {
+            auto p = static_cast<unsigned char*>(dst);
+            for (std::size_t i = 0; i < count; ++i){
+                ConcreteStateAllocator::construct(p + (i * stride), owner, dependentState);
+            }
+        }
+        void moveN(void* dst, void* src, std::size_t dstStride, std::size_t srcStride, std::size_t count) noexcept override final {
+            auto d = static_cast<unsigned char*>(dst);
+            auto s = static_cast<unsigned char*>(src);
+            if constexpr (IsTriviallyRelocatable<StateType>::value){
+                if (dstStride == sizeof(StateType) && srcStride == sizeof(StateType)){
+                    // densely packed, move everything at once
+                    if (count > 0){
+                        std::memcpy(d, s, count * sizeof(StateType));
+                    }
+                } else {
+                    for (std::size_t i = 0; i < count; ++i){
+                        std::memcpy(d + (i * dstStride), s + (i * srcStride), sizeof(StateType));
+                    }
+                }
+            } else {
+                for (std::size_t i = 0; i < count; ++i){
+                    auto from = reinterpret_cast<StateType*>(s + (i * srcStride));
+                    new (d + (i * dstStride)) StateType(std::move(*from));
+                    from->~StateType();
+                }
+            }
+        }
+        void destroyN(void* dst, std::size_t stride, std::size_t count) noexcept override final {
+            if constexpr (!std::is_trivially_destructible_v<StateType>){
+                auto p = static_cast<unsigned char*>(dst);
+                for (std::size_t i = 0; i < count; ++i){
+                    reinterpret_cast<StateType*>(p + (i * stride))->~StateType();
+                }
+            }
+        }
     };
 
+    inline void StateAllocator::constructN(void* dst, std::size_t stride, std::size_t count, SoundNode* owner, const SoundState* dependentState){
+        auto p = static_cast<unsigned char*>(dst);
+        for (std::size_t i = 0; i < count; ++i){
+            construct(p + (i * stride), owner, dependentState);
+        }
+    }
+
+    inline void StateAllocator::moveN(void* dst, void* src, std::size_t dstStride, std::size_t srcStride, std::size_t count) noexcept {
+        auto d = static_cast<unsigned char*>(dst);
+        auto s = static_cast<unsigned char*>(src);
+        for (std::size_t i = 0; i < count; ++i){
+            moveConstruct(d + (i * dstStride), s + (i * srcStride));
+            destroy(s + (i * srcStride));
+        }
+    }
+
+    inline void StateAllocator::destroyN(void* dst, std::size_t stride, std::size_t count) noexcept {
+        auto p = static_cast<unsigned char*>(dst);
+        for (std::size_t i = 0; i < count; ++i){
+            destroy(p + (i * stride));
+        }
+    }
+
 } // namespace flo
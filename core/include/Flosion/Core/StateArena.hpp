@@ -0,0 +1,92 @@
+#pragma once
+
+#include <Flosion/Core/Immovable.hpp>
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace flo {
+
+    /**
+     * StateArena is a memory pool for the storage of state tables.
+     * Small blocks are carved out of large pages, where every page holds
+     * blocks of a single power-of-two size class. Freed blocks are kept
+     * in a free list for their size class and are reused without going
+     * back to the system allocator. Otherwise, blocks are handed out in
+     * order from the most recent page of their size class. Blocks that are larger than the
+     * largest size class are allocated individually.
+     * All pages are released at once when the arena is reset or destroyed,
+     * which makes tearing down an entire network cheap.
+     * A Network owns one arena which is shared by all of its sound nodes.
+     */
+    class StateArena : private Immovable {
+    public:
+        StateArena();
+        ~StateArena();
+
+        /**
+         * Allocates a block of at least the given size in bytes and with at
+         * least the given alignment, which must be a power of two.
+         */
+        void* allocate(std::size_t size, std::size_t align);
+
+        /**
+         * Returns a block that was allocated from this arena.
+         */
+        void deallocate(void* ptr) noexcept;
+
+        /**
+         * Releases all memory held by the arena at once. Every block that
+         * was allocated from this arena becomes invalid, so this must only
+         * be called after everything using the arena has been destroyed.
+         */
+        void reset() noexcept;
+
+        /**
+         * The total number of bytes currently obtained from the system,
+         * including unused blocks in pages.
+         */
+        std::size_t bytesReserved() const noexcept;
+
+        static constexpr std::size_t pageSize = 64 * 1024;
+        static constexpr std::size_t minBlockSize = 64;
+        static constexpr std::size_t maxBlockSize = pageSize / 2;
+
+    private:
+        static constexpr std::size_t numSizeClasses = 10;
+
+        static_assert((minBlockSize << (numSizeClasses - 1)) == maxBlockSize);
+
+        // returns the index of the smallest size class holding the given size
+        static std::size_t sizeClassFor(std::size_t size) noexcept;
+
+        // returns a new block from a fresh page of the given size class
+        unsigned char* allocateFromNewPage(std::size_t sizeClass);
+
+        mutable std::mutex m_mutex;
+
+        // freed blocks, for each size class
+        std::array<std::vector<unsigned char*>, numSizeClasses> m_freeBlocks;
+
+        // the next never-used block and the end of the most recent page,
+        // for each size class
+        std::array<unsigned char*, numSizeClasses> m_nextBlock;
+        std::array<unsigned char*, numSizeClasses> m_pageEnd;
+
+        // the size class of every page, by its address
+        std::unordered_map<const unsigned char*, std::size_t> m_pages;
+
+        // blocks too large for any size class
+        struct LargeBlock {
+            std::size_t size;
+            std::size_t align;
+        };
+        std::unordered_map<void*, LargeBlock> m_largeBlocks;
+
+        std::size_t m_bytesReserved;
+    };
+
+} // namespace flo
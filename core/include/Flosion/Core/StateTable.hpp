@@ -10,7 +10,9 @@
 namespace flo {
 
     class BorrowingNumberSource;
+    class Network;
     class SoundNode;
+    class StateArena;
 
     /*
      * StateTable is an array-like container of custom SoundState objects.
@@ -31,10 +33,52 @@ namespace flo {
     // - There is one slot for every pair of row and column
     // - There is one main state in each slot
     // - There is one borrowed state in each slot for each borrower
-    // - All slots are stored contiguously in row-major order
+    // - All slots are stored contiguously in row-major order, unless
+    //   stable-address storage is selected (see SlotStorage below)
     class StateTable : private Immovable {
     public:
-        StateTable(SoundNode* owner);
+        /**
+         * How the slots of a state table are laid out in memory.
+         * Contiguous:
+         *     All slots live in a single array in row-major order. Lookups are
+         *     a single multiply, but every structural edit (adding or removing
+         *     dependent states or keys) reallocates the array and moves every
+         *     state, after which all dependencies must repoint their dependent
+         *     state pointers.
+         * StableAddress:
+         *     Slots live in fixed-size pages and are recycled through a free list.
+         *     Adding or removing dependent states and keys never moves an existing
+         *     state, so no repointing is needed and pointers to states remain valid
+         *     across such edits. Each slot is preceded by a small header storing
+         *     its current index, and an index-to-slot table is kept alongside.
+         *     Adding or removing a borrower changes the size of every slot and
+         *     thus still moves all states.
+         */
+        enum class SlotStorage {
+            Contiguous,
+            StableAddress
+        };
+
+        /**
+         * How much space is left between neighbouring slots.
+         * None:
+         *     Slots are packed at the natural alignment of the main state.
+         *     Neighbouring slots, e.g. the states of different keys, may share
+         *     a cache line.
+         * CacheLine:
+         *     Every slot starts on a cache line boundary and its size is rounded
+         *     up to a whole number of cache lines, so that states which are
+         *     written to by different threads never share a cache line.
+         *     Within each slot, the main state comes first, followed by any
+         *     borrowed states.
+         */
+        enum class SlotPadding {
+            None,
+            CacheLine
+        };
+
+        // If arena is null, storage is obtained from the system allocator
+        StateTable(SoundNode* owner, StateArena* arena);
         ~StateTable();
 
         StateTable(const StateTable&) = delete;
@@ -217,9 +261,33 @@ namespace flo {
 
         bool hasMonostate() const noexcept;
 
+        /**
+         * Changes how slots are stored. Existing states are moved once into
+         * the new storage. This is cheapest when done before any states are
+         * allocated, e.g. in the constructor of a concrete sound node.
+         * The caller must ensure that no sound processing is taking place.
+         */
+        void setSlotStorage(SlotStorage);
+
+        SlotStorage getSlotStorage() const noexcept;
+
+        /**
+         * Changes the padding between slots. Existing states are moved once
+         * with the new layout. Like setSlotStorage, this is meant to be called
+         * by node types whose states are rendered concurrently, ideally in
+         * their constructor. The caller must ensure that no sound processing
+         * is taking place.
+         */
+        void setSlotPadding(SlotPadding);
+
+        SlotPadding getSlotPadding() const noexcept;
+
     private:
         SoundNode* m_owner;
 
+        // where all storage for slots comes from, may be null
+        StateArena* const m_arena;
+
         // the allocator for states owned by the state table's owner
         // This will be null until the first state is allocated
         // Use getStateAllocator() instead of this member.
@@ -246,6 +314,10 @@ namespace flo {
             // the node whose states are parents to the states in this array
             const SoundNode* dependent;
 
+            // the dependent's own state table, through which the indices
+            // of its states can be found where SoundNode is incomplete
+            const StateTable* dependentTable;
+
             // the index at which the dependent's states begin
             // NOTE: this index is in terms of all states owned by
             // the state table. It is effectively the sum of numbers
@@ -271,9 +343,69 @@ namespace flo {
 
         bool m_isMonostate;
 
-        // the array
+        SlotStorage m_slotStorage;
+
+        SlotPadding m_slotPadding;
+
+        // The network whose transaction all structural changes to the table
+        // are deferred until, or null. A deferred table has no slots. Only its
+        // numbers of keys and dependents are kept, and the numbers of rows are
+        // brought up to date once the slots are rebuilt.
+        Network* m_deferringNetwork;
+
+        // the array (contiguous storage only)
         unsigned char* m_data;
 
+        // Stable-address storage
+        // The address of each slot, in row-major order
+        std::vector<unsigned char*> m_slotAddresses;
+
+        // A page of cells. Each cell holds a header followed by a slot.
+        // Each new page has twice as many cells as the previous one, up to a
+        // fixed size in bytes. Pages are only released once the table becomes
+        // empty or the slot size changes.
+        struct Page {
+            unsigned char* data;
+            size_t numCells;
+        };
+
+        std::vector<Page> m_pages;
+
+        // Addresses of slots in unused cells
+        std::vector<unsigned char*> m_freeSlots;
+
+        // The address of the slot at the given index
+        unsigned char* slotAddress(size_t index) const noexcept;
+
+        // The alignment of every slot, which depends on the main state and the padding
+        size_t slotAlignment() const noexcept;
+
+        // The size in bytes of a cell's header, which stores the slot's current index
+        size_t cellHeaderSize() const noexcept;
+
+        // The size in bytes of a cell, including its header
+        size_t cellSize() const noexcept;
+
+        unsigned char* allocateStableSlot();
+        void releaseStableSlot(unsigned char*);
+        void releaseAllPages() noexcept;
+
+        // writes the current index of every slot from the given index onwards to its header
+        void renumberStableSlots(size_t beginIndex) noexcept;
+
+        // the dependent state that all slots in the given row point to
+        const SoundState* getRowDependentState(size_t row) const noexcept;
+
+        void insertDependentStatesStable(const SoundNode* dependent, size_t beginIndex, size_t endIndex);
+        void eraseDependentStatesStable(const SoundNode* dependent, size_t beginIndex, size_t endIndex);
+        void insertKeysStable(size_t beginIndex, size_t endIndex);
+        void eraseKeysStable(size_t beginIndex, size_t endIndex);
+
+        // moves all slots into freshly allocated storage of the current mode,
+        // using the given function to move each slot
+        template<typename MoveFn>
+        void relocateAllSlots(SlotStorage oldStorage, size_t oldSlotSize, size_t oldAlignment, MoveFn&& moveFn);
+
         size_t getDependentOffset(const SoundNode* dependent) const noexcept;
 
         size_t nextAlignedOffset(size_t minOffset, size_t align) const;
@@ -282,9 +414,10 @@ namespace flo {
 
         unsigned char* allocateData(size_t slotSize, size_t numSlots);
         void deallocateData(unsigned char*);
+        void deallocateData(unsigned char*, size_t align);
 
         // constructs a slot in place from uninitialized storage
-        void constructSlot(unsigned char* where);
+        void constructSlot(unsigned char* where, const SoundState* dependentState);
 
         // destroys a slot in place
         void destroySlot(unsigned char* where);
@@ -293,6 +426,12 @@ namespace flo {
         // the old slot is destroyed
         void moveSlot(unsigned char* from, unsigned char* to);
 
+        // Bulk versions of the above for consecutive slots, which make
+        // a single call to each allocator
+        void constructSlots(unsigned char* where, size_t count, const SoundState* dependentState);
+        void destroySlots(unsigned char* where, size_t count);
+        void moveSlots(unsigned char* from, unsigned char* to, size_t count);
+
         void resetSlot(unsigned char* where);
 
         // moves a slot from one location to another while adding a slot item
@@ -307,12 +446,25 @@ namespace flo {
         // updates the dependent state pointers for all states associated
         // with the given dependent.
         // This should be called anytime the given dependent moves any of
-        // its states
+        // its states. Dependents with stable-address storage never need to.
         void repointStatesFor(const SoundNode* dependent) noexcept;
 
         void addDependentOffset(const SoundNode*);
         void removeDependentOffset(const SoundNode*);
 
+        // Returns true if a structural change should only be recorded, in
+        // which case all slots are discarded until the owner's network
+        // commits its transaction. See Network::beginTransaction
+        bool deferChanges();
+
+        // destroys all slots and releases their storage
+        void discardSlots();
+
+        // allocates and constructs all slots of a deferred table at once.
+        // The slots of all dependents must be in place.
+        void rebuildSlots();
+
+        friend class Network;
         friend class SoundNode;
     };
 
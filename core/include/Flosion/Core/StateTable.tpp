@@ -2,6 +2,51 @@
 
 namespace flo {
 
+    // NOTE: the following are defined inline because they are called by
+    // every sound source and sound input for every chunk
+
+    inline SoundState* StateTable::getState(const SoundNode* dependent, const SoundState* dependentState, size_t keyIndex) noexcept {
+        return const_cast<SoundState*>(const_cast<const StateTable*>(this)->getState(dependent, dependentState, keyIndex));
+    }
+
+    inline const SoundState* StateTable::getState(const SoundNode* dependent, const SoundState* dependentState, size_t keyIndex) const noexcept {
+        for (const auto& d : m_dependentOffsets){
+            if (d.dependent == dependent){
+                return getState(d.offset + (d.dependentTable->getStateIndex(dependentState) * numKeys()) + keyIndex);
+            }
+        }
+        assert(false);
+        return nullptr;
+    }
+
+    inline SoundState* StateTable::getState(size_t slotIndex) noexcept {
+        return const_cast<SoundState*>(const_cast<const StateTable*>(this)->getState(slotIndex));
+    }
+
+    inline const SoundState* StateTable::getState(size_t slotIndex) const noexcept {
+        assert(slotIndex < numSlots());
+        return reinterpret_cast<const SoundState*>(slotAddress(slotIndex));
+    }
+
+    inline size_t StateTable::getStateIndex(const SoundState* ownState) const noexcept {
+        assert(hasState(ownState));
+        if (m_slotStorage == SlotStorage::StableAddress){
+            const auto addr = reinterpret_cast<const unsigned char*>(ownState);
+            return *reinterpret_cast<const size_t*>(addr - cellHeaderSize());
+        }
+        auto idx = (reinterpret_cast<const unsigned char*>(ownState) - m_data) / m_slotSize;
+        assert(idx < numSlots());
+        return static_cast<size_t>(idx);
+    }
+
+    inline unsigned char* StateTable::slotAddress(size_t index) const noexcept {
+        if (m_slotStorage == SlotStorage::Contiguous){
+            return m_data + (index * m_slotSize);
+        }
+        assert(index < m_slotAddresses.size());
+        return m_slotAddresses[index];
+    }
+
     template<typename SoundStateType>
     SoundStateType* StateTable::getState(const SoundNode* dependent, const SoundState* dependentState, size_t keyIndex) noexcept {
         return const_cast<SoundStateType*>(
@@ -0,0 +1,122 @@
+#include <Flosion/Core/DeadlineMonitor.hpp>
+
+#include <Flosion/Core/Sample.hpp>
+#include <Flosion/Core/SoundChunk.hpp>
+
+#include <algorithm>
+
+namespace flo {
+
+    DeadlineMonitor::DeadlineMonitor()
+        : m_chunks(0)
+        , m_deadlineMisses(0)
+        , m_xruns(0)
+        , m_maxBudgetShare(0.0)
+        , m_slowThreshold(0.8)
+        , m_slowChunksBegin(0)
+        , m_slowChunksSize(0) {
+
+        onDeadlineMiss.enableDeferredBroadcast();
+        for (auto& b : m_histogram){
+            b.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    double DeadlineMonitor::getChunkPeriod() noexcept {
+        return static_cast<double>(SoundChunk::size) / static_cast<double>(sampleFrequency);
+    }
+
+    void DeadlineMonitor::record(std::chrono::steady_clock::duration elapsed) noexcept {
+        const auto seconds = std::chrono::duration<double>(elapsed).count();
+        const auto share = seconds / getChunkPeriod();
+        const auto index = m_chunks.fetch_add(1, std::memory_order_relaxed);
+
+        const auto bucket = std::min(static_cast<std::size_t>(share / bucketWidth), numBuckets - 1);
+        m_histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+
+        // NOTE: chunks are rendered on one thread at a time, so the
+        // maximum only needs to be compared against, not exchanged
+        if (share > m_maxBudgetShare.load(std::memory_order_relaxed)){
+            m_maxBudgetShare.store(share, std::memory_order_relaxed);
+        }
+
+        const auto missed = share > 1.0;
+        if (missed){
+            m_deadlineMisses.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (!missed && share < m_slowThreshold.load(std::memory_order_relaxed)){
+            return;
+        }
+
+        auto report = ChunkReport{};
+        report.chunkIndex = index;
+        report.seconds = seconds;
+        report.budgetShare = share;
+        report.time = std::chrono::system_clock::now();
+        report.breakdownSize = Profiler::getLastChunkBreakdown(report.breakdown.data());
+
+        if (m_slowChunksMutex.try_lock()){
+            const auto i = (m_slowChunksBegin + m_slowChunksSize) % maxSlowChunks;
+            m_slowChunks[i] = report;
+            if (m_slowChunksSize == maxSlowChunks){
+                m_slowChunksBegin = (m_slowChunksBegin + 1) % maxSlowChunks;
+            } else {
+                ++m_slowChunksSize;
+            }
+            m_slowChunksMutex.unlock();
+        }
+
+        if (missed){
+            onDeadlineMiss.broadcastDeferred(report);
+        }
+    }
+
+    void DeadlineMonitor::reportXrun() noexcept {
+        m_xruns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void DeadlineMonitor::setSlowThreshold(double budgetShare) noexcept {
+        m_slowThreshold.store(budgetShare, std::memory_order_relaxed);
+    }
+
+    double DeadlineMonitor::getSlowThreshold() const noexcept {
+        return m_slowThreshold.load(std::memory_order_relaxed);
+    }
+
+    std::vector<DeadlineMonitor::ChunkReport> DeadlineMonitor::getSlowChunks() const {
+        auto lock = std::lock_guard{m_slowChunksMutex};
+        auto ret = std::vector<ChunkReport>{};
+        ret.reserve(m_slowChunksSize);
+        for (std::size_t i = 0; i < m_slowChunksSize; ++i){
+            ret.push_back(m_slowChunks[(m_slowChunksBegin + i) % maxSlowChunks]);
+        }
+        return ret;
+    }
+
+    DeadlineMonitor::Stats DeadlineMonitor::getStats() const noexcept {
+        auto s = Stats{};
+        s.chunks = m_chunks.load(std::memory_order_relaxed);
+        s.deadlineMisses = m_deadlineMisses.load(std::memory_order_relaxed);
+        s.xruns = m_xruns.load(std::memory_order_relaxed);
+        s.maxBudgetShare = m_maxBudgetShare.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < numBuckets; ++i){
+            s.histogram[i] = m_histogram[i].load(std::memory_order_relaxed);
+        }
+        return s;
+    }
+
+    void DeadlineMonitor::reset() noexcept {
+        m_chunks.store(0, std::memory_order_relaxed);
+        m_deadlineMisses.store(0, std::memory_order_relaxed);
+        m_xruns.store(0, std::memory_order_relaxed);
+        m_maxBudgetShare.store(0.0, std::memory_order_relaxed);
+        for (auto& b : m_histogram){
+            b.store(0, std::memory_order_relaxed);
+        }
+        auto lock = std::lock_guard{m_slowChunksMutex};
+        m_slowChunksBegin = 0;
+        m_slowChunksSize = 0;
+    }
+
+} // namespace flo
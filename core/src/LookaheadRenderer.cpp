@@ -0,0 +1,115 @@
+#include <Flosion/Core/LookaheadRenderer.hpp>
+
+#include <Flosion/Core/Profiler.hpp>
+#include <Flosion/Core/SoundResult.hpp>
+
+#include <cassert>
+#include <chrono>
+
+namespace flo {
+
+    LookaheadRenderer::LookaheadRenderer(SoundResult& result, std::size_t lookahead)
+        : m_result(result)
+        , m_writeIndex(0)
+        , m_readIndex(0)
+        , m_chunksRequested(0)
+        , m_lateChunks(0)
+        , m_minQueued(lookahead)
+        , m_running(false) {
+        assert(lookahead > 0);
+        m_slots.reserve(lookahead + 1);
+        for (std::size_t i = 0; i < lookahead + 1; ++i){
+            m_slots.emplace_back(result.getNumChannels());
+        }
+    }
+
+    LookaheadRenderer::~LookaheadRenderer() noexcept {
+        stop();
+    }
+
+    void LookaheadRenderer::start(){
+        if (m_running.load()){
+            return;
+        }
+        m_writeIndex.store(0);
+        m_readIndex.store(0);
+        m_running.store(true);
+        m_thread = std::thread([this]{ run(); });
+    }
+
+    void LookaheadRenderer::stop() noexcept {
+        m_running.store(false);
+        if (m_thread.joinable()){
+            m_thread.join();
+        }
+    }
+
+    bool LookaheadRenderer::isRunning() const noexcept {
+        return m_running.load();
+    }
+
+    std::size_t LookaheadRenderer::getLookahead() const noexcept {
+        return m_slots.size() - 1;
+    }
+
+    bool LookaheadRenderer::getNextChunk(SoundChunk& chunk) noexcept {
+        const auto n = m_slots.size();
+        const auto r = m_readIndex.load(std::memory_order_relaxed);
+        const auto w = m_writeIndex.load(std::memory_order_acquire);
+        const auto queued = (w + n - r) % n;
+
+        m_chunksRequested.fetch_add(1, std::memory_order_relaxed);
+        if (queued < m_minQueued.load(std::memory_order_relaxed)){
+            m_minQueued.store(queued, std::memory_order_relaxed);
+        }
+
+        if (queued == 0){
+            m_lateChunks.fetch_add(1, std::memory_order_relaxed);
+            chunk.silence();
+            return false;
+        }
+
+        // NOTE: moving a SoundChunk hands over its samples without copying
+        // if they are allocated separately. Mono and stereo chunks store
+        // their samples inline and are copied instead.
+        chunk = std::move(m_slots[r]);
+        m_readIndex.store((r + 1) % n, std::memory_order_release);
+        return true;
+    }
+
+    LookaheadRenderer::Stats LookaheadRenderer::getStats() const noexcept {
+        auto s = Stats{};
+        s.chunksRequested = m_chunksRequested.load(std::memory_order_relaxed);
+        s.lateChunks = m_lateChunks.load(std::memory_order_relaxed);
+        s.minQueued = m_minQueued.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void LookaheadRenderer::resetStats() noexcept {
+        m_chunksRequested.store(0, std::memory_order_relaxed);
+        m_lateChunks.store(0, std::memory_order_relaxed);
+        m_minQueued.store(getLookahead(), std::memory_order_relaxed);
+    }
+
+    void LookaheadRenderer::run() noexcept {
+        Profiler::registerCurrentThread();
+
+        // When the queue is full, check again a few times per chunk
+        const auto pollInterval = std::chrono::microseconds{
+            static_cast<long long>(250'000.0 * static_cast<double>(SoundChunk::size) / static_cast<double>(sampleFrequency))
+        };
+
+        const auto n = m_slots.size();
+        while (m_running.load(std::memory_order_relaxed)){
+            const auto w = m_writeIndex.load(std::memory_order_relaxed);
+            const auto r = m_readIndex.load(std::memory_order_acquire);
+            if ((w + 1) % n == r){
+                std::this_thread::sleep_for(pollInterval);
+                continue;
+            }
+            m_result.getNextChunk(m_slots[w]);
+            m_writeIndex.store((w + 1) % n, std::memory_order_release);
+        }
+    }
+
+} // namespace flo
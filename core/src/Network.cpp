@@ -0,0 +1,246 @@
+#include <Flosion/Core/Network.hpp>
+
+#include <Flosion/Core/SoundResult.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace flo {
+
+    namespace {
+        thread_local Network* constructingNetwork = nullptr;
+    }
+
+    Network::Network() noexcept
+        : m_transactionDepth(0) {
+
+    }
+
+    Network::~Network(){
+        assert(m_transactionDepth == 0);
+        {
+            // NOTE: the states of the remaining nodes are rebuilt only once,
+            // and sound results destroyed meanwhile release their own locks
+            auto t = Transaction{*this};
+            while (!m_ownedNumberNodes.empty()){
+                m_ownedNumberNodes.pop_back();
+            }
+            while (!m_ownedSoundNodes.empty()){
+                m_ownedSoundNodes.pop_back();
+            }
+        }
+        assert(m_deferredNodes.empty());
+        assert(m_suspendedResults.empty());
+        assert(m_soundNodes.empty());
+        assert(m_numberNodes.empty());
+    }
+
+    void Network::removeSoundNode(SoundNode* node){
+        auto it = std::find_if(
+            m_ownedSoundNodes.begin(),
+            m_ownedSoundNodes.end(),
+            [&](const std::unique_ptr<SoundNode>& p){ return p.get() == node; }
+        );
+        assert(it != m_ownedSoundNodes.end());
+        m_ownedSoundNodes.erase(it);
+    }
+
+    void Network::removeNumberNode(NumberNode* node){
+        auto it = std::find_if(
+            m_ownedNumberNodes.begin(),
+            m_ownedNumberNodes.end(),
+            [&](const std::unique_ptr<NumberNode>& p){ return p.get() == node; }
+        );
+        assert(it != m_ownedNumberNodes.end());
+        m_ownedNumberNodes.erase(it);
+    }
+
+    Network* Network::getConstructingNetwork() noexcept {
+        return constructingNetwork;
+    }
+
+    std::vector<SoundNode*> Network::getAllSoundNodes() noexcept {
+        return m_soundNodes;
+    }
+
+    const std::vector<SoundNode*> Network::getAllSoundNodes() const noexcept {
+        return m_soundNodes;
+    }
+
+    std::vector<NumberNode*> Network::getAllNumberNodes() noexcept {
+        return m_numberNodes;
+    }
+
+    const std::vector<NumberNode*> Network::getAllNumberNodes() const noexcept {
+        return m_numberNodes;
+    }
+
+    StateArena& Network::getStateArena() noexcept {
+        return m_stateArena;
+    }
+
+    void Network::beginTransaction(){
+        ++m_transactionDepth;
+    }
+
+    void Network::commitTransaction(){
+        assert(m_transactionDepth > 0);
+        if (--m_transactionDepth > 0){
+            return;
+        }
+        // NOTE: the suspended sound results don't access any deferred
+        // states, so these may be rebuilt without holding their locks
+        for (const auto& n : m_deferredNodes){
+            rebuildStates(n);
+        }
+        m_deferredNodes.clear();
+
+        // Sort the sound results in order of address, as done by
+        // SoundNode::acquireLock, to prevent deadlock
+        std::sort(m_suspendedResults.begin(), m_suspendedResults.end());
+        auto locks = std::vector<std::unique_lock<RecursiveSharedMutex>>{};
+        locks.reserve(m_suspendedResults.size());
+        for (const auto& r : m_suspendedResults){
+            locks.emplace_back(r->m_mutex);
+        }
+        for (const auto& r : m_suspendedResults){
+            r->resume(this);
+        }
+        m_suspendedResults.clear();
+    }
+
+    bool Network::isInTransaction() const noexcept {
+        return m_transactionDepth > 0;
+    }
+
+    Network::Transaction::Transaction(Network& network)
+        : m_network(network) {
+        m_network.beginTransaction();
+    }
+
+    Network::Transaction::~Transaction(){
+        m_network.commitTransaction();
+    }
+
+    Network::ConstructionScope::ConstructionScope(Network& network) noexcept
+        : m_previous(std::exchange(constructingNetwork, &network)) {
+
+    }
+
+    Network::ConstructionScope::~ConstructionScope() noexcept {
+        constructingNetwork = m_previous;
+    }
+
+    void Network::addNode(SoundNode* node){
+        m_soundNodes.push_back(node);
+        if (!node->m_initDone){
+            m_uninitializedNodes.push_back(node);
+        }
+    }
+
+    void Network::addNode(NumberNode* node){
+        m_numberNodes.push_back(node);
+    }
+
+    void Network::removeNode(const SoundNode* node) noexcept {
+        auto it = std::find(m_soundNodes.begin(), m_soundNodes.end(), node);
+        assert(it != m_soundNodes.end());
+        m_soundNodes.erase(it);
+
+        // This happens if the node's constructor throws
+        auto uit = std::find(m_uninitializedNodes.begin(), m_uninitializedNodes.end(), node);
+        if (uit != m_uninitializedNodes.end()){
+            m_uninitializedNodes.erase(uit);
+        }
+    }
+
+    void Network::removeNode(const NumberNode* node) noexcept {
+        auto it = std::find(m_numberNodes.begin(), m_numberNodes.end(), node);
+        assert(it != m_numberNodes.end());
+        m_numberNodes.erase(it);
+    }
+
+    void Network::initializeNodes(std::size_t first){
+        assert(first <= m_uninitializedNodes.size());
+        // NOTE: the nodes are taken out first, since their initialization
+        // may construct further nodes through the network
+        auto nodes = std::vector<SoundNode*>{};
+        if (first == 0){
+            nodes.swap(m_uninitializedNodes);
+        } else {
+            nodes.assign(m_uninitializedNodes.begin() + first, m_uninitializedNodes.end());
+            m_uninitializedNodes.resize(first);
+        }
+        // The states allocated by all nodes are built in a single pass
+        auto t = Transaction{*this};
+        for (const auto& n : nodes){
+            n->initNow();
+        }
+    }
+
+    void Network::deferStates(SoundNode* node){
+        assert(m_transactionDepth > 0);
+        if (node->m_deferringNetwork){
+            return;
+        }
+        // NOTE: everything depending on a node which is already deferred
+        // is suspended already
+        const auto& dependents = node->getDirectDependents();
+        if (dependents.empty()){
+            suspendResults(node);
+        }
+        for (const auto& d : dependents){
+            if (!d->m_deferringNetwork){
+                suspendResults(d);
+            }
+        }
+        node->discardSlots();
+        node->m_deferringNetwork = this;
+        m_deferredNodes.push_back(node);
+
+        // The states of all dependencies point to the discarded states
+        for (const auto& d : node->getDirectDependencies()){
+            deferStates(d);
+        }
+    }
+
+    void Network::suspendResults(SoundNode* node){
+        auto soundResults = std::vector<SoundResult*>{};
+        node->findDependentSoundResults(soundResults);
+        for (const auto& r : soundResults){
+            if (std::find(m_suspendedResults.begin(), m_suspendedResults.end(), r) != m_suspendedResults.end()){
+                continue;
+            }
+            // NOTE: this waits for any chunk being rendered to finish
+            auto lock = std::unique_lock{r->m_mutex};
+            r->suspend(this);
+            m_suspendedResults.push_back(r);
+        }
+    }
+
+    void Network::forgetDeferred(const SoundNode* node) noexcept {
+        auto it = std::find(m_deferredNodes.begin(), m_deferredNodes.end(), node);
+        assert(it != m_deferredNodes.end());
+        m_deferredNodes.erase(it);
+    }
+
+    void Network::forgetSuspended(SoundResult* soundResult) noexcept {
+        auto it = std::find(m_suspendedResults.begin(), m_suspendedResults.end(), soundResult);
+        assert(it != m_suspendedResults.end());
+        m_suspendedResults.erase(it);
+    }
+
+    void Network::rebuildStates(SoundNode* node){
+        if (node->m_deferringNetwork != this){
+            return;
+        }
+        // The states of all dependents are pointed to by the rebuilt states
+        for (const auto& d : node->getDirectDependents()){
+            rebuildStates(d);
+        }
+        node->rebuildSlots();
+        node->m_deferringNetwork = nullptr;
+    }
+
+} // namespace flo
@@ -1,5 +1,6 @@
 #include <Flosion/Core/NumberNode.hpp>
 
+#include <Flosion/Core/Network.hpp>
 #include <Flosion/Core/SoundNode.hpp>
 #include <Flosion/Core/SoundResult.hpp>
 
@@ -10,13 +11,23 @@
 namespace flo {
 
     NumberNode::NumberNode()
-        : m_network(nullptr)
+        : m_network(Network::getConstructingNetwork())
         , m_stateOwner(nullptr) {
 
+        if (m_network){
+            m_network->addNode(this);
+        }
     }
 
     NumberNode::~NumberNode(){
         setStateOwner(nullptr);
+        if (m_network){
+            m_network->removeNode(this);
+        }
+    }
+
+    Network* NumberNode::getNetwork() const noexcept {
+        return m_network;
     }
 
     bool NumberNode::canAddDependency(const NumberNode* node) const noexcept {
@@ -28,8 +39,8 @@ namespace flo {
         // and that every dependent of the dependent's state owner is a dependent or dependency of the dependency's
         // state owner.
         // That might sound confusing but trust me.
-        const auto dcs = node->getAllDependencies();
-        const auto dts = getAllDependents();
+        const auto& dcs = node->getAllDependencies();
+        const auto& dts = getAllDependents();
         for (const auto& dc : dcs){
             const auto dcso = dc->getStateOwner();
             if (!dcso){
@@ -86,6 +97,10 @@ namespace flo {
         return nullptr;
     }
 
+    void NumberNode::reseed(std::uint64_t) noexcept {
+        // Nothing to do
+    }
+
     void NumberNode::setStateOwner(SoundNode* sn){
         if (m_stateOwner){
             m_stateOwner->removeNumberNode(this);
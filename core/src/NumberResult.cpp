@@ -8,7 +8,7 @@ namespace flo {
         setStateOwner(m_hiddenNode.get());
     }
 
-    double NumberResult::getValue() const noexcept {
+    Number NumberResult::getValue() const noexcept {
         const auto& m_hiddenNodeButConst = m_hiddenNode; // Grumble grumble grumble...
         return input.getValue(m_hiddenNodeButConst->getMonoState());
     }
@@ -1,5 +1,7 @@
 #include <Flosion/Core/NumberSource.hpp>
 
+#include <Flosion/Core/Profiler.hpp>
+
 namespace flo {
 
     std::lock_guard<std::mutex> NumberInput::acquireLock(){
@@ -7,7 +9,7 @@ namespace flo {
         return std::lock_guard{m_uselessMutexPleaseRemove};
     }
 
-    NumberInput::NumberInput(double defaultValue) noexcept
+    NumberInput::NumberInput(Number defaultValue) noexcept
         : m_defaultValue(defaultValue) {
 
     }
@@ -23,41 +25,42 @@ namespace flo {
         return nullptr;
     }
 
-    double NumberInput::getValue(const SoundState* context) const noexcept {
+    Number NumberInput::getValue(const SoundState* context) const noexcept {
         if (auto s = getSource()){
+            [[maybe_unused]] auto timer = Profiler::NumberScope{s};
             return s->evaluate(context);
         }
         return m_defaultValue;
     }
 
-    double NumberInput::getDefaultValue() const noexcept {
+    Number NumberInput::getDefaultValue() const noexcept {
         return m_defaultValue;
     }
 
-    void NumberInput::setDefaultValue(double value) noexcept {
+    void NumberInput::setDefaultValue(Number value) noexcept {
         m_defaultValue = value;
         onDefaultValueChanged.broadcast(value);
     }
 
-    NumberSourceInput::NumberSourceInput(NumberSource* owner, double defaultValue)
+    NumberSourceInput::NumberSourceInput(NumberSource* owner, Number defaultValue)
         : NumberInput(defaultValue) {
         owner->addDependency(this);
     }
 
-    Constant::Constant(double value) noexcept 
+    Constant::Constant(Number value) noexcept 
         : m_value(value) {
     }
 
-    double Constant::getValue() const noexcept {
+    Number Constant::getValue() const noexcept {
         return m_value.load(std::memory_order_relaxed);
     }
 
-    void Constant::setValue(double value) noexcept {
+    void Constant::setValue(Number value) noexcept {
         m_value.store(value, std::memory_order_relaxed);
         onChangeValue.broadcast(value);
     }
 
-    double Constant::evaluate(const SoundState* /* context */) const noexcept {
+    Number Constant::evaluate(const SoundState* /* context */) const noexcept {
         return m_value.load(std::memory_order_relaxed);
     }
 
@@ -0,0 +1,491 @@
+#include <Flosion/Core/Profiler.hpp>
+
+#include <Flosion/Core/Sample.hpp>
+#include <Flosion/Core/SoundChunk.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define FLOSION_PROFILER_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define FLOSION_PROFILER_RDTSC
+#endif
+
+namespace flo {
+
+    std::uint64_t Profiler::now() noexcept {
+#ifdef FLOSION_PROFILER_RDTSC
+        return static_cast<std::uint64_t>(__rdtsc());
+#else
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            ).count()
+        );
+#endif
+    }
+
+    double Profiler::ticksPerSecond() noexcept {
+#ifdef FLOSION_PROFILER_RDTSC
+        // The rate of the timestamp counter is measured once against the
+        // steady clock. This assumes an invariant timestamp counter, which
+        // every x86 processor of the past decade has.
+        static const double rate = []{
+            using clock = std::chrono::steady_clock;
+            const auto t0 = clock::now();
+            const auto c0 = now();
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+            const auto t1 = clock::now();
+            const auto c1 = now();
+            const auto seconds = std::chrono::duration<double>(t1 - t0).count();
+            return static_cast<double>(c1 - c0) / seconds;
+        }();
+        return rate;
+#else
+        return 1e9;
+#endif
+    }
+
+#ifdef FLOSION_PROFILING
+
+    namespace {
+
+        std::atomic<bool> s_enabled{true};
+
+        // NOTE: the node is a number source if the state is null,
+        // and a sound node otherwise
+        struct Record {
+            const void* node;
+            const SoundState* state;
+            std::uint64_t ticks;
+        };
+
+        /**
+         * The measurements of a single rendering thread. The queue of records
+         * is written by that thread only and read by the collector only.
+         * Everything else is only ever touched by the rendering thread.
+         */
+        struct ThreadLog {
+            static constexpr std::size_t capacity = std::size_t{1} << 13;
+            static constexpr std::size_t maxDepth = 256;
+            static constexpr std::size_t numberTableSize = 128;
+
+            ThreadLog() noexcept
+                : writeIndex(0)
+                , readIndex(0)
+                , dropped(0)
+                , orphaned(false)
+                , depth(0)
+                , soundDepth(0)
+                , numNumbers(0)
+                , currentSize(0)
+                , lastSize(0) {
+
+                numberTable.fill(NumberEntry{nullptr, 0});
+            }
+
+            void push(const void* node, const SoundState* state, std::uint64_t ticks) noexcept {
+                const auto w = writeIndex.load(std::memory_order_relaxed);
+                const auto r = readIndex.load(std::memory_order_acquire);
+                if (w - r == capacity){
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                records[w % capacity] = Record{node, state, ticks};
+                writeIndex.store(w + 1, std::memory_order_release);
+            }
+
+            // Adds a measurement to the queue and to the breakdown of the current chunk
+            void record(const void* node, const SoundState* state, std::uint64_t ticks) noexcept {
+                push(node, state, ticks);
+                if (currentSize == maxBreakdownSize && currentChunk[currentSize - 1].ticks >= ticks){
+                    return;
+                }
+                auto i = std::min(currentSize, maxBreakdownSize - 1);
+                while (i > 0 && currentChunk[i - 1].ticks < ticks){
+                    currentChunk[i] = currentChunk[i - 1];
+                    --i;
+                }
+                currentChunk[i] = Record{node, state, ticks};
+                currentSize = std::min(currentSize + 1, maxBreakdownSize);
+            }
+
+            void finishChunk() noexcept {
+                lastChunk = currentChunk;
+                lastSize = currentSize;
+                currentSize = 0;
+            }
+
+            // Marks the start of a node's measurement
+            bool enter() noexcept {
+                if (depth == maxDepth){
+                    return false;
+                }
+                frames[depth++] = Frame{Profiler::now(), 0};
+                return true;
+            }
+
+            // Ends the innermost measurement and returns its own time
+            std::uint64_t leave() noexcept {
+                assert(depth > 0);
+                const auto t = Profiler::now();
+                const auto& f = frames[--depth];
+                const auto elapsed = t - f.start;
+                if (depth > 0){
+                    frames[depth - 1].children += elapsed;
+                }
+                return elapsed > f.children ? elapsed - f.children : 0;
+            }
+
+            void addNumberTime(const NumberSource* node, std::uint64_t ticks) noexcept {
+                auto i = (reinterpret_cast<std::uintptr_t>(node) >> 4) % numberTableSize;
+                while (numberTable[i].node && numberTable[i].node != node){
+                    i = (i + 1) % numberTableSize;
+                }
+                if (!numberTable[i].node){
+                    // NOTE: the table is kept at most half full
+                    if (2 * (numNumbers + 1) > numberTableSize){
+                        dropped.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+                    numberTable[i].node = node;
+                    numberSlots[numNumbers++] = i;
+                }
+                numberTable[i].ticks += ticks;
+            }
+
+            void flushNumbers() noexcept {
+                for (std::size_t k = 0; k < numNumbers; ++k){
+                    auto& e = numberTable[numberSlots[k]];
+                    record(e.node, nullptr, e.ticks);
+                    e = NumberEntry{nullptr, 0};
+                }
+                numNumbers = 0;
+            }
+
+            std::array<Record, capacity> records;
+            alignas(64) std::atomic<std::size_t> writeIndex;
+            alignas(64) std::atomic<std::size_t> readIndex;
+            std::atomic<std::size_t> dropped;
+
+            // Set once the thread has exited and the log only needs to be drained
+            std::atomic<bool> orphaned;
+
+            struct Frame {
+                std::uint64_t start;
+
+                // The time spent in nested measurements
+                std::uint64_t children;
+            };
+
+            alignas(64) std::array<Frame, maxDepth> frames;
+            std::size_t depth;
+
+            // The number of sound scopes among the frames
+            std::size_t soundDepth;
+
+            // The time spent in each number source during the current chunk
+            struct NumberEntry {
+                const NumberSource* node;
+                std::uint64_t ticks;
+            };
+            std::array<NumberEntry, numberTableSize> numberTable;
+            std::array<std::size_t, numberTableSize / 2> numberSlots;
+            std::size_t numNumbers;
+
+            // The slowest nodes of the chunk being rendered and of the previous
+            // chunk, in descending order of time
+            static constexpr std::size_t maxBreakdownSize = Profiler::maxBreakdownSize;
+            std::array<Record, maxBreakdownSize> currentChunk;
+            std::size_t currentSize;
+            std::array<Record, maxBreakdownSize> lastChunk;
+            std::size_t lastSize;
+        };
+
+        struct Accumulator {
+            static constexpr std::size_t bucketsPerOctave = 8;
+            static constexpr std::size_t numBuckets = 64 * bucketsPerOctave;
+
+            std::size_t count = 0;
+            std::uint64_t sum = 0;
+            std::uint64_t max = 0;
+            std::vector<std::uint32_t> histogram = std::vector<std::uint32_t>(numBuckets, 0);
+
+            // Values below 8 have a bucket of their own, and every doubling
+            // above that is split into 8 buckets of equal width
+            static std::size_t bucketOf(std::uint64_t v) noexcept {
+                if (v < bucketsPerOctave){
+                    return static_cast<std::size_t>(v);
+                }
+                std::size_t msb = 0;
+                while ((v >> msb) > 1){
+                    ++msb;
+                }
+                const auto sub = static_cast<std::size_t>((v >> (msb - 3)) & 7);
+                return (msb - 2) * bucketsPerOctave + sub;
+            }
+
+            static double middleOf(std::size_t bucket) noexcept {
+                if (bucket < bucketsPerOctave){
+                    return static_cast<double>(bucket);
+                }
+                const auto msb = bucket / bucketsPerOctave + 2;
+                const auto sub = bucket % bucketsPerOctave;
+                const auto width = static_cast<double>(std::uint64_t{1} << (msb - 3));
+                return static_cast<double>(bucketsPerOctave + sub) * width + 0.5 * width;
+            }
+
+            void add(std::uint64_t ticks) noexcept {
+                ++count;
+                sum += ticks;
+                max = std::max(max, ticks);
+                ++histogram[bucketOf(ticks)];
+            }
+
+            double percentile(double p) const noexcept {
+                const auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(count)));
+                std::size_t seen = 0;
+                for (std::size_t i = 0; i < numBuckets; ++i){
+                    seen += histogram[i];
+                    if (seen >= rank){
+                        return std::min(middleOf(i), static_cast<double>(max));
+                    }
+                }
+                return static_cast<double>(max);
+            }
+        };
+
+        class Collector {
+        public:
+            static Collector& instance(){
+                static Collector c;
+                return c;
+            }
+
+            ThreadLog* registerThread(){
+                auto log = std::make_shared<ThreadLog>();
+                auto lock = std::lock_guard{m_mutex};
+                m_logs.push_back(log);
+                return log.get();
+            }
+
+            // Drains every thread's queue into the accumulators.
+            // The mutex must be held.
+            void drain(){
+                for (auto it = m_logs.begin(); it != m_logs.end();){
+                    auto& log = **it;
+                    const auto orphaned = log.orphaned.load(std::memory_order_acquire);
+                    const auto w = log.writeIndex.load(std::memory_order_acquire);
+                    auto r = log.readIndex.load(std::memory_order_relaxed);
+                    for (; r != w; ++r){
+                        const auto& rec = log.records[r % ThreadLog::capacity];
+                        m_stats[{rec.node, rec.state}].add(rec.ticks);
+                    }
+                    log.readIndex.store(r, std::memory_order_release);
+                    m_dropped += log.dropped.exchange(0, std::memory_order_relaxed);
+                    if (orphaned){
+                        it = m_logs.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+
+            std::mutex m_mutex;
+            std::vector<std::shared_ptr<ThreadLog>> m_logs;
+            std::map<std::pair<const void*, const SoundState*>, Accumulator> m_stats;
+            std::size_t m_dropped = 0;
+        };
+
+        // NOTE: the log is accessed through a plain pointer, which needs no
+        // guard, and is handed back to the collector by a separate owner
+        // when the thread exits
+        thread_local ThreadLog* t_log = nullptr;
+
+        struct ThreadLogOwner {
+            ~ThreadLogOwner(){
+                if (t_log){
+                    t_log->orphaned.store(true, std::memory_order_release);
+                    t_log = nullptr;
+                }
+            }
+        };
+
+    } // anonymous namespace
+
+    Profiler::SoundScope::SoundScope(const SoundNode* node, const SoundState* state) noexcept
+        : m_node(node)
+        , m_state(state)
+        , m_active(false) {
+        assert(state);
+        if (!t_log || !s_enabled.load(std::memory_order_relaxed)){
+            return;
+        }
+        if (t_log->enter()){
+            ++t_log->soundDepth;
+            m_active = true;
+        }
+    }
+
+    Profiler::SoundScope::~SoundScope() noexcept {
+        if (!m_active){
+            return;
+        }
+        auto& log = *t_log;
+        log.record(m_node, m_state, log.leave());
+        assert(log.soundDepth > 0);
+        if (--log.soundDepth == 0){
+            log.flushNumbers();
+            log.finishChunk();
+        }
+    }
+
+    Profiler::NumberScope::NumberScope(const NumberSource* node) noexcept
+        : m_node(node)
+        , m_active(false) {
+        // Numbers are only measured while rendering a chunk, since that
+        // is when their measurements can be grouped by chunk
+        if (t_log && t_log->soundDepth > 0){
+            m_active = t_log->enter();
+        }
+    }
+
+    Profiler::NumberScope::~NumberScope() noexcept {
+        if (m_active){
+            t_log->addNumberTime(m_node, t_log->leave());
+        }
+    }
+
+    void Profiler::setEnabled(bool enabled) noexcept {
+        if (enabled){
+            ticksPerSecond();
+        }
+        s_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool Profiler::isEnabled() noexcept {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::registerCurrentThread(){
+        if (t_log){
+            return;
+        }
+        // NOTE: the rate of the timer is measured up front, since doing
+        // so takes a while and the measurements are about to be read
+        ticksPerSecond();
+        thread_local ThreadLogOwner owner;
+        t_log = Collector::instance().registerThread();
+    }
+
+    std::size_t Profiler::getLastChunkBreakdown(NodeTime* out) noexcept {
+        if (!t_log){
+            return 0;
+        }
+        const auto tps = ticksPerSecond();
+        for (std::size_t i = 0; i < t_log->lastSize; ++i){
+            const auto& r = t_log->lastChunk[i];
+            auto& nt = out[i];
+            nt = NodeTime{};
+            if (r.state){
+                nt.soundNode = static_cast<const SoundNode*>(r.node);
+                nt.state = r.state;
+            } else {
+                nt.numberSource = static_cast<const NumberSource*>(r.node);
+            }
+            nt.seconds = static_cast<double>(r.ticks) / tps;
+        }
+        return t_log->lastSize;
+    }
+
+    std::vector<Profiler::NodeStats> Profiler::getStats(){
+        auto& c = Collector::instance();
+        auto lock = std::lock_guard{c.m_mutex};
+        c.drain();
+
+        const auto tps = ticksPerSecond();
+        const auto chunkSeconds = static_cast<double>(SoundChunk::size) / static_cast<double>(sampleFrequency);
+
+        auto ret = std::vector<NodeStats>{};
+        ret.reserve(c.m_stats.size());
+        for (const auto& [key, acc] : c.m_stats){
+            auto s = NodeStats{};
+            if (key.second){
+                s.soundNode = static_cast<const SoundNode*>(key.first);
+                s.state = key.second;
+            } else {
+                s.numberSource = static_cast<const NumberSource*>(key.first);
+            }
+            s.count = acc.count;
+            s.meanSeconds = static_cast<double>(acc.sum) / static_cast<double>(acc.count) / tps;
+            s.p99Seconds = acc.percentile(0.99) / tps;
+            s.maxSeconds = static_cast<double>(acc.max) / tps;
+            s.budgetShare = s.meanSeconds / chunkSeconds;
+            ret.push_back(s);
+        }
+        std::sort(ret.begin(), ret.end(), [](const NodeStats& a, const NodeStats& b){
+            return a.meanSeconds > b.meanSeconds;
+        });
+        return ret;
+    }
+
+    void Profiler::reset(){
+        auto& c = Collector::instance();
+        auto lock = std::lock_guard{c.m_mutex};
+        c.drain();
+        c.m_stats.clear();
+        c.m_dropped = 0;
+    }
+
+    std::size_t Profiler::getDroppedCount(){
+        auto& c = Collector::instance();
+        auto lock = std::lock_guard{c.m_mutex};
+        c.drain();
+        return c.m_dropped;
+    }
+
+#else // FLOSION_PROFILING
+
+    void Profiler::setEnabled(bool) noexcept {
+
+    }
+
+    bool Profiler::isEnabled() noexcept {
+        return false;
+    }
+
+    void Profiler::registerCurrentThread(){
+
+    }
+
+    std::size_t Profiler::getLastChunkBreakdown(NodeTime*) noexcept {
+        return 0;
+    }
+
+    std::vector<Profiler::NodeStats> Profiler::getStats(){
+        return {};
+    }
+
+    void Profiler::reset(){
+
+    }
+
+    std::size_t Profiler::getDroppedCount(){
+        return 0;
+    }
+
+#endif // FLOSION_PROFILING
+
+} // namespace flo
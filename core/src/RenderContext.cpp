@@ -0,0 +1,104 @@
+#include <Flosion/Core/RenderContext.hpp>
+
+#include <Flosion/Core/SoundState.hpp>
+
+#include <cassert>
+#include <cstdint>
+
+namespace flo {
+
+    RenderContext::Scope::Scope(const SoundNode* owner, const SoundState* state) noexcept {
+        current().push(owner, state);
+    }
+
+    RenderContext::Scope::~Scope() noexcept {
+        current().pop();
+    }
+
+    const SoundState* RenderContext::findState(const SoundNode* owner, const SoundState* context) noexcept {
+        assert(owner);
+        auto& rc = current();
+        auto s = context;
+        const auto depth = rc.m_depth;
+        if (depth > 0 && depth <= maxDepth && rc.m_entries[depth - 1].state == context){
+            const auto& top = rc.m_entries[depth - 1];
+            auto i = hash(owner);
+            while (rc.m_table[i].owner){
+                if (rc.m_table[i].owner == owner){
+                    const auto e = rc.m_table[i].entry;
+                    if (e >= top.chainBase){
+                        return rc.m_entries[e].state;
+                    }
+                    break;
+                }
+                i = (i + 1) % tableSize;
+            }
+            // The owner is not among the states depending directly on one
+            // another, so only the states beyond them need to be searched
+            s = rc.m_entries[top.chainBase].state->getDependentState();
+        }
+        while (s && s->getOwner() != owner){
+            s = s->getDependentState();
+        }
+        return s;
+    }
+
+    RenderContext& RenderContext::current() noexcept {
+        thread_local RenderContext theContext;
+        return theContext;
+    }
+
+    void RenderContext::push(const SoundNode* owner, const SoundState* state) noexcept {
+        assert(owner);
+        assert(state);
+        const auto idx = m_depth++;
+        if (idx >= maxDepth){
+            return;
+        }
+        auto& e = m_entries[idx];
+        e.owner = owner;
+        e.state = state;
+        e.chainBase = (idx > 0 && state->getDependentState() == m_entries[idx - 1].state)
+            ? m_entries[idx - 1].chainBase
+            : idx;
+        e.shadowedEntry = noEntry;
+
+        // NOTE: the table holds at most maxDepth owners, so an empty slot always exists
+        auto i = hash(owner);
+        while (m_table[i].owner && m_table[i].owner != owner){
+            i = (i + 1) % tableSize;
+        }
+        if (m_table[i].owner){
+            e.shadowedEntry = m_table[i].entry;
+        } else {
+            m_table[i].owner = owner;
+        }
+        m_table[i].entry = idx;
+        e.tableSlot = i;
+    }
+
+    void RenderContext::pop() noexcept {
+        assert(m_depth > 0);
+        const auto idx = --m_depth;
+        if (idx >= maxDepth){
+            return;
+        }
+        const auto& e = m_entries[idx];
+        auto& ts = m_table[e.tableSlot];
+        assert(ts.owner == e.owner);
+        assert(ts.entry == idx);
+        if (e.shadowedEntry == noEntry){
+            ts = TableSlot{nullptr, noEntry};
+        } else {
+            ts.entry = e.shadowedEntry;
+        }
+    }
+
+    std::size_t RenderContext::hash(const SoundNode* owner) noexcept {
+        // Nodes are at least pointer-aligned, so the lowest bits carry no information
+        // and the highest bits of the product are the best mixed
+        const auto addr = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(owner) >> 4);
+        return static_cast<std::size_t>((addr * 0x9E3779B97F4A7C15ull) >> (64 - tableBits));
+    }
+
+} // namespace flo
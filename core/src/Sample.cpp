@@ -122,86 +122,89 @@ namespace flo {
     }
 
     Sample::operator SampleProxy() & noexcept {
-        return SampleProxy(static_cast<float*>(m_data));
+        return SampleProxy(&m_data[0], &m_data[1]);
     }
 
     Sample::operator ConstSampleProxy() const & noexcept {
-        return ConstSampleProxy(static_cast<const float*>(m_data));
+        return ConstSampleProxy(&m_data[0], &m_data[1]);
     }
 
     // SampleProxy
 
-    SampleProxy::SampleProxy(float* ptr) noexcept
-        : m_ptr(ptr) {
+    SampleProxy::SampleProxy(float* lPtr, float* rPtr) noexcept
+        : m_lPtr(lPtr)
+        , m_rPtr(rPtr) {
         
     }
 
     void SampleProxy::silence(){
-        m_ptr[0] = 0.0f;
-        m_ptr[1] = 0.0f;
+        *m_lPtr = 0.0f;
+        *m_rPtr = 0.0f;
     }
 
     float& SampleProxy::l() noexcept {
-        return m_ptr[0];
+        return *m_lPtr;
     }
 
     float SampleProxy::l() const noexcept {
-        return m_ptr[0];
+        return *m_lPtr;
     }
 
     float& SampleProxy::r() noexcept {
-        return m_ptr[1];
+        return *m_rPtr;
     }
 
     float SampleProxy::r() const noexcept {
-        return m_ptr[1];
+        return *m_rPtr;
+    }
+
+    void SampleProxy::assign(float left, float right) noexcept {
+        if (m_lPtr == m_rPtr){
+            // mono, store the average of both channels
+            *m_lPtr = 0.5f * (left + right);
+        } else {
+            *m_lPtr = left;
+            *m_rPtr = right;
+        }
     }
 
     SampleProxy& SampleProxy::operator=(const Sample& other) noexcept {
-        l() = other.l();
-        r() = other.r();
+        assign(other.l(), other.r());
         return *this;
     }
 
     SampleProxy& SampleProxy::operator=(const ConstSampleProxy& other) noexcept {
-        l() = other.l();
-        r() = other.r();
+        assign(other.l(), other.r());
         return *this;
     }
 
     SampleProxy& SampleProxy::operator+=(const Sample& other) noexcept {
-        l() += other.l();
-        r() += other.r();
+        assign(l() + other.l(), r() + other.r());
         return *this;
     }
 
     SampleProxy& SampleProxy::operator+=(const ConstSampleProxy& other) noexcept {
-        l() += other.l();
-        r() += other.r();
+        assign(l() + other.l(), r() + other.r());
         return *this;
     }
 
     SampleProxy& SampleProxy::operator-=(const Sample& other) noexcept {
-        l() -= other.l();
-        r() -= other.r();
+        assign(l() - other.l(), r() - other.r());
         return *this;
     }
 
     SampleProxy& SampleProxy::operator-=(const ConstSampleProxy& other) noexcept {
-        l() -= other.l();
-        r() -= other.r();
+        assign(l() - other.l(), r() - other.r());
         return *this;
     }
 
     SampleProxy& SampleProxy::operator*=(float value) noexcept {
-        l() *= value;
-        r() *= value;
+        assign(l() * value, r() * value);
         return *this;
     }
 
     SampleProxy& SampleProxy::operator/=(float v) noexcept {
-        l() /= v;
-        r() /= v;
+        assign(l() / v, r() / v);
         return *this;
     }
 
@@ -235,21 +238,23 @@ namespace flo {
 
     // ConstSampleProxy
 
-    ConstSampleProxy::ConstSampleProxy(const float* ptr) noexcept
-        : m_ptr(ptr) {
+    ConstSampleProxy::ConstSampleProxy(const float* lPtr, const float* rPtr) noexcept
+        : m_lPtr(lPtr)
+        , m_rPtr(rPtr) {
     
     }
 
     ConstSampleProxy::ConstSampleProxy(SampleProxy other) noexcept 
-        : m_ptr(other.m_ptr) {
+        : m_lPtr(other.m_lPtr)
+        , m_rPtr(other.m_rPtr) {
     }
 
     float ConstSampleProxy::l() const noexcept {
-        return m_ptr[0];
+        return *m_lPtr;
     }
 
     float ConstSampleProxy::r() const noexcept {
-        return m_ptr[1];
+        return *m_rPtr;
     }
 
     Sample ConstSampleProxy::operator-() const noexcept {
@@ -0,0 +1,301 @@
+#include <Flosion/Core/SampleFormat.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace flo {
+
+    // NOTE: like the bulk operations of SoundChunk, the loops below work on
+    // contiguous channels through restrict-qualified pointers and avoid
+    // branches and library calls such as std::lround, so that they are
+    // compiled to packed SIMD instructions. Samples are clamped after they
+    // are scaled and rounded, right before the conversion to integers,
+    // because compilers won't vectorize a clamp that is followed by
+    // arithmetic which might raise floating point exceptions.
+
+    namespace {
+
+        constexpr float int16Scale = 32767.0f;
+        constexpr float int24Scale = 8388607.0f;
+        constexpr double int32Scale = 2147483647.0;
+
+        // A cheap, well mixed hash (lowbias32), so that dither noise can be
+        // computed for every sample independently
+        inline std::uint32_t hash(std::uint32_t x) noexcept {
+            x ^= x >> 16;
+            x *= 0x7feb352du;
+            x ^= x >> 15;
+            x *= 0x846ca68bu;
+            x ^= x >> 16;
+            return x;
+        }
+
+        // Triangular noise in [-1, 1], the difference of the two
+        // uniformly distributed halves of the hash
+        inline float triangular(std::uint32_t x) noexcept {
+            const auto h = hash(x);
+            const auto a = static_cast<std::int32_t>(h & 0xffffu);
+            const auto b = static_cast<std::int32_t>(h >> 16);
+            return static_cast<float>(a - b) * (1.0f / 65536.0f);
+        }
+
+        inline float clampUnit(float v) noexcept {
+            return v < -1.0f ? -1.0f : (v > 1.0f ? 1.0f : v);
+        }
+
+        // Rounds half away from zero to an integer in [-limit, limit],
+        // using a truncating conversion
+        inline std::int32_t roundToInt(float v, float limit) noexcept {
+            v += std::copysign(0.5f, v);
+            v = v < -limit ? -limit : v;
+            v = v > limit ? limit : v;
+            return static_cast<std::int32_t>(v);
+        }
+
+        // Scales a sample to the given full scale, adding triangular
+        // dither from the given position of the noise sequence if needed
+        template<bool Dithered>
+        inline std::int32_t quantizeSample(float v, float fullScale, std::uint32_t noiseIndex) noexcept {
+            auto x = v * fullScale;
+            if constexpr (Dithered){
+                x += triangular(noiseIndex);
+            }
+            return roundToInt(x, fullScale);
+        }
+
+        template<bool Dithered>
+        void quantizeChannel(const float* __restrict src, std::size_t count, float fullScale, std::uint32_t seed, std::int32_t* __restrict dst) noexcept {
+            for (std::size_t i = 0; i < count; ++i){
+                dst[i] = quantizeSample<Dithered>(src[i], fullScale, seed + static_cast<std::uint32_t>(i));
+            }
+        }
+
+        // Quantizes and interleaves two channels at once, which is
+        // the common case of a stereo int16 stream
+        template<bool Dithered>
+        void quantizeStereoInt16(const float* __restrict l, const float* __restrict r, std::size_t count, std::uint32_t seedL, std::uint32_t seedR, std::int16_t* __restrict dst) noexcept {
+            for (std::size_t i = 0; i < count; ++i){
+                const auto j = static_cast<std::uint32_t>(i);
+                dst[2 * i + 0] = static_cast<std::int16_t>(quantizeSample<Dithered>(l[i], int16Scale, seedL + j));
+                dst[2 * i + 1] = static_cast<std::int16_t>(quantizeSample<Dithered>(r[i], int16Scale, seedR + j));
+            }
+        }
+
+        void quantizeInt32(const float* __restrict src, std::size_t count, std::int32_t* __restrict dst) noexcept {
+            for (std::size_t i = 0; i < count; ++i){
+                // NOTE: 2^31 - 1 can't be represented as a float
+                auto v = static_cast<double>(src[i]) * int32Scale;
+                v += std::copysign(0.5, v);
+                v = v < -int32Scale ? -int32Scale : v;
+                v = v > int32Scale ? int32Scale : v;
+                dst[i] = static_cast<std::int32_t>(v);
+            }
+        }
+
+        void decodeInt16(const std::int16_t* __restrict src, std::size_t stride, std::size_t count, float* __restrict dst) noexcept {
+            constexpr auto k = 1.0f / int16Scale;
+            for (std::size_t i = 0; i < count; ++i){
+                dst[i] = static_cast<float>(src[i * stride]) * k;
+            }
+        }
+
+        void decodeInt24(const unsigned char* __restrict src, std::size_t stride, std::size_t count, float* __restrict dst) noexcept {
+            constexpr auto k = 1.0f / int24Scale;
+            for (std::size_t i = 0; i < count; ++i){
+                const auto p = src + 3 * i * stride;
+                const auto u = static_cast<std::uint32_t>(p[0])
+                    | (static_cast<std::uint32_t>(p[1]) << 8)
+                    | (static_cast<std::uint32_t>(p[2]) << 16);
+                // sign-extend from 24 bits
+                const auto s = static_cast<std::int32_t>(u << 8) >> 8;
+                dst[i] = static_cast<float>(s) * k;
+            }
+        }
+
+        void decodeInt32(const std::int32_t* __restrict src, std::size_t stride, std::size_t count, float* __restrict dst) noexcept {
+            constexpr auto k = 1.0 / int32Scale;
+            for (std::size_t i = 0; i < count; ++i){
+                dst[i] = static_cast<float>(static_cast<double>(src[i * stride]) * k);
+            }
+        }
+
+        void decodeFloat32(const float* __restrict src, std::size_t stride, std::size_t count, float* __restrict dst) noexcept {
+            for (std::size_t i = 0; i < count; ++i){
+                dst[i] = src[i * stride];
+            }
+        }
+
+        void decodeChannel(const void* src, SampleFormat format, std::size_t stride, std::size_t count, float* dst) noexcept {
+            switch (format){
+            case SampleFormat::Float32:
+                decodeFloat32(static_cast<const float*>(src), stride, count, dst);
+                return;
+            case SampleFormat::Int16:
+                decodeInt16(static_cast<const std::int16_t*>(src), stride, count, dst);
+                return;
+            case SampleFormat::Int24:
+                decodeInt24(static_cast<const unsigned char*>(src), stride, count, dst);
+                return;
+            case SampleFormat::Int32:
+                decodeInt32(static_cast<const std::int32_t*>(src), stride, count, dst);
+                return;
+            }
+        }
+
+    } // anonymous namespace
+
+    void interleave(const SoundChunk& src, std::size_t offset, std::size_t numFrames, float* dst) noexcept {
+        assert(offset + numFrames <= SoundChunk::size);
+        const auto n = src.numChannels();
+        for (std::size_t c = 0; c < n; ++c){
+            const auto s = src.channel(c) + offset;
+            for (std::size_t i = 0; i < numFrames; ++i){
+                dst[n * i + c] = s[i];
+            }
+        }
+    }
+
+    void deinterleave(const float* src, std::size_t numFrames, SoundChunk& dst, std::size_t offset) noexcept {
+        assert(offset + numFrames <= SoundChunk::size);
+        const auto n = dst.numChannels();
+        for (std::size_t c = 0; c < n; ++c){
+            decodeFloat32(src + c, n, numFrames, dst.channel(c) + offset);
+        }
+    }
+
+    void decodeSamples(const void* src, SampleFormat format, std::size_t count, float* dst) noexcept {
+        decodeChannel(src, format, 1, count, dst);
+    }
+
+    void decodeInterleaved(const void* src, SampleFormat format, std::size_t numChannels, std::size_t numFrames, SoundChunk& dst, std::size_t offset) noexcept {
+        assert(offset + numFrames <= SoundChunk::size);
+        const auto bytes = static_cast<const unsigned char*>(src);
+        const auto n = std::min(numChannels, dst.numChannels());
+        for (std::size_t c = 0; c < n; ++c){
+            decodeChannel(bytes + c * bytesPerSample(format), format, numChannels, numFrames, dst.channel(c) + offset);
+        }
+    }
+
+    SampleEncoder::SampleEncoder(SampleFormat format, Dither dither) noexcept
+        : m_format(format)
+        , m_dither(dither) {
+        reset();
+    }
+
+    SampleFormat SampleEncoder::getFormat() const noexcept {
+        return m_format;
+    }
+
+    Dither SampleEncoder::getDither() const noexcept {
+        return m_dither;
+    }
+
+    void SampleEncoder::reset() noexcept {
+        m_counter = 0;
+        m_error.fill(0.0f);
+    }
+
+    void SampleEncoder::encode(const SoundChunk& src, std::size_t offset, std::size_t numFrames, void* dst) noexcept {
+        assert(offset + numFrames <= SoundChunk::size);
+        const auto n = src.numChannels();
+
+        if (m_format == SampleFormat::Float32){
+            const auto out = static_cast<float*>(dst);
+            for (std::size_t c = 0; c < n; ++c){
+                const auto s = src.channel(c) + offset;
+                for (std::size_t i = 0; i < numFrames; ++i){
+                    out[n * i + c] = clampUnit(s[i]);
+                }
+            }
+            return;
+        }
+
+        if (m_format == SampleFormat::Int16 && n == 2 && m_dither != Dither::NoiseShaped){
+            const auto l = src.channel(0) + offset;
+            const auto r = src.channel(1) + offset;
+            const auto out = static_cast<std::int16_t*>(dst);
+            if (m_dither == Dither::Triangular){
+                quantizeStereoInt16<true>(l, r, numFrames, seed(0), seed(1), out);
+            } else {
+                quantizeStereoInt16<false>(l, r, numFrames, 0, 0, out);
+            }
+            m_counter += static_cast<std::uint32_t>(numFrames);
+            return;
+        }
+
+        // Otherwise, each channel is quantized into a contiguous
+        // buffer, which is then interleaved into the output
+        alignas(SoundChunk::alignment) std::int32_t q[SoundChunk::size];
+        for (std::size_t c = 0; c < n; ++c){
+            const auto s = src.channel(c) + offset;
+            switch (m_format){
+            case SampleFormat::Int16: {
+                quantize(s, numFrames, int16Scale, c, q);
+                const auto out = static_cast<std::int16_t*>(dst);
+                for (std::size_t i = 0; i < numFrames; ++i){
+                    out[n * i + c] = static_cast<std::int16_t>(q[i]);
+                }
+                break;
+            }
+            case SampleFormat::Int24: {
+                quantize(s, numFrames, int24Scale, c, q);
+                const auto out = static_cast<unsigned char*>(dst);
+                for (std::size_t i = 0; i < numFrames; ++i){
+                    const auto u = static_cast<std::uint32_t>(q[i]);
+                    const auto p = out + 3 * (n * i + c);
+                    p[0] = static_cast<unsigned char>(u & 0xff);
+                    p[1] = static_cast<unsigned char>((u >> 8) & 0xff);
+                    p[2] = static_cast<unsigned char>((u >> 16) & 0xff);
+                }
+                break;
+            }
+            case SampleFormat::Int32: {
+                quantizeInt32(s, numFrames, q);
+                const auto out = static_cast<std::int32_t*>(dst);
+                for (std::size_t i = 0; i < numFrames; ++i){
+                    out[n * i + c] = q[i];
+                }
+                break;
+            }
+            case SampleFormat::Float32:
+                break;
+            }
+        }
+        m_counter += static_cast<std::uint32_t>(numFrames);
+    }
+
+    std::uint32_t SampleEncoder::seed(std::size_t channel) const noexcept {
+        // Every channel uses its own part of the noise sequence, so that
+        // the dither is uncorrelated between channels
+        return m_counter + static_cast<std::uint32_t>(channel) * 0x9e3779b9u;
+    }
+
+    void SampleEncoder::quantize(const float* src, std::size_t count, float fullScale, std::size_t channel, std::int32_t* dst) noexcept {
+        if (m_dither == Dither::None){
+            quantizeChannel<false>(src, count, fullScale, 0, dst);
+            return;
+        }
+
+        if (m_dither == Dither::Triangular){
+            quantizeChannel<true>(src, count, fullScale, seed(channel), dst);
+            return;
+        }
+
+        assert(m_dither == Dither::NoiseShaped);
+        assert(channel < m_error.size());
+        // NOTE: the error feedback makes every sample depend on the previous
+        // one, so this loop can't be vectorized. The input is clamped first,
+        // since the error of a clipped sample would otherwise grow without bound.
+        const auto s = seed(channel);
+        auto e = m_error[channel];
+        for (std::size_t i = 0; i < count; ++i){
+            const auto v = clampUnit(src[i]) * fullScale - e;
+            const auto q = roundToInt(v + triangular(s + static_cast<std::uint32_t>(i)), fullScale);
+            e = static_cast<float>(q) - v;
+            dst[i] = q;
+        }
+        m_error[channel] = e;
+    }
+
+} // namespace flo
@@ -1,9 +1,30 @@
 #include <Flosion/Core/Signal.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <mutex>
 
 namespace flo {
 
+    namespace {
+
+        // The signals which may have deferred events. Signals which are
+        // unregistered during delivery are replaced by null until the
+        // end of delivery, since they are being iterated over.
+        struct DeferredRegistry {
+            std::recursive_mutex mutex;
+            std::vector<SignalBase*> signals;
+            bool delivering = false;
+            bool hasRemovedSignals = false;
+        };
+
+        DeferredRegistry& deferredRegistry(){
+            static DeferredRegistry r;
+            return r;
+        }
+
+    } // anonymous namespace
+
     Connection::Connection()
         : m_signal(nullptr) {
             
@@ -38,4 +59,44 @@ namespace flo {
         }
     }
 
+    void SignalBase::registerDeferred(SignalBase* s){
+        auto& r = deferredRegistry();
+        auto lock = std::lock_guard{r.mutex};
+        assert(std::find(r.signals.begin(), r.signals.end(), s) == r.signals.end());
+        r.signals.push_back(s);
+    }
+
+    void SignalBase::unregisterDeferred(SignalBase* s){
+        auto& r = deferredRegistry();
+        auto lock = std::lock_guard{r.mutex};
+        auto it = std::find(r.signals.begin(), r.signals.end(), s);
+        assert(it != r.signals.end());
+        if (r.delivering){
+            *it = nullptr;
+            r.hasRemovedSignals = true;
+        } else {
+            r.signals.erase(it);
+        }
+    }
+
+    void deliverDeferredSignals(){
+        auto& r = deferredRegistry();
+        auto lock = std::lock_guard{r.mutex};
+        assert(!r.delivering);
+        r.delivering = true;
+        // NOTE: signals registered by a handler are added past the end
+        // and are first visited by the next delivery
+        const auto n = r.signals.size();
+        for (std::size_t i = 0; i < n; ++i){
+            if (auto s = r.signals[i]){
+                s->deliverDeferred();
+            }
+        }
+        r.delivering = false;
+        if (r.hasRemovedSignals){
+            r.signals.erase(std::remove(r.signals.begin(), r.signals.end(), nullptr), r.signals.end());
+            r.hasRemovedSignals = false;
+        }
+    }
+
 } // namespace flo
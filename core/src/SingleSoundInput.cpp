@@ -1,4 +1,5 @@
 #include <Flosion/Core/SingleSoundInput.hpp>
+#include <Flosion/Core/RenderContext.hpp>
 #include <Flosion/Core/SoundSource.hpp>
 
 #include <cassert>
@@ -21,7 +22,9 @@ namespace flo {
     void SingleSoundInput::getNextChunkFor(SoundChunk& chunk, const SoundNode* node, const SoundState* state){
         assert(node->hasDirectDependency(this));
         if (getSource()){
-            getSource()->getNextChunkFor(chunk, this, getState(node, state));
+            const auto ownState = getState(node, state);
+            auto scope = RenderContext::Scope{this, ownState};
+            getSource()->getNextChunkFor(chunk, this, ownState);
         } else {
             chunk.silence();
         }
@@ -1,57 +1,241 @@
 #include <Flosion/Core/SoundChunk.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <new>
+#include <utility>
 
 namespace flo {
 
-    SoundChunk::SoundChunk() noexcept 
-        : m_data{} {
+    // NOTE: the bulk operations below loop over each channel through
+    // restrict-qualified pointers, so that compilers are free to vectorize
+    // them without checking whether the source and destination overlap.
 
+    namespace {
+
+        void mixChannel(float* __restrict dst, const float* __restrict src, float gain, std::size_t count) noexcept {
+            for (std::size_t i = 0; i < count; ++i){
+                dst[i] += src[i] * gain;
+            }
+        }
+
+    } // anonymous namespace
+
+    SoundChunk::SoundChunk(std::size_t numChannels)
+        : m_numChannels(numChannels)
+        , m_data(numChannels > maxInlineChannels ? allocate(numChannels) : m_inline) {
+        assert(numChannels > 0);
+        silence();
+    }
+
+    SoundChunk::SoundChunk(const SoundChunk& other)
+        : m_numChannels(other.m_numChannels)
+        , m_data(other.isInline() ? m_inline : allocate(other.m_numChannels)) {
+        std::copy(other.m_data, other.m_data + m_numChannels * size, m_data);
+    }
+
+    SoundChunk::SoundChunk(SoundChunk&& other) noexcept
+        : m_numChannels(other.m_numChannels)
+        , m_data(m_inline) {
+        if (other.isInline()){
+            std::copy(other.m_data, other.m_data + m_numChannels * size, m_data);
+        } else {
+            // NOTE: the other chunk is left as a silent stereo chunk
+            m_data = std::exchange(other.m_data, other.m_inline);
+            other.m_numChannels = channels::stereo;
+            other.silence();
+        }
+    }
+
+    SoundChunk& SoundChunk::operator=(const SoundChunk& other){
+        copyFrom(other);
+        return *this;
+    }
+
+    SoundChunk& SoundChunk::operator=(SoundChunk&& other) noexcept {
+        if (&other == this){
+            return *this;
+        }
+        if (other.isInline()){
+            useInline(other.m_numChannels);
+            std::copy(other.m_data, other.m_data + m_numChannels * size, m_data);
+        } else {
+            useInline(channels::stereo);
+            m_data = std::exchange(other.m_data, other.m_inline);
+            m_numChannels = std::exchange(other.m_numChannels, channels::stereo);
+            other.silence();
+        }
+        return *this;
+    }
+
+    SoundChunk::~SoundChunk() noexcept {
+        if (!isInline()){
+            deallocate(m_data);
+        }
+    }
+
+    std::size_t SoundChunk::numChannels() const noexcept {
+        return m_numChannels;
+    }
+
+    void SoundChunk::setNumChannels(std::size_t n){
+        if (n == m_numChannels){
+            return;
+        }
+        if (n <= maxInlineChannels){
+            useInline(n);
+        } else {
+            const auto newData = allocate(n);
+            useInline(channels::stereo);
+            m_data = newData;
+            m_numChannels = n;
+        }
+        silence();
     }
 
     float& SoundChunk::l(size_t i) noexcept {
-        assert(2 * i < m_data.size());
-        return m_data[2 * i + 0];
+        assert(i < size);
+        return channel(0)[i];
     }
 
     const float& SoundChunk::l(size_t i) const noexcept {
-        assert(2 * i < m_data.size());
-        return m_data[2 * i + 0];
+        assert(i < size);
+        return channel(0)[i];
     }
 
     float& SoundChunk::r(size_t i) noexcept {
-        assert(2 * i + 1 < m_data.size());
-        return m_data[2 * i + 1];
+        assert(i < size);
+        return channel(m_numChannels > 1 ? 1 : 0)[i];
     }
 
     const float& SoundChunk::r(size_t i) const noexcept {
-        assert(2 * i + 1 < m_data.size());
-        return m_data[2 * i + 1];
+        assert(i < size);
+        return channel(m_numChannels > 1 ? 1 : 0)[i];
     }
 
     SampleProxy SoundChunk::operator[](size_t i) noexcept {
-        assert(2 * i + 1 < m_data.size());
-        return SampleProxy{&m_data[2 * i]};
+        return SampleProxy{&l(i), &r(i)};
     }
     ConstSampleProxy SoundChunk::operator[](size_t i) const noexcept {
-        assert(2 * i + 1 < m_data.size());
-        return ConstSampleProxy{&m_data[2 * i]};
+        return ConstSampleProxy{&l(i), &r(i)};
     }
 
     SampleProxy SoundChunk::at(size_t i){
-        assert(2 * i + 1 < m_data.size());
-        return SampleProxy{&m_data[2 * i]};
+        return SampleProxy{&l(i), &r(i)};
     }
 
     ConstSampleProxy SoundChunk::at(size_t i) const {
-        assert(2 * i + 1 < m_data.size());
-        return ConstSampleProxy{&m_data[2 * i]};
+        return ConstSampleProxy{&l(i), &r(i)};
+    }
+
+    float* SoundChunk::channel(size_t c) noexcept {
+        assert(c < m_numChannels);
+        return m_data + c * size;
+    }
+
+    const float* SoundChunk::channel(size_t c) const noexcept {
+        assert(c < m_numChannels);
+        return m_data + c * size;
     }
 
     void SoundChunk::silence() noexcept {
-        for (auto& v : m_data){
-            v = 0.0f;
+        std::fill(m_data, m_data + m_numChannels * size, 0.0f);
+    }
+
+    void SoundChunk::copyFrom(const SoundChunk& other){
+        if (&other == this){
+            return;
+        }
+        setNumChannels(other.m_numChannels);
+        std::copy(other.m_data, other.m_data + m_numChannels * size, m_data);
+    }
+
+    void SoundChunk::spreadChannel(size_t c) noexcept {
+        const auto src = channel(c);
+        for (size_t d = 0; d < m_numChannels; ++d){
+            if (d != c){
+                std::copy(src, src + size, channel(d));
+            }
+        }
+    }
+
+    void SoundChunk::mixAdd(const SoundChunk& other, float gain) noexcept {
+        if (&other == this){
+            scale(1.0f + gain);
+            return;
+        }
+        if (m_numChannels == other.m_numChannels){
+            // the channels are adjacent, so they can all be mixed in one loop
+            mixChannel(m_data, other.m_data, gain, m_numChannels * size);
+            return;
+        }
+        mixAdd(other, gain, 0, 0, size);
+    }
+
+    void SoundChunk::mixAdd(const SoundChunk& other, float gain, size_t srcOffset, size_t dstOffset, size_t count) noexcept {
+        assert(srcOffset + count <= size);
+        assert(dstOffset + count <= size);
+        assert(&other != this);
+        if (other.m_numChannels == 1){
+            const auto src = other.channel(0) + srcOffset;
+            for (size_t c = 0; c < m_numChannels; ++c){
+                mixChannel(channel(c) + dstOffset, src, gain, count);
+            }
+        } else if (m_numChannels == 1){
+            const auto g = gain / static_cast<float>(other.m_numChannels);
+            const auto dst = channel(0) + dstOffset;
+            for (size_t c = 0; c < other.m_numChannels; ++c){
+                mixChannel(dst, other.channel(c) + srcOffset, g, count);
+            }
+        } else {
+            const auto n = std::min(m_numChannels, other.m_numChannels);
+            for (size_t c = 0; c < n; ++c){
+                mixChannel(channel(c) + dstOffset, other.channel(c) + srcOffset, gain, count);
+            }
+        }
+    }
+
+    void SoundChunk::scale(float gain) noexcept {
+        float* __restrict dst = m_data;
+        for (size_t i = 0, iEnd = m_numChannels * size; i < iEnd; ++i){
+            dst[i] *= gain;
+        }
+    }
+
+    void SoundChunk::clamp(float lo, float hi) noexcept {
+        assert(lo <= hi);
+        float* __restrict dst = m_data;
+        for (size_t i = 0, iEnd = m_numChannels * size; i < iEnd; ++i){
+            // NOTE: written without std::clamp, whose reference-returning
+            // form tends to prevent vectorization
+            const auto v = dst[i];
+            dst[i] = v < lo ? lo : (v > hi ? hi : v);
+        }
+    }
+
+    float* SoundChunk::allocate(std::size_t numChannels){
+        assert(numChannels > maxInlineChannels);
+        assert(numChannels <= maxChannels);
+        const auto bytes = numChannels * size * sizeof(float);
+        return static_cast<float*>(operator new(bytes, std::align_val_t{alignment}));
+    }
+
+    void SoundChunk::deallocate(float* data) noexcept {
+        operator delete(data, std::align_val_t{alignment});
+    }
+
+    bool SoundChunk::isInline() const noexcept {
+        return m_data == m_inline;
+    }
+
+    void SoundChunk::useInline(std::size_t numChannels) noexcept {
+        assert(numChannels > 0);
+        assert(numChannels <= maxInlineChannels);
+        if (!isInline()){
+            deallocate(m_data);
+            m_data = m_inline;
         }
+        m_numChannels = numChannels;
     }
 
 } // namespace flo
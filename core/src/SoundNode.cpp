@@ -1,5 +1,6 @@
 #include <Flosion/Core/SoundNode.hpp>
 
+#include <Flosion/Core/Network.hpp>
 #include <Flosion/Core/SoundResult.hpp>
 
 #include <algorithm>
@@ -8,11 +9,66 @@
 
 namespace flo {
 
+    namespace {
+
+        // Returns true if the given dependent would still depend (directly or
+        // indirectly) on the given dependency if the direct dependency of
+        // `from` on `to` was removed
+        bool wouldStillDependOn(const SoundNode* dependent, const SoundNode* dependency, const SoundNode* from, const SoundNode* to){
+            if (!dependent->hasDependency(dependency)){
+                return false;
+            }
+            // Only the nodes which depend on `from` are searched any further,
+            // since for all others, nothing changes
+            auto stack = std::vector<const SoundNode*>{dependent};
+            auto visited = std::set<const SoundNode*>{dependent};
+            while (!stack.empty()){
+                const auto n = stack.back();
+                stack.pop_back();
+                if (n == dependency || !n->hasDependency(from)){
+                    return true;
+                }
+                for (const auto& d : n->getDirectDependencies()){
+                    if (n == from && d == to){
+                        continue;
+                    }
+                    if (d->hasDependency(dependency) && visited.insert(d).second){
+                        stack.push_back(d);
+                    }
+                }
+            }
+            return false;
+        }
+
+        Network* networkFor(Network* network) noexcept {
+            return network ? network : Network::getConstructingNetwork();
+        }
+
+        StateArena* arenaFor(Network* network) noexcept {
+            const auto n = networkFor(network);
+            return n ? &n->getStateArena() : nullptr;
+        }
+
+    } // anonymous namespace
+
     SoundNode::SoundNode(Network* network)
-        : StateTable(this)
-        , m_network(network)
-        , m_initDone(false) {
+        : StateTable(this, arenaFor(network))
+        , m_network(networkFor(network))
+        , m_initDone(Network::getConstructingNetwork() == nullptr) {
 
+        if (m_network){
+            m_network->addNode(this);
+        }
+    }
+
+    SoundNode::~SoundNode(){
+        if (m_network){
+            m_network->removeNode(this);
+        }
+    }
+
+    Network* SoundNode::getNetwork() const noexcept {
+        return m_network;
     }
 
     bool SoundNode::canAddDependency(const SoundNode* node) const noexcept {
@@ -66,25 +122,11 @@ namespace flo {
             return false;
         }
 
-        std::function<bool(const SoundNode*, const SoundNode*)> wouldStillHaveDependency = [&](const SoundNode* dt, const SoundNode* dc){
-            if (dt == dc){
-                return true;
-            }
-            for (const auto& dtdc : dt->getDirectDependencies()){
-                if (!(dt == this && dtdc == node)){
-                    if (wouldStillHaveDependency(dtdc, dc)){
-                        return true;
-                    }
-                }
-            }
-            return false;
-        };
-
         for (const auto& dc : node->getAllDependencies()){
             for (const auto& dcnn : dc->getNumberNodes()){
                 for (const auto& nndc : dcnn->getAllDependencies()){
                     if (const auto sn = nndc->getStateOwner()){
-                        if (!wouldStillHaveDependency(sn, dc)){
+                        if (!wouldStillDependOn(sn, dc, this, node)){
                             return false;
                         }
                     }
@@ -97,30 +139,20 @@ namespace flo {
 
     void SoundNode::afterDependencyAdded(SoundNode* node){
         node->addDependentOffset(this);
+        if (m_deferringNetwork){
+            // The dependencies of a deferred node are always deferred too
+            m_deferringNetwork->deferStates(node);
+        } else if (node->m_deferringNetwork){
+            node->m_deferringNetwork->suspendResults(this);
+        }
         if (numSlots() > 0){
             node->insertDependentStates(this, 0, numSlots());
-            node->repointStatesFor(this);
         }
     }
 
     void SoundNode::beforeDependencyRemoved(SoundNode* nodeToRemove){
         // If any number nodes belonging to any dependencies of the given
         // node would lose access to their state, break their connections
-        
-        std::function<bool(const SoundNode*, const SoundNode*)> wouldStillHaveAccess = [&](const SoundNode* dc, const SoundNode* dt){
-            if (dc == dt){
-                return true;
-            }
-            for (const auto& ddt : dc->getDirectDependents()){
-                if (dc == nodeToRemove && ddt == this){
-                    continue;
-                }
-                if (wouldStillHaveAccess(ddt, dt)){
-                    return true;
-                }
-            }
-            return false;
-        };
 
         // NOTE: connections to break are cached to avoid modifying
         // containers while iterating over them
@@ -133,7 +165,7 @@ namespace flo {
                     for (const auto& dcniddc : dcni->getDirectDependencies()){
                         for (const auto& dcnidc : dcniddc->getAllDependencies()){
                             if (auto dcnidcso = dcnidc->getStateOwner()){
-                                if (!wouldStillHaveAccess(dc, dcnidcso)){
+                                if (!wouldStillDependOn(dcnidcso, dc, this, nodeToRemove)){
                                     assert(dcni->hasDirectDependency(dcniddc));
                                     toDisconnect.insert({dcni, dcniddc});
                                 }
@@ -184,6 +216,10 @@ namespace flo {
     const SoundInput* SoundNode::toSoundInput() const noexcept {
         return nullptr;
     }
+
+    void SoundNode::reseed(std::uint64_t) noexcept {
+        // Nothing to do
+    }
     
     SoundNode::Lock::Lock(std::vector<std::unique_lock<RecursiveSharedMutex>> locks) noexcept
         : m_locks(std::move(locks)) {
@@ -222,6 +258,10 @@ namespace flo {
     }
 
     void SoundNode::initLater(std::function<void()> f) {
+        if (m_initDone){
+            f();
+            return;
+        }
         m_initLaterFunctions.emplace_back(std::move(f));
     }
 
@@ -269,8 +309,8 @@ namespace flo {
         setStateOwner(m_owner);
     }
 
-    double CurrentTime::evaluate(const SoundState* context) const noexcept {
-        return context->getElapsedTimeAt(m_owner);
+    Number CurrentTime::evaluate(const SoundState* context) const noexcept {
+        return static_cast<Number>(context->getElapsedTimeAt(m_owner));
     }
 
 } // namespace flo
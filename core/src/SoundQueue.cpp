@@ -31,8 +31,7 @@ namespace flo {
         }
         m_index = (m_index + nSamples) % m_data.size();
         while ((m_front + SoundChunk::size) % m_data.size() <= m_index){
-            SoundChunk ch;
-            for (std::size_t i = 0; i < ch.size; ++i){
+            for (std::size_t i = 0; i < SoundChunk::size; ++i){
                 m_data[m_front].silence();
                 ++m_front;
             }
@@ -45,10 +44,9 @@ namespace flo {
         }
         m_index = (m_index + nSamples) % m_data.size();
         while ((m_front + SoundChunk::size) % m_data.size() <= m_index){
-            SoundChunk ch;
-            input.getNextChunkFor(ch, target, state);
-            for (std::size_t i = 0; i < ch.size; ++i){
-                m_data[m_front] = ch[i];
+            input.getNextChunkFor(m_chunk, target, state);
+            for (std::size_t i = 0; i < SoundChunk::size; ++i){
+                m_data[m_front] = m_chunk[i];
                 ++m_front;
             }
         }
@@ -1,24 +1,119 @@
 #include <Flosion/Core/SoundResult.hpp>
 
+#include <Flosion/Core/Network.hpp>
+#include <Flosion/Core/NumberNode.hpp>
+#include <Flosion/Util/RNG.hpp>
+
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <functional>
+#include <set>
 
 namespace flo {
 
     SoundResult::SoundResult()
-        : m_input(this) {
+        : m_input(this)
+        , m_numChannels(channels::stereo)
+        , m_suspended(false)
+        , m_destroying(false) {
+
+        initLater([this](){
+            StateTable::enableMonostate();
+        });
+    }
 
-        // TODO: AAAAAAAAAAaaaaaa hack!
-        StateTable::enableMonostate();
+    SoundResult::~SoundResult(){
+        // NOTE: the input is disconnected after the mutex is destroyed,
+        // which may cause a network in a transaction to lock it again
+        m_destroying = true;
+        for (const auto& n : m_suspendingNetworks){
+            n->forgetSuspended(this);
+        }
     }
 
     void SoundResult::getNextChunk(SoundChunk& chunk){
-        // Acquire read lock to prevent race conditions
-        auto lock = std::shared_lock{m_mutex};
-        m_input.getNextChunkFor(chunk, this, getMonoState());
+        const auto start = std::chrono::steady_clock::now();
+        {
+            // Acquire read lock to prevent race conditions
+            auto lock = std::shared_lock{m_mutex};
+            chunk.setNumChannels(m_numChannels.load(std::memory_order_relaxed));
+            if (m_suspended.load(std::memory_order_relaxed)){
+                chunk.silence();
+            } else {
+                m_input.getNextChunkFor(chunk, this, getMonoState());
+            }
+        }
+        m_deadlineMonitor.record(std::chrono::steady_clock::now() - start);
+    }
+
+    void SoundResult::setNumChannels(std::size_t n) noexcept {
+        assert(n > 0 && n <= SoundChunk::maxChannels);
+        m_numChannels.store(n, std::memory_order_relaxed);
+    }
+
+    std::size_t SoundResult::getNumChannels() const noexcept {
+        return m_numChannels.load(std::memory_order_relaxed);
     }
 
     void SoundResult::reset(){
-        m_input.resetStateFor(this, getMonoState());
+        if (m_deterministicSeed){
+            reseedUpstream(*m_deterministicSeed);
+        }
+        // NOTE: the deferred states of a suspended sound result are
+        // rebuilt from fresh states anyway
+        if (!isSuspended()){
+            m_input.resetStateFor(this, getMonoState());
+        }
+    }
+
+    void SoundResult::enableDeterministicMode(std::uint64_t seed){
+        m_deterministicSeed = seed;
+        reset();
+    }
+
+    void SoundResult::disableDeterministicMode() noexcept {
+        m_deterministicSeed.reset();
+    }
+
+    bool SoundResult::isDeterministic() const noexcept {
+        return m_deterministicSeed.has_value();
+    }
+
+    void SoundResult::reseedUpstream(std::uint64_t seed){
+        auto lock = std::unique_lock{m_mutex};
+
+        // NOTE: the nodes are numbered in depth-first order of their
+        // dependencies, which unlike their addresses is the same every
+        // time the same network is built
+        std::uint64_t index = 0;
+        auto visitedSoundNodes = std::set<const SoundNode*>{};
+        auto visitedNumberNodes = std::set<const NumberNode*>{};
+
+        std::function<void(NumberNode*)> visitNumberNode = [&](NumberNode* nn){
+            if (!visitedNumberNodes.insert(nn).second){
+                return;
+            }
+            nn->reseed(util::CounterRNG::keyFor(seed, index++));
+            for (const auto& d : nn->getDirectDependencies()){
+                visitNumberNode(d);
+            }
+        };
+
+        std::function<void(SoundNode*)> visitSoundNode = [&](SoundNode* sn){
+            if (!visitedSoundNodes.insert(sn).second){
+                return;
+            }
+            sn->reseed(util::CounterRNG::keyFor(seed, index++));
+            for (const auto& nn : sn->getNumberNodes()){
+                visitNumberNode(nn);
+            }
+            for (const auto& d : sn->getDirectDependencies()){
+                visitSoundNode(d);
+            }
+        };
+
+        visitSoundNode(this);
     }
 
     void SoundResult::setSource(SoundSource* source) noexcept {
@@ -33,8 +128,35 @@ namespace flo {
         return m_input;
     }
 
+    bool SoundResult::isSuspended() const noexcept {
+        return m_suspended.load(std::memory_order_relaxed);
+    }
+
+    DeadlineMonitor& SoundResult::getDeadlineMonitor() noexcept {
+        return m_deadlineMonitor;
+    }
+
+    const DeadlineMonitor& SoundResult::getDeadlineMonitor() const noexcept {
+        return m_deadlineMonitor;
+    }
+
+    void SoundResult::suspend(Network* network){
+        assert(std::count(m_suspendingNetworks.begin(), m_suspendingNetworks.end(), network) == 0);
+        m_suspendingNetworks.push_back(network);
+        m_suspended.store(true, std::memory_order_relaxed);
+    }
+
+    void SoundResult::resume(Network* network) noexcept {
+        auto it = std::find(m_suspendingNetworks.begin(), m_suspendingNetworks.end(), network);
+        assert(it != m_suspendingNetworks.end());
+        m_suspendingNetworks.erase(it);
+        m_suspended.store(!m_suspendingNetworks.empty(), std::memory_order_relaxed);
+    }
+
     void SoundResult::findDependentSoundResults(std::vector<SoundResult*>& soundResults) noexcept {
-        soundResults.push_back(this);
+        if (!m_destroying){
+            soundResults.push_back(this);
+        }
         assert(getDirectDependents().size() == 0);
     }
 
@@ -4,7 +4,7 @@
 
 namespace flo {
 
-    SoundNumberInput::SoundNumberInput(SoundNode* owner, double defaultValue) noexcept
+    SoundNumberInput::SoundNumberInput(SoundNode* owner, Number defaultValue) noexcept
         : NumberInput(defaultValue) {
         setStateOwner(owner);
     }
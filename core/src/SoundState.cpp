@@ -11,7 +11,9 @@ namespace flo {
         : m_owner(owner)
         , m_dependentState(dependentState)
         , m_coarseTime(0)
-        , m_fineTime(0) {
+        , m_fineTime(0)
+        , m_timeCacheNodes{}
+        , m_timeCacheSpeeds{} {
     
     }
 
@@ -28,20 +30,44 @@ namespace flo {
     }
 
     double SoundState::getElapsedTimeAt(const SoundNode* node) const noexcept {
+        assert(node);
+        auto i = std::size_t{0};
+        while (i < timeCacheSize && m_timeCacheNodes[i] != node){
+            ++i;
+        }
+        if (i == timeCacheSize){
+            // Evict the least recently used entry
+            i = timeCacheSize - 1;
+            m_timeCacheNodes[i] = node;
+            m_timeCacheSpeeds[i] = computeTimeSpeedTo(node);
+        }
+        // Move the entry to the front
+        const auto speed = m_timeCacheSpeeds[i];
+        for (; i > 0; --i){
+            m_timeCacheNodes[i] = m_timeCacheNodes[i - 1];
+            m_timeCacheSpeeds[i] = m_timeCacheSpeeds[i - 1];
+        }
+        m_timeCacheNodes[0] = node;
+        m_timeCacheSpeeds[0] = speed;
+
+        const auto base = static_cast<double>(m_coarseTime);
+        const auto offset = static_cast<double>(m_fineTime) * speed;
+        return (base + offset) / static_cast<double>(Sample::frequency);
+    }
+
+    double SoundState::computeTimeSpeedTo(const SoundNode* node) const noexcept {
         auto curr = this;
-        auto base = static_cast<double>(m_coarseTime);
-        auto offset = static_cast<double>(m_fineTime);
+        auto speed = 1.0;
         while (curr){
             auto owner = curr->getOwner();
             if (owner == node){
-                const auto elapsed = (base + offset) / static_cast<double>(Sample::frequency);
-                return elapsed;
+                return speed;
             }
-            offset *= owner->getTimeSpeed(curr);
+            speed *= owner->getTimeSpeed(curr);
             curr = curr->getDependentState();
         }
         assert(false);
-        return 0.0;
+        return speed;
     }
 
     void SoundState::adjustTime(std::uint32_t offset){
@@ -51,6 +77,19 @@ namespace flo {
     void SoundState::resetTime(){
         m_coarseTime = 0;
         m_fineTime = 0;
+        clearTimeCache();
+    }
+
+    void SoundState::setDependentState(const SoundState* s) noexcept {
+        m_dependentState = s;
+        // The chain of states above this one may have changed
+        clearTimeCache();
+    }
+
+    void SoundState::clearTimeCache() noexcept {
+        for (auto& n : m_timeCacheNodes){
+            n = nullptr;
+        }
     }
 
     void EmptySoundState::reset() noexcept {
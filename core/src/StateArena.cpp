@@ -0,0 +1,127 @@
+#include <Flosion/Core/StateArena.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+namespace flo {
+
+    StateArena::StateArena()
+        : m_bytesReserved(0) {
+        m_nextBlock.fill(nullptr);
+        m_pageEnd.fill(nullptr);
+    }
+
+    StateArena::~StateArena(){
+        reset();
+    }
+
+    void* StateArena::allocate(std::size_t size, std::size_t align){
+        // make sure that align is a power of 2
+        assert(align != 0 && (align & (align - 1)) == 0);
+
+        auto lock = std::lock_guard{m_mutex};
+
+        // Blocks are aligned to their own size, so a block
+        // at least as large as the alignment will do
+        const auto blockSize = std::max(size, align);
+
+        if (blockSize > maxBlockSize){
+            const auto ptr = operator new(size, std::align_val_t{align});
+            m_largeBlocks.emplace(ptr, LargeBlock{size, align});
+            m_bytesReserved += size;
+            return ptr;
+        }
+
+        const auto sc = sizeClassFor(blockSize);
+
+        // reuse a freed block if possible
+        auto& freeBlocks = m_freeBlocks[sc];
+        if (!freeBlocks.empty()){
+            const auto ptr = freeBlocks.back();
+            freeBlocks.pop_back();
+            return ptr;
+        }
+
+        // otherwise take the next block of the current page
+        if (m_nextBlock[sc] != m_pageEnd[sc]){
+            const auto ptr = m_nextBlock[sc];
+            m_nextBlock[sc] += minBlockSize << sc;
+            return ptr;
+        }
+
+        return allocateFromNewPage(sc);
+    }
+
+    void StateArena::deallocate(void* ptr) noexcept {
+        if (!ptr){
+            return;
+        }
+
+        auto lock = std::lock_guard{m_mutex};
+
+        // Pages are aligned to their size, so the page containing
+        // any small block is found by rounding its address down
+        const auto addr = reinterpret_cast<std::uintptr_t>(ptr);
+        const auto page = reinterpret_cast<const unsigned char*>(addr - (addr % pageSize));
+        if (auto it = m_pages.find(page); it != m_pages.end()){
+            m_freeBlocks[it->second].push_back(static_cast<unsigned char*>(ptr));
+            return;
+        }
+
+        auto it = m_largeBlocks.find(ptr);
+        assert(it != m_largeBlocks.end());
+        operator delete(ptr, std::align_val_t{it->second.align});
+        m_bytesReserved -= it->second.size;
+        m_largeBlocks.erase(it);
+    }
+
+    void StateArena::reset() noexcept {
+        auto lock = std::lock_guard{m_mutex};
+        for (auto& fb : m_freeBlocks){
+            fb.clear();
+        }
+        m_nextBlock.fill(nullptr);
+        m_pageEnd.fill(nullptr);
+        for (const auto& p : m_pages){
+            operator delete(const_cast<unsigned char*>(p.first), std::align_val_t{pageSize});
+        }
+        m_pages.clear();
+        for (const auto& b : m_largeBlocks){
+            operator delete(b.first, std::align_val_t{b.second.align});
+        }
+        m_largeBlocks.clear();
+        m_bytesReserved = 0;
+    }
+
+    std::size_t StateArena::bytesReserved() const noexcept {
+        auto lock = std::lock_guard{m_mutex};
+        return m_bytesReserved;
+    }
+
+    std::size_t StateArena::sizeClassFor(std::size_t size) noexcept {
+        assert(size <= maxBlockSize);
+        auto sc = std::size_t{0};
+        auto blockSize = minBlockSize;
+        while (blockSize < size){
+            blockSize *= 2;
+            ++sc;
+        }
+        assert(sc < numSizeClasses);
+        return sc;
+    }
+
+    unsigned char* StateArena::allocateFromNewPage(std::size_t sizeClass){
+        const auto blockSize = minBlockSize << sizeClass;
+        const auto page = static_cast<unsigned char*>(operator new(pageSize, std::align_val_t{pageSize}));
+        m_pages.emplace(page, sizeClass);
+        m_bytesReserved += pageSize;
+
+        // the rest of the page is handed out in order of address
+        m_nextBlock[sizeClass] = page + blockSize;
+        m_pageEnd[sizeClass] = page + pageSize;
+        return page;
+    }
+
+} // namespace flo
@@ -1,35 +1,55 @@
 #include <Flosion/Core/StateTable.hpp>
 
+#include <Flosion/Core/Network.hpp>
 #include <Flosion/Core/StateAllocator.hpp>
+#include <Flosion/Core/StateArena.hpp>
 #include <Flosion/Core/SoundNode.hpp>
 #include <Flosion/Core/BorrowingNumberSource.hpp>
 
 #include <algorithm>
 #include <cassert>
+#include <new>
 #include <numeric>
+#include <utility>
 
 namespace flo {
 
-    StateTable::StateTable(SoundNode* owner)
+    namespace {
+        // The number of cells in the first page of a stable-address state table
+        const size_t minCellsPerPage = 4;
+
+        // Pages of a stable-address state table stop growing at this size
+        const size_t maxPageBytes = 64 * 1024;
+
+        // Slots padded to cache lines are aligned to this
+#ifdef __cpp_lib_hardware_interference_size
+        const size_t cacheLineSize = std::hardware_destructive_interference_size;
+#else
+        const size_t cacheLineSize = 64;
+#endif
+    }
+
+    StateTable::StateTable(SoundNode* owner, StateArena* arena)
         : m_owner(owner)
+        , m_arena(arena)
         , m_numDependentStates(0)
         , m_numKeys(0)
         , m_slotSize(static_cast<std::size_t>(-1))
         , m_isMonostate(false)
+        , m_slotStorage(SlotStorage::Contiguous)
+        , m_slotPadding(SlotPadding::None)
+        , m_deferringNetwork(nullptr)
         , m_data(nullptr) {
 
     }
 
     StateTable::~StateTable(){
-        if (!m_data){
+        if (m_deferringNetwork){
+            // NOTE: the slots were already discarded
+            m_deferringNetwork->forgetDeferred(m_owner);
             return;
         }
-
-        for (size_t i = 0, iEnd = m_numDependentStates * m_numKeys; i != iEnd; ++i){
-            destroySlot(m_data + (i * m_slotSize));
-        }
-
-        deallocateData(m_data);
+        discardSlots();
     }
 
     size_t StateTable::getDependentOffset(const SoundNode* dependent) const noexcept {
@@ -93,31 +113,43 @@ namespace flo {
             assert(m_slotSize == static_cast<size_t>(-1));
             assert(m_slotItems.size() == 0);
             m_mainAllocator = makeAllocator();
-            m_slotSize = m_mainAllocator->getSize();
+            m_slotSize = nextAlignedOffset(m_mainAllocator->getSize(), slotAlignment());
         }
         assert(m_mainAllocator);
         return m_mainAllocator.get();
     }
 
     unsigned char* StateTable::allocateData(size_t slotSize, size_t numSlots){
-        const auto align = std::align_val_t{getMainAllocator()->getAlignment()};
+        getMainAllocator();
+        if (m_arena){
+            return static_cast<unsigned char*>(m_arena->allocate(slotSize * numSlots, slotAlignment()));
+        }
+        const auto align = std::align_val_t{slotAlignment()};
         void* ptr = operator new(slotSize * numSlots, align);
         return static_cast<unsigned char*>(ptr);
     }
 
     void StateTable::deallocateData(unsigned char* ptr){
+        getMainAllocator();
+        deallocateData(ptr, slotAlignment());
+    }
+
+    void StateTable::deallocateData(unsigned char* ptr, size_t align){
         if (ptr == nullptr){
             return;
         }
-        const auto align = std::align_val_t{getMainAllocator()->getAlignment()};
-        operator delete(static_cast<void*>(ptr), align);
+        if (m_arena){
+            m_arena->deallocate(ptr);
+            return;
+        }
+        operator delete(static_cast<void*>(ptr), std::align_val_t{align});
     }
 
-    void StateTable::constructSlot(unsigned char* where){
-        getMainAllocator()->construct(where, m_owner, nullptr);
+    void StateTable::constructSlot(unsigned char* where, const SoundState* dependentState){
+        getMainAllocator()->construct(where, m_owner, dependentState);
         for (auto& slot : m_slotItems){
             assert(slot.offset != static_cast<size_t>(-1));
-            slot.allocator->construct(where + slot.offset, m_owner, nullptr);
+            slot.allocator->construct(where + slot.offset, m_owner, dependentState);
         }
     }
 
@@ -138,6 +170,30 @@ namespace flo {
         destroySlot(from);
     }
 
+    void StateTable::constructSlots(unsigned char* where, size_t count, const SoundState* dependentState){
+        getMainAllocator()->constructN(where, m_slotSize, count, m_owner, dependentState);
+        for (auto& slot : m_slotItems){
+            assert(slot.offset != static_cast<size_t>(-1));
+            slot.allocator->constructN(where + slot.offset, m_slotSize, count, m_owner, dependentState);
+        }
+    }
+
+    void StateTable::destroySlots(unsigned char* where, size_t count){
+        getMainAllocator()->destroyN(where, m_slotSize, count);
+        for (auto& slot : m_slotItems){
+            assert(slot.offset != static_cast<size_t>(-1));
+            slot.allocator->destroyN(where + slot.offset, m_slotSize, count);
+        }
+    }
+
+    void StateTable::moveSlots(unsigned char* from, unsigned char* to, size_t count){
+        getMainAllocator()->moveN(to, from, m_slotSize, m_slotSize, count);
+        for (auto& slot : m_slotItems){
+            assert(slot.offset != static_cast<size_t>(-1));
+            slot.allocator->moveN(to + slot.offset, from + slot.offset, m_slotSize, m_slotSize, count);
+        }
+    }
+
     void StateTable::resetSlot(unsigned char* where){
         auto ss = reinterpret_cast<SoundState*>(where);
         ss->reset();
@@ -178,6 +234,10 @@ namespace flo {
     }
 
     void StateTable::repointStatesFor(const SoundNode* dependent) noexcept {
+        // NOTE: deferred slots are pointed to their dependent states when rebuilt
+        if (m_deferringNetwork){
+            return;
+        }
         for (const auto& dto : m_dependentOffsets){
             if (dto.dependent != dependent){
                 continue;
@@ -188,7 +248,7 @@ namespace flo {
             for (size_t i = 0; i < dto.count; ++i){
                 const auto dependentState = dependent->getState(i);
                 for (size_t k = 0; k < numKeys(); ++k){
-                    getState(dto.offset + (i * numKeys()) + k)->m_dependentState = dependentState;
+                    getState(dto.offset + (i * numKeys()) + k)->setDependentState(dependentState);
                 }
             }
             return;
@@ -196,6 +256,118 @@ namespace flo {
         assert(false);
     }
 
+    size_t StateTable::slotAlignment() const noexcept {
+        assert(m_mainAllocator);
+        const auto align = m_mainAllocator->getAlignment();
+        if (m_slotPadding == SlotPadding::CacheLine){
+            return std::max(align, cacheLineSize);
+        }
+        return align;
+    }
+
+    size_t StateTable::cellHeaderSize() const noexcept {
+        const auto align = slotAlignment();
+        assert(align >= alignof(size_t));
+        return nextAlignedOffset(sizeof(size_t), align);
+    }
+
+    size_t StateTable::cellSize() const noexcept {
+        return cellHeaderSize() + m_slotSize;
+    }
+
+    unsigned char* StateTable::allocateStableSlot(){
+        assert(m_slotStorage == SlotStorage::StableAddress);
+        if (m_freeSlots.empty()){
+            const auto cs = cellSize();
+            const auto maxCells = std::max(minCellsPerPage, maxPageBytes / cs);
+            const auto numCells = m_pages.empty() ?
+                minCellsPerPage :
+                std::min(2 * m_pages.back().numCells, maxCells);
+            const auto data = allocateData(cs, numCells);
+            m_pages.push_back({data, numCells});
+            // push in reverse so that cells are handed out in order of address
+            for (size_t i = numCells; i != 0; --i){
+                m_freeSlots.push_back(data + ((i - 1) * cs) + cellHeaderSize());
+            }
+        }
+        const auto slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        return slot;
+    }
+
+    void StateTable::releaseStableSlot(unsigned char* slot){
+        assert(m_slotStorage == SlotStorage::StableAddress);
+        m_freeSlots.push_back(slot);
+    }
+
+    void StateTable::releaseAllPages() noexcept {
+        for (const auto& p : m_pages){
+            deallocateData(p.data);
+        }
+        m_pages.clear();
+        m_freeSlots.clear();
+    }
+
+    void StateTable::renumberStableSlots(size_t beginIndex) noexcept {
+        assert(m_slotStorage == SlotStorage::StableAddress);
+        assert(m_slotAddresses.size() == numSlots());
+        const auto hs = cellHeaderSize();
+        for (size_t i = beginIndex, iEnd = m_slotAddresses.size(); i != iEnd; ++i){
+            *reinterpret_cast<size_t*>(m_slotAddresses[i] - hs) = i;
+        }
+    }
+
+    const SoundState* StateTable::getRowDependentState(size_t row) const noexcept {
+        size_t firstRow = 0;
+        for (const auto& dto : m_dependentOffsets){
+            if (row < firstRow + dto.count){
+                return dto.dependent->getState(row - firstRow);
+            }
+            firstRow += dto.count;
+        }
+        // This happens for a monostate without a dependent
+        return nullptr;
+    }
+
+    template<typename MoveFn>
+    void StateTable::relocateAllSlots(SlotStorage oldStorage, size_t oldSlotSize, size_t oldAlignment, MoveFn&& moveFn){
+        const auto n = numSlots();
+
+        // find all the old slots
+        auto oldSlots = std::vector<unsigned char*>(n);
+        for (size_t i = 0; i < n; ++i){
+            oldSlots[i] = (oldStorage == SlotStorage::Contiguous) ?
+                m_data + (i * oldSlotSize) :
+                m_slotAddresses[i];
+        }
+        const auto oldData = std::exchange(m_data, nullptr);
+        const auto oldPages = std::exchange(m_pages, {});
+        m_slotAddresses.clear();
+        m_freeSlots.clear();
+
+        // allocate new storage and move everything
+        if (m_slotStorage == SlotStorage::Contiguous){
+            m_data = allocateData(m_slotSize, n);
+            for (size_t i = 0; i < n; ++i){
+                moveFn(oldSlots[i], m_data + (i * m_slotSize));
+            }
+        } else {
+            m_slotAddresses.reserve(n);
+            for (size_t i = 0; i < n; ++i){
+                const auto to = allocateStableSlot();
+                moveFn(oldSlots[i], to);
+                m_slotAddresses.push_back(to);
+            }
+            renumberStableSlots(0);
+        }
+
+        // clean up
+        deallocateData(oldData, oldAlignment);
+        for (const auto& p : oldPages){
+            deallocateData(p.data, oldAlignment);
+        }
+    }
+
     void StateTable::addDependentOffset(const SoundNode* d){
         assert(std::find_if(
             m_dependentOffsets.begin(),
@@ -216,6 +388,7 @@ namespace flo {
         );
 
         m_dependentOffsets.push_back({
+            d,
             d,
             offset,
             (m_isMonostate ? 1u : 0u)
@@ -235,22 +408,94 @@ namespace flo {
         m_dependentOffsets.erase(it);
     }
 
-    SoundState* StateTable::getState(const SoundNode* dependent, const SoundState* dependentState, size_t keyIndex) noexcept {
-        return const_cast<SoundState*>(const_cast<const StateTable*>(this)->getState(dependent, dependentState, keyIndex));
+    bool StateTable::deferChanges(){
+        if (m_deferringNetwork){
+            return true;
+        }
+        const auto network = m_owner->getNetwork();
+        if (network && network->isInTransaction()){
+            network->deferStates(m_owner);
+            return true;
+        }
+        return false;
     }
 
-    const SoundState* StateTable::getState(const SoundNode* dependent, const SoundState* dependentState, size_t keyIndex) const noexcept {
-        const auto offset = getDependentOffset(dependent);
-        return getState(offset + (dependent->getStateIndex(dependentState) * numKeys()) + keyIndex);
-    }
+    void StateTable::discardSlots(){
+        // NOTE: if no allocator was ever made, no state was ever allocated
+        if (!m_mainAllocator){
+            return;
+        }
+
+        if (m_slotStorage == SlotStorage::Contiguous){
+            destroySlots(m_data, numSlots());
+        } else {
+            for (size_t i = 0, iEnd = numSlots(); i != iEnd; ++i){
+                destroySlot(slotAddress(i));
+            }
+        }
 
-    SoundState* StateTable::getState(size_t slotIndex) noexcept {
-        return const_cast<SoundState*>(const_cast<const StateTable*>(this)->getState(slotIndex));
+        deallocateData(m_data);
+        m_data = nullptr;
+        m_slotAddresses.clear();
+        releaseAllPages();
     }
 
-    const SoundState* StateTable::getState(size_t slotIndex) const noexcept {
-        assert(slotIndex < numSlots());
-        return reinterpret_cast<const SoundState*>(m_data + (slotIndex * m_slotSize));
+    void StateTable::rebuildSlots(){
+        assert(m_deferringNetwork);
+        assert(m_data == nullptr);
+        assert(m_slotAddresses.empty());
+        assert(m_pages.empty());
+
+        // count the rows of every dependent again
+        size_t numRows = 0;
+        for (auto& dto : m_dependentOffsets){
+            dto.count = dto.dependent->numSlots();
+            dto.offset = numRows * m_numKeys;
+            numRows += dto.count;
+        }
+        if (m_isMonostate){
+            assert(numRows < 2);
+            numRows = 1;
+        }
+        m_numDependentStates = numRows;
+
+        const auto n = numSlots();
+        if (n == 0){
+            return;
+        }
+
+        // allocate all slots at once
+        if (m_slotStorage == SlotStorage::Contiguous){
+            m_data = allocateData(m_slotSize, n);
+        } else {
+            m_slotAddresses.reserve(n);
+            for (size_t i = 0; i < n; ++i){
+                m_slotAddresses.push_back(allocateStableSlot());
+            }
+            renumberStableSlots(0);
+        }
+
+        // construct every row of slots
+        const auto constructRow = [&](size_t row, const SoundState* dependentState){
+            if (m_slotStorage == SlotStorage::Contiguous){
+                constructSlots(m_data + (m_slotSize * row * m_numKeys), m_numKeys, dependentState);
+            } else {
+                for (size_t k = 0; k < m_numKeys; ++k){
+                    constructSlot(m_slotAddresses[(row * m_numKeys) + k], dependentState);
+                }
+            }
+        };
+        size_t row = 0;
+        for (const auto& dto : m_dependentOffsets){
+            for (size_t i = 0; i < dto.count; ++i){
+                constructRow(row++, dto.dependent->getState(i));
+            }
+        }
+        if (row == 0 && m_isMonostate){
+            // a monostate without a dependent state
+            constructRow(row++, nullptr);
+        }
+        assert(row == numRows);
     }
 
     State* StateTable::getBorrowedState(const SoundState* mainState, const BorrowingNumberSource* borrower) const noexcept {
@@ -260,14 +505,29 @@ namespace flo {
     }
 
     const SoundState* StateTable::getMainState(const State* borrowedState) const noexcept {
-        const auto idx = ((reinterpret_cast<const unsigned char*>(borrowedState)) - m_data) / m_slotSize;
-        return getState(idx);
+        const auto addr = reinterpret_cast<const unsigned char*>(borrowedState);
+        if (m_slotStorage == SlotStorage::Contiguous){
+            const auto idx = (addr - m_data) / m_slotSize;
+            return getState(idx);
+        }
+        // find the page and cell containing the borrowed state
+        const auto cs = cellSize();
+        for (const auto& p : m_pages){
+            if (addr >= p.data && addr < p.data + (p.numCells * cs)){
+                const auto cell = p.data + (((addr - p.data) / cs) * cs);
+                const auto mainState = reinterpret_cast<const SoundState*>(cell + cellHeaderSize());
+                assert(hasState(mainState));
+                return mainState;
+            }
+        }
+        assert(false);
+        return nullptr;
     }
 
     void StateTable::resetState(SoundState* ownState){
         assert(hasState(ownState));
         const auto slotIdx = getStateIndex(ownState);
-        const auto slotAddr = m_data + (m_slotSize * slotIdx);
+        const auto slotAddr = slotAddress(slotIdx);
         resetSlot(slotAddr);
         for (const auto& d : m_owner->getDirectDependencies()){
             d->resetStateFor(m_owner, ownState);
@@ -280,7 +540,7 @@ namespace flo {
         const auto baseSlot = getDependentOffset(dependent) + (stateIdx * numKeys());
         for (size_t j = 0; j < numKeys(); ++j){
             const auto slotIdx = baseSlot + j;
-            const auto slotAddr = m_data + (m_slotSize * slotIdx);
+            const auto slotAddr = slotAddress(slotIdx);
             const auto slotState = reinterpret_cast<const SoundState*>(slotAddr);
             resetSlot(slotAddr);
             for (const auto& d : m_owner->getDirectDependencies()){
@@ -296,7 +556,7 @@ namespace flo {
         const auto baseSlot = getDependentOffset(dependent) + (stateIdx * numKeys());
 
         const auto slotIdx = baseSlot + keyIndex;
-        const auto slotAddr = m_data + (m_slotSize * slotIdx);
+        const auto slotAddr = slotAddress(slotIdx);
         const auto slotState = reinterpret_cast<const SoundState*>(slotAddr);
         resetSlot(slotAddr);
         for (const auto& d : m_owner->getDirectDependencies()){
@@ -304,16 +564,15 @@ namespace flo {
         }
     }
 
-    size_t StateTable::getStateIndex(const SoundState* ownState) const noexcept {
-        assert(ownState->getOwner() == this);
-        assert(hasState(ownState));
-        auto idx = (reinterpret_cast<const unsigned char*>(ownState) - m_data) / m_slotSize;
-        assert(idx < numSlots());
-        return static_cast<size_t>(idx);
-    }
-
     bool StateTable::hasState(const SoundState* ownState) const noexcept {
         const auto addr = reinterpret_cast<const unsigned char*>(ownState);
+        if (m_slotStorage == SlotStorage::StableAddress){
+            if (ownState->getOwner() != m_owner){
+                return false;
+            }
+            const auto idx = *reinterpret_cast<const size_t*>(addr - cellHeaderSize());
+            return (idx < numSlots()) && (m_slotAddresses[idx] == addr);
+        }
         const auto diff = addr - m_data;
         if (diff % m_slotSize != 0){
             return false;
@@ -359,6 +618,11 @@ namespace flo {
         // ensure allocation things are initialized
         getMainAllocator();
 
+        // NOTE: the new rows are counted once the slots are rebuilt
+        if (deferChanges()){
+            return;
+        }
+
         if (beginIndex == endIndex){
             return;
         }
@@ -372,7 +636,12 @@ namespace flo {
             assert(endIndex == 1);
             assert(numSlots() == 1);
             assert(getState(0)->m_dependentState == nullptr);
-            getState(0)->m_dependentState = dependent->getState(0);
+            getState(0)->setDependentState(dependent->getState(0));
+            return;
+        }
+
+        if (m_slotStorage == SlotStorage::StableAddress){
+            insertDependentStatesStable(dependent, beginIndex, endIndex);
             return;
         }
 
@@ -384,112 +653,50 @@ namespace flo {
             }
         ));
 
-        // allocate new array
-        auto newNumSlots = numKeys() * (numDependentStates() + (endIndex - beginIndex));
-        auto oldData = m_data;
-        auto newData = allocateData(m_slotSize, newNumSlots);
-
-        // indices of next slots to be moved/added
-        auto oldSlotIndex = size_t{0};
-        auto newSlotIndex = size_t{0};
-
-        auto itDependent = m_dependentOffsets.begin();
+        auto itDependent = std::find_if(
+            m_dependentOffsets.begin(),
+            m_dependentOffsets.end(),
+            [&](const DependentOffset& d){ return d.dependent == dependent; }
+        );
         assert(itDependent != m_dependentOffsets.end());
 
-        // for all dependents prior to the given dependent
-        while (itDependent->dependent != dependent){
-            // move all states to new array
-            assert(itDependent->dependent->numSlots() == itDependent->count);
-            for (size_t i = 0; i < itDependent->count; i++){
-                for (size_t j = 0; j < numKeys(); ++j){
-                    assert(oldSlotIndex < numSlots());
-                    assert(newSlotIndex < newNumSlots);
-                    auto from = oldData + (m_slotSize * oldSlotIndex);
-                    auto to = newData + (m_slotSize * newSlotIndex);
-                    moveSlot(from, to);
-
-                    ++oldSlotIndex;
-                    ++newSlotIndex;
-                }
-            }
-            ++itDependent;
-            assert(itDependent != m_dependentOffsets.end());
-        }
+        // allocate new array
+        const auto numNewRows = endIndex - beginIndex;
+        const auto numNewSlots = numNewRows * numKeys();
+        const auto newNumSlots = numSlots() + numNewSlots;
+        const auto oldData = m_data;
+        const auto newData = allocateData(m_slotSize, newNumSlots);
 
-        assert(itDependent != m_dependentOffsets.end());
-        assert(itDependent->dependent == dependent);
+        // index of the first new slot
+        const auto firstNewSlot = itDependent->offset + (beginIndex * numKeys());
+        assert(firstNewSlot <= numSlots());
 
-        // move states for the given dependent with new states (this is the interesting part)
-        {
-            // move all the dependent's states prior to the first new state
-            for (size_t i = 0; i < beginIndex; ++i){
-                for (size_t j = 0; j < numKeys(); ++j){
-                    //assert(oldSlotIndex == (itDependent->offset + i));
-                    assert(oldSlotIndex < numSlots());
-                    assert(newSlotIndex < newNumSlots);
-                    auto from = oldData + (m_slotSize * oldSlotIndex);
-                    auto to = newData + (m_slotSize * newSlotIndex);
-                    moveSlot(from, to);
-
-                    ++oldSlotIndex;
-                    ++newSlotIndex;
-                }
-            }
-
-            // move all the dependent's new states
-            for (size_t i = beginIndex; i < endIndex; ++i){
-                for (size_t j = 0; j < numKeys(); ++j){
-                    auto dst = newData + (m_slotSize * newSlotIndex);
-                    assert(newSlotIndex < newNumSlots);
-                    constructSlot(dst);
+        // move all states prior to the first new state, including those of
+        // any preceding dependents
+        moveSlots(oldData, newData, firstNewSlot);
 
-                    ++newSlotIndex;
-                }
-            }
+        // construct the new states
+        for (size_t i = beginIndex; i < endIndex; ++i){
+            const auto rowSlot = firstNewSlot + ((i - beginIndex) * numKeys());
+            constructSlots(newData + (m_slotSize * rowSlot), numKeys(), dependent->getState(i));
+        }
 
-            // move all the depdendent's states after the last new state
-            for (size_t i = endIndex, iEnd = itDependent->count; i < iEnd; ++i){
-                for (size_t j = 0; j < numKeys(); ++j){
-                    assert(oldSlotIndex == itDependent->offset + i - (endIndex - beginIndex));
-                    assert(oldSlotIndex < numSlots());
-                    assert(newSlotIndex < newNumSlots);
-                    auto from = oldData + (m_slotSize * oldSlotIndex);
-                    auto to = newData + (m_slotSize * newSlotIndex);
-                    moveSlot(from, to);
-
-                    ++oldSlotIndex;
-                    ++newSlotIndex;
-                }
-            }
+        // move all states after the last new state, including those of
+        // any following dependents
+        moveSlots(
+            oldData + (m_slotSize * firstNewSlot),
+            newData + (m_slotSize * (firstNewSlot + numNewSlots)),
+            numSlots() - firstNewSlot
+        );
 
-            // update the number of states
-            itDependent->count += (endIndex - beginIndex);
-        }
-
-        // move the states of all remaining dependents
-        ++itDependent;
-        while (itDependent != m_dependentOffsets.end()){
-            assert(itDependent->dependent != dependent);
-            itDependent->offset = newSlotIndex;
-            assert(itDependent->dependent->numSlots() == itDependent->count);
-            for (size_t i = 0; i < itDependent->count; i++){
-                for (size_t j = 0; j < numKeys(); ++j){
-                    assert(oldSlotIndex == itDependent->offset + i);
-                    assert(oldSlotIndex < numSlots());
-                    assert(newSlotIndex < newNumSlots);
-                    auto from = oldData + (m_slotSize * oldSlotIndex);
-                    auto to = newData + (m_slotSize * newSlotIndex);
-                    moveSlot(from, to);
-
-                    ++oldSlotIndex;
-                    ++newSlotIndex;
-                }
-            }
-            ++itDependent;
+        // update the number of states and the offsets of following dependents
+        itDependent->count += numNewRows;
+        for (auto it = std::next(itDependent); it != m_dependentOffsets.end(); ++it){
+            assert(it->dependent != dependent);
+            assert(it->dependent->numSlots() == it->count);
+            it->offset += numNewSlots;
         }
 
-        assert(newSlotIndex == newNumSlots);
-
         // cleanup
         deallocateData(oldData);
         m_data = newData;
@@ -516,6 +723,11 @@ namespace flo {
             ) != m_dependentOffsets.end()
         );
 
+        // NOTE: the removed rows are no longer counted once the slots are rebuilt
+        if (deferChanges()){
+            return;
+        }
+
         if (m_isMonostate){
             assert(m_dependentOffsets.size() == 1);
             assert(m_dependentOffsets[0].dependent == dependent);
@@ -526,11 +738,16 @@ namespace flo {
             assert(numSlots() == 1);
             // TODO: this assertion is not safe, since the dependent may have just erased its last state
             // assert(getState(0)->m_dependentState == dependent->getState(0));
-            getState(0)->m_dependentState = nullptr;
+            getState(0)->setDependentState(nullptr);
             m_dependentOffsets[0].count = 0;
             return;
         }
 
+        if (m_slotStorage == SlotStorage::StableAddress){
+            eraseDependentStatesStable(dependent, beginIndex, endIndex);
+            return;
+        }
+
         assert(numKeys() != 0 || std::all_of(
             m_dependentOffsets.begin(),
             m_dependentOffsets.end(),
@@ -544,145 +761,48 @@ namespace flo {
         assert(endIndex <= m_numDependentStates);
         assert(m_numDependentStates >= endIndex - beginIndex);
 
-        // allocate new array
-        auto newNumSlots = numKeys() * (numDependentStates() - (endIndex - beginIndex));
-        auto oldData = m_data;
-        auto newData = allocateData(m_slotSize, newNumSlots);
-
-        // indices of next slots to be moved/added
-        auto oldSlotIndex = size_t{0};
-        auto newSlotIndex = size_t{0};
-
-        auto itDependent = m_dependentOffsets.begin();
-        assert(itDependent != m_dependentOffsets.end());
-
-        // for all dependents prior to the given dependent
-        while (itDependent->dependent != dependent){
-            // move all states to new array
-            assert(itDependent->dependent->numSlots() == itDependent->count);
-            for (size_t i = 0; i < itDependent->count; i++){
-                for (size_t j = 0; j < numKeys(); ++j){
-                    assert(oldSlotIndex / numKeys() == itDependent->offset + i);
-                    assert(oldSlotIndex % numKeys() == j);
-                    assert(newSlotIndex / numKeys() == itDependent->offset + i);
-                    assert(newSlotIndex % numKeys() == j);
-                    
-                    assert(oldSlotIndex < numSlots());
-                    assert(newSlotIndex < newNumSlots);
-                    auto from = oldData + (m_slotSize * oldSlotIndex);
-                    auto to = newData + (m_slotSize * newSlotIndex);
-                    moveSlot(from, to);
-
-                    ++oldSlotIndex;
-                    ++newSlotIndex;
-                }
-            }
-            ++itDependent;
-            assert(itDependent != m_dependentOffsets.end());
-        }
-
+        auto itDependent = std::find_if(
+            m_dependentOffsets.begin(),
+            m_dependentOffsets.end(),
+            [&](const DependentOffset& d){ return d.dependent == dependent; }
+        );
         assert(itDependent != m_dependentOffsets.end());
-        assert(itDependent->dependent == dependent);
+        assert(itDependent->count >= (endIndex - beginIndex));
 
-        // begin moving states for the given dependent with new states
-        {
-            // move all the dependent's states prior to the first new state
-            for (size_t i = 0; i < beginIndex; ++i){
-                for (size_t j = 0; j < numKeys(); ++j){
-                    assert(oldSlotIndex / numKeys() == itDependent->offset + i);
-                    assert(oldSlotIndex % numKeys() == j);
-                    assert(newSlotIndex / numKeys() == itDependent->offset + i);
-                    assert(newSlotIndex % numKeys() == j);
-                
-                    assert(oldSlotIndex < numSlots());
-                    assert(newSlotIndex < newNumSlots);
-                    auto from = oldData + (m_slotSize * oldSlotIndex);
-                    auto to = newData + (m_slotSize * newSlotIndex);
-                    moveSlot(from, to);
-
-                    ++oldSlotIndex;
-                    ++newSlotIndex;
-                }
-            }
+        // allocate new array
+        const auto numOldRows = endIndex - beginIndex;
+        const auto numOldSlots = numOldRows * numKeys();
+        const auto newNumSlots = numSlots() - numOldSlots;
+        const auto oldData = m_data;
+        const auto newData = allocateData(m_slotSize, newNumSlots);
 
-            assert(oldSlotIndex / numKeys() == itDependent->offset + beginIndex);
-            assert(newSlotIndex / numKeys() == itDependent->offset + beginIndex);
+        // index of the first slot being removed
+        const auto firstOldSlot = itDependent->offset + (beginIndex * numKeys());
+        assert(firstOldSlot + numOldSlots <= numSlots());
 
-            // destroy all the dependent's old states
-            for (size_t i = beginIndex; i < endIndex; ++i){
-                for (size_t j = 0; j < numKeys(); ++j){
-                    assert(oldSlotIndex / numKeys() == itDependent->offset + i);
-                    assert(oldSlotIndex % numKeys() == j);
-                
-                    assert(oldSlotIndex < numSlots());
-                    auto dst = oldData + (m_slotSize * oldSlotIndex);
-                    destroySlot(dst);
+        // move all states prior to the first removed state, including those
+        // of any preceding dependents
+        moveSlots(oldData, newData, firstOldSlot);
 
-                    ++oldSlotIndex;
-                }
-            }
+        // destroy the removed states
+        destroySlots(oldData + (m_slotSize * firstOldSlot), numOldSlots);
 
-            assert(oldSlotIndex / numKeys() == itDependent->offset + endIndex);
-            assert(newSlotIndex / numKeys() == itDependent->offset + beginIndex);
-
-            // move all the dependent's states after the last state being removed
-            for (size_t i = endIndex, iEnd = itDependent->count; i < iEnd; ++i){
-                for (size_t j = 0; j < numKeys(); ++j){
-                    assert(oldSlotIndex / numKeys() == itDependent->offset + i);
-                    assert(oldSlotIndex % numKeys() == j);
-                    assert(newSlotIndex / numKeys() == itDependent->offset + i - (endIndex - beginIndex));
-                    assert(newSlotIndex % numKeys() == j);
-                
-                    assert(oldSlotIndex < numSlots());
-                    assert(newSlotIndex < newNumSlots);
-                    auto from = oldData + (m_slotSize * oldSlotIndex);
-                    auto to = newData + (m_slotSize * newSlotIndex);
-                    moveSlot(from, to);
-
-                    ++oldSlotIndex;
-                    ++newSlotIndex;
-                }
-            }
+        // move all states after the last removed state, including those of
+        // any following dependents
+        moveSlots(
+            oldData + (m_slotSize * (firstOldSlot + numOldSlots)),
+            newData + (m_slotSize * firstOldSlot),
+            numSlots() - firstOldSlot - numOldSlots
+        );
 
-            // update the number of states for the dependent
-            assert(itDependent->count >= (endIndex - beginIndex));
-            itDependent->count -= (endIndex - beginIndex);
-        }
-
-        // move the states of all remaining dependents
-        ++itDependent;
-        while (itDependent != m_dependentOffsets.end()){
-            assert(itDependent->dependent != dependent);
-            const auto newOffset = newSlotIndex;
-            assert(newOffset == itDependent->offset - numKeys() * (endIndex - beginIndex));
-            assert(itDependent->dependent->numSlots() == itDependent->count);
-            for (size_t i = 0, iEnd = itDependent->count; i < iEnd; i++){
-                for (size_t j = 0; j < numKeys(); ++j){
-
-                    assert(oldSlotIndex / numKeys() == itDependent->offset + i);
-                    assert(oldSlotIndex % numKeys() == j);
-                    assert(newSlotIndex / numKeys() == itDependent->offset + i - (endIndex - beginIndex));
-                    assert(newSlotIndex / numKeys() == newOffset + i);
-                    assert(newSlotIndex % numKeys() == j);
-                    
-                    assert(oldSlotIndex < numSlots());
-                    assert(newSlotIndex < newNumSlots);
-                    auto from = oldData + (m_slotSize * oldSlotIndex);
-                    auto to = newData + (m_slotSize * newSlotIndex);
-                    moveSlot(from, to);
-
-                    ++oldSlotIndex;
-                    ++newSlotIndex;
-                }
-            }
-            itDependent->offset = newOffset;
-            ++itDependent;
+        // update the number of states and the offsets of following dependents
+        itDependent->count -= numOldRows;
+        for (auto it = std::next(itDependent); it != m_dependentOffsets.end(); ++it){
+            assert(it->dependent != dependent);
+            assert(it->dependent->numSlots() == it->count);
+            it->offset -= numOldSlots;
         }
 
-        assert(oldSlotIndex == m_numDependentStates * numKeys());
-
-        assert(newSlotIndex == newNumSlots);
-
         // cleanup
         deallocateData(oldData);
         m_data = newData;
@@ -707,6 +827,16 @@ namespace flo {
         assert(beginIndex < endIndex);
         assert(beginIndex <= numKeys());
 
+        if (deferChanges()){
+            m_numKeys += endIndex - beginIndex;
+            return;
+        }
+
+        if (m_slotStorage == SlotStorage::StableAddress){
+            insertKeysStable(beginIndex, endIndex);
+            return;
+        }
+
         // allocate new data
         const auto oldData = m_data;
         const auto newNumSlots = numDependentStates() * (numKeys() + (endIndex - beginIndex));
@@ -736,29 +866,18 @@ namespace flo {
             }
 
             // move states before new keys
-            for (size_t j = 0; j < beginIndex; ++j){
-                assert(oldSlotIndex % oldNumKeys == j);
-                assert(newSlotIndex % m_numKeys == j);
-                moveSlot(oldData + m_slotSize * oldSlotIndex, m_data + m_slotSize * newSlotIndex);
-                ++oldSlotIndex;
-                ++newSlotIndex;
-            }
+            moveSlots(oldData + m_slotSize * oldSlotIndex, m_data + m_slotSize * newSlotIndex, beginIndex);
+            oldSlotIndex += beginIndex;
+            newSlotIndex += beginIndex;
 
             // add states for new keys
-            for (size_t j = beginIndex; j < endIndex; ++j){
-                assert(newSlotIndex % m_numKeys == j);
-                constructSlot(m_data + m_slotSize * newSlotIndex);
-                ++newSlotIndex;
-            }
+            constructSlots(m_data + m_slotSize * newSlotIndex, endIndex - beginIndex, getRowDependentState(i));
+            newSlotIndex += endIndex - beginIndex;
             
             // move states after new keys
-            for (size_t j = beginIndex; j < oldNumKeys; ++j){
-                assert(oldSlotIndex % oldNumKeys == j);
-                assert(newSlotIndex % m_numKeys == j + beginIndex - endIndex);
-                moveSlot(oldData + m_slotSize * oldSlotIndex, m_data + m_slotSize * newSlotIndex);
-                ++oldSlotIndex;
-                ++newSlotIndex;
-            }
+            moveSlots(oldData + m_slotSize * oldSlotIndex, m_data + m_slotSize * newSlotIndex, oldNumKeys - beginIndex);
+            oldSlotIndex += oldNumKeys - beginIndex;
+            newSlotIndex += oldNumKeys - beginIndex;
 
             // propagate changes
             for (auto& d : m_owner->getDirectDependencies()){
@@ -782,6 +901,16 @@ namespace flo {
         assert(beginIndex < endIndex);
         assert(endIndex <= numKeys());
 
+        if (deferChanges()){
+            m_numKeys -= endIndex - beginIndex;
+            return;
+        }
+
+        if (m_slotStorage == SlotStorage::StableAddress){
+            eraseKeysStable(beginIndex, endIndex);
+            return;
+        }
+
         // allocate new data
         const auto oldData = m_data;
         const auto newNumSlots = numDependentStates() * (numKeys() - (endIndex - beginIndex));
@@ -813,30 +942,19 @@ namespace flo {
                 assert(currentDependent != m_dependentOffsets.end());
             }
 
-            // move states before new keys
-            for (size_t j = 0; j < beginIndex; ++j){
-                assert(oldSlotIndex % oldNumKeys == j);
-                assert(newSlotIndex % m_numKeys == j);
-                moveSlot(oldData + m_slotSize * oldSlotIndex, m_data + m_slotSize * newSlotIndex);
-                ++oldSlotIndex;
-                ++newSlotIndex;
-            }
+            // move states before old keys
+            moveSlots(oldData + m_slotSize * oldSlotIndex, m_data + m_slotSize * newSlotIndex, beginIndex);
+            oldSlotIndex += beginIndex;
+            newSlotIndex += beginIndex;
 
             // destroy slots of old keys
-            for (size_t j = beginIndex; j < endIndex; ++j){
-                assert(oldSlotIndex % oldNumKeys == j);
-                destroySlot(oldData + m_slotSize * oldSlotIndex);
-                ++oldSlotIndex;
-            }
+            destroySlots(oldData + m_slotSize * oldSlotIndex, endIndex - beginIndex);
+            oldSlotIndex += endIndex - beginIndex;
             
-            // move states after new keys
-            for (size_t j = beginIndex; j < m_numKeys; ++j){
-                assert(oldSlotIndex % oldNumKeys == j + (endIndex - beginIndex));
-                assert(newSlotIndex % m_numKeys == j);
-                moveSlot(oldData + m_slotSize * oldSlotIndex, m_data + m_slotSize * newSlotIndex);
-                ++oldSlotIndex;
-                ++newSlotIndex;
-            }
+            // move states after old keys
+            moveSlots(oldData + m_slotSize * oldSlotIndex, m_data + m_slotSize * newSlotIndex, m_numKeys - beginIndex);
+            oldSlotIndex += m_numKeys - beginIndex;
+            newSlotIndex += m_numKeys - beginIndex;
 
             // propagate changes
             for (auto& d : m_owner->getDirectDependencies()){
@@ -903,23 +1021,20 @@ namespace flo {
         }
 
         // infer position of next slot and update size
-        nextOffset = nextAlignedOffset(nextOffset, mainAllocator->getAlignment());
+        nextOffset = nextAlignedOffset(nextOffset, slotAlignment());
         const auto oldSlotSize = m_slotSize;
         m_slotSize = nextOffset;
-        assert(oldSlotSize < m_slotSize);
-
-        // allocate new data
-        auto oldData = m_data;
-        m_data = allocateData(m_slotSize, numSlots());
-
-        // move everything
-        for (size_t i = 0, iEnd = numSlots(); i < iEnd; ++i){
-            moveSlotAndAddItem(oldData + (i * oldSlotSize), m_data + (i * m_slotSize), borrower);
+        // NOTE: with padded slots, the new state may fit into the padding
+        assert(oldSlotSize <= m_slotSize);
+
+        // allocate new storage and move everything, unless deferred
+        // NOTE: this moves every state, even with stable-address storage
+        if (!deferChanges()){
+            relocateAllSlots(m_slotStorage, oldSlotSize, slotAlignment(), [&](unsigned char* from, unsigned char* to){
+                moveSlotAndAddItem(from, to, borrower);
+            });
         }
 
-        // clean up
-        deallocateData(oldData);
-
         // propagate changes
         for (const auto& d : m_owner->getDirectDependencies()){
             d->repointStatesFor(m_owner);
@@ -969,27 +1084,23 @@ namespace flo {
         }
 
         // infer position of next slot and update size
-        nextOffset = nextAlignedOffset(nextOffset, mainAllocator->getAlignment());
+        nextOffset = nextAlignedOffset(nextOffset, slotAlignment());
         const auto oldSlotSize = m_slotSize;
         m_slotSize = nextOffset;
-        assert(oldSlotSize > m_slotSize);
-
-        // allocate new data
-        auto oldData = m_data;
-        m_data = allocateData(m_slotSize, numSlots());
-
-        // move everything
-        for (size_t i = 0, iEnd = numSlots(); i < iEnd; ++i){
-            moveSlotAndRemoveItem(oldData + (i * oldSlotSize), m_data + (i * m_slotSize), borrower);
+        assert(oldSlotSize >= m_slotSize);
+
+        // allocate new storage and move everything, unless deferred
+        // NOTE: this moves every state, even with stable-address storage
+        if (!deferChanges()){
+            relocateAllSlots(m_slotStorage, oldSlotSize, slotAlignment(), [&](unsigned char* from, unsigned char* to){
+                moveSlotAndRemoveItem(from, to, borrower);
+            });
         }
 
         // erase the old slot item
         m_slotItems.erase(itemToRemove);
         borrower->m_stateOffset = static_cast<size_t>(-1);
 
-        // clean up
-        deallocateData(oldData);
-
         // propagate changes
         for (const auto& d : m_owner->getDirectDependencies()){
             d->repointStatesFor(m_owner);
@@ -1005,19 +1116,37 @@ namespace flo {
         getMainAllocator();
 
         if (enable){
+            if (deferChanges()){
+                // NOTE: the single slot is constructed once the slots are rebuilt
+                m_numKeys = 1;
+                m_numDependentStates = 1;
+                m_isMonostate = true;
+                return;
+            }
+
             // Erase any old data
             if (numSlots() > 0){
                 for (auto& d : m_owner->getDirectDependencies()){
                     d->eraseDependentStates(m_owner, 0, numSlots());
                 }
                 for (size_t i = 0; i < numSlots(); ++i){
-                    destroySlot(m_data + (m_slotSize * i));
+                    destroySlot(slotAddress(i));
                 }
             }
             deallocateData(m_data);
+            m_data = nullptr;
+            m_slotAddresses.clear();
+            releaseAllPages();
 
             // allocate space for one new slot
-            m_data = allocateData(m_slotSize, 1);
+            unsigned char* where = nullptr;
+            if (m_slotStorage == SlotStorage::Contiguous){
+                m_data = allocateData(m_slotSize, 1);
+                where = m_data;
+            } else {
+                where = allocateStableSlot();
+                m_slotAddresses.push_back(where);
+            }
 
             // get pointer to dependent state
             const auto& dependents = m_owner->getDirectDependents();
@@ -1031,15 +1160,19 @@ namespace flo {
             }
 
             // construct new slot and point to dependent state
-            constructSlot(m_data);
+            constructSlot(where, dependentState);
             m_numKeys = 1;
             m_numDependentStates = 1;
-            getState(0)->m_dependentState = dependentState;
+            if (m_slotStorage == SlotStorage::StableAddress){
+                renumberStableSlots(0);
+            }
 
             // propagate changes
             for (const auto& d : m_owner->getDirectDependencies()){
                 d->insertDependentStates(m_owner, 0, 1);
-                d->repointStatesFor(m_owner);
+                if (m_slotStorage == SlotStorage::Contiguous){
+                    d->repointStatesFor(m_owner);
+                }
             }
 
         } else {
@@ -1053,4 +1186,253 @@ namespace flo {
         return m_isMonostate;
     }
 
+    void StateTable::setSlotStorage(SlotStorage storage){
+        if (storage == m_slotStorage){
+            return;
+        }
+
+        // ensure allocation things are initialized
+        getMainAllocator();
+
+        const auto oldStorage = m_slotStorage;
+        m_slotStorage = storage;
+        if (deferChanges()){
+            return;
+        }
+        relocateAllSlots(oldStorage, m_slotSize, slotAlignment(), [&](unsigned char* from, unsigned char* to){
+            moveSlot(from, to);
+        });
+
+        // propagate changes
+        for (const auto& d : m_owner->getDirectDependencies()){
+            d->repointStatesFor(m_owner);
+        }
+    }
+
+    StateTable::SlotStorage StateTable::getSlotStorage() const noexcept {
+        return m_slotStorage;
+    }
+
+    void StateTable::setSlotPadding(SlotPadding padding){
+        if (padding == m_slotPadding){
+            return;
+        }
+
+        // If nothing was allocated yet, the padding will be applied
+        // once the main allocator is created
+        if (!m_mainAllocator){
+            m_slotPadding = padding;
+            return;
+        }
+
+        const auto oldAlignment = slotAlignment();
+        const auto oldSlotSize = m_slotSize;
+        m_slotPadding = padding;
+
+        // Recompute the slot size. Borrowed states keep their offsets, since
+        // only the padding at the end of the slot changes.
+        auto nextOffset = m_mainAllocator->getSize();
+        if (!m_slotItems.empty()){
+            nextOffset = m_slotItems.back().offset + m_slotItems.back().allocator->getSize();
+        }
+        m_slotSize = nextAlignedOffset(nextOffset, slotAlignment());
+
+        if (deferChanges()){
+            return;
+        }
+        relocateAllSlots(m_slotStorage, oldSlotSize, oldAlignment, [&](unsigned char* from, unsigned char* to){
+            moveSlot(from, to);
+        });
+
+        // propagate changes
+        for (const auto& d : m_owner->getDirectDependencies()){
+            d->repointStatesFor(m_owner);
+        }
+    }
+
+    StateTable::SlotPadding StateTable::getSlotPadding() const noexcept {
+        return m_slotPadding;
+    }
+
+    void StateTable::insertDependentStatesStable(const SoundNode* dependent, size_t beginIndex, size_t endIndex){
+        assert(m_slotStorage == SlotStorage::StableAddress);
+        auto it = std::find_if(
+            m_dependentOffsets.begin(),
+            m_dependentOffsets.end(),
+            [&](const DependentOffset& d){ return d.dependent == dependent; }
+        );
+        assert(it != m_dependentOffsets.end());
+
+        const auto numNewRows = endIndex - beginIndex;
+        const auto numNewSlots = numNewRows * numKeys();
+        const auto firstSlot = it->offset + (beginIndex * numKeys());
+
+        // construct the new slots wherever there is room
+        auto newSlots = std::vector<unsigned char*>{};
+        newSlots.reserve(numNewSlots);
+        for (size_t i = beginIndex; i < endIndex; ++i){
+            const auto dependentState = dependent->getState(i);
+            for (size_t j = 0; j < numKeys(); ++j){
+                const auto slot = allocateStableSlot();
+                constructSlot(slot, dependentState);
+                newSlots.push_back(slot);
+            }
+        }
+
+        // insert them into the index
+        m_slotAddresses.insert(
+            m_slotAddresses.begin() + firstSlot,
+            newSlots.begin(),
+            newSlots.end()
+        );
+        it->count += numNewRows;
+        for (auto jt = std::next(it); jt != m_dependentOffsets.end(); ++jt){
+            jt->offset += numNewSlots;
+        }
+        m_numDependentStates += numNewRows;
+        renumberStableSlots(firstSlot);
+
+        // propagate the changes
+        // NOTE: no existing states have moved, so nothing needs repointing
+        if (numNewSlots > 0){
+            for (auto& d : m_owner->getDirectDependencies()){
+                d->insertDependentStates(m_owner, firstSlot, firstSlot + numNewSlots);
+            }
+        }
+    }
+
+    void StateTable::eraseDependentStatesStable(const SoundNode* dependent, size_t beginIndex, size_t endIndex){
+        assert(m_slotStorage == SlotStorage::StableAddress);
+        assert(beginIndex < endIndex);
+        assert(endIndex <= m_numDependentStates);
+        auto it = std::find_if(
+            m_dependentOffsets.begin(),
+            m_dependentOffsets.end(),
+            [&](const DependentOffset& d){ return d.dependent == dependent; }
+        );
+        assert(it != m_dependentOffsets.end());
+        assert(it->count >= endIndex - beginIndex);
+
+        const auto numOldRows = endIndex - beginIndex;
+        const auto numOldSlots = numOldRows * numKeys();
+        const auto firstSlot = it->offset + (beginIndex * numKeys());
+        const auto slotsBegin = m_slotAddresses.begin() + firstSlot;
+        const auto slotsEnd = slotsBegin + numOldSlots;
+
+        // destroy the old slots and hand back their cells
+        for (auto jt = slotsBegin; jt != slotsEnd; ++jt){
+            destroySlot(*jt);
+            releaseStableSlot(*jt);
+        }
+
+        // remove them from the index
+        m_slotAddresses.erase(slotsBegin, slotsEnd);
+        it->count -= numOldRows;
+        for (auto jt = std::next(it); jt != m_dependentOffsets.end(); ++jt){
+            jt->offset -= numOldSlots;
+        }
+        m_numDependentStates -= numOldRows;
+        renumberStableSlots(firstSlot);
+
+        if (numSlots() == 0){
+            releaseAllPages();
+        }
+
+        // propagate the changes
+        // NOTE: no remaining states have moved, so nothing needs repointing
+        if (numOldSlots > 0){
+            for (auto& d : m_owner->getDirectDependencies()){
+                d->eraseDependentStates(m_owner, firstSlot, firstSlot + numOldSlots);
+            }
+        }
+    }
+
+    void StateTable::insertKeysStable(size_t beginIndex, size_t endIndex){
+        assert(m_slotStorage == SlotStorage::StableAddress);
+        const auto oldNumKeys = m_numKeys;
+        const auto newNumKeys = oldNumKeys + (endIndex - beginIndex);
+
+        // build the new index, constructing new slots along the way
+        auto newSlotAddresses = std::vector<unsigned char*>{};
+        newSlotAddresses.reserve(numDependentStates() * newNumKeys);
+        for (size_t i = 0; i < numDependentStates(); ++i){
+            const auto oldRow = m_slotAddresses.begin() + (i * oldNumKeys);
+            newSlotAddresses.insert(newSlotAddresses.end(), oldRow, oldRow + beginIndex);
+            const auto dependentState = getRowDependentState(i);
+            for (size_t j = beginIndex; j < endIndex; ++j){
+                const auto slot = allocateStableSlot();
+                constructSlot(slot, dependentState);
+                newSlotAddresses.push_back(slot);
+            }
+            newSlotAddresses.insert(newSlotAddresses.end(), oldRow + beginIndex, oldRow + oldNumKeys);
+        }
+
+        swap(m_slotAddresses, newSlotAddresses);
+        m_numKeys = newNumKeys;
+
+        // Update dependent offsets
+        {
+            size_t sum = 0;
+            for (auto& dto : m_dependentOffsets){
+                dto.offset = sum;
+                sum += dto.count * m_numKeys;
+            }
+            assert(sum == numSlots());
+        }
+        renumberStableSlots(0);
+
+        // propagate changes
+        // NOTE: no existing states have moved, so nothing needs repointing
+        for (size_t i = 0; i < numDependentStates(); ++i){
+            for (auto& d : m_owner->getDirectDependencies()){
+                d->insertDependentStates(m_owner, m_numKeys * i + beginIndex, m_numKeys * i + endIndex);
+            }
+        }
+    }
+
+    void StateTable::eraseKeysStable(size_t beginIndex, size_t endIndex){
+        assert(m_slotStorage == SlotStorage::StableAddress);
+        const auto oldNumKeys = m_numKeys;
+        const auto newNumKeys = oldNumKeys - (endIndex - beginIndex);
+
+        // build the new index, destroying old slots along the way
+        auto newSlotAddresses = std::vector<unsigned char*>{};
+        newSlotAddresses.reserve(numDependentStates() * newNumKeys);
+        for (size_t i = 0; i < numDependentStates(); ++i){
+            const auto oldRow = m_slotAddresses.begin() + (i * oldNumKeys);
+            newSlotAddresses.insert(newSlotAddresses.end(), oldRow, oldRow + beginIndex);
+            for (size_t j = beginIndex; j < endIndex; ++j){
+                destroySlot(oldRow[j]);
+                releaseStableSlot(oldRow[j]);
+            }
+            newSlotAddresses.insert(newSlotAddresses.end(), oldRow + endIndex, oldRow + oldNumKeys);
+        }
+
+        swap(m_slotAddresses, newSlotAddresses);
+        m_numKeys = newNumKeys;
+
+        // Update dependent offsets
+        {
+            size_t sum = 0;
+            for (auto& dto : m_dependentOffsets){
+                dto.offset = sum;
+                sum += dto.count * m_numKeys;
+            }
+            assert(sum == numSlots());
+        }
+        renumberStableSlots(0);
+
+        if (numSlots() == 0){
+            releaseAllPages();
+        }
+
+        // propagate changes
+        // NOTE: no remaining states have moved, so nothing needs repointing
+        for (size_t i = 0; i < numDependentStates(); ++i){
+            for (auto& d : m_owner->getDirectDependencies()){
+                d->eraseDependentStates(m_owner, m_numKeys * i + beginIndex, m_numKeys * i + endIndex);
+            }
+        }
+    }
+
 } // namespace flo
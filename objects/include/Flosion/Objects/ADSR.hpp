@@ -33,7 +33,7 @@ namespace flo {
         // sustainLevel and does not change.
 
     private:
-        double evaluate(const SoundState*) const noexcept override;
+        Number evaluate(const SoundState*) const noexcept override;
     };
 
 } // namespace flo
@@ -8,11 +8,15 @@ namespace flo {
     public:
         void reset() noexcept override;
 
+        // NOTE: the sum is kept in double precision so that small increments are not lost
         double value = {};
-        double prevReset = {};
+        Number prevReset = {};
     };
 
-    class Accumulator : public flo::BorrowingNumberSourceTemplate<AccumulatorState> {
+    template<>
+    struct IsTriviallyRelocatable<AccumulatorState> : std::true_type {};
+
+    class Accumulator : public flo::BorrowingNumberSourceTemplate<Accumulator, AccumulatorState> {
     public:
         Accumulator();
 
@@ -20,7 +24,9 @@ namespace flo {
         flo::NumberSourceInput reset;
 
     private:
-        double evaluate(AccumulatorState* state, const flo::SoundState* context) const noexcept override;
+        Number evaluate(AccumulatorState* state, const flo::SoundState* context) const noexcept;
+
+        friend flo::BorrowingNumberSourceTemplate<Accumulator, AccumulatorState>;
     };
 
 } // namespace flo
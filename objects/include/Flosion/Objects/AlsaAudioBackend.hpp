@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Flosion/Objects/AudioOutput.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace flo {
+
+    /**
+     * AlsaAudioBackend writes float32 frames directly to an ALSA pcm device,
+     * bypassing SFML's fixed buffering, so that the period size and number
+     * of periods requested by the config are used as-is where the hardware
+     * allows it.
+     * This is only functional when Flosion is built with ALSA (FLOSION_HAS_ALSA),
+     * and start() throws otherwise.
+     */
+    class AlsaAudioBackend : public AudioOutputBackend {
+    public:
+        AlsaAudioBackend(std::string deviceName = "default");
+        ~AlsaAudioBackend() noexcept;
+
+        void start(const AudioOutputConfig& config, Callback callback) override;
+
+        void stop() noexcept override;
+
+        bool isRunning() const noexcept override;
+
+        const std::string& getDeviceName() const noexcept;
+
+        /**
+         * The period size which the device actually agreed to,
+         * which may differ from the one requested.
+         */
+        std::size_t getPeriodSize() const noexcept;
+
+    private:
+        void run(Callback callback) noexcept;
+
+        std::string m_deviceName;
+
+        // The snd_pcm_t handle. Kept opaque, so that this header does not
+        // depend on the ALSA headers
+        void* m_pcm;
+
+        std::size_t m_numChannels;
+        std::size_t m_periodSize;
+        bool m_realtimePriority;
+
+        std::thread m_thread;
+        std::atomic<bool> m_running;
+        std::vector<float> m_buffer;
+    };
+
+} // namespace flo
@@ -15,7 +15,7 @@ namespace flo {
         void reset() noexcept override;
     };
 
-    class AudioClip : public Realtime<ControlledSoundSource<AudioClipState>> {
+    class AudioClip : public Realtime<ControlledSoundSource<AudioClip, AudioClipState>> {
     public:
         AudioClip();
 
@@ -29,11 +29,13 @@ namespace flo {
         void setLooping(bool);
 
     private:
-        void renderNextChunk(SoundChunk& chunk, AudioClipState* state) override;
+        void renderNextChunk(SoundChunk& chunk, AudioClipState* state);
 
         sf::SoundBuffer m_buffer;
 
         bool m_looping;
+
+        friend ControlledSoundSource<AudioClip, AudioClipState>;
     };
 
 } // namespace flo
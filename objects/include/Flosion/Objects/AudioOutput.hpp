@@ -0,0 +1,134 @@
+#pragma once
+
+#include <Flosion/Core/LookaheadRenderer.hpp>
+#include <Flosion/Core/SoundResult.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace flo {
+
+    /**
+     * The settings with which an audio output device is opened.
+     */
+    struct AudioOutputConfig {
+        std::size_t numChannels = channels::stereo;
+
+        // The number of frames the device consumes at a time. Smaller periods
+        // lower the latency added by the device, at the cost of more frequent
+        // wakeups. NOTE: sound is still rendered a whole SoundChunk at a time,
+        // so the latency can never be less than one chunk.
+        std::size_t periodSize = 256;
+
+        // The number of periods buffered by the device
+        std::size_t numPeriods = 2;
+
+        // Whether the device thread should ask for realtime scheduling
+        // (SCHED_FIFO on POSIX systems) if the process is permitted to
+        bool realtimePriority = true;
+
+        // The number of chunks rendered ahead of the device on a separate
+        // thread (see LookaheadRenderer), or zero to render on the device
+        // thread. Lookahead adds as many chunks of latency, in exchange
+        // for absorbing chunks that occasionally take too long to render.
+        std::size_t lookahead = 0;
+    };
+
+    /**
+     * AudioOutputBackend is a device or audio API to which interleaved float32
+     * frames are written, one period at a time, from a thread owned by the
+     * backend. Backends report every buffer underrun (xrun) they detect.
+     */
+    class AudioOutputBackend {
+    public:
+        /**
+         * Called on the device thread to fill the given buffer with the
+         * given number of interleaved frames. Must not block.
+         */
+        using Callback = std::function<void(float* interleaved, std::size_t numFrames)>;
+
+        AudioOutputBackend() noexcept;
+        virtual ~AudioOutputBackend() noexcept = default;
+
+        AudioOutputBackend(const AudioOutputBackend&) = delete;
+        AudioOutputBackend& operator=(const AudioOutputBackend&) = delete;
+
+        /**
+         * Opens the device and begins calling the callback from the device thread.
+         * Throws std::runtime_error if the device could not be opened.
+         */
+        virtual void start(const AudioOutputConfig& config, Callback callback) = 0;
+
+        /**
+         * Stops calling the callback and closes the device. Once this returns,
+         * the callback is not called again until the next call to start().
+         */
+        virtual void stop() noexcept = 0;
+
+        virtual bool isRunning() const noexcept = 0;
+
+        /**
+         * The number of underruns detected since the backend was created.
+         * May be polled from any thread.
+         */
+        std::size_t getXrunCount() const noexcept;
+
+    protected:
+        void reportXrun() noexcept;
+
+        /**
+         * Asks for the calling thread to be scheduled with realtime priority.
+         * Returns false if this is not supported or not permitted, in which
+         * case the thread keeps its normal priority.
+         */
+        static bool promoteCurrentThread() noexcept;
+
+    private:
+        std::atomic<std::size_t> m_xruns;
+    };
+
+    /**
+     * AudioOutput plays the sound result through any backend, converting
+     * its chunks to the periods requested by the device.
+     */
+    class AudioOutput {
+    public:
+        AudioOutput(std::unique_ptr<AudioOutputBackend> backend, const AudioOutputConfig& config = {});
+        ~AudioOutput() noexcept;
+
+        AudioOutput(const AudioOutput&) = delete;
+        AudioOutput& operator=(const AudioOutput&) = delete;
+
+        WithCurrentTime<SoundResult> soundResult;
+
+        void start();
+
+        void stop() noexcept;
+
+        bool isRunning() const noexcept;
+
+        const AudioOutputConfig& getConfig() const noexcept;
+
+        AudioOutputBackend& getBackend() noexcept;
+        const AudioOutputBackend& getBackend() const noexcept;
+
+        /**
+         * The renderer used if the config asks for lookahead, or null.
+         */
+        const LookaheadRenderer* getLookaheadRenderer() const noexcept;
+
+    private:
+        void render(float* interleaved, std::size_t numFrames) noexcept;
+
+        std::unique_ptr<AudioOutputBackend> m_backend;
+        AudioOutputConfig m_config;
+        std::unique_ptr<LookaheadRenderer> m_lookahead;
+        SoundChunk m_chunk;
+
+        // The number of frames of m_chunk that have been written to the device
+        std::size_t m_chunkPosition;
+    };
+
+} // namespace flo
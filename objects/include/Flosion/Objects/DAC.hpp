@@ -1,17 +1,38 @@
+#include <Flosion/Core/LookaheadRenderer.hpp>
+#include <Flosion/Core/SampleFormat.hpp>
 #include <Flosion/Core/SoundResult.hpp>
 
 #include <SFML/Audio.hpp>
 
+#include <memory>
+
 namespace flo {
 
     class DAC : public sf::SoundStream {
     public:
-        DAC();
+        /**
+         * Opens an output stream with the given number of channels,
+         * which also becomes the number of channels of the sound result.
+         * If lookahead is nonzero, the sound is rendered that many chunks
+         * ahead of the stream on a thread of its own (see LookaheadRenderer),
+         * starting when the stream first asks for audio. Otherwise, it is
+         * rendered directly in the stream's callback.
+         */
+        DAC(std::size_t numChannels = channels::stereo, std::size_t lookahead = 0);
+
+        ~DAC();
 
         flo::WithCurrentTime<flo::SoundResult> soundResult;
 
+        /**
+         * The renderer used if lookahead was requested, or null.
+         */
+        const flo::LookaheadRenderer* getLookaheadRenderer() const noexcept;
+
     private:
+        std::unique_ptr<flo::LookaheadRenderer> m_lookahead;
         flo::SoundChunk m_chunk;
+        flo::SampleEncoder m_encoder;
         std::vector<sf::Int16> m_buffer;
 
         bool onGetData(sf::SoundStream::Chunk& out) override;
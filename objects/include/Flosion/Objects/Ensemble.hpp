@@ -14,7 +14,7 @@ namespace flo {
 
         void reset() noexcept override;
 
-        double randomOffset {};
+        Number randomOffset {};
     };
 
     class EnsembleState : public flo::SoundState {
@@ -25,36 +25,49 @@ namespace flo {
 
         flo::SoundChunk buffer;
         bool init {};
+
+        // Used for the offsets of the voices. A new stream
+        // is taken with every reset
+        util::CounterRNG rng;
     };
 
-    class Ensemble : public Realtime<ControlledSoundSource<EnsembleState>> {
+    class Ensemble : public Realtime<ControlledSoundSource<Ensemble, EnsembleState>> {
     public:
         // TODO: allow this to be changed using number inputs
         static const size_t numVoices = 4;
     
         Ensemble();
         ~Ensemble();
-    
-        void renderNextChunk(flo::SoundChunk& chunk, EnsembleState* state) override;
 
         flo::SoundNumberInput frequencyIn;
         flo::SoundNumberInput frequencySpread;
 
+        util::RandomSeed randomSeed;
+
+        void reseed(std::uint64_t seed) noexcept override;
+
         class Input : public flo::MultiSoundInput<EnsembleInputState, size_t> {
         public:
             Input(Ensemble* ensemble);
 
-            class Frequency : public flo::SoundNumberSource<Input> {    
+            class Frequency : public flo::SoundNumberSource<Frequency, Input> {    
             public:
                 using SoundNumberSource::SoundNumberSource;
 
             private:
-                double evaluate(const EnsembleInputState* state, const flo::SoundState* context) const noexcept override;
+                Number evaluate(const EnsembleInputState* state, const flo::SoundState* context) const noexcept;
+
+                friend flo::SoundNumberSource<Frequency, Input>;
             } frequencyOut;
 
         private:
             Ensemble* const m_ensemble;
         } input;
+
+    private:
+        void renderNextChunk(flo::SoundChunk& chunk, EnsembleState* state);
+
+        friend ControlledSoundSource<Ensemble, EnsembleState>;
     };
 
 } // namespace flo
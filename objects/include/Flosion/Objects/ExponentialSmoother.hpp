@@ -8,11 +8,13 @@ namespace flo {
     public:
         void reset() noexcept override;
 
+        // NOTE: the value is kept in double precision so that it keeps
+        // approaching the input when the decay rate is small
         double value = {};
-        double prevReset = {};
+        Number prevReset = {};
     };
 
-    class ExponentialSmoother : public flo::BorrowingNumberSourceTemplate<ExponentialSmootherState> {
+    class ExponentialSmoother : public flo::BorrowingNumberSourceTemplate<ExponentialSmoother, ExponentialSmootherState> {
     public:
         ExponentialSmoother();
 
@@ -21,7 +23,9 @@ namespace flo {
         NumberSourceInput reset;
 
     private:
-        double evaluate(ExponentialSmootherState* state, const flo::SoundState* context) const noexcept override;
+        Number evaluate(ExponentialSmootherState* state, const flo::SoundState* context) const noexcept;
+
+        friend flo::BorrowingNumberSourceTemplate<ExponentialSmoother, ExponentialSmootherState>;
     };
 
 } // namespace flo
@@ -8,11 +8,11 @@ namespace flo {
     public:
         void reset() noexcept override;
 
-        double storedValue = {};
-        double prevClock = {};
+        Number storedValue = {};
+        Number prevClock = {};
     };
 
-    class FlipFlop : public flo::BorrowingNumberSourceTemplate<FlipFlopState> {
+    class FlipFlop : public flo::BorrowingNumberSourceTemplate<FlipFlop, FlipFlopState> {
     public:
         FlipFlop();
 
@@ -20,7 +20,9 @@ namespace flo {
         flo::NumberSourceInput clock;
 
     private:
-        double evaluate(FlipFlopState* state, const flo::SoundState* context) const noexcept override;
+        Number evaluate(FlipFlopState* state, const flo::SoundState* context) const noexcept;
+
+        friend flo::BorrowingNumberSourceTemplate<FlipFlop, FlipFlopState>;
     };
 
 } // namespace flo
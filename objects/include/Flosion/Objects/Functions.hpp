@@ -1,20 +1,21 @@
 #pragma once
 
+#include <Flosion/Core/BorrowingNumberSource.hpp>
 #include <Flosion/Objects/FunctionsBase.hpp>
+#include <Flosion/Util/RNG.hpp>
 
 #include <cmath>
-#include <random>
 
 namespace flo {
 
     class Add : public BinaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Subtract : public BinaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Multiply : public BinaryFunction {
@@ -22,7 +23,7 @@ namespace flo {
         Multiply();
 
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Divide : public BinaryFunction {
@@ -30,177 +31,177 @@ namespace flo {
         Divide();
 
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class PiConstant : public flo::NumberSource {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class EulersConstant : public flo::NumberSource {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class TauConstant : public flo::NumberSource {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class SampleFrequencyConstant : public flo::NumberSource {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Abs : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class SquareRoot : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class CubeRoot : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Square : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Log : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Log2 : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Log10 : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Exp : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Exp2 : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Exp10 : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Sin : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Cos : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Tan : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Asin : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Acos : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Atan : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Sinh : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Cosh : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Tanh : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Asinh : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Acosh : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Atanh : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Ceil : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Floor : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Round : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Frac : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class PlusOne : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class MinusOne : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class OneMinus : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
     
     class Negate : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Reciprocal : public UnaryFunction {
@@ -208,80 +209,106 @@ namespace flo {
         Reciprocal();
 
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     // maps [-1,1] to [0,1] linearly
     class StdToNorm : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     // maps [0,1] to [-1,1] linearly
     class NormToStd : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Sigmoid : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Min : public BinaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Max : public BinaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Pow : public BinaryFunction {
     public:
         Pow();
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class LogBase : public BinaryFunction {
     public:
         LogBase();
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Hypot : public BinaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Atan2 : public BinaryFunction {
     public:
         Atan2();
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
-    class RandomUniform : public BinaryFunction {
+    class RandomState : public flo::State {
+    public:
+        void reset() noexcept override;
+
+        // NOTE: this takes a new stream the first time the state is
+        // evaluated after each reset
+        util::CounterRNG rng;
+    };
+
+    template<>
+    struct IsTriviallyRelocatable<RandomState> : std::true_type {};
+
+    class RandomUniform : public flo::BorrowingNumberSourceTemplate<RandomUniform, RandomState> {
     public:
         RandomUniform();
 
+        flo::NumberSourceInput minimum;
+        flo::NumberSourceInput maximum;
+
+        util::RandomSeed randomSeed;
+
+        void reseed(std::uint64_t seed) noexcept override;
+
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(RandomState* state, const flo::SoundState* context) const noexcept;
 
-        mutable std::uniform_real_distribution<double> m_dist;
+        friend flo::BorrowingNumberSourceTemplate<RandomUniform, RandomState>;
     };
 
-    class RandomNormal : public BinaryFunction {
+    class RandomNormal : public flo::BorrowingNumberSourceTemplate<RandomNormal, RandomState> {
     public:
         RandomNormal();
 
+        flo::NumberSourceInput mean;
+        flo::NumberSourceInput deviation;
+
+        util::RandomSeed randomSeed;
+
+        void reseed(std::uint64_t seed) noexcept override;
+
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(RandomState* state, const flo::SoundState* context) const noexcept;
 
-        mutable std::normal_distribution<double> m_dist;
+        friend flo::BorrowingNumberSourceTemplate<RandomNormal, RandomState>;
     };
 
     class RoundTo : public BinaryFunction {
@@ -289,17 +316,17 @@ namespace flo {
         RoundTo();
 
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class FloorTo : public BinaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class CeilTo : public BinaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Remainder : public BinaryFunction {
@@ -307,7 +334,7 @@ namespace flo {
         Remainder();
 
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class Gaussian : public flo::NumberSource {
@@ -319,7 +346,7 @@ namespace flo {
         NumberSourceInput width;
         NumberSourceInput amplitude;
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class LinearInterpolation : public flo::NumberSource {
@@ -330,7 +357,7 @@ namespace flo {
         NumberSourceInput end;
         NumberSourceInput fraction;
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
 } // namespace flo
@@ -8,10 +8,11 @@ namespace flo {
     public:
         void reset() noexcept override;
 
+        // NOTE: the value is kept in double precision so that small steps are not lost
         double value{};
     };
 
-    class LinearSmoother : public BorrowingNumberSourceTemplate<LinearSmootherState> {
+    class LinearSmoother : public BorrowingNumberSourceTemplate<LinearSmoother, LinearSmootherState> {
     public:
         LinearSmoother();
 
@@ -19,7 +20,9 @@ namespace flo {
         NumberSourceInput rate;
 
     private:
-        double evaluate(LinearSmootherState* state, const SoundState* context) const noexcept override;
+        Number evaluate(LinearSmootherState* state, const SoundState* context) const noexcept;
+
+        friend BorrowingNumberSourceTemplate<LinearSmoother, LinearSmootherState>;
     };
 
 } // namespace flo
@@ -4,6 +4,7 @@
 #include <SFML/Audio/SoundRecorder.hpp>
 
 #include <array>
+#include <atomic>
 
 namespace flo {
 
@@ -11,17 +12,25 @@ namespace flo {
     public:
         using SoundState::SoundState;
 
+        LiveInputState(LiveInputState&&) noexcept;
+
         void reset() noexcept override;
 
         static constexpr std::size_t buffer_size = 4096;
 
-        // TODO: synchronization
+        // A single-producer single-consumer queue of frames. One slot is
+        // always left empty, so that a full buffer can be told apart from
+        // an empty one.
         std::array<Sample, buffer_size> buffer;
-        std::size_t producer_pos;
-        std::size_t consumer_pos;
+
+        // The next frame to be written, written by the producer only
+        std::atomic<std::size_t> producer_pos{0};
+
+        // The next frame to be read, written by the consumer only
+        std::atomic<std::size_t> consumer_pos{0};
     };
 
-    class LiveInput : public WithCurrentTime<Realtime<UncontrolledSoundSource<LiveInputState>>> {
+    class LiveInput : public WithCurrentTime<Realtime<UncontrolledSoundSource<LiveInput, LiveInputState>>> {
     public:
         LiveInput();
         ~LiveInput();
@@ -42,9 +51,19 @@ namespace flo {
 
         const std::string& getDevice() const;
 
-    private:
+        /**
+         * Appends interleaved stereo frames to the input buffer, to be heard
+         * in the next chunks rendered. Frames which don't fit in the buffer
+         * are dropped. Returns the number of frames that were appended.
+         * Recorded audio arrives through this, and it may also be called
+         * directly to play audio from elsewhere, such as a NullInputDevice.
+         * This may be called concurrently with rendering, but only from
+         * one thread at a time.
+         */
+        std::size_t pushFrames(const float* interleavedStereo, std::size_t numFrames) noexcept;
 
-        void renderNextChunk(SoundChunk&, LiveInputState*) override;
+    private:
+        void renderNextChunk(SoundChunk&, LiveInputState*);
 
         class Recorder : public sf::SoundRecorder {
         public:
@@ -59,6 +78,7 @@ namespace flo {
 
         Recorder m_recorder;
 
+        friend UncontrolledSoundSource<LiveInput, LiveInputState>;
     };
 
 } // namespace flo
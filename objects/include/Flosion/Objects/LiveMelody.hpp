@@ -133,7 +133,7 @@ namespace flo {
 
 
     // A sequence of notes, much like a midi sequence
-    class LiveMelody : public WithCurrentTime<OutOfSync<UncontrolledSoundSource<LiveMelodyState>>> {
+    class LiveMelody : public WithCurrentTime<OutOfSync<UncontrolledSoundSource<LiveMelody, LiveMelodyState>>> {
     public:
         LiveMelody();
 
@@ -157,28 +157,34 @@ namespace flo {
         public:
             CurrentTime noteTime;
 
-            class NoteProgress : public SoundNumberSource<Input> {
+            class NoteProgress : public SoundNumberSource<NoteProgress, Input> {
             public:
                 using SoundNumberSource::SoundNumberSource;
 
             private:
-                double evaluate(const LiveMelodyNoteState*, const SoundState*) const noexcept override;
+                Number evaluate(const LiveMelodyNoteState*, const SoundState*) const noexcept;
+
+                friend SoundNumberSource<NoteProgress, Input>;
             } noteProgress;
 
-            class NoteLength : public SoundNumberSource<Input> {
+            class NoteLength : public SoundNumberSource<NoteLength, Input> {
             public:
                 using SoundNumberSource::SoundNumberSource;
 
             private:
-                double evaluate(const LiveMelodyNoteState*, const SoundState*) const noexcept override;
+                Number evaluate(const LiveMelodyNoteState*, const SoundState*) const noexcept;
+
+                friend SoundNumberSource<NoteLength, Input>;
             } noteLength;
 
-            class NoteFrequency : public SoundNumberSource<Input> {
+            class NoteFrequency : public SoundNumberSource<NoteFrequency, Input> {
             public:
                 using SoundNumberSource::SoundNumberSource;
 
             private:
-                double evaluate(const LiveMelodyNoteState*, const SoundState*) const noexcept override;
+                Number evaluate(const LiveMelodyNoteState*, const SoundState*) const noexcept;
+
+                friend SoundNumberSource<NoteFrequency, Input>;
             } noteFrequency;
 
         private:
@@ -188,7 +194,7 @@ namespace flo {
         } input;
 
     private:
-        void renderNextChunk(SoundChunk&, LiveMelodyState*) override;
+        void renderNextChunk(SoundChunk&, LiveMelodyState*);
 
         double getTimeSpeed(const SoundState*) const noexcept override;
 
@@ -210,6 +216,7 @@ namespace flo {
         void updateQueueSize();
 
         friend class LiveMelodyNote;
+        friend UncontrolledSoundSource<LiveMelody, LiveMelodyState>;
     };
 
 }
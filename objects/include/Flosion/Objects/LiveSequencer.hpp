@@ -54,7 +54,9 @@ namespace flo {
 
         SingleSoundInput input;
 
-        Signal<Mode> onChangeCurrentMode; // TODO: call this during renderNextChunk? Is that safe?
+        // NOTE: these are also broadcast while rendering, and those events
+        // are deferred until deliverDeferredSignals() is called
+        Signal<Mode> onChangeCurrentMode;
         Signal<Mode> onChangeNextMode;
         Signal<double> onChangeVolume;
 
@@ -89,7 +91,7 @@ namespace flo {
         friend class LiveSequencer;
     };
 
-    class LiveSequencer : public WithCurrentTime<Realtime<UncontrolledSoundSource<LiveSequencerState>>> {
+    class LiveSequencer : public WithCurrentTime<Realtime<UncontrolledSoundSource<LiveSequencer, LiveSequencerState>>> {
     public:
         LiveSequencer();
         ~LiveSequencer();
@@ -110,9 +112,10 @@ namespace flo {
         Signal<Track*> onRemoveTrack;
 
     private:
-        void renderNextChunk(SoundChunk&, LiveSequencerState*) noexcept override;
+        void renderNextChunk(SoundChunk&, LiveSequencerState*) noexcept;
 
         friend class Track;
+        friend UncontrolledSoundSource<LiveSequencer, LiveSequencerState>;
     };
 
 } // namespace flo
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <Flosion/Core/SoundSourceTemplate.hpp>
 #include <Flosion/Core/SingleSoundInput.hpp>
 
+#include <vector>
+
 namespace flo {
 
     class LowpassState : public SoundState {
@@ -11,10 +13,12 @@ namespace flo {
 
         void reset() noexcept override;
 
-        Sample value {};
+        // the most recent output, for each channel of the chunks
+        // being rendered
+        std::vector<float> values;
     };
 
-    class Lowpass : public Realtime<ControlledSoundSource<LowpassState>> {
+    class Lowpass : public Realtime<ControlledSoundSource<Lowpass, LowpassState>> {
     public:
         Lowpass();
 
@@ -23,7 +27,9 @@ namespace flo {
         SoundNumberInput cutoff;
 
     private:
-        void renderNextChunk(SoundChunk& chunk, LowpassState* state) override;
+        void renderNextChunk(SoundChunk& chunk, LowpassState* state);
+
+        friend ControlledSoundSource<Lowpass, LowpassState>;
     };
 
 } // namespace flo
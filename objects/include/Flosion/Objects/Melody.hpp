@@ -135,7 +135,7 @@ namespace flo {
 
 
     // A sequence of notes, much like a midi sequence
-    class Melody : public WithCurrentTime<OutOfSync<ControlledSoundSource<MelodyState>>> {
+    class Melody : public WithCurrentTime<OutOfSync<ControlledSoundSource<Melody, MelodyState>>> {
     public:
         Melody();
 
@@ -156,28 +156,34 @@ namespace flo {
         public:
             CurrentTime noteTime;
 
-            class NoteProgress : public SoundNumberSource<Input> {
+            class NoteProgress : public SoundNumberSource<NoteProgress, Input> {
             public:
                 using SoundNumberSource::SoundNumberSource;
 
             private:
-                double evaluate(const MelodyNoteState*, const SoundState*) const noexcept override;
+                Number evaluate(const MelodyNoteState*, const SoundState*) const noexcept;
+
+                friend SoundNumberSource<NoteProgress, Input>;
             } noteProgress;
             
-            class NoteLength : public SoundNumberSource<Input> {
+            class NoteLength : public SoundNumberSource<NoteLength, Input> {
             public:
                 using SoundNumberSource::SoundNumberSource;
 
             private:
-                double evaluate(const MelodyNoteState*, const SoundState*) const noexcept override;
+                Number evaluate(const MelodyNoteState*, const SoundState*) const noexcept;
+
+                friend SoundNumberSource<NoteLength, Input>;
             } noteLength;
 
-            class NoteFrequency : public SoundNumberSource<Input> {
+            class NoteFrequency : public SoundNumberSource<NoteFrequency, Input> {
             public:
                 using SoundNumberSource::SoundNumberSource;
 
             private:
-                double evaluate(const MelodyNoteState*, const SoundState*) const noexcept override;
+                Number evaluate(const MelodyNoteState*, const SoundState*) const noexcept;
+
+                friend SoundNumberSource<NoteFrequency, Input>;
             } noteFrequency;
 
         private:
@@ -187,7 +193,7 @@ namespace flo {
         } input;
 
     private:
-        void renderNextChunk(SoundChunk&, MelodyState*) override;
+        void renderNextChunk(SoundChunk&, MelodyState*);
 
         double getTimeSpeed(const SoundState*) const noexcept override;
 
@@ -207,6 +213,7 @@ namespace flo {
         void updateQueueSize();
 
         friend class MelodyNote;
+        friend ControlledSoundSource<Melody, MelodyState>;
     };
 
 }
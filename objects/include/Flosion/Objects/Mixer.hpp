@@ -14,12 +14,10 @@ namespace flo {
         flo::SoundChunk buffer;
     };
 
-    class Mixer : public flo::Realtime<flo::ControlledSoundSource<MixerState>> {
+    class Mixer : public flo::Realtime<flo::ControlledSoundSource<Mixer, MixerState>> {
     public:
         ~Mixer();
 
-        void renderNextChunk(flo::SoundChunk& chunk, MixerState* state) override;
-
         SingleSoundInput* addInput();
 
         void removeInput(const SoundInput*);
@@ -30,7 +28,11 @@ namespace flo {
         Signal<SingleSoundInput*> onInputRemoved;
 
     private:
+        void renderNextChunk(flo::SoundChunk& chunk, MixerState* state);
+
         std::vector<std::unique_ptr<SingleSoundInput>> m_inputs;
+
+        friend flo::ControlledSoundSource<Mixer, MixerState>;
     };
 
 
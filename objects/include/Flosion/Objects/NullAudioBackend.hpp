@@ -0,0 +1,97 @@
+#pragma once
+
+#include <Flosion/Objects/AudioOutput.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace flo {
+
+    /**
+     * NullAudioBackend behaves like a device without needing any audio
+     * hardware: periods are requested from the callback according to a
+     * clock, and the audio is discarded or optionally recorded into memory.
+     * This allows audio output to be tested on headless machines.
+     */
+    class NullAudioBackend : public AudioOutputBackend {
+    public:
+        enum class Clock {
+            // Periods are requested from a thread, paced by a timer at the
+            // sample frequency. A period which takes longer to render than
+            // it lasts is reported as an xrun.
+            RealTime,
+
+            // Periods are requested from a thread, one after another
+            // without waiting. Xruns never occur.
+            AsFastAsPossible,
+
+            // Periods are requested only by calling step(), on the calling
+            // thread, so that time advances exactly as the caller decides.
+            Manual
+        };
+
+        NullAudioBackend(Clock clock = Clock::RealTime) noexcept;
+        ~NullAudioBackend() noexcept;
+
+        void start(const AudioOutputConfig& config, Callback callback) override;
+
+        void stop() noexcept override;
+
+        bool isRunning() const noexcept override;
+
+        Clock getClock() const noexcept;
+
+        /**
+         * Requests the given number of periods from the callback, as if that
+         * much time had passed. The clock must be Manual and the backend
+         * must be running.
+         */
+        void step(std::size_t numPeriods = 1);
+
+        /**
+         * The number of frames requested from the callback since the
+         * backend was created.
+         */
+        std::size_t getFramesProcessed() const noexcept;
+
+        /**
+         * Stops requesting periods once the given total number of frames
+         * has been processed, after which isRunning() returns false.
+         * Zero means no limit, which is the default. Must be called while
+         * the backend is not running.
+         */
+        void setFrameLimit(std::size_t numFrames) noexcept;
+
+        /**
+         * Enables or disables keeping a copy of all output. The recording may
+         * grow without bound and allocates on the device thread. This and the
+         * methods below must only be called while the backend is not running.
+         */
+        void setRecording(bool enable) noexcept;
+
+        /**
+         * All recorded output as interleaved frames.
+         */
+        const std::vector<float>& getRecording() const noexcept;
+
+        void clearRecording() noexcept;
+
+    private:
+        // Requests a single period and records it
+        void process(const Callback& callback);
+
+        void run(Callback callback) noexcept;
+
+        const Clock m_clock;
+        AudioOutputConfig m_config;
+        Callback m_manualCallback;
+        std::thread m_thread;
+        std::atomic<bool> m_running;
+        std::atomic<std::size_t> m_framesProcessed;
+        std::size_t m_frameLimit;
+        bool m_recording;
+        std::vector<float> m_buffer;
+        std::vector<float> m_recordedFrames;
+    };
+
+} // namespace flo
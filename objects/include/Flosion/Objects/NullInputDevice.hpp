@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Flosion/Objects/LiveInput.hpp>
+
+#include <vector>
+
+namespace flo {
+
+    /**
+     * NullInputDevice stands in for a recording device, feeding audio from
+     * a buffer to a LiveInput instead. It is meant to be stepped together
+     * with a NullAudioBackend using the manual clock, by feeding each
+     * period of input before the matching period of output is requested.
+     */
+    class NullInputDevice {
+    public:
+        NullInputDevice(LiveInput& target);
+
+        /**
+         * Replaces the input with the given interleaved stereo frames,
+         * which will be fed from the beginning. If loop is true, the input
+         * is repeated forever, and otherwise nothing is fed after its end.
+         */
+        void setInput(std::vector<float> interleavedStereo, bool loop = false);
+
+        /**
+         * Feeds up to the given number of frames of the input to the
+         * LiveInput. Returns the number of frames that were accepted.
+         * Like LiveInput::pushFrames, this may be called concurrently
+         * with rendering, but only from one thread at a time.
+         */
+        std::size_t feed(std::size_t numFrames) noexcept;
+
+        /**
+         * Whether the whole input has been fed. Never true while looping.
+         */
+        bool isFinished() const noexcept;
+
+    private:
+        LiveInput& m_target;
+        std::vector<float> m_input;
+        std::size_t m_position;
+        bool m_loop;
+    };
+
+} // namespace flo
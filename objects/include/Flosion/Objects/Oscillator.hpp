@@ -8,8 +8,9 @@ namespace flo {
     public:
         void reset() noexcept override;
 
+        // NOTE: the phase is kept in double precision so that it does not drift
         double value = {};
-        double prevReset = {};
+        Number prevReset = {};
     };
 
 
@@ -18,7 +19,7 @@ namespace flo {
      * is called upon, much like Accumulator, but the output value is wrapped
      * to the unit half-open interval [0, 1)
      */
-    class Oscillator : public flo::BorrowingNumberSourceTemplate<OscillatorState> {
+    class Oscillator : public flo::BorrowingNumberSourceTemplate<Oscillator, OscillatorState> {
     public:
         Oscillator();
 
@@ -37,7 +38,9 @@ namespace flo {
         flo::NumberSourceInput reset;
 
     private:
-        double evaluate(OscillatorState* state, const flo::SoundState* context) const noexcept override;
+        Number evaluate(OscillatorState* state, const flo::SoundState* context) const noexcept;
+
+        friend flo::BorrowingNumberSourceTemplate<Oscillator, OscillatorState>;
     };
 
 } // namespace flo
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <Flosion/Core/BorrowingNumberSource.hpp>
-#include <random>
+#include <Flosion/Util/RNG.hpp>
 
 namespace flo {
 
@@ -10,11 +10,16 @@ namespace flo {
 
         void reset() noexcept override;
 
+        // NOTE: the walk is kept in double precision so that small steps are not lost
         double value;
         double velocity;
+
+        // NOTE: this takes a new stream the first time the state is
+        // evaluated after each reset
+        util::CounterRNG rng;
     };
 
-    class RandomWalk : public flo::BorrowingNumberSourceTemplate<RandomWalkState> {
+    class RandomWalk : public flo::BorrowingNumberSourceTemplate<RandomWalk, RandomWalkState> {
     public:
         RandomWalk();
 
@@ -22,10 +27,14 @@ namespace flo {
         flo::NumberSourceInput damping;
         flo::NumberSourceInput bias;
 
+        util::RandomSeed randomSeed;
+
+        void reseed(std::uint64_t seed) noexcept override;
+
     private:
-        std::uniform_real_distribution<double> m_dist;
+        Number evaluate(RandomWalkState* state, const flo::SoundState* context) const noexcept;
 
-        double evaluate(RandomWalkState* state, const flo::SoundState* context) const noexcept override;
+        friend flo::BorrowingNumberSourceTemplate<RandomWalk, RandomWalkState>;
     };
 
 } // namespace flo
@@ -17,17 +17,20 @@ namespace flo {
         double speed;
     };
 
-    class Resampler : public WithCurrentTime<OutOfSync<ControlledSoundSource<ResamplerState>>> {
+    class Resampler : public WithCurrentTime<OutOfSync<ControlledSoundSource<Resampler, ResamplerState>>> {
     public:
         Resampler();
 
-        void renderNextChunk(SoundChunk& chunk, ResamplerState* state) override;
-
         double getTimeSpeed(const SoundState* context) const noexcept override;
 
         flo::SingleSoundInput input;
 
         flo::SoundNumberInput timeSpeed;
+
+    private:
+        void renderNextChunk(SoundChunk& chunk, ResamplerState* state);
+
+        friend ControlledSoundSource<Resampler, ResamplerState>;
     };
 
 } // namespace flo
@@ -33,7 +33,7 @@ namespace flo {
 
 
     private:
-        class Output : public Realtime<ControlledSoundSource<EmptySoundState>> {
+        class Output : public Realtime<ControlledSoundSource<Output, EmptySoundState>> {
         public:
             Output(Router* parent);
 
@@ -43,12 +43,13 @@ namespace flo {
             const NumberInput* getNumberInput(size_t which) const;
 
         private:
-
-            void renderNextChunk(SoundChunk& chunk, EmptySoundState* state) override;
+            void renderNextChunk(SoundChunk& chunk, EmptySoundState* state);
 
             Router* const m_parent;
 
             std::vector<std::unique_ptr<SoundNumberInput>> m_numberInputs;
+
+            friend ControlledSoundSource<Output, EmptySoundState>;
         };
 
         class Input : public SingleSoundInput {
@@ -66,17 +67,18 @@ namespace flo {
             const Router* getRouter() const;
 
         private:
-            class InputNumberSource : public SoundNumberSource<Input> {
+            class InputNumberSource : public SoundNumberSource<InputNumberSource, Input> {
             public:
                 InputNumberSource(Input* parent);
 
-                double evaluate(const StateType* state, const SoundState* context) const noexcept;
-
             private:
+                Number evaluate(const StateType* state, const SoundState* context) const noexcept;
+
                 const Input* m_parent;
                 size_t m_numberSourceIdx;
 
                 friend class Input;
+                friend SoundNumberSource<InputNumberSource, Input>;
             };
 
             Router* const m_router;
@@ -26,7 +26,7 @@ namespace flo {
         RouteType currentRoute;
     };
 
-    class Splicer : public flo::Realtime<flo::ControlledSoundSource<SplicerState>> {
+    class Splicer : public flo::Realtime<flo::ControlledSoundSource<Splicer, SplicerState>> {
     public:
         Splicer();
 
@@ -46,15 +46,18 @@ namespace flo {
         const SoundSource* getInstalledSoundSource() const noexcept;
 
     private:
+        void renderNextChunk(SoundChunk&, SplicerState*);
 
-        class RoutingNode : public flo::Realtime<flo::ControlledSoundSource<EmptySoundState>> {
+        class RoutingNode : public flo::Realtime<flo::ControlledSoundSource<RoutingNode, EmptySoundState>> {
         public:
             RoutingNode(Splicer&);
 
-            void renderNextChunk(SoundChunk&, EmptySoundState*) override;
-
         private:
+            void renderNextChunk(SoundChunk&, EmptySoundState*);
+
             Splicer& m_parentSplicer;
+
+            friend flo::ControlledSoundSource<RoutingNode, EmptySoundState>;
         };
 
         RoutingNode m_routingNode;
@@ -67,7 +70,7 @@ namespace flo {
         SoundSource* m_installedSoundSource;
         SoundInput* m_installedInput;
 
-        void renderNextChunk(SoundChunk&, SplicerState*) override;
+        friend flo::ControlledSoundSource<Splicer, SplicerState>;
     };
 
 } // namespace flo
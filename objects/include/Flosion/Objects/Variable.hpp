@@ -8,17 +8,19 @@ namespace flo {
     public:
         void reset() noexcept override;
 
-        double value{};
+        Number value{};
     };
 
-    class Variable : public flo::BorrowingNumberSourceTemplate<VariableState> {
+    class Variable : public flo::BorrowingNumberSourceTemplate<Variable, VariableState> {
     public:
         Variable();
 
         flo::NumberSourceInput input;
 
     private:
-        double evaluate(VariableState* state, const flo::SoundState* context) const noexcept override;
+        Number evaluate(VariableState* state, const flo::SoundState* context) const noexcept;
+
+        friend flo::BorrowingNumberSourceTemplate<Variable, VariableState>;
     };
 
 } // namespace flo
@@ -6,22 +6,22 @@ namespace flo {
     
     class SineWave : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class SawWave : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class SquareWave : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class TriangleWave : public UnaryFunction {
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
     class PulseWave : public NumberSource {
@@ -32,7 +32,7 @@ namespace flo {
         NumberSourceInput width;
 
     private:
-        double evaluate(const flo::SoundState* context) const noexcept override;
+        Number evaluate(const flo::SoundState* context) const noexcept override;
     };
 
 } // namespace flo
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Flosion/Core/SoundSourceTemplate.hpp>
+#include <Flosion/Util/RNG.hpp>
 
 namespace flo {
 
@@ -12,21 +13,26 @@ namespace flo {
 
         void reset() noexcept override;
 
+        // NOTE: the phase is kept in double precision so that it does not drift
         double phase = 0.0;
+
+        // Used for the initial phase if the phase is not synced.
+        // A new stream is taken with every reset
+        util::CounterRNG rng;
     };
 
-    class WaveGenerator : public flo::Realtime<flo::ControlledSoundSource<WaveGeneratorState>> {
+    class WaveGenerator : public flo::Realtime<flo::ControlledSoundSource<WaveGenerator, WaveGeneratorState>> {
     public:
         WaveGenerator();
 
-        void renderNextChunk(flo::SoundChunk& chunk, WaveGeneratorState* state) override;
-
-        class Phase : public flo::SoundNumberSource<WaveGenerator> {
+        class Phase : public flo::SoundNumberSource<Phase, WaveGenerator> {
         public:
             using SoundNumberSource::SoundNumberSource;
 
         private:
-            double evaluate(const WaveGeneratorState* state, const flo::SoundState* context) const noexcept;
+            Number evaluate(const WaveGeneratorState* state, const flo::SoundState* context) const noexcept;
+
+            friend flo::SoundNumberSource<Phase, WaveGenerator>;
         } phase;
 
         flo::SoundNumberInput waveFunction;
@@ -35,9 +41,17 @@ namespace flo {
         void setPhaseSync(bool enable);
 
         bool getPhaseSync() const noexcept;
+
+        util::RandomSeed randomSeed;
+
+        void reseed(std::uint64_t seed) noexcept override;
     
     private:
+        void renderNextChunk(flo::SoundChunk& chunk, WaveGeneratorState* state);
+
         std::atomic<bool> m_phaseSync;
+
+        friend flo::ControlledSoundSource<WaveGenerator, WaveGeneratorState>;
     };
 
 } // namespace flo
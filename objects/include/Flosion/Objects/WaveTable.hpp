@@ -21,10 +21,10 @@ namespace flo {
         flo::Signal<std::size_t> onChange;
 
     private:
-        double evaluate(const SoundState*) const noexcept override;
+        Number evaluate(const SoundState*) const noexcept override;
 
         static constexpr std::size_t array_size = 256;
-        std::array<std::atomic<double>, array_size> m_array;
+        std::array<std::atomic<Number>, array_size> m_array;
     };
 
 } // namespace flo
@@ -12,19 +12,19 @@ namespace flo {
     
     }
 
-    double ADSR::evaluate(const SoundState* context) const noexcept {
-        const auto a = std::max(0.0, attackDuration.getValue(context));
-        const auto d = std::max(0.0, decayDuration.getValue(context));
-        const auto s = std::clamp(sustainLevel.getValue(context), 0.0, 1.0);
-        const auto l = std::max(0.0, totalDuration.getValue(context));
-        const auto t = std::clamp(currentTime.getValue(context), 0.0, l);
-        const auto t_rel = std::clamp(timeOfRelease.getValue(context), 0.0, l);
+    Number ADSR::evaluate(const SoundState* context) const noexcept {
+        const auto a = std::max(Number{0.0}, attackDuration.getValue(context));
+        const auto d = std::max(Number{0.0}, decayDuration.getValue(context));
+        const auto s = std::clamp(sustainLevel.getValue(context), Number{0.0}, Number{1.0});
+        const auto l = std::max(Number{0.0}, totalDuration.getValue(context));
+        const auto t = std::clamp(currentTime.getValue(context), Number{0.0}, l);
+        const auto t_rel = std::clamp(timeOfRelease.getValue(context), Number{0.0}, l);
 
         if (t < 1e-6 || l < 1e-6){
             return 0.0;
         }
 
-        double v = 0.0;
+        Number v = 0.0;
 
         if (t < a){
             // attack
@@ -33,7 +33,7 @@ namespace flo {
         } else if (t - a < d){
             // decay
             assert(d > 0.0);
-            v = 1.0 - (t - a) * (1.0 - s) / d;
+            v = Number{1.0} - (t - a) * (Number{1.0} - s) / d;
         } else {
             // sustain
             v = s;
@@ -48,7 +48,7 @@ namespace flo {
             if (rem < 1e-6){
                 return 0.0;
             }
-            const auto f = 1.0 - (t - t_rel) / rem;
+            const auto f = Number{1.0} - (t - t_rel) / rem;
             return f * v;
         }
 
@@ -4,7 +4,7 @@ namespace flo {
 
     void AccumulatorState::reset() noexcept {
         value = 0.0;
-        prevReset = std::numeric_limits<double>::min();
+        prevReset = std::numeric_limits<Number>::min();
     }
 
 
@@ -15,14 +15,14 @@ namespace flo {
 
     }
 
-    double Accumulator::evaluate(AccumulatorState* state, const flo::SoundState* context) const noexcept {
+    Number Accumulator::evaluate(AccumulatorState* state, const flo::SoundState* context) const noexcept {
         state->value += input.getValue(context);
         auto r = reset.getValue(context);
         if (r > state->prevReset) {
             state->value = 0.0;
         }
         state->prevReset = r;
-        return state->value;
+        return static_cast<Number>(state->value);
     }
 
 } // namespace flo
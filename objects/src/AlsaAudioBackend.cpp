@@ -0,0 +1,171 @@
+#include <Flosion/Objects/AlsaAudioBackend.hpp>
+#include <Flosion/Core/Profiler.hpp>
+
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+#ifdef FLOSION_HAS_ALSA
+#include <alsa/asoundlib.h>
+#include <cerrno>
+#endif
+
+namespace flo {
+
+    AlsaAudioBackend::AlsaAudioBackend(std::string deviceName)
+        : m_deviceName(std::move(deviceName))
+        , m_pcm(nullptr)
+        , m_numChannels(0)
+        , m_periodSize(0)
+        , m_realtimePriority(false)
+        , m_running(false) {
+
+    }
+
+    AlsaAudioBackend::~AlsaAudioBackend() noexcept {
+        stop();
+    }
+
+    bool AlsaAudioBackend::isRunning() const noexcept {
+        return m_running.load();
+    }
+
+    const std::string& AlsaAudioBackend::getDeviceName() const noexcept {
+        return m_deviceName;
+    }
+
+    std::size_t AlsaAudioBackend::getPeriodSize() const noexcept {
+        return m_periodSize;
+    }
+
+#ifdef FLOSION_HAS_ALSA
+
+    namespace {
+
+        void check(int err, const char* what){
+            if (err < 0){
+                throw std::runtime_error(std::string("ALSA: ") + what + ": " + snd_strerror(err));
+            }
+        }
+
+    } // anonymous namespace
+
+    void AlsaAudioBackend::start(const AudioOutputConfig& config, Callback callback){
+        if (m_running.load()){
+            return;
+        }
+        assert(!m_pcm);
+
+        snd_pcm_t* pcm = nullptr;
+        check(snd_pcm_open(&pcm, m_deviceName.c_str(), SND_PCM_STREAM_PLAYBACK, 0), "failed to open device");
+
+        try {
+            snd_pcm_hw_params_t* hw = nullptr;
+            snd_pcm_hw_params_alloca(&hw);
+            check(snd_pcm_hw_params_any(pcm, hw), "no hardware configurations available");
+            check(snd_pcm_hw_params_set_access(pcm, hw, SND_PCM_ACCESS_RW_INTERLEAVED), "interleaved access is not supported");
+            check(snd_pcm_hw_params_set_format(pcm, hw, SND_PCM_FORMAT_FLOAT), "float32 samples are not supported");
+            check(snd_pcm_hw_params_set_channels(pcm, hw, static_cast<unsigned int>(config.numChannels)), "the number of channels is not supported");
+
+            auto rate = static_cast<unsigned int>(sampleFrequency);
+            check(snd_pcm_hw_params_set_rate_near(pcm, hw, &rate, nullptr), "failed to set the sample rate");
+            if (rate != sampleFrequency){
+                throw std::runtime_error("ALSA: the device does not support the sample frequency");
+            }
+
+            auto periodSize = static_cast<snd_pcm_uframes_t>(config.periodSize);
+            check(snd_pcm_hw_params_set_period_size_near(pcm, hw, &periodSize, nullptr), "failed to set the period size");
+            auto periods = static_cast<unsigned int>(config.numPeriods);
+            check(snd_pcm_hw_params_set_periods_near(pcm, hw, &periods, nullptr), "failed to set the number of periods");
+            check(snd_pcm_hw_params(pcm, hw), "failed to apply the hardware configuration");
+            check(snd_pcm_hw_params_get_period_size(hw, &periodSize, nullptr), "failed to get the period size");
+
+            snd_pcm_sw_params_t* sw = nullptr;
+            snd_pcm_sw_params_alloca(&sw);
+            check(snd_pcm_sw_params_current(pcm, sw), "failed to get the software configuration");
+            check(snd_pcm_sw_params_set_start_threshold(pcm, sw, periodSize), "failed to set the start threshold");
+            check(snd_pcm_sw_params_set_avail_min(pcm, sw, periodSize), "failed to set the minimum available frames");
+            check(snd_pcm_sw_params(pcm, sw), "failed to apply the software configuration");
+            check(snd_pcm_prepare(pcm), "failed to prepare the device");
+
+            m_periodSize = static_cast<std::size_t>(periodSize);
+        } catch (...) {
+            snd_pcm_close(pcm);
+            throw;
+        }
+
+        m_pcm = pcm;
+        m_numChannels = config.numChannels;
+        m_realtimePriority = config.realtimePriority;
+        m_buffer.assign(m_numChannels * m_periodSize, 0.0f);
+        m_running.store(true);
+        m_thread = std::thread([this, cb = std::move(callback)]() mutable {
+            run(std::move(cb));
+        });
+    }
+
+    void AlsaAudioBackend::stop() noexcept {
+        m_running.store(false);
+        if (m_thread.joinable()){
+            m_thread.join();
+        }
+        if (m_pcm){
+            const auto pcm = static_cast<snd_pcm_t*>(m_pcm);
+            snd_pcm_drop(pcm);
+            snd_pcm_close(pcm);
+            m_pcm = nullptr;
+        }
+    }
+
+    void AlsaAudioBackend::run(Callback callback) noexcept {
+        const auto pcm = static_cast<snd_pcm_t*>(m_pcm);
+
+        Profiler::registerCurrentThread();
+        if (m_realtimePriority){
+            promoteCurrentThread();
+        }
+
+        while (m_running.load(std::memory_order_relaxed)){
+            callback(m_buffer.data(), m_periodSize);
+
+            // NOTE: snd_pcm_writei blocks until the device has room for
+            // the period, which is what paces this thread
+            auto data = m_buffer.data();
+            auto remaining = static_cast<snd_pcm_uframes_t>(m_periodSize);
+            while (remaining > 0){
+                const auto written = snd_pcm_writei(pcm, data, remaining);
+                if (written == -EPIPE){
+                    // the device ran out of frames
+                    reportXrun();
+                    snd_pcm_prepare(pcm);
+                } else if (written < 0){
+                    // e.g. the device was suspended
+                    if (snd_pcm_recover(pcm, static_cast<int>(written), 1) < 0){
+                        m_running.store(false);
+                        return;
+                    }
+                } else {
+                    data += static_cast<std::size_t>(written) * m_numChannels;
+                    remaining -= static_cast<snd_pcm_uframes_t>(written);
+                }
+            }
+        }
+    }
+
+#else
+
+    void AlsaAudioBackend::start(const AudioOutputConfig&, Callback){
+        throw std::runtime_error("Flosion was built without ALSA support");
+    }
+
+    void AlsaAudioBackend::stop() noexcept {
+        assert(!m_running.load());
+    }
+
+    void AlsaAudioBackend::run(Callback) noexcept {
+
+    }
+
+#endif
+
+} // namespace flo
@@ -1,4 +1,7 @@
 #include <Flosion/Objects/AudioClip.hpp>
+#include <Flosion/Core/SampleFormat.hpp>
+
+#include <algorithm>
 
 namespace flo {
 
@@ -39,37 +42,61 @@ namespace flo {
         }
 
         const auto c = m_buffer.getChannelCount();
-        const auto l = m_buffer.getSampleCount();
+        const auto l = static_cast<std::size_t>(m_buffer.getSampleCount());
         const auto s = m_buffer.getSamples();
         const auto r = m_buffer.getSampleRate(); // TODO: use this and resample if needed
-        constexpr auto k = 1.0f / static_cast<float>(std::numeric_limits<int16_t>::max());
 
+        // NOTE: the clip is decoded in runs of consecutive samples,
+        // which only end at the end of the clip or of the chunk
         if (c == 1){
-            for (std::size_t i = 0; i < chunk.size; ++i){
+            // A mono clip is the same in every channel
+            const auto out = chunk.channel(0);
+            std::size_t i = 0;
+            while (i < chunk.size){
                 if (m_looping && state->index >= l) {
                     state->index = 0;
                 }
-                if (state->index < l) {
-                    chunk.l(i) = s[state->index] * k;
-                    chunk.r(i) = s[state->index] * k;
-                    state->index += 1;
-                } else {
-                    chunk[i].silence();
+                if (state->index >= l) {
+                    std::fill(out + i, out + chunk.size, 0.0f);
+                    break;
                 }
+                const auto n = std::min(chunk.size - i, l - state->index);
+                decodeSamples(s + state->index, SampleFormat::Int16, n, out + i);
+                state->index += n;
+                i += n;
             }
+            chunk.spreadChannel(0);
             return;
         } else if (c == 2){
-            for (std::size_t i = 0; i < chunk.size; ++i){
-                if (m_looping && state->index * 2 + 1 >= l) {
+            // A stereo clip only fills the first two channels,
+            // or is mixed down if the chunk is mono
+            if (chunk.numChannels() > 2){
+                chunk.silence();
+            }
+            const auto frames = l / 2;
+            std::size_t i = 0;
+            while (i < chunk.size){
+                if (m_looping && state->index >= frames) {
                     state->index = 0;
                 }
-                if (state->index * 2 + 1 < l) {
-                    chunk.l(i) = s[state->index * 2 + 0] * k;
-                    chunk.r(i) = s[state->index * 2 + 1] * k;
-                    state->index += 1;
+                if (state->index >= frames) {
+                    for (; i < chunk.size; ++i){
+                        chunk[i].silence();
+                    }
+                    break;
+                }
+                const auto n = std::min(chunk.size - i, frames - state->index);
+                if (chunk.numChannels() == 1){
+                    constexpr auto k = 1.0f / static_cast<float>(std::numeric_limits<int16_t>::max());
+                    for (std::size_t j = 0; j < n; ++j){
+                        const auto f = s + 2 * (state->index + j);
+                        chunk[i + j] = Sample{f[0] * k, f[1] * k};
+                    }
                 } else {
-                    chunk[i].silence();
+                    decodeInterleaved(s + 2 * state->index, SampleFormat::Int16, 2, n, chunk, i);
                 }
+                state->index += n;
+                i += n;
             }
             return;
         } else {
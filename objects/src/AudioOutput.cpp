@@ -0,0 +1,122 @@
+#include <Flosion/Objects/AudioOutput.hpp>
+#include <Flosion/Core/SampleFormat.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace flo {
+
+    AudioOutputBackend::AudioOutputBackend() noexcept
+        : m_xruns(0) {
+
+    }
+
+    std::size_t AudioOutputBackend::getXrunCount() const noexcept {
+        return m_xruns.load(std::memory_order_relaxed);
+    }
+
+    void AudioOutputBackend::reportXrun() noexcept {
+        m_xruns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool AudioOutputBackend::promoteCurrentThread() noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+        auto param = sched_param{};
+        param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+        if (param.sched_priority < 0){
+            return false;
+        }
+        // NOTE: this fails with EPERM unless the process has CAP_SYS_NICE
+        // or a suitable RLIMIT_RTPRIO, which is not an error
+        return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+#else
+        return false;
+#endif
+    }
+
+    AudioOutput::AudioOutput(std::unique_ptr<AudioOutputBackend> backend, const AudioOutputConfig& config)
+        : m_backend(std::move(backend))
+        , m_config(config)
+        , m_chunk(config.numChannels)
+        , m_chunkPosition(SoundChunk::size) {
+        assert(m_backend);
+        assert(m_config.periodSize > 0);
+        assert(m_config.numPeriods > 0);
+        soundResult.setNumChannels(m_config.numChannels);
+        if (m_config.lookahead > 0){
+            m_lookahead = std::make_unique<LookaheadRenderer>(soundResult, m_config.lookahead);
+        }
+    }
+
+    AudioOutput::~AudioOutput() noexcept {
+        stop();
+    }
+
+    void AudioOutput::start(){
+        if (m_backend->isRunning()){
+            return;
+        }
+        if (m_lookahead){
+            m_lookahead->start();
+        }
+        m_backend->start(m_config, [this](float* interleaved, std::size_t numFrames){
+            render(interleaved, numFrames);
+        });
+    }
+
+    void AudioOutput::stop() noexcept {
+        m_backend->stop();
+        if (m_lookahead){
+            m_lookahead->stop();
+        }
+    }
+
+    bool AudioOutput::isRunning() const noexcept {
+        return m_backend->isRunning();
+    }
+
+    const AudioOutputConfig& AudioOutput::getConfig() const noexcept {
+        return m_config;
+    }
+
+    AudioOutputBackend& AudioOutput::getBackend() noexcept {
+        return *m_backend;
+    }
+
+    const AudioOutputBackend& AudioOutput::getBackend() const noexcept {
+        return *m_backend;
+    }
+
+    const LookaheadRenderer* AudioOutput::getLookaheadRenderer() const noexcept {
+        return m_lookahead.get();
+    }
+
+    void AudioOutput::render(float* interleaved, std::size_t numFrames) noexcept {
+        const auto n = m_config.numChannels;
+        while (numFrames > 0){
+            if (m_chunkPosition == SoundChunk::size){
+                if (m_lookahead){
+                    if (!m_lookahead->getNextChunk(m_chunk)){
+                        soundResult.getDeadlineMonitor().reportXrun();
+                    }
+                } else {
+                    soundResult.getNextChunk(m_chunk);
+                }
+                m_chunk.clamp(-1.0f, 1.0f);
+                m_chunkPosition = 0;
+            }
+            const auto k = std::min(numFrames, SoundChunk::size - m_chunkPosition);
+            interleave(m_chunk, m_chunkPosition, k, interleaved);
+            interleaved += n * k;
+            numFrames -= k;
+            m_chunkPosition += k;
+        }
+    }
+
+} // namespace flo
@@ -1,33 +1,64 @@
 #include <Flosion/Objects/DAC.hpp>
+#include <Flosion/Core/Profiler.hpp>
 #include <Flosion/Core/Sample.hpp>
 
 namespace flo {
 
-    DAC::DAC()
-        : m_buffer(2 * flo::SoundChunk::size, 0) {
+    DAC::DAC(std::size_t numChannels, std::size_t lookahead)
+        : m_chunk(numChannels)
+        , m_encoder(flo::SampleFormat::Int16, flo::Dither::Triangular)
+        , m_buffer(numChannels * flo::SoundChunk::size, 0) {
 
-        initialize(2, sampleFrequency);
+        soundResult.setNumChannels(numChannels);
+        if (lookahead > 0){
+            m_lookahead = std::make_unique<flo::LookaheadRenderer>(soundResult, lookahead);
+        }
+        initialize(static_cast<unsigned int>(numChannels), sampleFrequency);
+    }
+
+    DAC::~DAC(){
+        // The stream's thread must be stopped before the renderer it reads from
+        stop();
+    }
+
+    const flo::LookaheadRenderer* DAC::getLookaheadRenderer() const noexcept {
+        return m_lookahead.get();
     }
 
     bool DAC::onGetData(sf::SoundStream::Chunk& out){
-        soundResult.getNextChunk(m_chunk);
-        for (size_t i = 0; i < flo::SoundChunk::size; ++i){
-            const auto lClamped = std::clamp(m_chunk.l(i), -1.0f, 1.0f);
-            const auto rClamped = std::clamp(m_chunk.r(i), -1.0f, 1.0f);
-            const auto lScaled = static_cast<float>(std::numeric_limits<std::int16_t>::max()) * lClamped;
-            const auto rScaled = static_cast<float>(std::numeric_limits<std::int16_t>::max()) * rClamped;
-            m_buffer[2 * i + 0] = static_cast<sf::Int16>(lScaled);
-            m_buffer[2 * i + 1] = static_cast<sf::Int16>(rScaled);
+        if (m_lookahead){
+            // NOTE: sf::SoundStream::play() can't be overridden, so rendering
+            // ahead starts with the first request. That chunk is silent.
+            const auto started = m_lookahead->isRunning();
+            if (!started){
+                m_lookahead->start();
+            }
+            if (!m_lookahead->getNextChunk(m_chunk) && started){
+                soundResult.getDeadlineMonitor().reportXrun();
+            }
+        } else {
+            // NOTE: likewise, the stream's thread can only be registered
+            // with the profiler once it first asks for audio
+            Profiler::registerCurrentThread();
+            soundResult.getNextChunk(m_chunk);
         }
+        const auto n = m_chunk.numChannels();
+        m_buffer.resize(n * flo::SoundChunk::size);
+        m_encoder.encode(m_chunk, 0, flo::SoundChunk::size, m_buffer.data());
 
-        out.sampleCount = 2 * flo::SoundChunk::size;
+        out.sampleCount = n * flo::SoundChunk::size;
         out.samples = &m_buffer[0];
 
         return true;
     }
 
     void DAC::onSeek(sf::Time){
-        // Nothing to do
+        // This is called when the stream is stopped. Stop rendering ahead
+        // too, so that the sound result may be reset safely, and discard
+        // the chunks that were rendered ahead of the old position.
+        if (m_lookahead){
+            m_lookahead->stop();
+        }
     }
 
 } // namespace flo
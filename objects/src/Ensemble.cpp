@@ -13,7 +13,7 @@ namespace flo {
 
     Ensemble::Ensemble()
         : frequencyIn(this, 250.0)
-        , frequencySpread(this, 0.005)
+        , frequencySpread(this, Number{0.005})
         , input(this) {
 
         for (size_t k = 0; k < numVoices; ++k){
@@ -29,22 +29,26 @@ namespace flo {
     
     void Ensemble::renderNextChunk(flo::SoundChunk& chunk, EnsembleState* state){
         if (!state->init){
-            auto dist = std::normal_distribution<double>(0.0, 1.0);
+            state->rng = randomSeed.makeStream();
+            double offsets[numVoices];
+            state->rng.fillNormal(offsets, numVoices);
             for (size_t k = 0; k < numVoices; ++k){
-                input.getState(this, state, k)->randomOffset = dist(util::getRandomEngine());
+                input.getState(this, state, k)->randomOffset = static_cast<Number>(offsets[k]);
             }
             state->init = true;
         }
         chunk.silence();
+        state->buffer.setNumChannels(chunk.numChannels());
         for (size_t k = 0; k < numVoices; ++k){
             input.getNextChunkFor(state->buffer, this, state, k);
-            for (size_t i = 0; i < flo::SoundChunk::size; ++i){
-                state->adjustTime(static_cast<std::uint32_t>(i));
-                chunk[i] += state->buffer[i] * 0.05f;
-            }
+            chunk.mixAdd(state->buffer, 0.05f);
         }
     }
 
+    void Ensemble::reseed(std::uint64_t seed) noexcept {
+        randomSeed.set(seed);
+    }
+
     Ensemble::Input::Input(Ensemble* ensemble)
         : MultiSoundInput(ensemble)
         , m_ensemble(ensemble)
@@ -52,11 +56,11 @@ namespace flo {
     
     }
 
-    double Ensemble::Input::Frequency::evaluate(const EnsembleInputState* state, const flo::SoundState* context) const noexcept {
+    Number Ensemble::Input::Frequency::evaluate(const EnsembleInputState* state, const flo::SoundState* context) const noexcept {
         const auto& e = this->getOwner()->m_ensemble;
         const auto f = e->frequencyIn.getValue(context);
         const auto s = e->frequencySpread.getValue(context);
-        return (1.0 + state->randomOffset * s) * f;
+        return (Number{1.0} + state->randomOffset * s) * f;
     }
 
 } // namespace flo
@@ -4,25 +4,25 @@ namespace flo {
 
     void ExponentialSmootherState::reset() noexcept {
         value = 0.0;
-        prevReset = std::numeric_limits<double>::min();
+        prevReset = std::numeric_limits<Number>::min();
     }
 
     ExponentialSmoother::ExponentialSmoother()
         : input(this)
-        , decayRate(this, 0.1)
+        , decayRate(this, Number{0.1})
         , reset(this) {
 
     }
 
-    double ExponentialSmoother::evaluate(ExponentialSmootherState* state, const flo::SoundState* context) const noexcept {
-        auto v = input.getValue(context);
-        auto d = decayRate.getValue(context);
+    Number ExponentialSmoother::evaluate(ExponentialSmootherState* state, const flo::SoundState* context) const noexcept {
+        const auto v = static_cast<double>(input.getValue(context));
+        const auto d = static_cast<double>(decayRate.getValue(context));
         state->value += d * (v - state->value);
         auto r = reset.getValue(context);
         if (r > state->prevReset) {
             state->value = v;
         }
-        return state->value;
+        return static_cast<Number>(state->value);
     }
 
 } // namespace flo
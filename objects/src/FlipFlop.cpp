@@ -4,7 +4,7 @@ namespace flo {
 
     void FlipFlopState::reset() noexcept {
         storedValue = 0.0;
-        prevClock = std::numeric_limits<double>::min();
+        prevClock = std::numeric_limits<Number>::min();
     }
 
     FlipFlop::FlipFlop()
@@ -13,7 +13,7 @@ namespace flo {
 
     }
 
-    double FlipFlop::evaluate(FlipFlopState* state, const flo::SoundState* context) const noexcept {
+    Number FlipFlop::evaluate(FlipFlopState* state, const flo::SoundState* context) const noexcept {
         auto c = clock.getValue(context);
         if (c > state->prevClock){
             state->storedValue = input.getValue(context);
@@ -6,12 +6,12 @@
 namespace flo {
     
     namespace {
-        const double pi = 3.141592653589793;
-        const double tau = 6.283185307179586;
-        const double eulersConstant = 2.718281828459045;
+        const Number pi = static_cast<Number>(3.141592653589793);
+        const Number tau = static_cast<Number>(6.283185307179586);
+        const Number eulersConstant = static_cast<Number>(2.718281828459045);
     }
 
-    double Add::evaluate(const flo::SoundState* context) const noexcept {
+    Number Add::evaluate(const flo::SoundState* context) const noexcept {
         return input1.getValue(context) + input2.getValue(context);
     }
 
@@ -19,11 +19,11 @@ namespace flo {
         
     }
 
-    double Multiply::evaluate(const flo::SoundState* context) const noexcept {
+    Number Multiply::evaluate(const flo::SoundState* context) const noexcept {
         return input1.getValue(context) * input2.getValue(context);
     }
 
-    double Subtract::evaluate(const flo::SoundState* context) const noexcept {
+    Number Subtract::evaluate(const flo::SoundState* context) const noexcept {
         return input1.getValue(context) - input2.getValue(context);
     }
 
@@ -31,146 +31,146 @@ namespace flo {
 
     }
 
-    double Divide::evaluate(const flo::SoundState* context) const noexcept {
+    Number Divide::evaluate(const flo::SoundState* context) const noexcept {
         return input1.getValue(context) / input2.getValue(context);
     }
 
-    double PiConstant::evaluate(const flo::SoundState*) const noexcept {
+    Number PiConstant::evaluate(const flo::SoundState*) const noexcept {
         return pi;
     }
 
-    double EulersConstant::evaluate(const flo::SoundState*) const noexcept {
+    Number EulersConstant::evaluate(const flo::SoundState*) const noexcept {
         return eulersConstant;
     }
 
-    double TauConstant::evaluate(const flo::SoundState*) const noexcept {
+    Number TauConstant::evaluate(const flo::SoundState*) const noexcept {
         return tau;
     }
 
-    double SampleFrequencyConstant::evaluate(const flo::SoundState*) const noexcept {
-        return static_cast<double>(sampleFrequency);
+    Number SampleFrequencyConstant::evaluate(const flo::SoundState*) const noexcept {
+        return static_cast<Number>(sampleFrequency);
     }
 
-    double Abs::evaluate(const flo::SoundState* context) const noexcept {
+    Number Abs::evaluate(const flo::SoundState* context) const noexcept {
         return std::abs(input.getValue(context));
     }
 
-    double SquareRoot::evaluate(const flo::SoundState* context) const noexcept {
+    Number SquareRoot::evaluate(const flo::SoundState* context) const noexcept {
         return std::sqrt(input.getValue(context));
     }
 
-    double CubeRoot::evaluate(const flo::SoundState* context) const noexcept {
+    Number CubeRoot::evaluate(const flo::SoundState* context) const noexcept {
         return std::cbrt(input.getValue(context));
     }
 
-    double Square::evaluate(const flo::SoundState* context) const noexcept {
+    Number Square::evaluate(const flo::SoundState* context) const noexcept {
         const auto x = input.getValue(context);
         return x * x;
     }
 
-    double Log::evaluate(const flo::SoundState* context) const noexcept {
+    Number Log::evaluate(const flo::SoundState* context) const noexcept {
         return std::log(input.getValue(context));
     }
 
-    double Log2::evaluate(const flo::SoundState* context) const noexcept {
+    Number Log2::evaluate(const flo::SoundState* context) const noexcept {
         return std::log2(input.getValue(context));
     }
 
-    double Log10::evaluate(const flo::SoundState* context) const noexcept {
+    Number Log10::evaluate(const flo::SoundState* context) const noexcept {
         return std::log10(input.getValue(context));
     }
 
-    double Exp::evaluate(const flo::SoundState* context) const noexcept {
+    Number Exp::evaluate(const flo::SoundState* context) const noexcept {
         return std::exp(input.getValue(context));
     }
 
-    double Exp2::evaluate(const flo::SoundState* context) const noexcept {
+    Number Exp2::evaluate(const flo::SoundState* context) const noexcept {
         return std::exp2(input.getValue(context));
     }
 
-    double Exp10::evaluate(const flo::SoundState* context) const noexcept {
-        constexpr auto log10 = 2.302585092994;
+    Number Exp10::evaluate(const flo::SoundState* context) const noexcept {
+        constexpr auto log10 = static_cast<Number>(2.302585092994);
         return std::exp(log10 * input.getValue(context));
     }
 
-    double Sin::evaluate(const flo::SoundState* context) const noexcept {
+    Number Sin::evaluate(const flo::SoundState* context) const noexcept {
         return std::sin(input.getValue(context));
     }
 
-    double Cos::evaluate(const flo::SoundState* context) const noexcept {
+    Number Cos::evaluate(const flo::SoundState* context) const noexcept {
         return std::cos(input.getValue(context));
     }
 
-    double Tan::evaluate(const flo::SoundState* context) const noexcept {
+    Number Tan::evaluate(const flo::SoundState* context) const noexcept {
         return std::tan(input.getValue(context));
     }
 
-    double Asin::evaluate(const flo::SoundState* context) const noexcept {
+    Number Asin::evaluate(const flo::SoundState* context) const noexcept {
         return std::asin(input.getValue(context));
     }
 
-    double Acos::evaluate(const flo::SoundState* context) const noexcept {
+    Number Acos::evaluate(const flo::SoundState* context) const noexcept {
         return std::acos(input.getValue(context));
     }
 
-    double Atan::evaluate(const flo::SoundState* context) const noexcept {
+    Number Atan::evaluate(const flo::SoundState* context) const noexcept {
         return std::atan(input.getValue(context));
     }
 
-    double Sinh::evaluate(const flo::SoundState* context) const noexcept {
+    Number Sinh::evaluate(const flo::SoundState* context) const noexcept {
         return std::sinh(input.getValue(context));
     }
 
-    double Cosh::evaluate(const flo::SoundState* context) const noexcept {
+    Number Cosh::evaluate(const flo::SoundState* context) const noexcept {
         return std::cosh(input.getValue(context));
     }
 
-    double Tanh::evaluate(const flo::SoundState* context) const noexcept {
+    Number Tanh::evaluate(const flo::SoundState* context) const noexcept {
         return std::tanh(input.getValue(context));
     }
 
-    double Asinh::evaluate(const flo::SoundState* context) const noexcept {
-        return std::atanh(input.getValue(context));
+    Number Asinh::evaluate(const flo::SoundState* context) const noexcept {
+        return std::asinh(input.getValue(context));
     }
 
-    double Acosh::evaluate(const flo::SoundState* context) const noexcept {
+    Number Acosh::evaluate(const flo::SoundState* context) const noexcept {
         return std::acosh(input.getValue(context));
     }
 
-    double Atanh::evaluate(const flo::SoundState* context) const noexcept {
+    Number Atanh::evaluate(const flo::SoundState* context) const noexcept {
         return std::atanh(input.getValue(context));
     }
 
-    double Ceil::evaluate(const flo::SoundState* context) const noexcept {
+    Number Ceil::evaluate(const flo::SoundState* context) const noexcept {
         return std::ceil(input.getValue(context));
     }
 
-    double Floor::evaluate(const flo::SoundState* context) const noexcept {
+    Number Floor::evaluate(const flo::SoundState* context) const noexcept {
         return std::floor(input.getValue(context));
     }
 
-    double Round::evaluate(const flo::SoundState* context) const noexcept {
+    Number Round::evaluate(const flo::SoundState* context) const noexcept {
         return std::round(input.getValue(context));
     }
 
-    double Frac::evaluate(const flo::SoundState* context) const noexcept {
+    Number Frac::evaluate(const flo::SoundState* context) const noexcept {
         const auto x = input.getValue(context);
         return x - std::floor(x);
     }
 
-    double PlusOne::evaluate(const flo::SoundState* context) const noexcept {
-        return 1.0 + input.getValue(context);
+    Number PlusOne::evaluate(const flo::SoundState* context) const noexcept {
+        return Number{1.0} + input.getValue(context);
     }
 
-    double MinusOne::evaluate(const flo::SoundState* context) const noexcept {
-        return input.getValue(context) - 1.0;
+    Number MinusOne::evaluate(const flo::SoundState* context) const noexcept {
+        return input.getValue(context) - Number{1.0};
     }
 
-    double OneMinus::evaluate(const flo::SoundState* context) const noexcept {
-        return 1.0 - input.getValue(context);
+    Number OneMinus::evaluate(const flo::SoundState* context) const noexcept {
+        return Number{1.0} - input.getValue(context);
     }
 
-    double Negate::evaluate(const flo::SoundState* context) const noexcept {
+    Number Negate::evaluate(const flo::SoundState* context) const noexcept {
         return -input.getValue(context);
     }
 
@@ -179,27 +179,27 @@ namespace flo {
 
     }
 
-    double Reciprocal::evaluate(const flo::SoundState* context) const noexcept {
-        return 1.0 / input.getValue(context);
+    Number Reciprocal::evaluate(const flo::SoundState* context) const noexcept {
+        return Number{1.0} / input.getValue(context);
     }
 
-    double StdToNorm::evaluate(const flo::SoundState* context) const noexcept {
-        return input.getValue(context) * 0.5 + 0.5;
+    Number StdToNorm::evaluate(const flo::SoundState* context) const noexcept {
+        return input.getValue(context) * Number{0.5} + Number{0.5};
     }
 
-    double NormToStd::evaluate(const flo::SoundState* context) const noexcept {
-        return input.getValue(context) * 2.0 - 1.0;
+    Number NormToStd::evaluate(const flo::SoundState* context) const noexcept {
+        return input.getValue(context) * Number{2.0} - Number{1.0};
     }
 
-    double Sigmoid::evaluate(const flo::SoundState* context) const noexcept {
-        return 1.0 / (1.0 + std::exp(-input.getValue(context)));
+    Number Sigmoid::evaluate(const flo::SoundState* context) const noexcept {
+        return Number{1.0} / (Number{1.0} + std::exp(-input.getValue(context)));
     }
 
-    double Min::evaluate(const flo::SoundState* context) const noexcept {
+    Number Min::evaluate(const flo::SoundState* context) const noexcept {
         return std::min(input1.getValue(context), input2.getValue(context));
     }
 
-    double Max::evaluate(const flo::SoundState* context) const noexcept {
+    Number Max::evaluate(const flo::SoundState* context) const noexcept {
         return std::max(input1.getValue(context), input2.getValue(context));
     }
 
@@ -208,7 +208,7 @@ namespace flo {
 
     }
 
-    double Pow::evaluate(const flo::SoundState* context) const noexcept {
+    Number Pow::evaluate(const flo::SoundState* context) const noexcept {
         return std::pow(input1.getValue(context), input2.getValue(context));
     }
 
@@ -216,11 +216,11 @@ namespace flo {
         : BinaryFunction(1.0, eulersConstant) {
     }
 
-    double LogBase::evaluate(const flo::SoundState* context) const noexcept {
+    Number LogBase::evaluate(const flo::SoundState* context) const noexcept {
         return std::log(input1.getValue(context)) / std::log(input2.getValue(context));
     }
 
-    double Hypot::evaluate(const flo::SoundState* context) const noexcept {
+    Number Hypot::evaluate(const flo::SoundState* context) const noexcept {
         return std::hypot(input1.getValue(context), input2.getValue(context));
     }
 
@@ -229,30 +229,51 @@ namespace flo {
     
     }
 
-    double Atan2::evaluate(const flo::SoundState* context) const noexcept {
+    Number Atan2::evaluate(const flo::SoundState* context) const noexcept {
         return std::atan2(input2.getValue(context), input1.getValue(context));
     }
 
+    void RandomState::reset() noexcept {
+        rng = util::CounterRNG{};
+    }
+
     RandomUniform::RandomUniform()
-        : m_dist(0.0, 1.0) {
+        : minimum(this, 0.0)
+        , maximum(this, 0.0) {
     
     }
 
-    double RandomUniform::evaluate(const flo::SoundState* context) const noexcept {
-        const auto min = input1.getValue(context);
-        const auto max = input2.getValue(context);
-        return min + m_dist(util::getRandomEngine()) * (max - min);
+    Number RandomUniform::evaluate(RandomState* state, const flo::SoundState* context) const noexcept {
+        const auto min = minimum.getValue(context);
+        const auto max = maximum.getValue(context);
+        if (!state->rng.isSeeded()){
+            state->rng = randomSeed.makeStream();
+        }
+        const auto u = static_cast<Number>(state->rng.uniform());
+        return min + u * (max - min);
+    }
+
+    void RandomUniform::reseed(std::uint64_t seed) noexcept {
+        randomSeed.set(seed);
     }
 
     RandomNormal::RandomNormal()
-        : m_dist(0.0, 1.0) {
+        : mean(this, 0.0)
+        , deviation(this, 0.0) {
     
     }
 
-    double RandomNormal::evaluate(const flo::SoundState* context) const noexcept {
-        const auto mean = input1.getValue(context);
-        const auto stddev = input2.getValue(context);
-        return mean + stddev * m_dist(util::getRandomEngine());
+    Number RandomNormal::evaluate(RandomState* state, const flo::SoundState* context) const noexcept {
+        const auto m = mean.getValue(context);
+        const auto d = deviation.getValue(context);
+        if (!state->rng.isSeeded()){
+            state->rng = randomSeed.makeStream();
+        }
+        return m + d * static_cast<Number>(state->rng.normal());
+    }
+
+    void RandomNormal::reseed(std::uint64_t seed) noexcept {
+        randomSeed.set(seed);
     }
 
     RoundTo::RoundTo()
@@ -260,19 +281,19 @@ namespace flo {
     
     }
 
-    double RoundTo::evaluate(const flo::SoundState* context) const noexcept {
+    Number RoundTo::evaluate(const flo::SoundState* context) const noexcept {
         const auto a = input1.getValue(context);
         const auto b = input2.getValue(context);
         return std::round(a / b) * b;
     }
 
-    double FloorTo::evaluate(const flo::SoundState* context) const noexcept {
+    Number FloorTo::evaluate(const flo::SoundState* context) const noexcept {
         const auto a = input1.getValue(context);
         const auto b = input2.getValue(context);
         return std::floor(a / b) * b;
     }
 
-    double CeilTo::evaluate(const flo::SoundState* context) const noexcept {
+    Number CeilTo::evaluate(const flo::SoundState* context) const noexcept {
         const auto a = input1.getValue(context);
         const auto b = input2.getValue(context);
         return std::ceil(a / b) * b;
@@ -283,7 +304,7 @@ namespace flo {
 
     }
 
-    double Remainder::evaluate(const flo::SoundState* context) const noexcept {
+    Number Remainder::evaluate(const flo::SoundState* context) const noexcept {
         return std::fmod(input1.getValue(context), input2.getValue(context));
     }
 
@@ -295,11 +316,11 @@ namespace flo {
 
     }
 
-    double Gaussian::evaluate(const flo::SoundState* context) const noexcept {
+    Number Gaussian::evaluate(const flo::SoundState* context) const noexcept {
         const auto a = amplitude.getValue(context);
         const auto d = input.getValue(context) - center.getValue(context);
         const auto c = width.getValue(context);
-        return a * std::exp((-0.5 * d * d) / (c * c));
+        return a * std::exp((Number{-0.5} * d * d) / (c * c));
     }
 
     LinearInterpolation::LinearInterpolation()
@@ -309,7 +330,7 @@ namespace flo {
 
     }
 
-    double LinearInterpolation::evaluate(const flo::SoundState* context) const noexcept {
+    Number LinearInterpolation::evaluate(const flo::SoundState* context) const noexcept {
         const auto p0 = start.getValue(context);
         const auto p1 = end.getValue(context);
         const auto t = fraction.getValue(context);
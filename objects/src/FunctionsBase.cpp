@@ -2,11 +2,11 @@
 
 namespace flo {
     
-    UnaryFunction::UnaryFunction(double defaultValue)
+    UnaryFunction::UnaryFunction(Number defaultValue)
         : input(this, defaultValue) {
     }
 
-    BinaryFunction::BinaryFunction(double defaultValue1, double defaultValue2)
+    BinaryFunction::BinaryFunction(Number defaultValue1, Number defaultValue2)
         : input1(this, defaultValue1)
         , input2(this, defaultValue2) {
 
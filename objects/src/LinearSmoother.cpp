@@ -11,16 +11,16 @@ namespace flo {
         , rate(this) {
     }
 
-    double LinearSmoother::evaluate(LinearSmootherState* state, const flo::SoundState* context) const noexcept {
-        const auto i = input.getValue(context);
-        const auto r = std::abs(rate.getValue(context));
+    Number LinearSmoother::evaluate(LinearSmootherState* state, const flo::SoundState* context) const noexcept {
+        const auto i = static_cast<double>(input.getValue(context));
+        const auto r = std::abs(static_cast<double>(rate.getValue(context)));
         const auto d = i - state->value;
         if (std::abs(d) < r){
             state->value = i;
         } else {
             state->value += (d > 0.0 ? r : -r);
         }
-        return state->value;
+        return static_cast<Number>(state->value);
     }
 
 } // namespace flo
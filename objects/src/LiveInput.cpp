@@ -1,17 +1,31 @@
 #include <Flosion/Objects/LiveInput.hpp>
+#include <Flosion/Core/SampleFormat.hpp>
+
+#include <algorithm>
+#include <utility>
 
 namespace flo {
 
+    LiveInputState::LiveInputState(LiveInputState&& s) noexcept
+        : SoundState(std::move(s))
+        , buffer(s.buffer)
+        , producer_pos(s.producer_pos.load(std::memory_order_relaxed))
+        , consumer_pos(s.consumer_pos.load(std::memory_order_relaxed)) {
+
+    }
+
     void LiveInputState::reset() noexcept {
-        producer_pos = 0;
-        consumer_pos = 0;
+        // NOTE: only the consumer may move its position, so the
+        // queued frames are skipped rather than cleared
+        consumer_pos.store(producer_pos.load(std::memory_order_acquire), std::memory_order_release);
     }
 
     LiveInput::LiveInput()
         : m_recorder(*this) {
 
-        // TODO: hack
-        enableMonostate();
+        initLater([this](){
+            enableMonostate();
+        });
     }
 
     LiveInput::~LiveInput(){
@@ -50,15 +64,33 @@ namespace flo {
         return m_recorder.getDevice();
     }
 
+    std::size_t LiveInput::pushFrames(const float* interleavedStereo, std::size_t numFrames) noexcept {
+        // fill monostate's buffer, don't lap consumer
+        auto s = getMonoState();
+        const auto n = s->buffer.size();
+        const auto w = s->producer_pos.load(std::memory_order_relaxed);
+        const auto r = s->consumer_pos.load(std::memory_order_acquire);
+        const auto count = std::min(numFrames, (r + n - w - 1) % n);
+        for (std::size_t i = 0; i < count; ++i) {
+            s->buffer[(w + i) % n] = Sample{interleavedStereo[2 * i], interleavedStereo[2 * i + 1]};
+        }
+        s->producer_pos.store((w + count) % n, std::memory_order_release);
+        return count;
+    }
+
     void LiveInput::renderNextChunk(SoundChunk& chunk, LiveInputState* state) {
         // read data from monostate's buffer, don't surpass producer
-        // TODO: this is unsafe! Some kind of synchronization is needed
-        std::size_t count = 0;
-        while (count < SoundChunk::size && (state->consumer_pos + 1) != state->producer_pos) {
-            chunk[count] = state->buffer[state->consumer_pos];
-            ++count;
-            state->consumer_pos = (state->consumer_pos + 1) % state->buffer.size();
+        // NOTE: the input is stereo, and only fills the first two channels
+        // or is mixed down if the chunk is mono
+        chunk.silence();
+        const auto n = state->buffer.size();
+        const auto r = state->consumer_pos.load(std::memory_order_relaxed);
+        const auto w = state->producer_pos.load(std::memory_order_acquire);
+        const auto count = std::min(SoundChunk::size, (w + n - r) % n);
+        for (std::size_t i = 0; i < count; ++i) {
+            chunk[i] = state->buffer[(r + i) % n];
         }
+        state->consumer_pos.store((r + count) % n, std::memory_order_release);
     }
 
     LiveInput::Recorder::Recorder(LiveInput& parent)
@@ -74,17 +106,18 @@ namespace flo {
     }
 
     bool LiveInput::Recorder::onProcessSamples(const sf::Int16* samples, std::size_t sampleCount){
-        // fill parent's monostates' buffer, don't lap consumer
-        // TODO: this is unsafe! Some kind of synchronization is needed
-        auto s = m_parent.getMonoState();
-        constexpr auto k = 1.0f / static_cast<float>(std::numeric_limits<int16_t>::max());
-        std::size_t count = 0;
-        while (s->producer_pos != s->consumer_pos && count < sampleCount) {
-            auto l = static_cast<float>(samples[count + 0]) * k;
-            auto r = static_cast<float>(samples[count + 1]) * k;
-            s->buffer[s->producer_pos] = Sample{l, r};
-            count += 2;
-            s->producer_pos = (s->producer_pos + 1) % s->buffer.size();
+        // convert a few frames at a time, without allocating
+        std::array<float, 512> frames;
+        const auto numFrames = sampleCount / 2;
+        std::size_t done = 0;
+        while (done < numFrames) {
+            const auto n = std::min(numFrames - done, frames.size() / 2);
+            decodeSamples(samples + 2 * done, SampleFormat::Int16, 2 * n, frames.data());
+            if (m_parent.pushFrames(frames.data(), n) < n) {
+                // the buffer is full, the rest is lost
+                break;
+            }
+            done += n;
         }
         return true;
     }
@@ -151,10 +151,10 @@ namespace flo {
         , m_noteReleaseTime(Sample::frequency / 4)
         , m_loopEnabled(true) {
 
-        // TODO: AAAAAAAAAAAAAaaa hack!
-        StateTable::enableMonostate();
-
-        updateQueueSize();
+        initLater([this](){
+            StateTable::enableMonostate();
+            updateQueueSize();
+        });
     }
 
     LiveMelodyNote* LiveMelody::startNote(double frequency){
@@ -329,9 +329,7 @@ namespace flo {
             // or up to its end. Remove the note if it's done now
             // and skip the rest of this loop iteration
             const auto endLength = std::min(carryOver, notePlaying.remainingTime());
-            for (std::size_t i = 0; i < endLength; ++i) {
-                chunk[i] += notePlaying.buffer()[i + SoundChunk::size - carryOver] * attenuation;
-            }
+            chunk.mixAdd(notePlaying.buffer(), attenuation, SoundChunk::size - carryOver, 0, endLength);
             notePlaying.advance(endLength);
             if (notePlaying.remainingTime() == 0) {
                 state->removeNoteInProgress(&notePlaying);
@@ -342,14 +340,13 @@ namespace flo {
             // get the next chunk of the note
             const auto noteTimeOffset = carryOver;
             state->adjustTime(static_cast<std::uint32_t>(noteTimeOffset));
+            notePlaying.buffer().setNumChannels(chunk.numChannels());
             input.getNextChunkFor(notePlaying.buffer(), this, state, notePlaying.inputKey());
 
             // play the note until the end of the chunk, or until the
             // end of the note
             const auto beginLength = std::min(SoundChunk::size - carryOver, notePlaying.remainingTime());
-            for (std::size_t i = 0; i < beginLength; ++i) {
-                chunk[i + carryOver] += notePlaying.buffer()[i] * attenuation;
-            }
+            chunk.mixAdd(notePlaying.buffer(), attenuation, 0, carryOver, beginLength);
             notePlaying.advance(beginLength);
 
             // if the note finishes this chunk, remove it from the queue
@@ -398,14 +395,13 @@ namespace flo {
                 auto noteState = input.getState(this, state, notePlaying->inputKey());
                 noteState->m_currentNote = note.get();
                 state->adjustTime(static_cast<std::uint32_t>(carryOver));
+                notePlaying->buffer().setNumChannels(chunk.numChannels());
                 input.getNextChunkFor(notePlaying->buffer(), this, state, notePlaying->inputKey());
 
                 // play the note until the end of this chunk, or until
                 // the end of the note, whichever comes first
                 const auto beginLength = std::min(SoundChunk::size - carryOver, note->minLength());
-                for (std::size_t i = 0; i < beginLength; ++i) {
-                    chunk[i + carryOver] += notePlaying->buffer()[i] * attenuation;
-                }
+                chunk.mixAdd(notePlaying->buffer(), attenuation, 0, carryOver, beginLength);
 
                 assert(notePlaying->elapsedTime() == 0);
                 notePlaying->advance(beginLength);
@@ -463,9 +459,9 @@ namespace flo {
 
     }
 
-    double LiveMelody::Input::NoteFrequency::evaluate(const LiveMelodyNoteState* state, const SoundState*) const noexcept {
+    Number LiveMelody::Input::NoteFrequency::evaluate(const LiveMelodyNoteState* state, const SoundState*) const noexcept {
         assert(state->note());
-        return state->note()->frequency();
+        return static_cast<Number>(state->note()->frequency());
     }
 
     const LiveMelodyNote* LiveMelodyState::NoteInProgress::note() const noexcept {
@@ -501,14 +497,14 @@ namespace flo {
 
     }
 
-    double LiveMelody::Input::NoteProgress::evaluate(const LiveMelodyNoteState* state, const SoundState* context) const noexcept {
+    Number LiveMelody::Input::NoteProgress::evaluate(const LiveMelodyNoteState* state, const SoundState* context) const noexcept {
         const auto time = context->getElapsedTimeAt(getOwner());
         const auto length = static_cast<double>(state->note()->minLength()) / static_cast<double>(sampleFrequency);
-        return time / length;
+        return static_cast<Number>(time / length);
     }
 
-    double LiveMelody::Input::NoteLength::evaluate(const LiveMelodyNoteState* state, const SoundState*) const noexcept {
-        return static_cast<double>(state->note()->minLength()) / static_cast<double>(sampleFrequency);
+    Number LiveMelody::Input::NoteLength::evaluate(const LiveMelodyNoteState* state, const SoundState*) const noexcept {
+        return static_cast<Number>(static_cast<double>(state->note()->minLength()) / static_cast<double>(sampleFrequency));
     }
 
 } // namespace flo
@@ -5,10 +5,10 @@
 namespace flo {
 
     LiveSequencer::LiveSequencer() {
-        // TODO: hack
-        enableMonostate();
-
-        setLength(Sample::frequency * 4);
+        initLater([this](){
+            enableMonostate();
+            setLength(Sample::frequency * 4);
+        });
     }
 
     LiveSequencer::~LiveSequencer(){
@@ -109,10 +109,7 @@ namespace flo {
                 }
                 const auto a = static_cast<float>(util::volumeToAmplitude(t->volume(), maxVolume()));
                 assert(chunkIdx < t->m_chunks.size());
-                const auto& inChunk = t->m_chunks[chunkIdx];
-                for (std::size_t i = 0; i < len; ++i) {
-                    chunk[i + outChunkStart] += inChunk[i + inChunkStart] * a;
-                }
+                chunk.mixAdd(t->m_chunks[chunkIdx], a, inChunkStart, outChunkStart, len);
             }
         };
 
@@ -120,11 +117,14 @@ namespace flo {
             for (auto& t : state->m_tracks) {
                 t->m_currentMode = t->m_nextMode.load(std::memory_order_relaxed);
                 if (t->m_currentMode == Track::Mode::LiveOnce) {
-                    t->setNextMode(Track::Mode::RecordedInput);
+                    t->m_nextMode.store(Track::Mode::RecordedInput, std::memory_order_relaxed);
+                    t->onChangeNextMode.broadcastDeferred(Track::Mode::RecordedInput);
                 } else if (t->m_currentMode == Track::Mode::LiveRestarting) {
                     t->input.resetStateFor(this, getMonoState());
                 }
-                t->onChangeCurrentMode.broadcast(t->m_currentMode);
+                // NOTE: this is the audio thread, so the handlers are
+                // called later, by the UI thread
+                t->onChangeCurrentMode.broadcastDeferred(t->m_currentMode);
             }
         };
 
@@ -136,6 +136,7 @@ namespace flo {
                 }
                 assert(chunkIdx < t->m_chunks.size());
                 auto& inChunk = t->m_chunks[chunkIdx];
+                inChunk.setNumChannels(chunk.numChannels());
                 inChunk.silence();
                 t->input.getNextChunkFor(inChunk, this, state);
             }
@@ -194,6 +195,8 @@ namespace flo {
         , m_currentMode(Mode::Pause)
         , m_nextMode(Mode::Pause) {
 
+        onChangeCurrentMode.enableDeferredBroadcast();
+        onChangeNextMode.enableDeferredBroadcast();
     }
 
     double Track::volume() const noexcept {
@@ -1,9 +1,11 @@
 #include <Flosion/Objects/Lowpass.hpp>
 
+#include <algorithm>
+
 namespace flo {
 
     void LowpassState::reset() noexcept {
-        value = {0.0, 0.0};
+        std::fill(values.begin(), values.end(), 0.0f);
     }
 
     Lowpass::Lowpass()
@@ -15,14 +17,23 @@ namespace flo {
     void Lowpass::renderNextChunk(SoundChunk& chunk, LowpassState* state){
         input.getNextChunkFor(chunk, this, state);
         const auto dt = 1.0f / static_cast<float>(sampleFrequency);
+        const auto n = chunk.numChannels();
+        if (state->values.size() != n){
+            // NOTE: this only allocates when the number of channels changes
+            state->values.assign(n, 0.0f);
+        }
         for (int i = 0; i < chunk.size; ++i){
             state->adjustTime(i);
             const auto fc = static_cast<float>(cutoff.getValue(state));
             const auto rc = 1.0f / (2.0f * 3.141592654f * fc);
             const auto a = std::clamp(dt / (rc + dt), 0.0f, 1.0f);
 
-            chunk[i] = state->value + (chunk[i] - state->value) * a;
-            state->value = chunk[i];
+            for (size_t c = 0; c < n; ++c){
+                auto& v = state->values[c];
+                auto& x = chunk.channel(c)[i];
+                x = v + (x - v) * a;
+                v = x;
+            }
         }
     }
 
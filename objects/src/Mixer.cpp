@@ -17,13 +17,12 @@ namespace flo {
 
     void Mixer::renderNextChunk(flo::SoundChunk& chunk, MixerState* state){
         chunk.silence();
+        state->buffer.setNumChannels(chunk.numChannels());
 
         // TODO: proper mixing
         for (auto& input : m_inputs){
             input->getNextChunkFor(state->buffer, this, state);
-            for (size_t i = 0; i < flo::SoundChunk::size; ++i){
-                chunk[i] += state->buffer[i] * 0.1f;
-            }
+            chunk.mixAdd(state->buffer, 0.1f);
         }
     }
 
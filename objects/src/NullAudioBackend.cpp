@@ -0,0 +1,137 @@
+#include <Flosion/Objects/NullAudioBackend.hpp>
+#include <Flosion/Core/Profiler.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <utility>
+
+namespace flo {
+
+    NullAudioBackend::NullAudioBackend(Clock clock) noexcept
+        : m_clock(clock)
+        , m_running(false)
+        , m_framesProcessed(0)
+        , m_frameLimit(0)
+        , m_recording(false) {
+
+    }
+
+    NullAudioBackend::~NullAudioBackend() noexcept {
+        stop();
+    }
+
+    void NullAudioBackend::start(const AudioOutputConfig& config, Callback callback){
+        if (m_running.load()){
+            return;
+        }
+        // a thread whose frame limit was reached may not have been joined yet
+        stop();
+        m_config = config;
+        m_buffer.assign(config.numChannels * config.periodSize, 0.0f);
+        m_running.store(true);
+        if (m_clock == Clock::Manual){
+            m_manualCallback = std::move(callback);
+            return;
+        }
+        m_thread = std::thread([this, cb = std::move(callback)]() mutable {
+            run(std::move(cb));
+        });
+    }
+
+    void NullAudioBackend::stop() noexcept {
+        m_running.store(false);
+        if (m_thread.joinable()){
+            m_thread.join();
+        }
+        m_manualCallback = nullptr;
+    }
+
+    bool NullAudioBackend::isRunning() const noexcept {
+        return m_running.load();
+    }
+
+    NullAudioBackend::Clock NullAudioBackend::getClock() const noexcept {
+        return m_clock;
+    }
+
+    void NullAudioBackend::step(std::size_t numPeriods){
+        assert(m_clock == Clock::Manual);
+        Profiler::registerCurrentThread();
+        for (std::size_t i = 0; i < numPeriods && m_running.load(); ++i){
+            process(m_manualCallback);
+        }
+    }
+
+    std::size_t NullAudioBackend::getFramesProcessed() const noexcept {
+        return m_framesProcessed.load(std::memory_order_relaxed);
+    }
+
+    void NullAudioBackend::setFrameLimit(std::size_t numFrames) noexcept {
+        assert(!m_running.load());
+        m_frameLimit = numFrames;
+    }
+
+    void NullAudioBackend::setRecording(bool enable) noexcept {
+        assert(!m_running.load());
+        m_recording = enable;
+    }
+
+    const std::vector<float>& NullAudioBackend::getRecording() const noexcept {
+        assert(!m_running.load());
+        return m_recordedFrames;
+    }
+
+    void NullAudioBackend::clearRecording() noexcept {
+        assert(!m_running.load());
+        m_recordedFrames.clear();
+    }
+
+    void NullAudioBackend::process(const Callback& callback){
+        callback(m_buffer.data(), m_config.periodSize);
+        if (m_recording){
+            m_recordedFrames.insert(m_recordedFrames.end(), m_buffer.begin(), m_buffer.end());
+        }
+        const auto frames = m_framesProcessed.fetch_add(m_config.periodSize, std::memory_order_relaxed) + m_config.periodSize;
+        if (m_frameLimit > 0 && frames >= m_frameLimit){
+            m_running.store(false);
+        }
+    }
+
+    void NullAudioBackend::run(Callback callback) noexcept {
+        using Clock = std::chrono::steady_clock;
+
+        Profiler::registerCurrentThread();
+        if (m_config.realtimePriority){
+            promoteCurrentThread();
+        }
+
+        if (m_clock == NullAudioBackend::Clock::AsFastAsPossible){
+            while (m_running.load(std::memory_order_relaxed)){
+                process(callback);
+            }
+            return;
+        }
+
+        const auto period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(static_cast<double>(m_config.periodSize) / static_cast<double>(sampleFrequency))
+        );
+
+        auto deadline = Clock::now() + period;
+        while (m_running.load(std::memory_order_relaxed)){
+            process(callback);
+
+            const auto now = Clock::now();
+            if (now > deadline){
+                // The period was not ready in time, and a device would
+                // have run out of audio. Like a device, start over from now
+                // rather than trying to catch up.
+                reportXrun();
+                deadline = now + period;
+            } else {
+                std::this_thread::sleep_until(deadline);
+                deadline += period;
+            }
+        }
+    }
+
+} // namespace flo
@@ -0,0 +1,52 @@
+#include <Flosion/Objects/NullInputDevice.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace flo {
+
+    NullInputDevice::NullInputDevice(LiveInput& target)
+        : m_target(target)
+        , m_position(0)
+        , m_loop(false) {
+
+    }
+
+    void NullInputDevice::setInput(std::vector<float> interleavedStereo, bool loop){
+        assert(interleavedStereo.size() % 2 == 0);
+        m_input = std::move(interleavedStereo);
+        m_position = 0;
+        m_loop = loop;
+    }
+
+    std::size_t NullInputDevice::feed(std::size_t numFrames) noexcept {
+        const auto totalFrames = m_input.size() / 2;
+        if (totalFrames == 0){
+            return 0;
+        }
+        std::size_t count = 0;
+        while (count < numFrames){
+            if (m_position == totalFrames){
+                if (!m_loop){
+                    break;
+                }
+                m_position = 0;
+            }
+            const auto n = std::min(numFrames - count, totalFrames - m_position);
+            const auto accepted = m_target.pushFrames(m_input.data() + 2 * m_position, n);
+            m_position += accepted;
+            count += accepted;
+            if (accepted < n){
+                // the LiveInput's buffer is full
+                break;
+            }
+        }
+        return count;
+    }
+
+    bool NullInputDevice::isFinished() const noexcept {
+        return !m_loop && m_position == m_input.size() / 2;
+    }
+
+} // namespace flo
@@ -4,7 +4,7 @@ namespace flo {
 
     void OscillatorState::reset() noexcept {
         value = 0.0;
-        prevReset = std::numeric_limits<double>::min();
+        prevReset = std::numeric_limits<Number>::min();
     }
 
 
@@ -15,7 +15,7 @@ namespace flo {
 
     }
 
-    double Oscillator::evaluate(OscillatorState* state, const flo::SoundState* context) const noexcept {
+    Number Oscillator::evaluate(OscillatorState* state, const flo::SoundState* context) const noexcept {
         state->value += input.getValue(context);
         state->value -= std::floor(state->value);
         auto r = reset.getValue(context);
@@ -23,7 +23,7 @@ namespace flo {
             state->value = 0.0;
         }
         state->prevReset = r;
-        return state->value;
+        return static_cast<Number>(state->value);
     }
 
 } // namespace flo
@@ -9,24 +9,32 @@ namespace flo {
     void RandomWalkState::reset() noexcept {
         value = 0.0;
         velocity = 0.0;
+        rng = util::CounterRNG{};
     }
 
     RandomWalk::RandomWalk()
-        : speed(this, 0.001)
+        : speed(this, Number{0.001})
         , damping(this, 0.5)
-        , bias(this, 0.1)
-        , m_dist(-1.0, 1.0) {
+        , bias(this, Number{0.1}) {
 
     }
 
-    double RandomWalk::evaluate(RandomWalkState* state, const SoundState* context) const noexcept {
+    Number RandomWalk::evaluate(RandomWalkState* state, const SoundState* context) const noexcept {
         const auto sp = speed.getValue(context);
         const auto d = damping.getValue(context);
         const auto b = bias.getValue(context);
-        auto deltaVelocity = (m_dist(util::getRandomEngine()) - state->value * b) * sp;
+        if (!state->rng.isSeeded()){
+            state->rng = randomSeed.makeStream();
+        }
+        const auto r = 2.0 * state->rng.uniform() - 1.0;
+        auto deltaVelocity = (r - state->value * b) * sp;
         state->velocity = (state->velocity * d) + deltaVelocity;
         state->value += state->velocity;
-        return state->value;
+        return static_cast<Number>(state->value);
+    }
+
+    void RandomWalk::reseed(std::uint64_t seed) noexcept {
+        randomSeed.set(seed);
     }
 
 } // namespace flo
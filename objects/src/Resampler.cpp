@@ -1,5 +1,7 @@
 #include <Flosion/Objects/Resampler.hpp>
 
+#include <array>
+
 namespace flo {
 
     void ResamplerState::reset() noexcept {
@@ -22,19 +24,28 @@ namespace flo {
             state->posCoarse = 0;
         };
 
-        const auto getNextSample = [&](double speed) -> flo::Sample {
-            auto acc = flo::Sample{};
+        const auto n = chunk.numChannels();
+        state->buffer.setNumChannels(n);
+
+        // writes the next sample of every channel at position i of the chunk
+        const auto writeNextSample = [&](double speed, std::size_t i) -> void {
+            auto acc = std::array<float, flo::SoundChunk::maxChannels>{};
             auto count = std::uint8_t{0};
 
             state->posFine += speed;
 
             if (state->posFine < 1.0){
-                return flo::Sample{state->buffer[state->posCoarse]};
+                for (std::size_t c = 0; c < n; ++c){
+                    chunk.channel(c)[i] = state->buffer.channel(c)[state->posCoarse];
+                }
+                return;
             }
 
             while (state->posFine >= 1.0){
                 state->posFine -= 1.0;
-                acc += state->buffer[state->posCoarse];
+                for (std::size_t c = 0; c < n; ++c){
+                    acc[c] += state->buffer.channel(c)[state->posCoarse];
+                }
                 ++count;
                 ++state->posCoarse;
                 if (state->posCoarse == flo::SoundChunk::size){
@@ -42,13 +53,15 @@ namespace flo {
                 }
             }
 
-            return acc / static_cast<float>(count);
+            for (std::size_t c = 0; c < n; ++c){
+                chunk.channel(c)[i] = acc[c] / static_cast<float>(count);
+            }
         };
 
         for (std::uint16_t i = 0; i < flo::SoundChunk::size; ++i){
             state->adjustTime(i);
             state->speed = timeSpeed.getValue(state);
-            chunk[i] = getNextSample(state->speed);
+            writeNextSample(state->speed, i);
         }
     }
 
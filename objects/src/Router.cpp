@@ -201,7 +201,7 @@ namespace flo {
 
     }
 
-    double Router::Input::InputNumberSource::evaluate(const StateType* state, const SoundState* context) const noexcept {
+    Number Router::Input::InputNumberSource::evaluate(const StateType* state, const SoundState* context) const noexcept {
         auto ds = state->getDependentState();
         assert(ds);
         auto router = m_parent->getRouter();
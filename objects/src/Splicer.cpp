@@ -1,5 +1,7 @@
 #include <Flosion/Objects/Splicer.hpp>
 
+#include <Flosion/Core/RenderContext.hpp>
+
 namespace flo {
 
     void SplicerState::reset() noexcept {
@@ -98,18 +100,14 @@ namespace flo {
     }
 
     void Splicer::RoutingNode::renderNextChunk(SoundChunk& chunk, EmptySoundState* state){
-        const SoundState* s = state;
-        while (s){
-            if (s->getOwner() == &m_parentSplicer){
-                auto ss = m_parentSplicer.getDerivedState<SplicerState>(state);
-                if (ss->currentRoute == SplicerState::RouteType::Main){
-                    m_parentSplicer.getMainInput()->getNextChunkFor(chunk, this, state);
-                } else {
-                    m_parentSplicer.getSideInput()->getNextChunkFor(chunk, this, state);
-                }
-                return;
+        if (RenderContext::findState(&m_parentSplicer, state)){
+            auto ss = m_parentSplicer.getDerivedState<SplicerState>(state);
+            if (ss->currentRoute == SplicerState::RouteType::Main){
+                m_parentSplicer.getMainInput()->getNextChunkFor(chunk, this, state);
+            } else {
+                m_parentSplicer.getSideInput()->getNextChunkFor(chunk, this, state);
             }
-            s = s->getDependentState();
+            return;
         }
         assert(false);
         throw std::runtime_error("Failed to find state");
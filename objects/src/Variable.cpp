@@ -13,7 +13,7 @@ namespace flo {
 
     }
 
-    double Variable::evaluate(VariableState* state, const flo::SoundState* context) const noexcept {
+    Number Variable::evaluate(VariableState* state, const flo::SoundState* context) const noexcept {
         const auto v = state->value;
         state->value = input.getValue(context);
         return v;
@@ -4,23 +4,23 @@
 
 namespace flo {
 
-    double SineWave::evaluate(const flo::SoundState* context) const noexcept {
-        return std::sin(input.getValue(context) * 2.0 * 3.141592654);
+    Number SineWave::evaluate(const flo::SoundState* context) const noexcept {
+        return std::sin(input.getValue(context) * Number{6.283185307179586});
     }
 
-    double SawWave::evaluate(const flo::SoundState* context) const noexcept {
-        const auto v = input.getValue(context) - 0.5;
-        return 2.0 * (v - std::floor(v)) - 1.0;
+    Number SawWave::evaluate(const flo::SoundState* context) const noexcept {
+        const auto v = input.getValue(context) - Number{0.5};
+        return Number{2.0} * (v - std::floor(v)) - Number{1.0};
     }
 
-    double SquareWave::evaluate(const flo::SoundState* context) const noexcept {
+    Number SquareWave::evaluate(const flo::SoundState* context) const noexcept {
         const auto v = input.getValue(context);
-        return (v - std::floor(v)) < 0.5 ? 1.0 : -1.0;
+        return (v - std::floor(v)) < Number{0.5} ? Number{1.0} : Number{-1.0};
     }
 
-    double TriangleWave::evaluate(const flo::SoundState* context) const noexcept {
-        const auto v = input.getValue(context) + 0.25;
-        return 1.0 - 2.0 * std::abs(1.0 - 2.0 * (v - std::floor(v)));
+    Number TriangleWave::evaluate(const flo::SoundState* context) const noexcept {
+        const auto v = input.getValue(context) + Number{0.25};
+        return Number{1.0} - Number{2.0} * std::abs(Number{1.0} - Number{2.0} * (v - std::floor(v)));
     }
 
     PulseWave::PulseWave()
@@ -29,10 +29,11 @@ namespace flo {
 
     }
 
-    double PulseWave::evaluate(const flo::SoundState* context) const noexcept {
-        const auto w = std::clamp(width.getValue(context), 0.0, 1.0);
-        const auto x = input.getValue(context) + 0.25;
-        return std::clamp((2.0 * std::floor(x - std::floor(x - w)) - 1.0) - 2.0 * w + 1.0, -1.0, 1.0);
+    Number PulseWave::evaluate(const flo::SoundState* context) const noexcept {
+        const auto w = std::clamp(width.getValue(context), Number{0.0}, Number{1.0});
+        const auto x = input.getValue(context) + Number{0.25};
+        const auto y = (Number{2.0} * std::floor(x - std::floor(x - w)) - Number{1.0}) - Number{2.0} * w + Number{1.0};
+        return std::clamp(y, Number{-1.0}, Number{1.0});
     }
 
 } // namespace flo
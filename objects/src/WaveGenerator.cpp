@@ -8,8 +8,8 @@ namespace flo {
         if (getOwner().getPhaseSync()){
             phase = 0.0;
         } else {
-            auto dist = std::uniform_real_distribution<double>{0.0, 1.0};
-            phase = dist(util::getRandomEngine());
+            rng = getOwner().randomSeed.makeStream();
+            phase = rng.uniform();
         }
     }
 
@@ -19,21 +19,27 @@ namespace flo {
         , frequency(this, 250.0)
         , m_phaseSync(true) {
 
+        // NOTE: the states are small and written every sample. When several
+        // sound results rendered on their own threads (e.g. by a LookaheadRenderer)
+        // share the wave generator, neighbouring states would otherwise share
+        // cache lines (see FalseSharingBench)
+        setSlotPadding(StateTable::SlotPadding::CacheLine);
     }
 
     void WaveGenerator::renderNextChunk(flo::SoundChunk& chunk, WaveGeneratorState* state){
+        // The wave is the same in every channel, so only the first is computed
+        const auto out = chunk.channel(0);
         for (size_t i = 0; i < flo::SoundChunk::size; ++i){
             state->adjustTime(static_cast<std::uint32_t>(i));
-            float val = static_cast<float>(waveFunction.getValue(state));
-            chunk.l(i) = val;
-            chunk.r(i) = val;
+            out[i] = static_cast<float>(waveFunction.getValue(state));
             state->phase += frequency.getValue(state) / static_cast<double>(flo::Sample::frequency);
             state->phase -= std::floor(state->phase);
         }
+        chunk.spreadChannel(0);
     }
 
-    double WaveGenerator::Phase::evaluate(const WaveGeneratorState* state, const flo::SoundState*) const noexcept {
-        return state->phase;
+    Number WaveGenerator::Phase::evaluate(const WaveGeneratorState* state, const flo::SoundState*) const noexcept {
+        return static_cast<Number>(state->phase);
     }
 
     void WaveGenerator::setPhaseSync(bool enable){
@@ -44,4 +50,8 @@ namespace flo {
         return m_phaseSync.load(std::memory_order_relaxed);
     }
 
+    void WaveGenerator::reseed(std::uint64_t seed) noexcept {
+        randomSeed.set(seed);
+    }
+
 } // namespace flo
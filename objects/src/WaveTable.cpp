@@ -19,14 +19,14 @@ namespace flo {
 
     void WaveTable::setValue(std::size_t idx, double v) noexcept {
         assert(idx < array_size);
-        m_array[idx].store(v, std::memory_order_relaxed); // TODO: is this ok?
+        m_array[idx].store(static_cast<Number>(v), std::memory_order_relaxed); // TODO: is this ok?
         onChange.broadcast(idx);
     }
 
-    double WaveTable::evaluate(const SoundState* context) const noexcept {
+    Number WaveTable::evaluate(const SoundState* context) const noexcept {
         auto x = input.getValue(context);
         x -= std::floor(x); // wrap to [0, 1]
-        x *= static_cast<double>(array_size);
+        x *= static_cast<Number>(array_size);
         auto prev = std::floor(x);
         auto next = std::ceil(x);
         auto s0 = static_cast<std::size_t>(prev) % array_size;
@@ -0,0 +1,201 @@
+#include <Flosion/Core/SoundSourceTemplate.hpp>
+#include <Flosion/Objects/AudioOutput.hpp>
+#include <Flosion/Objects/NullAudioBackend.hpp>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace flo;
+
+namespace {
+
+    // Produces a ramp which counts frames in the first channel, and
+    // its negative in every other channel
+    class RampSource : public Realtime<ControlledSoundSource<RampSource, EmptySoundState>> {
+    public:
+        static constexpr float step = 1.0f / 4096.0f;
+
+        std::size_t frames = 0;
+        std::chrono::milliseconds delay{0};
+
+        void renderNextChunk(SoundChunk& chunk, EmptySoundState*){
+            if (delay.count() > 0){
+                std::this_thread::sleep_for(delay);
+            }
+            for (std::size_t i = 0; i < SoundChunk::size; ++i){
+                const auto v = static_cast<float>((frames + i) % 4096) * step;
+                chunk.channel(0)[i] = v;
+                for (std::size_t c = 1; c < chunk.numChannels(); ++c){
+                    chunk.channel(c)[i] = -v;
+                }
+            }
+            frames += SoundChunk::size;
+        }
+    };
+
+    // Calls the callback only when asked to
+    class ManualBackend : public AudioOutputBackend {
+    public:
+        void start(const AudioOutputConfig&, Callback cb) override {
+            callback = std::move(cb);
+        }
+
+        void stop() noexcept override {
+            callback = nullptr;
+        }
+
+        bool isRunning() const noexcept override {
+            return static_cast<bool>(callback);
+        }
+
+        Callback callback;
+    };
+
+} // anonymous namespace
+
+TEST(AudioOutputTest, Periods1){
+    auto config = AudioOutputConfig{};
+    config.numChannels = channels::stereo;
+    auto backend = std::make_unique<ManualBackend>();
+    auto& b = *backend;
+    auto out = AudioOutput{std::move(backend), config};
+    auto src = RampSource{};
+    out.soundResult.setSource(&src);
+
+    out.start();
+    ASSERT_TRUE(out.isRunning());
+
+    // periods that do not divide the chunk size must be spliced
+    // seamlessly across chunks
+    auto buffer = std::vector<float>{};
+    std::size_t frame = 0;
+    for (const std::size_t n : {300, 300, 300, 300, 1, 2047, 1024}){
+        buffer.assign(2 * n, 0.0f);
+        b.callback(buffer.data(), n);
+        for (std::size_t i = 0; i < n; ++i, ++frame){
+            const auto v = static_cast<float>(frame % 4096) * RampSource::step;
+            ASSERT_EQ(buffer[2 * i], v) << "at frame " << frame;
+            ASSERT_EQ(buffer[2 * i + 1], -v) << "at frame " << frame;
+        }
+    }
+    EXPECT_EQ(src.frames, 5 * SoundChunk::size);
+
+    out.stop();
+    EXPECT_FALSE(out.isRunning());
+    out.soundResult.setSource(nullptr);
+}
+
+TEST(AudioOutputTest, NullBackend1){
+    auto config = AudioOutputConfig{};
+    config.periodSize = 512;
+    auto backend = std::make_unique<NullAudioBackend>();
+    auto& b = *backend;
+    auto out = AudioOutput{std::move(backend), config};
+    auto src = RampSource{};
+    out.soundResult.setSource(&src);
+
+    out.start();
+    EXPECT_TRUE(out.isRunning());
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    out.stop();
+    EXPECT_FALSE(out.isRunning());
+
+    // roughly 8 periods should have been played, but the
+    // exact number depends on scheduling
+    const auto frames = b.getFramesProcessed();
+    EXPECT_GT(frames, 0);
+    EXPECT_EQ(frames % config.periodSize, 0);
+    EXPECT_LE(src.frames, frames + SoundChunk::size);
+
+    // once stopped, no more periods are requested
+    std::this_thread::sleep_for(std::chrono::milliseconds{30});
+    EXPECT_EQ(b.getFramesProcessed(), frames);
+
+    out.soundResult.setSource(nullptr);
+}
+
+TEST(AudioOutputTest, Xruns1){
+    auto config = AudioOutputConfig{};
+    config.periodSize = 64;
+    auto out = AudioOutput{std::make_unique<NullAudioBackend>(), config};
+    auto src = RampSource{};
+
+    // every chunk takes far longer to render than a period lasts
+    src.delay = std::chrono::milliseconds{20};
+    out.soundResult.setSource(&src);
+
+    out.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    out.stop();
+
+    EXPECT_GT(out.getBackend().getXrunCount(), 0);
+
+    out.soundResult.setSource(nullptr);
+}
+
+TEST(AudioOutputTest, ManualClock1){
+    auto config = AudioOutputConfig{};
+    config.periodSize = 256;
+    auto backend = std::make_unique<NullAudioBackend>(NullAudioBackend::Clock::Manual);
+    auto& b = *backend;
+    b.setRecording(true);
+    auto out = AudioOutput{std::move(backend), config};
+    auto src = RampSource{};
+    out.soundResult.setSource(&src);
+
+    out.start();
+    EXPECT_EQ(b.getFramesProcessed(), 0);
+
+    // time only passes when asked to
+    b.step(3);
+    EXPECT_EQ(b.getFramesProcessed(), 3 * 256);
+    EXPECT_EQ(src.frames, SoundChunk::size);
+    b.step(2);
+    EXPECT_EQ(b.getFramesProcessed(), 5 * 256);
+    EXPECT_EQ(src.frames, 2 * SoundChunk::size);
+    out.stop();
+
+    const auto& rec = b.getRecording();
+    ASSERT_EQ(rec.size(), 2 * 5 * 256);
+    for (std::size_t i = 0; i < 5 * 256; ++i){
+        const auto v = static_cast<float>(i % 4096) * RampSource::step;
+        ASSERT_EQ(rec[2 * i], v) << "at frame " << i;
+        ASSERT_EQ(rec[2 * i + 1], -v) << "at frame " << i;
+    }
+
+    out.soundResult.setSource(nullptr);
+}
+
+TEST(AudioOutputTest, AsFastAsPossible1){
+    auto config = AudioOutputConfig{};
+    config.periodSize = 512;
+    auto backend = std::make_unique<NullAudioBackend>(NullAudioBackend::Clock::AsFastAsPossible);
+    auto& b = *backend;
+    b.setRecording(true);
+
+    // ten seconds of audio, which should take far less than that
+    const auto limit = 10 * sampleFrequency;
+    b.setFrameLimit(limit);
+    auto out = AudioOutput{std::move(backend), config};
+    auto src = RampSource{};
+    out.soundResult.setSource(&src);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    out.start();
+    while (out.isRunning()){
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - t0;
+    out.stop();
+
+    EXPECT_LT(elapsed, std::chrono::seconds{5});
+    EXPECT_GE(b.getFramesProcessed(), limit);
+    EXPECT_LT(b.getFramesProcessed(), limit + config.periodSize);
+    EXPECT_EQ(b.getRecording().size(), 2 * b.getFramesProcessed());
+    EXPECT_EQ(b.getXrunCount(), 0);
+
+    out.soundResult.setSource(nullptr);
+}
@@ -0,0 +1,250 @@
+#include <Flosion/Util/BinaryFormat.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace util::binary;
+
+namespace {
+
+    constexpr std::uint32_t testVersion = 7;
+
+    constexpr auto testID = Tag{0x40};
+
+    std::vector<std::byte> bytes(const std::string& s){
+        auto v = std::vector<std::byte>(s.size());
+        std::memcpy(v.data(), s.data(), s.size());
+        return v;
+    }
+
+    // One value of every kind, in the order read by readValues
+    std::vector<std::byte> writeValues(){
+        auto v = std::vector<std::byte>{};
+        writeScalar(v, true);
+        writeScalar(v, std::uint8_t{0xAB});
+        writeScalar(v, std::uint16_t{0xABCD});
+        writeScalar(v, std::uint32_t{0xDEADBEEF});
+        writeScalar(v, std::numeric_limits<std::uint64_t>::max());
+        writeScalar(v, std::int8_t{-5});
+        writeScalar(v, std::int16_t{-1234});
+        writeScalar(v, std::int32_t{-123456789});
+        writeScalar(v, std::numeric_limits<std::int64_t>::min());
+        writeScalar(v, 0.1f);
+        writeScalar(v, -1e300);
+        writeString(v, "");
+        writeString(v, "Flosion \xE2\x99\xAB");
+        const auto fs = std::vector<float>{1.0f, -0.5f, 0.25f};
+        writeSpan(v, fs.data(), fs.size());
+        const auto is = std::vector<std::int16_t>{-1, 0, 32767};
+        writeSpan(v, is.data(), is.size());
+        const bool ba[] = {true, false, true};
+        writeSpan(v, ba, 3);
+        writeSpan(v, static_cast<const double*>(nullptr), 0);
+        const auto ss = std::vector<std::string>{"a", "", "bc"};
+        writeStringSpan(v, ss.data(), ss.size());
+        writeStringSpan(v, ss.data(), ss.size());
+        writeID(v, testID, 12345);
+        return v;
+    }
+
+    void readValues(const std::byte*& pos, const std::byte* end){
+        EXPECT_EQ(readScalar<bool>(pos, end), true);
+        EXPECT_EQ(readScalar<std::uint8_t>(pos, end), 0xAB);
+        EXPECT_EQ(readScalar<std::uint16_t>(pos, end), 0xABCD);
+        EXPECT_EQ(readScalar<std::uint32_t>(pos, end), 0xDEADBEEF);
+        EXPECT_EQ(readScalar<std::uint64_t>(pos, end), std::numeric_limits<std::uint64_t>::max());
+        EXPECT_EQ(readScalar<std::int8_t>(pos, end), -5);
+        EXPECT_EQ(readScalar<std::int16_t>(pos, end), -1234);
+        EXPECT_EQ(readScalar<std::int32_t>(pos, end), -123456789);
+        EXPECT_EQ(readScalar<std::int64_t>(pos, end), std::numeric_limits<std::int64_t>::min());
+        EXPECT_EQ(readScalar<float>(pos, end), 0.1f);
+        EXPECT_EQ(readScalar<double>(pos, end), -1e300);
+        EXPECT_EQ(readString(pos, end), "");
+        EXPECT_EQ(readString(pos, end), "Flosion \xE2\x99\xAB");
+        EXPECT_EQ(peekSpanLength(pos, end), 3u);
+        EXPECT_EQ(readVec<float>(pos, end), (std::vector<float>{1.0f, -0.5f, 0.25f}));
+        auto is = std::vector<std::int16_t>(3);
+        readSpan(pos, end, is.data(), is.size());
+        EXPECT_EQ(is, (std::vector<std::int16_t>{-1, 0, 32767}));
+        EXPECT_EQ(readVec<bool>(pos, end), (std::vector<bool>{true, false, true}));
+        EXPECT_EQ(readVec<double>(pos, end), std::vector<double>{});
+        EXPECT_EQ(readStringVec(pos, end), (std::vector<std::string>{"a", "", "bc"}));
+        auto ss = std::vector<std::string>(3);
+        readStringSpan(pos, end, ss.data(), ss.size());
+        EXPECT_EQ(ss, (std::vector<std::string>{"a", "", "bc"}));
+        EXPECT_EQ(readID(pos, end, testID), 12345u);
+    }
+
+    std::vector<std::byte> writeTestContainer(){
+        const auto chunks = std::vector<std::vector<std::byte>>{
+            bytes("first"),
+            {},
+            writeValues()
+        };
+        const auto sections = std::vector<SectionWriter>{
+            { 1, chunksSize(chunks), [&](std::vector<std::byte>& v){ writeChunks(v, chunks); } },
+            { 2, 3, [](std::vector<std::byte>& v){ v.push_back(std::byte{1}); v.push_back(std::byte{2}); v.push_back(std::byte{3}); } },
+            { 99, 0, [](std::vector<std::byte>&){} }
+        };
+        return writeContainer(testVersion, sections);
+    }
+
+    // Reads everything written by writeTestContainer
+    void readTestContainer(const std::vector<std::byte>& data){
+        const auto sections = readContainer(data.data(), data.size(), testVersion);
+        ASSERT_EQ(sections.size(), 3u);
+        EXPECT_EQ(sections[0].kind, 1u);
+        EXPECT_EQ(sections[1].kind, 2u);
+        EXPECT_EQ(sections[2].kind, 99u);
+        EXPECT_EQ(sections[1].end - sections[1].begin, 3);
+        EXPECT_EQ(sections[2].end - sections[2].begin, 0);
+        for (const auto& s : sections){
+            EXPECT_EQ((s.begin - data.data()) % 8, 0);
+        }
+
+        const auto chunks = readChunks(sections[0].begin, sections[0].end);
+        ASSERT_EQ(chunks.size(), 3u);
+        EXPECT_EQ(std::vector<std::byte>(chunks[0].first, chunks[0].second), bytes("first"));
+        EXPECT_EQ(chunks[1].first, chunks[1].second);
+        auto pos = chunks[2].first;
+        readValues(pos, chunks[2].second);
+        EXPECT_EQ(pos, chunks[2].second);
+    }
+
+    void overwrite(std::vector<std::byte>& data, std::size_t offset, std::uint64_t x){
+        auto v = std::vector<std::byte>{};
+        writeScalar(v, x);
+        std::memcpy(data.data() + offset, v.data(), v.size());
+    }
+
+} // anonymous namespace
+
+TEST(BinaryFormatTest, RoundTrip1){
+    const auto v = writeValues();
+    auto pos = v.data();
+    readValues(pos, v.data() + v.size());
+    EXPECT_EQ(pos, v.data() + v.size());
+}
+
+TEST(BinaryFormatTest, RoundTrip2){
+    const auto data = writeTestContainer();
+    EXPECT_EQ(data.size() % 8, 0u);
+    readTestContainer(data);
+
+    // the layout is little-endian on every platform
+    EXPECT_EQ(data[0], std::byte{'F'});
+    EXPECT_EQ(data[4], std::byte{testVersion});
+    EXPECT_EQ(data[5], std::byte{0});
+    EXPECT_EQ(data[8], std::byte{3});
+}
+
+TEST(BinaryFormatTest, Truncated1){
+    // Every value is cut off somewhere
+    const auto v = writeValues();
+    for (std::size_t n = 0; n < v.size(); ++n){
+        auto pos = v.data();
+        EXPECT_THROW(readValues(pos, v.data() + n), std::runtime_error) << "with " << n << " bytes";
+    }
+}
+
+TEST(BinaryFormatTest, Truncated2){
+    // Every section is cut off somewhere
+    const auto data = writeTestContainer();
+    const auto sections = readContainer(data.data(), data.size(), testVersion);
+    const auto lastEnd = static_cast<std::size_t>(sections[1].end - data.data());
+    for (std::size_t n = 0; n < lastEnd; ++n){
+        EXPECT_THROW(readContainer(data.data(), n, testVersion), std::runtime_error) << "with " << n << " bytes";
+    }
+}
+
+TEST(BinaryFormatTest, Corrupt1){
+    const auto data = writeTestContainer();
+    const auto sections = readContainer(data.data(), data.size(), testVersion);
+    const auto objectsOffset = static_cast<std::size_t>(sections[0].begin - data.data());
+
+    // wrong magic bytes
+    auto d = data;
+    d[3] = std::byte{'X'};
+    EXPECT_THROW(readContainer(d.data(), d.size(), testVersion), std::runtime_error);
+
+    // more sections than fit into the data
+    d = data;
+    d[8] = std::byte{0xFF};
+    d[11] = std::byte{0xFF};
+    EXPECT_THROW(readContainer(d.data(), d.size(), testVersion), std::runtime_error);
+
+    // a section which overflows the end of the data
+    d = data;
+    overwrite(d, 16 + 8, std::numeric_limits<std::uint64_t>::max());
+    EXPECT_THROW(readContainer(d.data(), d.size(), testVersion), std::runtime_error);
+    d = data;
+    overwrite(d, 16 + 16, std::numeric_limits<std::uint64_t>::max() - 8);
+    EXPECT_THROW(readContainer(d.data(), d.size(), testVersion), std::runtime_error);
+
+    // more chunks than fit into the section
+    d = data;
+    overwrite(d, objectsOffset, std::uint64_t{1} << 60);
+    auto s = readContainer(d.data(), d.size(), testVersion);
+    EXPECT_THROW(readChunks(s[0].begin, s[0].end), std::runtime_error);
+
+    // a chunk which overflows the end of the section
+    d = data;
+    overwrite(d, objectsOffset + 8 + 8, std::numeric_limits<std::uint64_t>::max());
+    s = readContainer(d.data(), d.size(), testVersion);
+    EXPECT_THROW(readChunks(s[0].begin, s[0].end), std::runtime_error);
+}
+
+TEST(BinaryFormatTest, Corrupt2){
+    auto v = std::vector<std::byte>{};
+    const auto xs = std::vector<std::uint32_t>{1, 2, 3};
+    writeSpan(v, xs.data(), xs.size());
+    const auto end = v.data() + v.size();
+
+    // mismatched tags
+    auto pos = static_cast<const std::byte*>(v.data());
+    EXPECT_THROW(readVec<float>(pos, end), std::runtime_error);
+    pos = v.data();
+    EXPECT_THROW(readID(pos, end, testID), std::runtime_error);
+    pos = v.data();
+    EXPECT_THROW(readStringVec(pos, end), std::runtime_error);
+
+    // a span of a different length than expected
+    auto ys = std::vector<std::uint32_t>(2);
+    pos = v.data();
+    EXPECT_THROW(readSpan(pos, end, ys.data(), ys.size()), std::runtime_error);
+
+    // bogus lengths are rejected before anything is allocated, even
+    // if their size in bytes overflows
+    for (const auto len : {std::uint64_t{4}, std::uint64_t{1} << 62, std::numeric_limits<std::uint64_t>::max()}){
+        overwrite(v, 2, len);
+        pos = v.data();
+        EXPECT_THROW(readVec<std::uint32_t>(pos, end), std::runtime_error);
+        pos = v.data();
+        EXPECT_EQ(peekSpanLength(pos, end), len);
+    }
+
+    auto w = std::vector<std::byte>{};
+    writeString(w, "abc");
+    overwrite(w, 0, std::numeric_limits<std::uint64_t>::max());
+    pos = w.data();
+    EXPECT_THROW(readString(pos, w.data() + w.size()), std::runtime_error);
+}
+
+TEST(BinaryFormatTest, WrongVersion1){
+    const auto data = writeTestContainer();
+    EXPECT_THROW(readContainer(data.data(), data.size(), testVersion + 1), std::runtime_error);
+    EXPECT_THROW(readContainer(data.data(), data.size(), testVersion - 1), std::runtime_error);
+
+    auto d = data;
+    d[4] = std::byte{testVersion + 1};
+    EXPECT_THROW(readContainer(d.data(), d.size(), testVersion), std::runtime_error);
+    d[4] = std::byte{testVersion};
+    readTestContainer(d);
+}
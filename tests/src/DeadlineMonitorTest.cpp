@@ -0,0 +1,110 @@
+#include <Flosion/Core/DeadlineMonitor.hpp>
+#include <Flosion/Core/SoundResult.hpp>
+#include <Flosion/Core/SoundSourceTemplate.hpp>
+
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace flo;
+
+namespace {
+
+    std::chrono::steady_clock::duration periods(double n){
+        return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(n * DeadlineMonitor::getChunkPeriod())
+        );
+    }
+
+    // Takes a little longer than the chunk period to render
+    class SlowSource : public Realtime<ControlledSoundSource<SlowSource, EmptySoundState>> {
+    public:
+        void renderNextChunk(SoundChunk& chunk, EmptySoundState*){
+            std::this_thread::sleep_for(periods(1.2));
+            chunk.silence();
+        }
+    };
+
+} // anonymous namespace
+
+TEST(DeadlineMonitorTest, Record1){
+    auto m = DeadlineMonitor{};
+    auto misses = std::vector<DeadlineMonitor::ChunkReport>{};
+    auto conn = m.onDeadlineMiss.connect([&](const DeadlineMonitor::ChunkReport& r){
+        misses.push_back(r);
+    });
+
+    m.record(periods(0.12));
+    m.record(periods(0.92));
+    m.record(periods(1.52));
+    m.record(periods(4.0));
+    m.reportXrun();
+    EXPECT_TRUE(misses.empty());
+    deliverDeferredSignals();
+
+    const auto s = m.getStats();
+    EXPECT_EQ(s.chunks, 4);
+    EXPECT_EQ(s.deadlineMisses, 2);
+    EXPECT_EQ(s.xruns, 1);
+    EXPECT_NEAR(s.maxBudgetShare, 4.0, 1e-6);
+    EXPECT_EQ(s.histogram[2], 1);
+    EXPECT_EQ(s.histogram[18], 1);
+    EXPECT_EQ(s.histogram[30], 1);
+    EXPECT_EQ(s.histogram[DeadlineMonitor::numBuckets - 1], 1);
+    EXPECT_EQ(std::accumulate(s.histogram.begin(), s.histogram.end(), std::size_t{0}), 4);
+
+    // only chunks above the threshold are kept
+    const auto slow = m.getSlowChunks();
+    ASSERT_EQ(slow.size(), 3);
+    EXPECT_EQ(slow[0].chunkIndex, 1);
+    EXPECT_EQ(slow[2].chunkIndex, 3);
+    EXPECT_NEAR(slow[1].budgetShare, 1.52, 1e-6);
+
+    ASSERT_EQ(misses.size(), 2);
+    EXPECT_EQ(misses[0].chunkIndex, 2);
+    EXPECT_NEAR(misses[0].seconds, 1.52 * DeadlineMonitor::getChunkPeriod(), 1e-6);
+
+    // the most recent slow chunks are kept
+    for (std::size_t i = 0; i < DeadlineMonitor::maxSlowChunks; ++i){
+        m.record(periods(0.9));
+    }
+    EXPECT_EQ(m.getSlowChunks().size(), DeadlineMonitor::maxSlowChunks);
+    EXPECT_EQ(m.getSlowChunks().front().chunkIndex, 4);
+
+    m.reset();
+    EXPECT_EQ(m.getStats().chunks, 0);
+    EXPECT_TRUE(m.getSlowChunks().empty());
+}
+
+TEST(DeadlineMonitorTest, SoundResult1){
+    auto result = SoundResult{};
+    auto src = SlowSource{};
+    result.setSource(&src);
+
+    auto breakdown = std::vector<Profiler::NodeTime>{};
+    auto conn = result.getDeadlineMonitor().onDeadlineMiss.connect([&](const DeadlineMonitor::ChunkReport& r){
+        breakdown.assign(r.breakdown.begin(), r.breakdown.begin() + r.breakdownSize);
+    });
+
+    Profiler::registerCurrentThread();
+    auto chunk = SoundChunk{};
+    result.getNextChunk(chunk);
+    result.getNextChunk(chunk);
+    deliverDeferredSignals();
+
+    const auto s = result.getDeadlineMonitor().getStats();
+    EXPECT_EQ(s.chunks, 2);
+    EXPECT_EQ(s.deadlineMisses, 2);
+    EXPECT_GE(s.maxBudgetShare, 1.2);
+
+    if (Profiler::isCompiledIn()){
+        ASSERT_FALSE(breakdown.empty());
+        EXPECT_EQ(breakdown.front().soundNode, &src);
+        EXPECT_GE(breakdown.front().seconds, DeadlineMonitor::getChunkPeriod());
+    } else {
+        EXPECT_TRUE(breakdown.empty());
+    }
+}
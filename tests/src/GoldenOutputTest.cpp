@@ -0,0 +1,306 @@
+#include <Flosion/Core/SoundResult.hpp>
+#include <Flosion/Objects/Ensemble.hpp>
+#include <Flosion/Objects/Functions.hpp>
+#include <Flosion/Objects/Lowpass.hpp>
+#include <Flosion/Objects/Melody.hpp>
+#include <Flosion/Objects/RandomWalk.hpp>
+#include <Flosion/Objects/WaveForms.hpp>
+#include <Flosion/Objects/WaveGenerator.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace flo;
+
+// NOTE: these tests render small networks in deterministic mode and compare
+// the output against the fingerprints stored in tests/golden. If the output
+// is expected to change, run them with FLOSION_UPDATE_GOLDEN=1 to store the
+// new fingerprints instead, and commit those along with the change.
+
+namespace {
+
+    constexpr double renderSeconds = 2.0;
+
+    // Every this many samples of each channel is stored
+    constexpr std::size_t decimation = 64;
+
+    // Zero crossings are counted in windows of this many samples
+    constexpr std::size_t windowSize = Sample::frequency / 10;
+
+    // The tolerances of each stored sample and of the number of zero
+    // crossings in each window, for output which doesn't match exactly,
+    // for example due to a different compiler or math library
+    constexpr double sampleTolerance = 1e-4;
+    constexpr long zeroCrossingTolerance = 2;
+
+    struct Fingerprint {
+        // FNV-1a hash of all samples, rounded to 20 fractional bits
+        std::uint64_t hash = 0;
+
+        // Every decimation-th sample of each channel, interleaved
+        std::vector<double> samples;
+
+        // The number of zero crossings in each window, over all channels
+        std::vector<long> zeroCrossings;
+    };
+
+    Fingerprint render(SoundResult& result, double seconds){
+        const auto numChunks = static_cast<std::size_t>(std::ceil(
+            seconds * Sample::frequency / SoundChunk::size
+        ));
+        auto fp = Fingerprint{};
+        fp.hash = 0xcbf29ce484222325ull;
+        long crossings = 0;
+        std::size_t windowSamples = 0;
+        std::size_t totalSamples = 0;
+        auto previous = std::vector<float>{};
+        auto chunk = SoundChunk{};
+        for (std::size_t i = 0; i < numChunks; ++i){
+            result.getNextChunk(chunk);
+            previous.resize(chunk.numChannels(), 0.0f);
+            for (std::size_t j = 0; j < SoundChunk::size; ++j){
+                for (std::size_t c = 0; c < chunk.numChannels(); ++c){
+                    const auto x = chunk.channel(c)[j];
+                    const auto q = static_cast<std::int32_t>(std::lround(x * 1048576.0));
+                    for (std::size_t b = 0; b < 4; ++b){
+                        fp.hash ^= static_cast<std::uint64_t>((q >> (8 * b)) & 0xff);
+                        fp.hash *= 0x100000001b3ull;
+                    }
+                    if (totalSamples % decimation == 0){
+                        fp.samples.push_back(x);
+                    }
+                    if ((x < 0.0f) != (previous[c] < 0.0f)){
+                        ++crossings;
+                    }
+                    previous[c] = x;
+                }
+                ++totalSamples;
+                if (++windowSamples == windowSize){
+                    fp.zeroCrossings.push_back(crossings);
+                    crossings = 0;
+                    windowSamples = 0;
+                }
+            }
+        }
+        return fp;
+    }
+
+    std::string goldenPath(const std::string& name){
+        return std::string{FLOSION_GOLDEN_DIR} + "/" + name + ".txt";
+    }
+
+    std::optional<Fingerprint> loadGolden(const std::string& name){
+        auto f = std::ifstream{goldenPath(name)};
+        if (!f){
+            return std::nullopt;
+        }
+        auto fp = Fingerprint{};
+        auto line = std::string{};
+        while (std::getline(f, line)){
+            auto ss = std::istringstream{line};
+            auto key = std::string{};
+            ss >> key;
+            if (key == "hash"){
+                ss >> std::hex >> fp.hash;
+            } else if (key == "samples"){
+                double x;
+                while (ss >> x){
+                    fp.samples.push_back(x);
+                }
+            } else if (key == "zerocrossings"){
+                long n;
+                while (ss >> n){
+                    fp.zeroCrossings.push_back(n);
+                }
+            }
+        }
+        return fp;
+    }
+
+    void saveGolden(const std::string& name, const Fingerprint& fp){
+        auto f = std::ofstream{goldenPath(name)};
+        f << "# " << renderSeconds << " seconds rendered in deterministic mode, every "
+            << decimation << "th sample, zero crossings per " << windowSize << " samples\n";
+        f << "hash " << std::hex << fp.hash << std::dec << '\n';
+        f << "samples";
+        f.precision(7);
+        for (const auto x : fp.samples){
+            f << ' ' << x;
+        }
+        f << '\n';
+        f << "zerocrossings";
+        for (const auto n : fp.zeroCrossings){
+            f << ' ' << n;
+        }
+        f << '\n';
+    }
+
+    void checkGolden(const std::string& name, SoundResult& result){
+        const auto fp = render(result, renderSeconds);
+
+        if (std::getenv("FLOSION_UPDATE_GOLDEN")){
+            saveGolden(name, fp);
+            return;
+        }
+
+        const auto golden = loadGolden(name);
+        ASSERT_TRUE(golden.has_value()) << "No golden output at " << goldenPath(name)
+            << ", run with FLOSION_UPDATE_GOLDEN=1 to create it";
+        if (golden->hash == fp.hash){
+            return;
+        }
+        ASSERT_EQ(fp.samples.size(), golden->samples.size());
+        for (std::size_t i = 0; i < fp.samples.size(); ++i){
+            ASSERT_NEAR(fp.samples[i], golden->samples[i], sampleTolerance)
+                << "in stored sample " << i << " of " << name;
+        }
+        ASSERT_EQ(fp.zeroCrossings.size(), golden->zeroCrossings.size());
+        for (std::size_t i = 0; i < fp.zeroCrossings.size(); ++i){
+            ASSERT_LE(std::abs(fp.zeroCrossings[i] - golden->zeroCrossings[i]), zeroCrossingTolerance)
+                << "in window " << i << " of " << name;
+        }
+    }
+
+    // A sine wave
+    struct SinePatch {
+        SinePatch(){
+            sine.input.setSource(&waveGen.phase);
+            waveGen.waveFunction.setSource(&sine);
+            waveGen.frequency.setDefaultValue(440.0);
+            result.setSource(&waveGen);
+        }
+
+        ~SinePatch(){
+            result.setSource(nullptr);
+        }
+
+        SoundResult result;
+        WaveGenerator waveGen;
+        SineWave sine;
+    };
+
+    // A melody of overlapping notes played by an ensemble of unsynced
+    // saw waves, through a lowpass filter
+    struct EnsemblePatch {
+        EnsemblePatch(){
+            melody.setLength(Sample::frequency);
+            melody.setLooping(true);
+            melody.addNote(0, Sample::frequency / 2, 220.0);
+            melody.addNote(Sample::frequency / 4, Sample::frequency / 2, 330.0);
+            melody.addNote(Sample::frequency / 2, Sample::frequency / 2, 440.0);
+
+            ensemble.input.setSource(&waveGen);
+            melody.input.setSource(&ensemble);
+            lowpass.input.setSource(&melody);
+            result.setSource(&lowpass);
+
+            saw.input.setSource(&waveGen.phase);
+            waveGen.waveFunction.setSource(&saw);
+            waveGen.setPhaseSync(false);
+            waveGen.frequency.setSource(&ensemble.input.frequencyOut);
+            ensemble.frequencyIn.setSource(&melody.input.noteFrequency);
+            ensemble.frequencySpread.setDefaultValue(0.02);
+            lowpass.cutoff.setDefaultValue(2000.0);
+        }
+
+        ~EnsemblePatch(){
+            result.setSource(nullptr);
+            lowpass.input.setSource(nullptr);
+            melody.input.setSource(nullptr);
+            ensemble.input.setSource(nullptr);
+        }
+
+        SoundResult result;
+        Lowpass lowpass;
+        Melody melody;
+        Ensemble ensemble;
+        WaveGenerator waveGen;
+        SawWave saw;
+    };
+
+    // A sine wave whose frequency follows a random walk, plus uniform noise
+    struct RandomPatch {
+        RandomPatch(){
+            walk.borrowFrom(&waveGen);
+            walk.speed.setDefaultValue(0.01);
+            scale.input1.setSource(&walk);
+            scale.input2.setDefaultValue(200.0);
+            frequency.input1.setSource(&scale);
+            frequency.input2.setDefaultValue(440.0);
+            waveGen.frequency.setSource(&frequency);
+
+            sine.input.setSource(&waveGen.phase);
+            noise.borrowFrom(&waveGen);
+            noise.minimum.setDefaultValue(-0.05);
+            noise.maximum.setDefaultValue(0.05);
+            wave.input1.setSource(&sine);
+            wave.input2.setSource(&noise);
+            waveGen.waveFunction.setSource(&wave);
+
+            result.setSource(&waveGen);
+        }
+
+        ~RandomPatch(){
+            result.setSource(nullptr);
+        }
+
+        SoundResult result;
+        WaveGenerator waveGen;
+        RandomWalk walk;
+        Multiply scale;
+        Add frequency;
+        SineWave sine;
+        RandomUniform noise;
+        Add wave;
+    };
+
+} // anonymous namespace
+
+TEST(GoldenOutputTest, Sine1){
+    auto p = SinePatch{};
+    p.result.enableDeterministicMode(1);
+    checkGolden("sine", p.result);
+}
+
+TEST(GoldenOutputTest, Ensemble1){
+    auto p = EnsemblePatch{};
+    p.result.enableDeterministicMode(1);
+    checkGolden("ensemble", p.result);
+}
+
+TEST(GoldenOutputTest, Random1){
+    auto p = RandomPatch{};
+    p.result.enableDeterministicMode(1);
+    checkGolden("random", p.result);
+}
+
+TEST(GoldenOutputTest, Reproducible1){
+    auto p1 = EnsemblePatch{};
+    auto p2 = EnsemblePatch{};
+    p1.result.enableDeterministicMode(7);
+    p2.result.enableDeterministicMode(7);
+    const auto h1 = render(p1.result, 0.5).hash;
+    EXPECT_EQ(render(p2.result, 0.5).hash, h1);
+
+    // resetting starts over with the same output
+    p1.result.reset();
+    EXPECT_EQ(render(p1.result, 0.5).hash, h1);
+
+    // and other seeds give other output
+    p1.result.enableDeterministicMode(8);
+    EXPECT_NE(render(p1.result, 0.5).hash, h1);
+
+    auto r1 = RandomPatch{};
+    auto r2 = RandomPatch{};
+    r1.result.enableDeterministicMode(7);
+    r2.result.enableDeterministicMode(7);
+    EXPECT_EQ(render(r1.result, 0.5).hash, render(r2.result, 0.5).hash);
+}
@@ -0,0 +1,107 @@
+#include <Flosion/Core/LookaheadRenderer.hpp>
+#include <Flosion/Core/SoundResult.hpp>
+#include <Flosion/Core/SoundSourceTemplate.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace flo;
+
+namespace {
+
+    // Fills every chunk with the number of chunks rendered before it
+    class CountingSource : public Realtime<ControlledSoundSource<CountingSource, EmptySoundState>> {
+    public:
+        std::atomic<std::size_t> chunks{0};
+        std::chrono::milliseconds delay{0};
+
+        void renderNextChunk(SoundChunk& chunk, EmptySoundState*){
+            if (delay.count() > 0){
+                std::this_thread::sleep_for(delay);
+            }
+            const auto v = static_cast<float>(chunks.fetch_add(1));
+            for (std::size_t c = 0; c < chunk.numChannels(); ++c){
+                std::fill(chunk.channel(c), chunk.channel(c) + SoundChunk::size, v);
+            }
+        }
+    };
+
+    // Takes the next chunk from the renderer, waiting until one is ready
+    void waitForChunk(LookaheadRenderer& renderer, SoundChunk& chunk){
+        while (!renderer.getNextChunk(chunk)){
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+    }
+
+} // anonymous namespace
+
+TEST(LookaheadRendererTest, Order1){
+    auto result = SoundResult{};
+    auto src = CountingSource{};
+    result.setSource(&src);
+
+    {
+        auto renderer = LookaheadRenderer{result, 3};
+        EXPECT_EQ(renderer.getLookahead(), 3);
+        renderer.start();
+
+        // every chunk arrives exactly once and in order
+        auto chunk = SoundChunk{};
+        for (std::size_t i = 0; i < 20; ++i){
+            waitForChunk(renderer, chunk);
+            ASSERT_EQ(chunk.numChannels(), channels::stereo);
+            EXPECT_EQ(chunk.l(0), static_cast<float>(i));
+            EXPECT_EQ(chunk.r(SoundChunk::size - 1), static_cast<float>(i));
+        }
+
+        // the renderer stays no more than the lookahead ahead
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        EXPECT_EQ(src.chunks.load(), 23);
+
+        renderer.stop();
+        EXPECT_FALSE(renderer.isRunning());
+    }
+
+    result.setSource(nullptr);
+}
+
+TEST(LookaheadRendererTest, Late1){
+    auto result = SoundResult{};
+    auto src = CountingSource{};
+    src.delay = std::chrono::milliseconds{50};
+    result.setSource(&src);
+
+    {
+        auto renderer = LookaheadRenderer{result, 2};
+        renderer.start();
+
+        // nothing can be ready yet, so silence is returned
+        auto chunk = SoundChunk{};
+        chunk.l(0) = 1.0f;
+        EXPECT_FALSE(renderer.getNextChunk(chunk));
+        EXPECT_EQ(chunk.l(0), 0.0f);
+
+        auto stats = renderer.getStats();
+        EXPECT_EQ(stats.chunksRequested, 1);
+        EXPECT_EQ(stats.lateChunks, 1);
+        EXPECT_EQ(stats.minQueued, 0);
+
+        // the sound continues from its beginning once it is ready
+        waitForChunk(renderer, chunk);
+        EXPECT_EQ(chunk.l(0), 0.0f);
+        waitForChunk(renderer, chunk);
+        EXPECT_EQ(chunk.l(0), 1.0f);
+
+        renderer.resetStats();
+        stats = renderer.getStats();
+        EXPECT_EQ(stats.chunksRequested, 0);
+        EXPECT_EQ(stats.lateChunks, 0);
+        EXPECT_EQ(stats.minQueued, 2);
+    }
+
+    result.setSource(nullptr);
+}
@@ -0,0 +1,62 @@
+#include <Flosion/Util/ByteOrder.hpp>
+#include <Flosion/Util/MappedFile.hpp>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(MappedFileTest, ByteOrder1){
+    const auto x = std::array<std::uint32_t, 2>{0x01020304u, 0xA0B0C0D0u};
+    auto bytes = std::array<std::byte, 8>{};
+    util::storeLittleEndian(bytes.data(), x.data(), x.size());
+    const auto expected = std::array<std::byte, 8>{
+        std::byte{0x04}, std::byte{0x03}, std::byte{0x02}, std::byte{0x01},
+        std::byte{0xD0}, std::byte{0xC0}, std::byte{0xB0}, std::byte{0xA0}
+    };
+    EXPECT_EQ(bytes, expected);
+
+    // reading doesn't require alignment
+    auto unaligned = std::array<std::byte, 9>{};
+    std::copy(bytes.begin(), bytes.end(), unaligned.begin() + 1);
+    auto y = std::array<std::uint32_t, 2>{};
+    util::loadLittleEndian(y.data(), unaligned.data() + 1, y.size());
+    EXPECT_EQ(x, y);
+
+    const auto f = -1.5;
+    auto fBytes = std::array<std::byte, 8>{};
+    util::storeLittleEndian(fBytes.data(), &f, 1);
+    EXPECT_EQ(fBytes[7], std::byte{0xBF});
+    auto g = 0.0;
+    util::loadLittleEndian(&g, fBytes.data(), 1);
+    EXPECT_EQ(f, g);
+}
+
+TEST(MappedFileTest, Read1){
+    const auto path = std::filesystem::temp_directory_path() / "flosion_mapped_file_test.bin";
+    auto contents = std::vector<char>(100000);
+    for (std::size_t i = 0; i < contents.size(); ++i){
+        contents[i] = static_cast<char>(i * 31);
+    }
+    {
+        auto f = std::ofstream(path, std::ios::binary);
+        f.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    }
+    {
+        const auto mf = util::MappedFile{path};
+        ASSERT_EQ(mf.size(), contents.size());
+        ASSERT_NE(mf.data(), nullptr);
+        EXPECT_TRUE(std::equal(
+            contents.begin(),
+            contents.end(),
+            reinterpret_cast<const char*>(mf.data())
+        ));
+    }
+    std::filesystem::remove(path);
+
+    EXPECT_THROW(util::MappedFile{path}, std::runtime_error);
+}
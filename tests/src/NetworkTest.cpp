@@ -0,0 +1,160 @@
+#include <Flosion/Core/Network.hpp>
+#include <Flosion/Core/SoundResult.hpp>
+#include <Flosion/Core/SoundSourceTemplate.hpp>
+#include <Flosion/Objects/Functions.hpp>
+#include <Flosion/Objects/WaveForms.hpp>
+#include <Flosion/Objects/WaveGenerator.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace flo;
+
+namespace {
+
+    // Records whether it was fully constructed by the time it was initialized
+    class InitOrderNode : public Realtime<Singular<SoundNode, EmptySoundState>> {
+    public:
+        InitOrderNode(bool& constructedBeforeInit, int& numDestroyed)
+            : m_numDestroyed(numDestroyed) {
+            initLater([this, &constructedBeforeInit](){
+                constructedBeforeInit = m_constructed;
+            });
+            m_constructed = true;
+        }
+
+        ~InitOrderNode(){
+            ++m_numDestroyed;
+        }
+
+    private:
+        bool m_constructed = false;
+        int& m_numDestroyed;
+    };
+
+    // Records whether its initialization ran inside a transaction
+    class InitTransactionNode : public Realtime<Singular<SoundNode, EmptySoundState>> {
+    public:
+        InitTransactionNode(bool& inTransaction){
+            initLater([this, &inTransaction](){
+                inTransaction = getNetwork() && getNetwork()->isInTransaction();
+            });
+        }
+    };
+
+    template<typename T>
+    bool contains(const std::vector<T*>& v, const void* x){
+        return std::find(v.begin(), v.end(), x) != v.end();
+    }
+
+} // anonymous namespace
+
+TEST(NetworkTest, TwoPhaseInit1){
+    auto constructedBeforeInit = false;
+    auto numDestroyed = 0;
+
+    // nodes created on their own are initialized right away
+    {
+        auto n = InitOrderNode{constructedBeforeInit, numDestroyed};
+        EXPECT_FALSE(constructedBeforeInit);
+        EXPECT_EQ(n.getNetwork(), nullptr);
+    }
+    EXPECT_EQ(numDestroyed, 1);
+
+    // nodes created by a network are initialized once fully constructed,
+    // and are destroyed along with the network
+    {
+        auto network = Network{};
+        const auto n = network.addSoundNode<InitOrderNode>(constructedBeforeInit, numDestroyed);
+        EXPECT_TRUE(constructedBeforeInit);
+        EXPECT_EQ(n->getNetwork(), &network);
+        EXPECT_TRUE(contains(network.getAllSoundNodes(), n));
+
+        network.addSoundNode<InitOrderNode>(constructedBeforeInit, numDestroyed);
+        EXPECT_EQ(network.getAllSoundNodes().size(), 2u);
+        network.removeSoundNode(n);
+        EXPECT_EQ(numDestroyed, 2);
+        EXPECT_EQ(network.getAllSoundNodes().size(), 1u);
+    }
+    EXPECT_EQ(numDestroyed, 3);
+    EXPECT_EQ(Network::getConstructingNetwork(), nullptr);
+}
+
+TEST(NetworkTest, TwoPhaseInit2){
+    // the nodes created together are initialized in a single transaction
+    auto network = Network{};
+    auto inTransaction = false;
+    network.addSoundNode<InitTransactionNode>(inTransaction);
+    EXPECT_TRUE(inTransaction);
+    EXPECT_FALSE(network.isInTransaction());
+
+    auto n = InitTransactionNode{inTransaction};
+    EXPECT_FALSE(inTransaction);
+}
+
+TEST(NetworkTest, OwnedPatch1){
+    auto network = Network{};
+    const auto result = network.addSoundNode<SoundResult>();
+    const auto waveGen = network.addSoundNode<WaveGenerator>();
+    const auto sine = network.addNumberNode<SineWave>();
+    const auto add = network.addNumberNode<Add>();
+
+    // the single state of a sound result is allocated during initialization
+    EXPECT_EQ(result->numSlots(), 1u);
+
+    // nodes constructed along with others join the network too
+    const auto soundNodes = network.getAllSoundNodes();
+    EXPECT_EQ(soundNodes.size(), 3u);
+    EXPECT_TRUE(contains(soundNodes, result));
+    EXPECT_TRUE(contains(soundNodes, waveGen));
+    const auto numberNodes = network.getAllNumberNodes();
+    EXPECT_TRUE(contains(numberNodes, sine));
+    EXPECT_TRUE(contains(numberNodes, add));
+    EXPECT_TRUE(contains(numberNodes, &waveGen->frequency));
+    EXPECT_TRUE(contains(numberNodes, &waveGen->phase));
+    EXPECT_EQ(waveGen->frequency.getNetwork(), &network);
+
+    sine->input.setSource(&waveGen->phase);
+    add->input1.setSource(sine);
+    add->input2.setDefaultValue(1.0);
+    waveGen->waveFunction.setSource(add);
+    waveGen->frequency.setDefaultValue(100.0);
+    result->setSource(waveGen);
+    EXPECT_EQ(waveGen->numSlots(), 1u);
+
+    auto chunk = SoundChunk{};
+    result->getNextChunk(chunk);
+    EXPECT_NEAR(chunk.channel(0)[0], 1.0f, 1e-3f);
+
+    result->setSource(nullptr);
+    waveGen->waveFunction.setSource(nullptr);
+    const auto phase = &waveGen->phase;
+    network.removeSoundNode(waveGen);
+    EXPECT_EQ(network.getAllSoundNodes().size(), 2u);
+    EXPECT_FALSE(contains(network.getAllNumberNodes(), phase));
+}
+
+TEST(NetworkTest, Teardown1){
+    auto outside = SoundResult{};
+    auto chunk = SoundChunk{};
+    {
+        // the network is destroyed with all its nodes still connected,
+        // including to a sound result outside of it
+        auto network = Network{};
+        const auto result = network.addSoundNode<SoundResult>();
+        const auto waveGen = network.addSoundNode<WaveGenerator>();
+        const auto sine = network.addNumberNode<SineWave>();
+        sine->input.setSource(&waveGen->phase);
+        waveGen->waveFunction.setSource(sine);
+        waveGen->frequency.setDefaultValue(100.0);
+        result->setSource(waveGen);
+        outside.setSource(waveGen);
+        result->getNextChunk(chunk);
+        outside.getNextChunk(chunk);
+    }
+    EXPECT_EQ(outside.getInput().getSource(), nullptr);
+    outside.getNextChunk(chunk);
+    EXPECT_EQ(chunk.channel(0)[0], 0.0f);
+}
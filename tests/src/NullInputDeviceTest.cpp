@@ -0,0 +1,44 @@
+#include <Flosion/Objects/AudioOutput.hpp>
+#include <Flosion/Objects/LiveInput.hpp>
+#include <Flosion/Objects/NullAudioBackend.hpp>
+#include <Flosion/Objects/NullInputDevice.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace flo;
+
+TEST(NullInputDeviceTest, Passthrough1){
+    auto config = AudioOutputConfig{};
+    config.periodSize = 256;
+    auto backend = std::make_unique<NullAudioBackend>(NullAudioBackend::Clock::Manual);
+    auto& b = *backend;
+    b.setRecording(true);
+    auto out = AudioOutput{std::move(backend), config};
+    auto live = LiveInput{};
+    out.soundResult.setSource(&live);
+
+    const std::size_t numFrames = 3 * SoundChunk::size;
+    auto input = std::vector<float>(2 * numFrames);
+    for (std::size_t i = 0; i < numFrames; ++i){
+        input[2 * i] = static_cast<float>(i % 1000) / 1000.0f;
+        input[2 * i + 1] = -static_cast<float>(i % 100) / 100.0f;
+    }
+    auto dev = NullInputDevice{live};
+    dev.setInput(input);
+
+    // feed each chunk of input before the output requests it
+    out.start();
+    for (std::size_t i = 0; i < numFrames / SoundChunk::size; ++i){
+        EXPECT_EQ(dev.feed(SoundChunk::size), SoundChunk::size);
+        b.step(SoundChunk::size / config.periodSize);
+    }
+    out.stop();
+    EXPECT_TRUE(dev.isFinished());
+    EXPECT_EQ(dev.feed(SoundChunk::size), 0);
+
+    EXPECT_EQ(b.getRecording(), input);
+
+    out.soundResult.setSource(nullptr);
+}
@@ -0,0 +1,334 @@
+#include <Flosion/Core/Number.hpp>
+#include <Flosion/Core/SoundResult.hpp>
+#include <Flosion/Core/SoundSourceTemplate.hpp>
+#include <Flosion/Objects/ADSR.hpp>
+#include <Flosion/Objects/Accumulator.hpp>
+#include <Flosion/Objects/ExponentialSmoother.hpp>
+#include <Flosion/Objects/Functions.hpp>
+#include <Flosion/Objects/LinearSmoother.hpp>
+#include <Flosion/Objects/Oscillator.hpp>
+#include <Flosion/Objects/RandomWalk.hpp>
+#include <Flosion/Objects/WaveForms.hpp>
+#include <Flosion/Objects/WaveGenerator.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace flo;
+
+// NOTE: these tests run in whichever precision flo::Number was compiled with,
+// so both configurations of FLOSION_SINGLE_PRECISION_NUMBERS need to be built
+// and tested. Each object is compared against a double precision reference
+// evaluated on the same (possibly rounded) input, and must agree to within
+// a few units of the least precision of flo::Number.
+// Objects with state are evaluated once per sample over many chunks, and
+// must not drift away from the reference as they accumulate.
+
+namespace {
+
+    constexpr double maxRelativeError = 4.0 * static_cast<double>(std::numeric_limits<Number>::epsilon());
+
+    double rounded(double x){
+        return static_cast<double>(static_cast<Number>(x));
+    }
+
+    double evaluate(const NumberSource& source){
+        return static_cast<double>(source.evaluate(nullptr));
+    }
+
+    template<typename Reference>
+    void checkUnary(UnaryFunction& fn, Reference ref, std::initializer_list<double> xs){
+        auto c = Constant{};
+        fn.input.setSource(&c);
+        for (const auto x : xs){
+            c.setValue(static_cast<Number>(x));
+            const auto expected = ref(rounded(x));
+            const auto tolerance = maxRelativeError * std::max(1.0, std::abs(expected));
+            EXPECT_NEAR(evaluate(fn), expected, tolerance) << "with input " << x;
+        }
+        fn.input.setSource(nullptr);
+    }
+
+    template<typename Reference>
+    void checkBinary(BinaryFunction& fn, Reference ref, std::initializer_list<std::pair<double, double>> xs){
+        auto c1 = Constant{};
+        auto c2 = Constant{};
+        fn.input1.setSource(&c1);
+        fn.input2.setSource(&c2);
+        for (const auto& [x, y] : xs){
+            c1.setValue(static_cast<Number>(x));
+            c2.setValue(static_cast<Number>(y));
+            const auto expected = ref(rounded(x), rounded(y));
+            const auto tolerance = maxRelativeError * std::max(1.0, std::abs(expected));
+            EXPECT_NEAR(evaluate(fn), expected, tolerance) << "with inputs " << x << ", " << y;
+        }
+        fn.input1.setSource(nullptr);
+        fn.input2.setSource(nullptr);
+    }
+
+    // Records the value of its input once per sample
+    class Probe : public Realtime<ControlledSoundSource<Probe, EmptySoundState>> {
+    public:
+        SoundNumberInput value{this};
+
+        std::vector<double> values;
+
+        void renderNextChunk(SoundChunk& chunk, EmptySoundState* state){
+            for (std::size_t i = 0; i < SoundChunk::size; ++i){
+                state->adjustTime(static_cast<std::uint32_t>(i));
+                values.push_back(static_cast<double>(value.getValue(state)));
+            }
+            chunk.silence();
+        }
+    };
+
+    constexpr std::size_t numStatefulChunks = 64;
+
+    // Evaluates the borrowing number source once per sample of
+    // numStatefulChunks chunks, with the state borrowed from a probe
+    std::vector<double> evaluateStateful(BorrowingNumberSource& source){
+        auto result = SoundResult{};
+        auto probe = Probe{};
+        source.borrowFrom(&probe);
+        probe.value.setSource(&source);
+        result.setSource(&probe);
+        auto chunk = SoundChunk{};
+        for (std::size_t i = 0; i < numStatefulChunks; ++i){
+            result.getNextChunk(chunk);
+        }
+        result.setSource(nullptr);
+        probe.value.setSource(nullptr);
+        source.borrowFrom(nullptr);
+        return std::move(probe.values);
+    }
+
+    // The distance between two phases in cycles
+    double phaseDistance(double a, double b){
+        const auto d = std::abs(a - b);
+        return std::min(d, 1.0 - d);
+    }
+
+} // anonymous namespace
+
+TEST(NumberPrecisionTest, Constants1){
+    EXPECT_NEAR(evaluate(PiConstant{}), 3.141592653589793, maxRelativeError * 4.0);
+    EXPECT_NEAR(evaluate(TauConstant{}), 6.283185307179586, maxRelativeError * 8.0);
+    EXPECT_NEAR(evaluate(EulersConstant{}), 2.718281828459045, maxRelativeError * 4.0);
+    EXPECT_EQ(evaluate(Constant{0.5}), 0.5);
+}
+
+TEST(NumberPrecisionTest, UnaryFunctions1){
+    const auto xs = {-2.5, -1.0, -0.3, 0.0, 0.1, 0.7, 1.0, 3.25, 17.0};
+    const auto positive = {0.001, 0.1, 0.7, 1.0, 3.25, 17.0, 44100.0};
+    const auto unit = {-0.99, -0.5, -0.1, 0.0, 0.3, 0.75, 0.99};
+
+    { auto f = Abs{}; checkUnary(f, [](double x){ return std::abs(x); }, xs); }
+    { auto f = SquareRoot{}; checkUnary(f, [](double x){ return std::sqrt(x); }, positive); }
+    { auto f = CubeRoot{}; checkUnary(f, [](double x){ return std::cbrt(x); }, xs); }
+    { auto f = Square{}; checkUnary(f, [](double x){ return x * x; }, xs); }
+    { auto f = Log{}; checkUnary(f, [](double x){ return std::log(x); }, positive); }
+    { auto f = Log2{}; checkUnary(f, [](double x){ return std::log2(x); }, positive); }
+    { auto f = Log10{}; checkUnary(f, [](double x){ return std::log10(x); }, positive); }
+    { auto f = Exp{}; checkUnary(f, [](double x){ return std::exp(x); }, xs); }
+    { auto f = Exp2{}; checkUnary(f, [](double x){ return std::exp2(x); }, xs); }
+    { auto f = Sin{}; checkUnary(f, [](double x){ return std::sin(x); }, xs); }
+    { auto f = Cos{}; checkUnary(f, [](double x){ return std::cos(x); }, xs); }
+    { auto f = Asin{}; checkUnary(f, [](double x){ return std::asin(x); }, unit); }
+    { auto f = Acos{}; checkUnary(f, [](double x){ return std::acos(x); }, unit); }
+    { auto f = Atan{}; checkUnary(f, [](double x){ return std::atan(x); }, xs); }
+    { auto f = Sinh{}; checkUnary(f, [](double x){ return std::sinh(x); }, xs); }
+    { auto f = Cosh{}; checkUnary(f, [](double x){ return std::cosh(x); }, xs); }
+    { auto f = Tanh{}; checkUnary(f, [](double x){ return std::tanh(x); }, xs); }
+    { auto f = Asinh{}; checkUnary(f, [](double x){ return std::asinh(x); }, xs); }
+    { auto f = Atanh{}; checkUnary(f, [](double x){ return std::atanh(x); }, unit); }
+    { auto f = Floor{}; checkUnary(f, [](double x){ return std::floor(x); }, xs); }
+    { auto f = Ceil{}; checkUnary(f, [](double x){ return std::ceil(x); }, xs); }
+    { auto f = Negate{}; checkUnary(f, [](double x){ return -x; }, xs); }
+    { auto f = OneMinus{}; checkUnary(f, [](double x){ return 1.0 - x; }, xs); }
+    { auto f = Reciprocal{}; checkUnary(f, [](double x){ return 1.0 / x; }, positive); }
+    { auto f = Sigmoid{}; checkUnary(f, [](double x){ return 1.0 / (1.0 + std::exp(-x)); }, xs); }
+}
+
+TEST(NumberPrecisionTest, BinaryFunctions1){
+    const auto xys = {
+        std::pair{1.0, 2.0},
+        std::pair{-3.5, 0.25},
+        std::pair{0.1, 0.7},
+        std::pair{440.0, 1.5}
+    };
+
+    { auto f = Add{}; checkBinary(f, [](double x, double y){ return x + y; }, xys); }
+    { auto f = Subtract{}; checkBinary(f, [](double x, double y){ return x - y; }, xys); }
+    { auto f = Multiply{}; checkBinary(f, [](double x, double y){ return x * y; }, xys); }
+    { auto f = Divide{}; checkBinary(f, [](double x, double y){ return x / y; }, xys); }
+    { auto f = Min{}; checkBinary(f, [](double x, double y){ return std::min(x, y); }, xys); }
+    { auto f = Max{}; checkBinary(f, [](double x, double y){ return std::max(x, y); }, xys); }
+    { auto f = Hypot{}; checkBinary(f, [](double x, double y){ return std::hypot(x, y); }, xys); }
+    // NOTE: the first input of Atan2 is the x coordinate
+    { auto f = Atan2{}; checkBinary(f, [](double x, double y){ return std::atan2(y, x); }, xys); }
+}
+
+TEST(NumberPrecisionTest, WaveForms1){
+    const auto phases = {0.0, 0.1, 0.25, 0.4, 0.6, 0.9, 2.3, 100.35};
+    const auto pi = 3.141592653589793;
+
+    // NOTE: the sine wave's input is a phase in cycles, which is scaled by
+    // a rounded 2*pi, so that large phases are less precise than small ones
+    {
+        auto f = SineWave{};
+        auto c = Constant{};
+        f.input.setSource(&c);
+        for (const auto x : phases){
+            c.setValue(static_cast<Number>(x));
+            const auto tolerance = maxRelativeError * std::max(1.0, 2.0 * pi * std::abs(x));
+            EXPECT_NEAR(evaluate(f), std::sin(2.0 * pi * rounded(x)), tolerance) << "with input " << x;
+        }
+        f.input.setSource(nullptr);
+    }
+    {
+        auto f = SawWave{};
+        checkUnary(f, [](double x){ const auto v = x - 0.5; return 2.0 * (v - std::floor(v)) - 1.0; }, {0.0, 0.1, 0.25, 0.4, 0.6, 0.9});
+    }
+    {
+        auto f = TriangleWave{};
+        checkUnary(f, [](double x){ const auto v = x + 0.25; return 1.0 - 2.0 * std::abs(1.0 - 2.0 * (v - std::floor(v))); }, {0.0, 0.1, 0.25, 0.4, 0.6, 0.9});
+    }
+}
+
+TEST(NumberPrecisionTest, Accumulator1){
+    auto f = Accumulator{};
+    f.input.setDefaultValue(Number{0.001});
+    const auto values = evaluateStateful(f);
+    const auto step = rounded(0.001);
+    auto expected = 0.0;
+    for (std::size_t i = 0; i < values.size(); ++i){
+        expected += step;
+        const auto tolerance = maxRelativeError * std::max(1.0, expected);
+        ASSERT_NEAR(values[i], expected, tolerance) << "at sample " << i;
+    }
+}
+
+TEST(NumberPrecisionTest, Oscillator1){
+    auto f = Oscillator{};
+    f.input.setDefaultValue(Number{440.0 / 44100.0});
+    const auto values = evaluateStateful(f);
+    const auto step = rounded(440.0 / 44100.0);
+    auto expected = 0.0;
+    for (std::size_t i = 0; i < values.size(); ++i){
+        expected += step;
+        expected -= std::floor(expected);
+        ASSERT_LE(phaseDistance(values[i], expected), maxRelativeError) << "at sample " << i;
+    }
+}
+
+TEST(NumberPrecisionTest, WaveGenerator1){
+    // The wave generator renders its own phase, which is rounded to
+    // single precision samples in either configuration
+    auto result = SoundResult{};
+    auto waveGen = WaveGenerator{};
+    waveGen.waveFunction.setSource(&waveGen.phase);
+    waveGen.frequency.setDefaultValue(Number{441.3});
+    result.setSource(&waveGen);
+
+    const auto tolerance = 4.0 * static_cast<double>(std::numeric_limits<float>::epsilon());
+    const auto step = rounded(441.3) / static_cast<double>(Sample::frequency);
+    auto expected = 0.0;
+    auto chunk = SoundChunk{};
+    for (std::size_t i = 0; i < numStatefulChunks; ++i){
+        result.getNextChunk(chunk);
+        for (std::size_t j = 0; j < SoundChunk::size; ++j){
+            ASSERT_LE(phaseDistance(chunk.l(j), expected), tolerance) << "at sample " << j << " of chunk " << i;
+            expected += step;
+            expected -= std::floor(expected);
+        }
+    }
+    result.setSource(nullptr);
+}
+
+TEST(NumberPrecisionTest, RandomWalk1){
+    auto f = RandomWalk{};
+    f.randomSeed.set(1);
+    const auto values = evaluateStateful(f);
+
+    // The same walk, taking its random numbers from the first stream of the seed
+    f.randomSeed.set(1);
+    auto rng = f.randomSeed.makeStream();
+    const auto speed = rounded(0.001);
+    const auto damping = rounded(0.5);
+    const auto bias = rounded(0.1);
+    auto value = 0.0;
+    auto velocity = 0.0;
+    for (std::size_t i = 0; i < values.size(); ++i){
+        const auto r = 2.0 * rng.uniform() - 1.0;
+        velocity = velocity * damping + (r - value * bias) * speed;
+        value += velocity;
+        const auto tolerance = maxRelativeError * std::max(1.0, std::abs(value));
+        ASSERT_NEAR(values[i], value, tolerance) << "at sample " << i;
+    }
+}
+
+TEST(NumberPrecisionTest, Smoothers1){
+    {
+        // A slow exponential approach towards 1
+        auto f = ExponentialSmoother{};
+        f.input.setDefaultValue(1.0);
+        f.decayRate.setDefaultValue(Number{0.0001});
+        const auto values = evaluateStateful(f);
+        const auto d = rounded(0.0001);
+        auto expected = 0.0;
+        for (std::size_t i = 0; i < values.size(); ++i){
+            expected += d * (1.0 - expected);
+            ASSERT_NEAR(values[i], expected, maxRelativeError) << "at sample " << i;
+        }
+    }
+    {
+        // A slow linear ramp towards a distant target
+        auto f = LinearSmoother{};
+        f.input.setDefaultValue(1000.0);
+        f.rate.setDefaultValue(Number{0.001});
+        const auto values = evaluateStateful(f);
+        const auto r = rounded(0.001);
+        auto expected = 0.0;
+        for (std::size_t i = 0; i < values.size(); ++i){
+            expected += r;
+            const auto tolerance = maxRelativeError * std::max(1.0, expected);
+            ASSERT_NEAR(values[i], expected, tolerance) << "at sample " << i;
+        }
+    }
+}
+
+TEST(NumberPrecisionTest, ADSR1){
+    // An envelope whose attack and decay are short compared to its length
+    auto f = ADSR{};
+    auto t = Constant{};
+    f.currentTime.setSource(&t);
+    f.attackDuration.setDefaultValue(Number{0.01});
+    f.decayDuration.setDefaultValue(Number{0.05});
+    f.sustainLevel.setDefaultValue(Number{0.6});
+    f.timeOfRelease.setDefaultValue(Number{1.0});
+    f.totalDuration.setDefaultValue(Number{1.5});
+
+    const auto a = rounded(0.01);
+    const auto d = rounded(0.05);
+    const auto s = rounded(0.6);
+    const auto rel = rounded(1.0);
+    const auto l = rounded(1.5);
+    for (const auto x : {0.001, 0.005, 0.0099, 0.02, 0.059, 0.3, 0.99, 1.1, 1.25, 1.499}){
+        t.setValue(static_cast<Number>(x));
+        const auto time = rounded(x);
+        auto expected = time < a ? time / a : (time - a < d ? 1.0 - (time - a) * (1.0 - s) / d : s);
+        if (time >= rel){
+            expected *= 1.0 - (time - rel) / (l - rel);
+        }
+        EXPECT_NEAR(evaluate(f), expected, maxRelativeError * 8.0) << "at time " << x;
+    }
+    f.currentTime.setSource(nullptr);
+}
@@ -0,0 +1,113 @@
+#include <Flosion/Core/Profiler.hpp>
+#include <Flosion/Core/SoundResult.hpp>
+#include <Flosion/Core/SoundSourceTemplate.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace flo;
+
+// NOTE: these tests check the measurements only if FLOSION_PROFILING is
+// defined, and otherwise that nothing is measured
+
+namespace {
+
+    // Fills every chunk with the value of its input, evaluated per sample
+    class ValueSource : public Realtime<ControlledSoundSource<ValueSource, EmptySoundState>> {
+    public:
+        SoundNumberInput value{this};
+
+        void renderNextChunk(SoundChunk& chunk, EmptySoundState* state){
+            for (std::size_t i = 0; i < SoundChunk::size; ++i){
+                chunk.channel(0)[i] = static_cast<float>(value.getValue(state));
+            }
+            chunk.spreadChannel(0);
+        }
+    };
+
+    // Renders its input after sleeping a while
+    class SlowSource : public Realtime<ControlledSoundSource<SlowSource, EmptySoundState>> {
+    public:
+        SingleSoundInput input{this};
+
+        void renderNextChunk(SoundChunk& chunk, EmptySoundState* state){
+            std::this_thread::sleep_for(std::chrono::milliseconds{2});
+            input.getNextChunkFor(chunk, this, state);
+        }
+    };
+
+} // anonymous namespace
+
+TEST(ProfilerTest, Nodes1){
+    auto result = SoundResult{};
+    auto slow = SlowSource{};
+    auto src = ValueSource{};
+    auto c = Constant{0.5};
+    src.value.setSource(&c);
+    slow.input.setSource(&src);
+    result.setSource(&slow);
+
+    // threads which aren't registered are not measured
+    Profiler::reset();
+    std::thread([&]{
+        auto chunk = SoundChunk{};
+        result.getNextChunk(chunk);
+    }).join();
+    EXPECT_TRUE(Profiler::getStats().empty());
+
+    Profiler::registerCurrentThread();
+    Profiler::reset();
+    auto chunk = SoundChunk{};
+    const std::size_t numChunks = 10;
+    for (std::size_t i = 0; i < numChunks; ++i){
+        result.getNextChunk(chunk);
+    }
+    EXPECT_EQ(chunk.l(0), 0.5f);
+
+    const auto stats = Profiler::getStats();
+    if (!Profiler::isCompiledIn()){
+        EXPECT_TRUE(stats.empty());
+        return;
+    }
+
+    const auto find = [&](const void* node) -> const Profiler::NodeStats* {
+        auto it = std::find_if(stats.begin(), stats.end(), [&](const Profiler::NodeStats& s){
+            return s.soundNode == node || s.numberSource == node;
+        });
+        return it == stats.end() ? nullptr : &*it;
+    };
+
+    const auto s = find(&slow);
+    const auto v = find(&src);
+    const auto n = find(&c);
+    ASSERT_TRUE(s && v && n);
+    EXPECT_NE(s->state, nullptr);
+    EXPECT_EQ(n->state, nullptr);
+    EXPECT_EQ(s->count, numChunks);
+    EXPECT_EQ(v->count, numChunks);
+
+    // the number source is measured once per chunk, not once per sample
+    EXPECT_EQ(n->count, numChunks);
+
+    // the slow source's own time excludes the time spent in its input,
+    // and the sleep dominates everything else
+    EXPECT_GE(s->meanSeconds, 0.0015);
+    EXPECT_GE(s->maxSeconds, s->p99Seconds);
+    EXPECT_GE(s->p99Seconds, 0.9 * s->meanSeconds);
+    EXPECT_LT(v->meanSeconds, s->meanSeconds);
+    EXPECT_EQ(stats.front().soundNode, &slow);
+
+    const auto chunkSeconds = static_cast<double>(SoundChunk::size) / static_cast<double>(sampleFrequency);
+    EXPECT_DOUBLE_EQ(s->budgetShare, s->meanSeconds / chunkSeconds);
+
+    // nothing is measured while profiling is disabled
+    Profiler::reset();
+    Profiler::setEnabled(false);
+    result.getNextChunk(chunk);
+    EXPECT_TRUE(Profiler::getStats().empty());
+    Profiler::setEnabled(true);
+    EXPECT_EQ(Profiler::getDroppedCount(), 0);
+}
@@ -0,0 +1,123 @@
+#include <Flosion/Util/RNG.hpp>
+#include <Flosion/Core/SoundResult.hpp>
+#include <Flosion/Objects/Functions.hpp>
+#include <Flosion/Objects/WaveGenerator.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace util;
+
+TEST(RNGTest, Streams1){
+    auto a = CounterRNG{CounterRNG::keyFor(1, 0)};
+    auto b = CounterRNG{CounterRNG::keyFor(1, 1)};
+    EXPECT_TRUE(a.isSeeded());
+    EXPECT_FALSE(CounterRNG{}.isSeeded());
+
+    // streams are pure functions of their key and position
+    auto a2 = CounterRNG{a.key()};
+    a2.discard(10);
+    for (int i = 0; i < 10; ++i){
+        a();
+    }
+    EXPECT_EQ(a(), a2());
+    EXPECT_NE(a(), b());
+
+    // and uniforms of one block match those drawn one at a time
+    auto c = CounterRNG{CounterRNG::keyFor(7, 3)};
+    auto d = c;
+    auto block = std::vector<float>(1000);
+    c.fillUniform(block.data(), block.size());
+    for (const auto x : block){
+        ASSERT_NEAR(x, static_cast<float>(d.uniform()), 1e-6f);
+    }
+    EXPECT_EQ(c.counter(), d.counter());
+}
+
+TEST(RNGTest, Distributions1){
+    auto rng = CounterRNG{CounterRNG::keyFor(42, 0)};
+    const std::size_t n = 100000;
+
+    auto u = std::vector<double>(n);
+    rng.fillUniform(u.data(), n, -1.0, 3.0);
+    double sum = 0.0;
+    for (const auto x : u){
+        ASSERT_GE(x, -1.0);
+        ASSERT_LT(x, 3.0);
+        sum += x;
+    }
+    EXPECT_NEAR(sum / n, 1.0, 0.02);
+
+    auto g = std::vector<float>(n + 1);
+    rng.fillNormal(g.data(), g.size(), 2.0f, 0.5f);
+    double m = 0.0;
+    double v = 0.0;
+    for (const auto x : g){
+        m += x;
+        v += (x - 2.0) * (x - 2.0);
+    }
+    EXPECT_NEAR(m / g.size(), 2.0, 0.01);
+    EXPECT_NEAR(std::sqrt(v / g.size()), 0.5, 0.01);
+}
+
+namespace {
+
+    // Renders a chunk whose samples are the values of the given random
+    // source, which borrows its state from a wave generator
+    std::vector<float> renderRandom(flo::BorrowingNumberSource& source){
+        auto result = flo::SoundResult{};
+        auto waveGen = flo::WaveGenerator{};
+        source.borrowFrom(&waveGen);
+        waveGen.waveFunction.setSource(&source);
+        result.setSource(&waveGen);
+        auto chunk = flo::SoundChunk{};
+        result.getNextChunk(chunk);
+        result.setSource(nullptr);
+        waveGen.waveFunction.setSource(nullptr);
+        source.borrowFrom(nullptr);
+        return std::vector<float>(chunk.channel(0), chunk.channel(0) + flo::SoundChunk::size);
+    }
+
+} // anonymous namespace
+
+TEST(RNGTest, Seeds1){
+    // the same seeds are handed out again after a reset
+    resetSeeds(123);
+    auto u1 = flo::RandomUniform{};
+    auto n1 = flo::RandomNormal{};
+    resetSeeds(123);
+    auto u2 = flo::RandomUniform{};
+    auto n2 = flo::RandomNormal{};
+    EXPECT_EQ(u1.randomSeed.get(), u2.randomSeed.get());
+    EXPECT_NE(u1.randomSeed.get(), n1.randomSeed.get());
+
+    for (auto u : {&u1, &u2}){
+        u->minimum.setDefaultValue(-1.0);
+        u->maximum.setDefaultValue(1.0);
+    }
+    for (auto n : {&n1, &n2}){
+        n->deviation.setDefaultValue(1.0);
+    }
+    const auto uniform = renderRandom(u1);
+    EXPECT_EQ(renderRandom(u2), uniform);
+    EXPECT_EQ(renderRandom(n2), renderRandom(n1));
+    for (const auto x : uniform){
+        ASSERT_GE(x, -1.0f);
+        ASSERT_LT(x, 1.0f);
+    }
+
+    // every new state takes a stream of its own
+    EXPECT_NE(renderRandom(u1), uniform);
+
+    // and setting the seed restarts the streams
+    u1.randomSeed.set(5);
+    const auto first = renderRandom(u1);
+    EXPECT_NE(renderRandom(u1), first);
+    u1.randomSeed.set(5);
+    EXPECT_EQ(renderRandom(u1), first);
+    const auto s1 = u1.randomSeed.makeStream();
+    const auto s2 = u1.randomSeed.makeStream();
+    EXPECT_NE(s1.key(), s2.key());
+}
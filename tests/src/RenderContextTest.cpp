@@ -0,0 +1,80 @@
+#include <Flosion/Core/RenderContext.hpp>
+#include <Flosion/Core/SoundSourceTemplate.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace flo;
+
+namespace {
+
+    // Like SoundResult, owns a single state regardless of its dependents
+    class RootSoundNode : public Realtime<Uncontrolled<SoundNode, EmptySoundState>> {
+    public:
+        RootSoundNode(){
+            enableMonostate();
+        }
+    };
+
+    using DivergentSoundNode = Realtime<Divergent<SoundNode, EmptySoundState, int>>;
+    using LeafSoundNode = Realtime<Singular<SoundNode, EmptySoundState>>;
+
+} // anonymous namespace
+
+TEST(RenderContextTest, FindState1){
+    auto root = RootSoundNode{};
+    auto div = DivergentSoundNode{};
+    auto mid = LeafSoundNode{};
+    auto leaf = LeafSoundNode{};
+
+    root.addDependency(&div);
+    div.addDependency(&mid);
+    mid.addDependency(&leaf);
+    div.addKey(0);
+    div.addKey(1);
+
+    const auto leafState = leaf.getState(1);
+    const auto midState = mid.getState(1);
+    const auto divState = div.getState(1);
+    ASSERT_EQ(leafState->getDependentState(), midState);
+    ASSERT_EQ(midState->getDependentState(), divState);
+
+    // without any scopes, the chain is walked
+    EXPECT_EQ(RenderContext::findState(&div, leafState), divState);
+    EXPECT_EQ(RenderContext::findState(&root, leafState), root.getMonoState());
+    EXPECT_EQ(RenderContext::findState(&leaf, midState), nullptr);
+
+    {
+        auto s1 = RenderContext::Scope{&div, divState};
+        auto s2 = RenderContext::Scope{&mid, midState};
+        auto s3 = RenderContext::Scope{&leaf, leafState};
+
+        EXPECT_EQ(RenderContext::findState(&leaf, leafState), leafState);
+        EXPECT_EQ(RenderContext::findState(&mid, leafState), midState);
+        EXPECT_EQ(RenderContext::findState(&div, leafState), divState);
+
+        // states outside of the scopes are still found
+        EXPECT_EQ(RenderContext::findState(&root, leafState), root.getMonoState());
+
+        // contexts other than the innermost one are still answered correctly
+        EXPECT_EQ(RenderContext::findState(&div, midState), divState);
+        EXPECT_EQ(RenderContext::findState(&leaf, midState), nullptr);
+        EXPECT_EQ(RenderContext::findState(&div, leaf.getState(0)), div.getState(0));
+
+        // a scope whose state does not depend on the previous one
+        // hides the states of all enclosing scopes
+        {
+            auto s4 = RenderContext::Scope{&mid, mid.getState(0)};
+            EXPECT_EQ(RenderContext::findState(&mid, mid.getState(0)), mid.getState(0));
+            EXPECT_EQ(RenderContext::findState(&div, mid.getState(0)), div.getState(0));
+            EXPECT_EQ(RenderContext::findState(&leaf, mid.getState(0)), nullptr);
+        }
+
+        EXPECT_EQ(RenderContext::findState(&mid, leafState), midState);
+    }
+
+    EXPECT_EQ(RenderContext::findState(&mid, leafState), midState);
+
+    mid.removeDependency(&leaf);
+    div.removeDependency(&mid);
+    root.removeDependency(&div);
+}
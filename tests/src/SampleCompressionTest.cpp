@@ -0,0 +1,92 @@
+#include <Flosion/Util/SampleCompression.hpp>
+#include <Flosion/Util/RNG.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+    // A decaying chord with a little noise, like recorded sound
+    std::vector<std::int16_t> makeSamples(std::size_t numFrames, std::size_t numChannels){
+        auto rng = util::CounterRNG{util::CounterRNG::keyFor(42, 0)};
+        auto v = std::vector<std::int16_t>(numFrames * numChannels);
+        for (std::size_t i = 0; i < numFrames; ++i){
+            const auto t = static_cast<double>(i) / 44100.0;
+            for (std::size_t c = 0; c < numChannels; ++c){
+                const auto x = std::exp(-t) * (
+                    std::sin(t * 1382.3 * (c + 1)) + 0.5 * std::sin(t * 2073.4)
+                ) + 0.001 * rng.uniform();
+                v[i * numChannels + c] = static_cast<std::int16_t>(std::lround(x * 20000.0));
+            }
+        }
+        return v;
+    }
+
+    std::vector<std::int16_t> roundTrip(const std::vector<std::int16_t>& v, std::size_t numChannels){
+        const auto c = util::compressSamples(v.data(), numChannels == 0 ? 0 : v.size() / numChannels, numChannels);
+        return util::decompressSamples(c.data(), c.size());
+    }
+
+} // anonymous namespace
+
+TEST(SampleCompressionTest, RoundTrip1){
+    for (const auto numChannels : {1u, 2u, 5u}){
+        for (const auto numFrames : {0u, 1u, 3u, 4096u, 4097u, 100000u}){
+            const auto v = makeSamples(numFrames, numChannels);
+            EXPECT_EQ(roundTrip(v, numChannels), v);
+        }
+    }
+}
+
+TEST(SampleCompressionTest, Extremes1){
+    // Full scale square waves and white noise predict poorly
+    // and need the escape codes
+    auto v = std::vector<std::int16_t>(20000);
+    auto rng = util::CounterRNG{util::CounterRNG::keyFor(7, 0)};
+    for (std::size_t i = 0; i < v.size(); ++i){
+        if (i < v.size() / 2){
+            v[i] = (i / 3) % 2 == 0 ? std::numeric_limits<std::int16_t>::min() : std::numeric_limits<std::int16_t>::max();
+        } else {
+            v[i] = static_cast<std::int16_t>(rng() & 0xFFFF);
+        }
+    }
+    EXPECT_EQ(roundTrip(v, 1), v);
+    EXPECT_EQ(roundTrip(v, 2), v);
+
+    // Moderate noise with rare spikes has residuals whose Rice codes
+    // are long, but not long enough to be escaped
+    auto w = std::vector<std::int16_t>(3 * 4096);
+    for (std::size_t i = 0; i < w.size(); ++i){
+        w[i] = static_cast<std::int16_t>(static_cast<int>(rng() % 2001) - 1000);
+    }
+    for (std::size_t i = 100; i < w.size(); i += 4096){
+        w[i] = 6000;
+        w[i + 1] = -6000;
+    }
+    EXPECT_EQ(roundTrip(w, 1), w);
+    EXPECT_EQ(roundTrip(w, 3), w);
+}
+
+TEST(SampleCompressionTest, Ratio1){
+    const auto v = makeSamples(200000, 2);
+    const auto c = util::compressSamples(v.data(), 200000, 2);
+    EXPECT_LT(c.size(), v.size() * sizeof(std::int16_t) / 2);
+}
+
+TEST(SampleCompressionTest, Malformed1){
+    const auto v = makeSamples(10000, 2);
+    auto c = util::compressSamples(v.data(), 10000, 2);
+
+    EXPECT_THROW(util::decompressSamples(c.data(), 0), std::runtime_error);
+    EXPECT_THROW(util::decompressSamples(c.data(), 10), std::runtime_error);
+    EXPECT_THROW(util::decompressSamples(c.data(), c.size() - 1), std::runtime_error);
+
+    // an absurd number of frames
+    c[16] = std::byte{0xFF};
+    EXPECT_THROW(util::decompressSamples(c.data(), c.size()), std::runtime_error);
+}
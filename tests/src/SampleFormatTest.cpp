@@ -0,0 +1,139 @@
+#include <Flosion/Core/SampleFormat.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace flo;
+
+namespace {
+
+    // Fills every channel with a different sweep over [-1.2, 1.2],
+    // so that clamping is exercised as well
+    void fill(SoundChunk& chunk){
+        for (std::size_t c = 0; c < chunk.numChannels(); ++c){
+            const auto dst = chunk.channel(c);
+            for (std::size_t i = 0; i < SoundChunk::size; ++i){
+                const auto t = static_cast<float>((i * (c + 1)) % SoundChunk::size) / static_cast<float>(SoundChunk::size);
+                dst[i] = 2.4f * t - 1.2f;
+            }
+        }
+    }
+
+    float clamped(float v){
+        return v < -1.0f ? -1.0f : (v > 1.0f ? 1.0f : v);
+    }
+
+} // anonymous namespace
+
+TEST(SampleFormatTest, Interleave1){
+    auto src = SoundChunk{channels::quad};
+    fill(src);
+    auto buffer = std::vector<float>(4 * 100);
+    interleave(src, 50, 100, buffer.data());
+    for (std::size_t i = 0; i < 100; ++i){
+        for (std::size_t c = 0; c < 4; ++c){
+            ASSERT_EQ(buffer[4 * i + c], src.channel(c)[50 + i]);
+        }
+    }
+
+    auto dst = SoundChunk{channels::quad};
+    deinterleave(buffer.data(), 100, dst, 10);
+    for (std::size_t c = 0; c < 4; ++c){
+        for (std::size_t i = 0; i < 100; ++i){
+            ASSERT_EQ(dst.channel(c)[10 + i], src.channel(c)[50 + i]);
+        }
+        EXPECT_EQ(dst.channel(c)[0], 0.0f);
+        EXPECT_EQ(dst.channel(c)[110], 0.0f);
+    }
+}
+
+TEST(SampleFormatTest, RoundTrip1){
+    auto src = SoundChunk{channels::stereo};
+    fill(src);
+
+    const auto check = [&](SampleFormat format, float lsb){
+        auto enc = SampleEncoder{format};
+        auto bytes = std::vector<unsigned char>(2 * SoundChunk::size * bytesPerSample(format));
+        enc.encode(src, 0, SoundChunk::size, bytes.data());
+        auto dst = SoundChunk{channels::stereo};
+        decodeInterleaved(bytes.data(), format, 2, SoundChunk::size, dst, 0);
+        for (std::size_t c = 0; c < 2; ++c){
+            for (std::size_t i = 0; i < SoundChunk::size; ++i){
+                // rounding to the nearest integer is off by at most half an LSB
+                ASSERT_NEAR(dst.channel(c)[i], clamped(src.channel(c)[i]), 0.5f * lsb + 1e-7f)
+                    << "in channel " << c << " at " << i;
+            }
+        }
+    };
+
+    check(SampleFormat::Float32, 0.0f);
+    check(SampleFormat::Int16, 1.0f / 32767.0f);
+    check(SampleFormat::Int24, 1.0f / 8388607.0f);
+    check(SampleFormat::Int32, 0.0f);
+}
+
+TEST(SampleFormatTest, Layout1){
+    auto src = SoundChunk{channels::stereo};
+    src.channel(0)[0] = 1.0f;
+    src.channel(1)[0] = -1.0f;
+    src.channel(0)[1] = 0.5f;
+    src.channel(1)[1] = 2.0f;
+
+    auto i16 = std::vector<std::int16_t>(4);
+    SampleEncoder{SampleFormat::Int16}.encode(src, 0, 2, i16.data());
+    EXPECT_EQ(i16, (std::vector<std::int16_t>{32767, -32767, 16384, 32767}));
+
+    auto i24 = std::vector<unsigned char>(12);
+    SampleEncoder{SampleFormat::Int24}.encode(src, 0, 2, i24.data());
+    EXPECT_EQ(i24, (std::vector<unsigned char>{
+        0xff, 0xff, 0x7f,
+        0x01, 0x00, 0x80,
+        0x00, 0x00, 0x40,
+        0xff, 0xff, 0x7f
+    }));
+
+    auto i32 = std::vector<std::int32_t>(4);
+    SampleEncoder{SampleFormat::Int32}.encode(src, 0, 2, i32.data());
+    EXPECT_EQ(i32, (std::vector<std::int32_t>{2147483647, -2147483647, 1073741824, 2147483647}));
+}
+
+TEST(SampleFormatTest, Dither1){
+    // a constant signal a fraction of an LSB above zero, which without
+    // dither would always be rounded to the same value
+    auto src = SoundChunk{channels::mono};
+    const auto lsb = 1.0f / 32767.0f;
+    const auto value = 0.25f * lsb;
+    for (std::size_t i = 0; i < SoundChunk::size; ++i){
+        src.channel(0)[i] = value;
+    }
+
+    for (const auto dither : {Dither::Triangular, Dither::NoiseShaped}){
+        auto enc = SampleEncoder{SampleFormat::Int16, dither};
+        auto out = std::vector<std::int16_t>(SoundChunk::size);
+        double sum = 0.0;
+        const std::size_t numChunks = 64;
+        for (std::size_t k = 0; k < numChunks; ++k){
+            enc.encode(src, 0, SoundChunk::size, out.data());
+            for (const auto q : out){
+                // triangular dither spans +/- 1 LSB, and noise shaping
+                // adds at most the previous error
+                ASSERT_LE(std::abs(q), dither == Dither::Triangular ? 2 : 3);
+                sum += static_cast<double>(q);
+            }
+        }
+        // on average, the signal is preserved
+        const auto mean = sum / static_cast<double>(numChunks * SoundChunk::size);
+        EXPECT_NEAR(mean, 0.25, 0.05);
+
+        // and the noise is reproducible
+        enc.reset();
+        auto first = std::vector<std::int16_t>(SoundChunk::size);
+        enc.encode(src, 0, SoundChunk::size, first.data());
+        enc.reset();
+        enc.encode(src, 0, SoundChunk::size, out.data());
+        EXPECT_EQ(first, out);
+    }
+}
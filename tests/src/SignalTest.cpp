@@ -0,0 +1,108 @@
+#include <Flosion/Core/Signal.hpp>
+
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace flo;
+
+TEST(SignalTest, Broadcast1){
+    auto s = Signal<int>{};
+    auto calls = std::vector<int>{};
+
+    auto c1 = s.connect([&](int x){ calls.push_back(x); });
+    {
+        auto c2 = s.connect([&](int x){ calls.push_back(10 * x); });
+        s.broadcast(1);
+    }
+    s.broadcast(2);
+    EXPECT_EQ(calls, (std::vector<int>{1, 10, 2}));
+
+    // moved connections stay connected
+    auto c3 = std::move(c1);
+    s.broadcast(3);
+    EXPECT_EQ(calls.back(), 3);
+    c3.reset();
+    s.broadcast(4);
+    EXPECT_EQ(calls.back(), 3);
+
+    // moved signals keep their handlers
+    auto c4 = s.connect([&](int x){ calls.push_back(x); });
+    auto t = std::move(s);
+    t.broadcast(5);
+    EXPECT_EQ(calls.back(), 5);
+}
+
+TEST(SignalTest, Reentrant1){
+    auto s = Signal<int>{};
+    auto calls = std::vector<int>{};
+
+    // a handler which disconnects itself, one which disconnects
+    // the next handler, and one which connects a new handler
+    auto c1 = Connection{};
+    auto c3 = Connection{};
+    auto added = std::optional<Connection>{};
+    c1 = s.connect([&](int){
+        calls.push_back(1);
+        c1.reset();
+    });
+    auto c2 = s.connect([&](int x){
+        calls.push_back(2);
+        c3.reset();
+        if (!added){
+            added = s.connect([&](int){ calls.push_back(4); });
+        }
+        // nested broadcasts see the changes made so far,
+        // including the handler that was just connected
+        if (x == 0){
+            s.broadcast(1);
+        }
+    });
+    c3 = s.connect([&](int){ calls.push_back(3); });
+
+    s.broadcast(0);
+    EXPECT_EQ(calls, (std::vector<int>{1, 2, 2, 4}));
+
+    calls.clear();
+    s.broadcast(1);
+    EXPECT_EQ(calls, (std::vector<int>{2, 4}));
+}
+
+TEST(SignalTest, Deferred1){
+    auto s = Signal<int>{};
+    s.enableDeferredBroadcast(4);
+    auto calls = std::vector<int>{};
+    auto c = s.connect([&](int x){ calls.push_back(x); });
+
+    auto t = std::thread([&]{
+        for (int i = 0; i < 6; ++i){
+            // only four events fit until they are delivered
+            EXPECT_EQ(s.broadcastDeferred(i), i < 4);
+        }
+    });
+    t.join();
+    EXPECT_TRUE(calls.empty());
+
+    deliverDeferredSignals();
+    EXPECT_EQ(calls, (std::vector<int>{0, 1, 2, 3}));
+
+    EXPECT_TRUE(s.broadcastDeferred(7));
+    deliverDeferredSignals();
+    deliverDeferredSignals();
+    EXPECT_EQ(calls.back(), 7);
+    EXPECT_EQ(calls.size(), 5);
+
+    // destroyed signals are no longer delivered
+    {
+        auto d = Signal<int>{};
+        d.enableDeferredBroadcast();
+        auto cd = d.connect([&](int x){ calls.push_back(x); });
+        d.broadcastDeferred(8);
+        deliverDeferredSignals();
+        d.broadcastDeferred(9);
+    }
+    deliverDeferredSignals();
+    EXPECT_EQ(calls.back(), 8);
+}
@@ -0,0 +1,160 @@
+#include <Flosion/Core/SoundChunk.hpp>
+#include <Flosion/Core/SoundResult.hpp>
+
+#include <cstdint>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+using namespace flo;
+
+TEST(SoundChunkTest, PlanarLayout1){
+    auto chunk = SoundChunk{};
+    EXPECT_EQ(chunk.numChannels(), channels::stereo);
+    for (size_t c = 0; c < chunk.numChannels(); ++c){
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(chunk.channel(c)) % SoundChunk::alignment, 0u);
+    }
+
+    chunk.l(3) = 1.0f;
+    chunk.r(3) = 2.0f;
+    EXPECT_EQ(chunk.channel(0)[3], 1.0f);
+    EXPECT_EQ(chunk.channel(1)[3], 2.0f);
+
+    // proxies refer to both channels of the same sample
+    chunk[5] = Sample{3.0f, 4.0f};
+    EXPECT_EQ(chunk.channel(0)[5], 3.0f);
+    EXPECT_EQ(chunk.channel(1)[5], 4.0f);
+    chunk[3] += chunk[5];
+    EXPECT_EQ(chunk.l(3), 4.0f);
+    EXPECT_EQ(chunk.r(3), 6.0f);
+}
+
+TEST(SoundChunkTest, BulkOperations1){
+    auto a = SoundChunk{};
+    auto b = SoundChunk{};
+    for (size_t i = 0; i < SoundChunk::size; ++i){
+        a.l(i) = 1.0f;
+        a.r(i) = -1.0f;
+        b.l(i) = static_cast<float>(i);
+        b.r(i) = -static_cast<float>(i);
+    }
+
+    a.mixAdd(b, 0.5f);
+    EXPECT_EQ(a.l(10), 6.0f);
+    EXPECT_EQ(a.r(10), -6.0f);
+
+    a.scale(2.0f);
+    EXPECT_EQ(a.l(10), 12.0f);
+    EXPECT_EQ(a.r(10), -12.0f);
+
+    a.clamp(-5.0f, 5.0f);
+    EXPECT_EQ(a.l(0), 2.0f);
+    EXPECT_EQ(a.l(10), 5.0f);
+    EXPECT_EQ(a.r(10), -5.0f);
+
+    a.copyFrom(b);
+    EXPECT_EQ(a.l(100), 100.0f);
+    EXPECT_EQ(a.r(100), -100.0f);
+
+    a.silence();
+    a.mixAdd(b, 2.0f, 10, 20, 5);
+    EXPECT_EQ(a.l(19), 0.0f);
+    EXPECT_EQ(a.l(20), 20.0f);
+    EXPECT_EQ(a.r(24), -28.0f);
+    EXPECT_EQ(a.l(25), 0.0f);
+}
+
+TEST(SoundChunkTest, Multichannel1){
+    auto quad = SoundChunk{channels::quad};
+    EXPECT_EQ(quad.numChannels(), 4u);
+    for (size_t c = 0; c < quad.numChannels(); ++c){
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(quad.channel(c)) % SoundChunk::alignment, 0u);
+        EXPECT_EQ(quad.channel(c)[7], 0.0f);
+    }
+
+    quad.channel(2)[7] = 3.0f;
+    quad.spreadChannel(2);
+    for (size_t c = 0; c < quad.numChannels(); ++c){
+        EXPECT_EQ(quad.channel(c)[7], 3.0f);
+    }
+
+    // mono chunks are added to every channel
+    auto mono = SoundChunk{channels::mono};
+    mono.l(7) = 1.0f;
+    quad.mixAdd(mono, 2.0f);
+    for (size_t c = 0; c < quad.numChannels(); ++c){
+        EXPECT_EQ(quad.channel(c)[7], 5.0f);
+    }
+
+    // and other chunks are averaged into mono chunks
+    quad.channel(0)[7] = 1.0f;
+    mono.mixAdd(quad, 1.0f);
+    EXPECT_EQ(mono.l(7), 5.0f);
+
+    quad.setNumChannels(channels::surround51);
+    EXPECT_EQ(quad.numChannels(), 6u);
+    EXPECT_EQ(quad.channel(5)[7], 0.0f);
+}
+
+TEST(SoundChunkTest, Move1){
+    // stereo chunks are stored inline and copied when moved
+    auto stereo = SoundChunk{};
+    stereo.r(7) = 1.0f;
+    auto movedStereo = SoundChunk{std::move(stereo)};
+    EXPECT_EQ(movedStereo.numChannels(), channels::stereo);
+    EXPECT_EQ(movedStereo.r(7), 1.0f);
+    EXPECT_NE(stereo.channel(0), movedStereo.channel(0));
+
+    // wider chunks hand over their samples
+    auto quad = SoundChunk{channels::quad};
+    quad.channel(3)[7] = 2.0f;
+    const auto samples = quad.channel(0);
+    auto movedQuad = SoundChunk{std::move(quad)};
+    EXPECT_EQ(movedQuad.numChannels(), channels::quad);
+    EXPECT_EQ(movedQuad.channel(0), samples);
+    EXPECT_EQ(movedQuad.channel(3)[7], 2.0f);
+
+    // and leave a usable chunk behind
+    EXPECT_EQ(quad.numChannels(), channels::stereo);
+    EXPECT_EQ(quad.channel(1)[7], 0.0f);
+    quad.mixAdd(movedQuad, 1.0f);
+    EXPECT_EQ(quad.channel(1)[7], 0.0f);
+
+    movedStereo = std::move(movedQuad);
+    EXPECT_EQ(movedStereo.numChannels(), channels::quad);
+    EXPECT_EQ(movedStereo.channel(3)[7], 2.0f);
+    EXPECT_EQ(movedQuad.numChannels(), channels::stereo);
+
+    movedQuad.setNumChannels(channels::surround51);
+    movedQuad = std::move(stereo);
+    EXPECT_EQ(movedQuad.numChannels(), channels::stereo);
+    EXPECT_EQ(movedQuad.r(7), 1.0f);
+}
+
+TEST(SoundChunkTest, MonoProxy1){
+    auto mono = SoundChunk{channels::mono};
+
+    // left and right both refer to the only channel
+    EXPECT_EQ(&mono.l(3), &mono.r(3));
+
+    // assigning a stereo sample stores its average
+    mono[3] = Sample{1.0f, 3.0f};
+    EXPECT_EQ(mono.l(3), 2.0f);
+
+    mono[3] += Sample{1.0f, 1.0f};
+    EXPECT_EQ(mono.l(3), 3.0f);
+
+    mono[3] *= 2.0f;
+    EXPECT_EQ(mono.l(3), 6.0f);
+}
+
+TEST(SoundChunkTest, SoundResultChannels1){
+    auto result = SoundResult{};
+    EXPECT_EQ(result.getNumChannels(), channels::stereo);
+
+    auto chunk = SoundChunk{};
+    result.setNumChannels(channels::ambisonic(1));
+    result.getNextChunk(chunk);
+    EXPECT_EQ(chunk.numChannels(), 4u);
+    EXPECT_EQ(chunk.channel(3)[0], 0.0f);
+}
@@ -1,7 +1,10 @@
 #include <Flosion/Core/SoundSourceTemplate.hpp>
 
 #include <algorithm>
+#include <memory>
+#include <set>
 #include <type_traits>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -933,6 +936,52 @@ TEST(SoundNodeTest, DependencySafety5){
     EXPECT_TRUE(root.canSafelyRemoveDependency(&innera2));
 }
 
+TEST(SoundNodeTest, CachedDependencies1){
+    // Makes many random edits and compares the cached dependencies
+    // and dependents after each against a full search
+    const std::size_t numNodes = 12;
+    auto nodes = std::vector<std::unique_ptr<BasicSoundNode>>{};
+    for (std::size_t i = 0; i < numNodes; ++i){
+        nodes.push_back(std::make_unique<BasicSoundNode>("node " + std::to_string(i)));
+    }
+
+    const auto search = [](const SoundNode* node, bool dependencies){
+        auto found = std::set<const SoundNode*>{};
+        auto stack = std::vector<const SoundNode*>{node};
+        while (!stack.empty()){
+            const auto n = stack.back();
+            stack.pop_back();
+            if (found.insert(n).second){
+                const auto& next = dependencies ? n->getDirectDependencies() : n->getDirectDependents();
+                stack.insert(stack.end(), next.begin(), next.end());
+            }
+        }
+        return std::vector<const SoundNode*>(found.begin(), found.end());
+    };
+
+    std::uint32_t x = 12345;
+    const auto next = [&](){
+        x = x * 1664525u + 1013904223u;
+        return static_cast<std::size_t>(x >> 16) % numNodes;
+    };
+
+    for (int i = 0; i < 500; ++i){
+        const auto a = nodes[next()].get();
+        const auto b = nodes[next()].get();
+        if (a->hasDirectDependency(b)){
+            a->removeDependency(b);
+        } else if (a->canAddDependency(b)){
+            a->addDependency(b);
+        } else {
+            EXPECT_TRUE(a == b || a->hasDependency(b) || b->hasDependency(a));
+        }
+        for (const auto& n : nodes){
+            ASSERT_EQ(n->getAllDependencies(), search(n.get(), true));
+            ASSERT_EQ(n->getAllDependents(), search(n.get(), false));
+        }
+    }
+}
+
 using BasicUncontrolled = Named<Realtime<Uncontrolled<SoundNode, EmptySoundState>>>;
 
 TEST(SoundNodeTest, Uncontrolled1){
@@ -0,0 +1,116 @@
+#include <Flosion/Core/Sample.hpp>
+#include <Flosion/Core/SoundSourceTemplate.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+using namespace flo;
+
+namespace {
+
+    // Like SoundResult, owns a single state regardless of its dependents
+    class RootSoundNode : public Realtime<Uncontrolled<SoundNode, EmptySoundState>> {
+    public:
+        RootSoundNode(){
+            enableMonostate();
+        }
+    };
+
+    // Plays its dependencies at a fixed multiple of normal speed
+    class FastSoundNode : public OutOfSync<Singular<SoundNode, EmptySoundState>> {
+    public:
+        FastSoundNode(double s) : speed(s), numQueries(0) {}
+
+        const double speed;
+
+        // The number of times the time speed was queried
+        mutable int numQueries;
+
+    private:
+        double getTimeSpeed(const SoundState*) const noexcept override {
+            ++numQueries;
+            return speed;
+        }
+    };
+
+    using BasicSoundNode = Realtime<Singular<SoundNode, EmptySoundState>>;
+
+    double samplesToSeconds(double samples){
+        return samples / static_cast<double>(Sample::frequency);
+    }
+
+} // anonymous namespace
+
+TEST(SoundStateTest, ElapsedTime1){
+    auto root = RootSoundNode{};
+    auto fast = FastSoundNode{2.0};
+    auto faster = FastSoundNode{3.0};
+    auto leaf = BasicSoundNode{};
+
+    root.addDependency(&fast);
+    fast.addDependency(&faster);
+    faster.addDependency(&leaf);
+
+    ASSERT_EQ(leaf.numSlots(), 1u);
+    auto s = leaf.getState(0);
+
+    s->adjustTime(100);
+    EXPECT_DOUBLE_EQ(s->getElapsedTimeAt(&leaf), samplesToSeconds(100.0));
+    EXPECT_DOUBLE_EQ(s->getElapsedTimeAt(&faster), samplesToSeconds(100.0));
+    EXPECT_DOUBLE_EQ(s->getElapsedTimeAt(&fast), samplesToSeconds(300.0));
+    EXPECT_DOUBLE_EQ(s->getElapsedTimeAt(&root), samplesToSeconds(600.0));
+
+    // the cached speed is reused for later offsets within the same chunk
+    s->adjustTime(10);
+    EXPECT_DOUBLE_EQ(s->getElapsedTimeAt(&root), samplesToSeconds(60.0));
+    EXPECT_DOUBLE_EQ(s->getElapsedTimeAt(&fast), samplesToSeconds(30.0));
+
+    // the cache is dropped when the chain of states changes
+    fast.removeDependency(&faster);
+    root.addDependency(&faster);
+    ASSERT_EQ(leaf.numSlots(), 1u);
+    s = leaf.getState(0);
+    s->adjustTime(10);
+    EXPECT_DOUBLE_EQ(s->getElapsedTimeAt(&root), samplesToSeconds(30.0));
+
+    faster.removeDependency(&leaf);
+    root.removeDependency(&faster);
+}
+
+TEST(SoundStateTest, ElapsedTime2){
+    auto root = RootSoundNode{};
+    auto fast = FastSoundNode{2.0};
+    auto faster = FastSoundNode{3.0};
+    auto leaf = BasicSoundNode{};
+
+    root.addDependency(&fast);
+    fast.addDependency(&faster);
+    faster.addDependency(&leaf);
+
+    ASSERT_EQ(leaf.numSlots(), 1u);
+    auto s = leaf.getState(0);
+
+    // queries alternating between two nodes, as by two number sources
+    // evaluated once per sample, walk the chain of states only once each
+    for (std::uint32_t i = 0; i < 64; ++i){
+        s->adjustTime(i);
+        EXPECT_DOUBLE_EQ(s->getElapsedTimeAt(&root), samplesToSeconds(6.0 * i));
+        EXPECT_DOUBLE_EQ(s->getElapsedTimeAt(&fast), samplesToSeconds(3.0 * i));
+    }
+    EXPECT_EQ(faster.numQueries, 2);
+    EXPECT_EQ(fast.numQueries, 1);
+
+    // a third node evicts the least recently queried one, and all
+    // results stay correct
+    for (std::uint32_t i = 0; i < 4; ++i){
+        s->adjustTime(i);
+        EXPECT_DOUBLE_EQ(s->getElapsedTimeAt(&leaf), samplesToSeconds(1.0 * i));
+        EXPECT_DOUBLE_EQ(s->getElapsedTimeAt(&fast), samplesToSeconds(3.0 * i));
+        EXPECT_DOUBLE_EQ(s->getElapsedTimeAt(&root), samplesToSeconds(6.0 * i));
+    }
+
+    faster.removeDependency(&leaf);
+    fast.removeDependency(&faster);
+    root.removeDependency(&fast);
+}
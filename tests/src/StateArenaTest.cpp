@@ -0,0 +1,68 @@
+#include <Flosion/Core/StateArena.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace flo;
+
+namespace {
+
+    bool isAligned(const void* ptr, std::size_t align){
+        return reinterpret_cast<std::uintptr_t>(ptr) % align == 0;
+    }
+
+} // anonymous namespace
+
+TEST(StateArenaTest, SmallBlocks1){
+    auto arena = StateArena{};
+    EXPECT_EQ(arena.bytesReserved(), 0u);
+
+    auto blocks = std::vector<void*>{};
+    for (std::size_t size : {1, 8, 40, 64, 100, 1000, 4096}){
+        for (std::size_t align : {8, 16, 64}){
+            auto p = arena.allocate(size, align);
+            ASSERT_NE(p, nullptr);
+            EXPECT_TRUE(isAligned(p, align));
+            blocks.push_back(p);
+        }
+    }
+    const auto reserved = arena.bytesReserved();
+    EXPECT_GT(reserved, 0u);
+
+    // freed blocks are reused without reserving more memory
+    for (auto p : blocks){
+        arena.deallocate(p);
+    }
+    auto p = arena.allocate(100, 8);
+    auto q = arena.allocate(100, 8);
+    EXPECT_NE(p, q);
+    EXPECT_EQ(arena.bytesReserved(), reserved);
+    arena.deallocate(p);
+    arena.deallocate(q);
+
+    arena.reset();
+    EXPECT_EQ(arena.bytesReserved(), 0u);
+}
+
+TEST(StateArenaTest, LargeBlocks1){
+    auto arena = StateArena{};
+
+    const auto size = StateArena::maxBlockSize * 3;
+    auto p = arena.allocate(size, 64);
+    ASSERT_NE(p, nullptr);
+    EXPECT_TRUE(isAligned(p, 64));
+    EXPECT_EQ(arena.bytesReserved(), size);
+
+    // a small block must not be confused with a large one
+    auto q = arena.allocate(64, 64);
+    arena.deallocate(p);
+    EXPECT_EQ(arena.bytesReserved(), StateArena::pageSize);
+    arena.deallocate(q);
+
+    // large blocks are released by resetting as well
+    arena.allocate(size, 8);
+    arena.reset();
+    EXPECT_EQ(arena.bytesReserved(), 0u);
+}
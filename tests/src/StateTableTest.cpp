@@ -0,0 +1,333 @@
+#include <Flosion/Core/BorrowingNumberSource.hpp>
+#include <Flosion/Core/Network.hpp>
+#include <Flosion/Core/SoundResult.hpp>
+#include <Flosion/Core/SoundSource.hpp>
+#include <Flosion/Core/SoundSourceTemplate.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace flo;
+
+namespace {
+
+    // Like SoundResult, owns a single state regardless of its dependents
+    class RootSoundNode : public Realtime<Uncontrolled<SoundNode, EmptySoundState>> {
+    public:
+        RootSoundNode(){
+            enableMonostate();
+        }
+    };
+
+    using DivergentSoundNode = Realtime<Divergent<SoundNode, EmptySoundState, int>>;
+    using LeafSoundNode = Realtime<Singular<SoundNode, EmptySoundState>>;
+
+    // Lends its states to number sources connected to its input
+    class DivergentSoundSource : public Realtime<Divergent<SoundSource, EmptySoundState, int>> {
+    public:
+        DivergentSoundSource()
+            : input(this) {
+
+        }
+
+        SoundNumberInput input;
+
+        void getNextChunkFor(SoundChunk& chunk, const SoundInput*, const SoundState*) override {
+            chunk.silence();
+        }
+    };
+
+    class CountingState : public State {
+    public:
+        void reset() noexcept override {
+            count = 0;
+        }
+
+        int count = 0;
+    };
+
+    // Counts how often it was evaluated with each borrowed state
+    class CountingNumberSource : public BorrowingNumberSourceTemplate<CountingNumberSource, CountingState> {
+    public:
+        Number evaluate(CountingState* state, const SoundState*) const noexcept {
+            return static_cast<Number>(++state->count);
+        }
+    };
+
+    // Checks that every state of the leaf points to the matching state of its only dependent
+    void expectConsistent(const LeafSoundNode& leaf, const DivergentSoundNode& div){
+        ASSERT_EQ(leaf.numSlots(), div.numSlots());
+        for (size_t i = 0; i < leaf.numSlots(); ++i){
+            const auto s = leaf.getState(i);
+            EXPECT_EQ(s->getDependentState(), div.getState(i));
+            EXPECT_TRUE(leaf.hasState(s));
+            EXPECT_EQ(leaf.getStateIndex(s), i);
+        }
+    }
+
+} // anonymous namespace
+
+TEST(StateTableTest, StableAddress1){
+    auto root = RootSoundNode{};
+    auto div = DivergentSoundNode{};
+    auto leaf = LeafSoundNode{};
+
+    leaf.setSlotStorage(StateTable::SlotStorage::StableAddress);
+    EXPECT_EQ(leaf.getSlotStorage(), StateTable::SlotStorage::StableAddress);
+
+    root.addDependency(&div);
+    div.addDependency(&leaf);
+
+    for (int k = 0; k < 8; ++k){
+        div.addKey(k);
+    }
+    expectConsistent(leaf, div);
+
+    auto before = std::vector<const SoundState*>{};
+    for (size_t i = 0; i < leaf.numSlots(); ++i){
+        before.push_back(leaf.getState(i));
+    }
+
+    // adding a key must not move any existing state
+    div.addKey(100);
+    expectConsistent(leaf, div);
+    for (size_t i = 0; i < before.size(); ++i){
+        EXPECT_EQ(leaf.getState(i), before[i]);
+    }
+
+    // removing a key must not move any remaining state
+    div.removeKey(100);
+    div.removeKey(3);
+    expectConsistent(leaf, div);
+    for (size_t i = 0; i < 3; ++i){
+        EXPECT_EQ(leaf.getState(i), before[i]);
+    }
+    for (size_t i = 3; i < leaf.numSlots(); ++i){
+        EXPECT_EQ(leaf.getState(i), before[i + 1]);
+    }
+
+    div.removeDependency(&leaf);
+    EXPECT_EQ(leaf.numSlots(), 0u);
+}
+
+TEST(StateTableTest, StableAddress2){
+    auto root = RootSoundNode{};
+    auto div = DivergentSoundNode{};
+    auto leaf = LeafSoundNode{};
+
+    root.addDependency(&div);
+    div.addDependency(&leaf);
+
+    for (int k = 0; k < 5; ++k){
+        div.addKey(k);
+    }
+    expectConsistent(leaf, div);
+
+    // switching storage after states exist moves them once
+    leaf.setSlotStorage(StateTable::SlotStorage::StableAddress);
+    expectConsistent(leaf, div);
+
+    div.setSlotStorage(StateTable::SlotStorage::StableAddress);
+    expectConsistent(leaf, div);
+
+    div.addKey(5);
+    div.removeKey(0);
+    expectConsistent(leaf, div);
+
+    // and switching back restores contiguous storage
+    leaf.setSlotStorage(StateTable::SlotStorage::Contiguous);
+    div.setSlotStorage(StateTable::SlotStorage::Contiguous);
+    expectConsistent(leaf, div);
+
+    div.addKey(6);
+    expectConsistent(leaf, div);
+}
+
+TEST(StateTableTest, CacheLinePadding1){
+    auto root = RootSoundNode{};
+    auto div = DivergentSoundNode{};
+    auto leaf = LeafSoundNode{};
+
+    div.setSlotPadding(StateTable::SlotPadding::CacheLine);
+    EXPECT_EQ(div.getSlotPadding(), StateTable::SlotPadding::CacheLine);
+
+    root.addDependency(&div);
+    div.addDependency(&leaf);
+
+    for (int k = 0; k < 4; ++k){
+        div.addKey(k);
+    }
+    expectConsistent(leaf, div);
+
+    // neighbouring keys never share a cache line
+    EXPECT_EQ(div.slotSize() % 64, 0u);
+    for (size_t i = 0; i < div.numSlots(); ++i){
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(div.getState(i)) % 64, 0u);
+    }
+
+    // padding can also be changed after states exist
+    leaf.setSlotPadding(StateTable::SlotPadding::CacheLine);
+    expectConsistent(leaf, div);
+    div.setSlotPadding(StateTable::SlotPadding::None);
+    expectConsistent(leaf, div);
+    EXPECT_EQ(div.slotSize(), sizeof(EmptySoundState));
+    EXPECT_LE(div.slotSize(), 64u);
+}
+
+TEST(StateTableTest, CacheLinePadding2){
+    auto root = RootSoundNode{};
+    auto div = DivergentSoundSource{};
+    auto first = CountingNumberSource{};
+    auto second = CountingNumberSource{};
+    div.input.setSource(&second);
+
+    div.setSlotPadding(StateTable::SlotPadding::CacheLine);
+    root.addDependency(&div);
+    for (int k = 0; k < 4; ++k){
+        div.addKey(k);
+    }
+
+    first.borrowFrom(&div);
+    const auto paddedSize = div.slotSize();
+    EXPECT_EQ(paddedSize % 64, 0u);
+
+    // a second small state fits into the padding of the slot
+    second.borrowFrom(&div);
+    EXPECT_EQ(div.slotSize(), paddedSize);
+    for (size_t i = 0; i < div.numSlots(); ++i){
+        const auto s = div.getState(i);
+        EXPECT_EQ(div.input.getValue(s), 1.0);
+        EXPECT_EQ(div.input.getValue(s), 2.0);
+    }
+
+    // the borrowed states keep their values when more slots are added
+    div.addKey(4);
+    EXPECT_EQ(div.input.getValue(div.getState(0)), 3.0);
+    EXPECT_EQ(div.input.getValue(div.getState(4)), 1.0);
+
+    // and when the other borrowed state is removed again
+    first.borrowFrom(nullptr);
+    EXPECT_EQ(div.input.getValue(div.getState(0)), 4.0);
+
+    second.borrowFrom(nullptr);
+    div.input.setSource(nullptr);
+}
+
+TEST(StateTableTest, NetworkArena1){
+    // NOTE: the network must outlive its nodes
+    auto network = Network{};
+    auto root = RootSoundNode{};
+    auto div = DivergentSoundNode{&network};
+    auto leaf = LeafSoundNode{&network};
+
+    root.addDependency(&div);
+    div.addDependency(&leaf);
+
+    for (int k = 0; k < 16; ++k){
+        div.addKey(k);
+    }
+    expectConsistent(leaf, div);
+    EXPECT_GT(network.getStateArena().bytesReserved(), 0u);
+
+    for (int k = 0; k < 16; k += 2){
+        div.removeKey(k);
+    }
+    expectConsistent(leaf, div);
+
+    div.removeDependency(&leaf);
+    EXPECT_EQ(leaf.numSlots(), 0u);
+}
+
+TEST(StateTableTest, NetworkTransaction1){
+    auto network = Network{};
+    auto root = RootSoundNode{};
+    auto div = DivergentSoundNode{&network};
+    auto leaf = LeafSoundNode{&network};
+
+    leaf.setSlotStorage(StateTable::SlotStorage::StableAddress);
+
+    network.beginTransaction();
+    EXPECT_TRUE(network.isInTransaction());
+    root.addDependency(&div);
+    div.addDependency(&leaf);
+    for (int k = 0; k < 16; ++k){
+        div.addKey(k);
+    }
+    network.commitTransaction();
+    EXPECT_FALSE(network.isInTransaction());
+    EXPECT_EQ(div.numSlots(), 16u);
+    expectConsistent(leaf, div);
+    EXPECT_EQ(div.getState(0)->getDependentState(), root.getMonoState());
+
+    // editing nodes which already have states, in nested transactions
+    {
+        auto t1 = Network::Transaction{network};
+        auto t2 = Network::Transaction{network};
+        for (int k = 0; k < 16; k += 2){
+            div.removeKey(k);
+        }
+        div.removeDependency(&leaf);
+        div.addDependency(&leaf);
+    }
+    EXPECT_EQ(leaf.numSlots(), 8u);
+    expectConsistent(leaf, div);
+
+    // nodes may be created and destroyed during a transaction
+    {
+        auto t = Network::Transaction{network};
+        auto other = std::make_unique<LeafSoundNode>(&network);
+        div.addDependency(other.get());
+        div.addKey(100);
+        other.reset();
+    }
+    EXPECT_EQ(leaf.numSlots(), 9u);
+    expectConsistent(leaf, div);
+
+    // nodes outside the network are deferred along with their dependents
+    auto outside = LeafSoundNode{};
+    {
+        auto t = Network::Transaction{network};
+        leaf.addDependency(&outside);
+        div.addKey(101);
+    }
+    ASSERT_EQ(outside.numSlots(), 10u);
+    for (size_t i = 0; i < outside.numSlots(); ++i){
+        EXPECT_EQ(outside.getState(i)->getDependentState(), leaf.getState(i));
+    }
+
+    leaf.removeDependency(&outside);
+    root.removeDependency(&div);
+    EXPECT_EQ(leaf.numSlots(), 0u);
+}
+
+TEST(StateTableTest, NetworkTransaction2){
+    auto network = Network{};
+    auto div = DivergentSoundNode{&network};
+    auto outside = std::make_unique<SoundResult>();
+    auto result = SoundResult{};
+    outside->getInput().addDependency(&div);
+    result.getInput().addDependency(&div);
+    div.addKey(0);
+    EXPECT_FALSE(result.isSuspended());
+
+    auto chunk = SoundChunk{};
+    {
+        auto t = Network::Transaction{network};
+        div.addKey(1);
+        EXPECT_TRUE(result.isSuspended());
+
+        // suspended sound results render silence instead of blocking
+        std::thread([&](){ result.getNextChunk(chunk); }).join();
+
+        // sound results may be destroyed while suspended
+        outside.reset();
+        result.getNextChunk(chunk);
+    }
+    EXPECT_FALSE(result.isSuspended());
+    EXPECT_EQ(div.numSlots(), 2u);
+    result.getNextChunk(chunk);
+}
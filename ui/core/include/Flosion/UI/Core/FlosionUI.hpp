@@ -14,6 +14,9 @@ namespace flui {
 
 	private:
 		MainPanel& m_panel;
+
+		// Also delivers the signals deferred by the audio thread
+		void render(sf::RenderWindow&) override;
 	};
 
 }
\ No newline at end of file
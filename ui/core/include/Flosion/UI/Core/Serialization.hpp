@@ -1,24 +1,20 @@
 #pragma once
 
-#include <exception>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
 #include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <typeinfo>
 #include <typeindex>
 #include <vector>
 
 // TODO: use std::span?
 
-// TODO: worry about endianness
-// see https://en.cppreference.com/w/cpp/types/endian
-
-#ifndef _WIN64
-    #error "This code is not portable. Sorry. Ask Tim to fix it."
-#endif
-
 namespace flui {
 
     class Object;
@@ -34,9 +30,11 @@ namespace flui {
     class Deserializer;
     class Serializable;
 
-    class SerializationException : public std::exception {
+    // NOTE: malformed data may also be reported by util::binary, which
+    // throws std::runtime_error
+    class SerializationException : public std::runtime_error {
     public:
-        const char* what() const noexcept override;
+        SerializationException();
     };
 
 
@@ -62,6 +60,7 @@ namespace flui {
         // Creates a vector containing the serialized data. This may be saved to a string,
         // written to a file, sent over a network, etc. This data can be used to construct
         // a Deserializer which can be used to recover the original objects and wires.
+        // The data is versioned and has the same little-endian layout on every platform.
         std::vector<std::byte> dump() const;
 
         // When an Object is being serialized, it is responsible for adding all
@@ -126,6 +125,11 @@ namespace flui {
 
         Serializer& str_vec(const std::vector<std::string>&);
 
+        // Chainable inserter for large binary data, such as compressed audio.
+        // Blobs are stored apart from the objects which insert them, and blobs
+        // with identical contents are only stored once.
+        Serializer& blob(std::vector<std::byte>);
+
     private:
 
         // TODO: this name no longer makes sense
@@ -157,14 +161,22 @@ namespace flui {
         // lists of wire connections represented as (input peg id, output peg id) pairs
         std::vector<std::pair<heap_id, heap_id>> m_soundWires;
         std::vector<std::pair<heap_id, heap_id>> m_numberWires;
+
+        // Distinct blobs. Ids of blobs are their indices in this vector.
+        std::vector<std::vector<std::byte>> m_blobs;
+
+        // Ids of blobs, by hash of their contents
+        std::multimap<std::uint64_t, heap_id> m_blobsByHash;
     };
 
 
     class Deserializer {
     public:
-        // Creates a Deserializer from a vector binary data.
-        // This data needs to have been created by a Serializer.
-
+        // Creates a Deserializer from binary data which was created by a Serializer.
+        // Throws std::runtime_error if the data is malformed or of an unknown version.
+        // The data is not copied and must outlive the Deserializer, which allows reading
+        // directly from a memory-mapped file (see util::MappedFile).
+        Deserializer(const std::byte* data, std::size_t size);
         Deserializer(const std::vector<std::byte>& buffer);
         Deserializer() = delete;
         ~Deserializer() = default;
@@ -263,6 +275,14 @@ namespace flui {
 
         std::vector<std::string> str_vec();
 
+        // A blob, which points into the data given to the constructor
+        struct Blob {
+            const std::byte* data;
+            std::size_t size;
+        };
+
+        Blob blob();
+
         // TODO
 
     public:
@@ -295,13 +315,20 @@ namespace flui {
         NumberOutputPeg* findNumberOutputPeg(heap_id);
 
     private:
-        using IterableObjects = std::vector<std::pair<std::vector<std::byte>, std::vector<std::byte>::const_iterator>>;
+        // The serialized data of a single object, which points into
+        // the data given to the constructor
+        struct ObjectData {
+            const std::byte* begin;
+            const std::byte* end;
+
+            // The position of the next value to be read
+            const std::byte* pos;
+        };
 
-        IterableObjects m_objects;
-        IterableObjects::iterator m_currentObject;
+        std::vector<ObjectData> m_objects;
+        std::vector<ObjectData>::iterator m_currentObject;
 
-        const std::vector<std::byte>& currentObject();
-        std::vector<std::byte>::const_iterator& currentIterator();
+        ObjectData& currentObject();
 
         // List of known sound/number input/output pegs.
         // Ids of these pegs are their indices in these vectors.
@@ -315,6 +342,8 @@ namespace flui {
         std::vector<std::pair<heap_id, heap_id>> m_soundWires;
         std::vector<std::pair<heap_id, heap_id>> m_numberWires;
 
+        std::vector<Blob> m_blobs;
+
         using ObjectCreator = std::function<std::unique_ptr<Object>()>;
 
         // Used for converting from non-portable typeid() to portable
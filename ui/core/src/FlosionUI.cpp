@@ -10,4 +10,9 @@ namespace flui {
 		
 	}
 
+	void FlosionUI::render(sf::RenderWindow& rw){
+		flo::deliverDeferredSignals();
+		ui::GridContainer::render(rw);
+	}
+
 } // namespace flui
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Flosion/UI/Core/BorrowingNumberObject.hpp>
 #include <Flosion/UI/Core/NumberObject.hpp>
 #include <Flosion/Objects/Functions.hpp>
 #include <GUI/Helpers/Slider.hpp>
@@ -453,20 +454,26 @@ namespace flui {
         flo::Atan2 m_atan2;
     };
 
-    class RandomUniform : public TrivialNumberObject {
+    class RandomUniform : public BorrowingNumberObject {
     public:
         RandomUniform();
 
     private:
         flo::RandomUniform m_randomUniform;
+
+        void serialize(Serializer&) const override;
+        void deserialize(Deserializer&) override;
     };
 
-    class RandomNormal : public TrivialNumberObject {
+    class RandomNormal : public BorrowingNumberObject {
     public:
         RandomNormal();
 
     private:
         flo::RandomNormal m_randomNormal;
+
+        void serialize(Serializer&) const override;
+        void deserialize(Deserializer&) override;
     };
 
     class RoundTo : public TrivialNumberObject {
@@ -6,6 +6,7 @@
 #include <GUI/Helpers/CallbackButton.hpp>
 #include <GUI/Helpers/ToggleButton.hpp>
 #include <Flosion/Util/FileBrowser.hpp>
+#include <Flosion/Util/SampleCompression.hpp>
 
 namespace flui {
 
@@ -57,11 +58,14 @@ namespace flui {
         serializePegs(s);
 
         const auto& b = m_audioClip.getSoundBuffer();
-        const auto n = b.getSampleCount() * b.getChannelCount();
 
-        s.u64(b.getSampleCount()).u64(b.getChannelCount()).u64(b.getSampleRate());
+        // NOTE: the sample count includes all channels
+        const auto sc = static_cast<std::size_t>(b.getSampleCount());
+        const auto cc = static_cast<std::size_t>(b.getChannelCount());
 
-        s.i16_span(b.getSamples(), n);
+        s.u64(sc).u64(cc).u64(b.getSampleRate());
+
+        s.blob(util::compressSamples(b.getSamples(), cc > 0 ? sc / cc : 0, cc));
 
         s.b(m_audioClip.looping());
 
@@ -74,11 +78,14 @@ namespace flui {
         auto sc = d.u64();
         auto cc = d.u64();
         auto sr = d.u64();
-        auto audioData = d.i16_vec();
+        auto compressed = d.blob();
         auto loop = d.b();
         auto txt = d.str();
 
-        assert(audioData.size() == sc * cc);
+        auto audioData = util::decompressSamples(compressed.data, compressed.size);
+        if (audioData.size() != sc) {
+            throw SerializationException{};
+        }
 
         m_audioClip.getSoundBuffer().loadFromSamples(
             audioData.data(),
@@ -621,21 +621,43 @@ namespace flui {
     RegisterFactoryObject(Atan2, "atan2");
     REGISTER_SERIALIZABLE(Atan2, "Atan2");
 
-    RandomUniform::RandomUniform(){
-        addToInflow(makePeg(&m_randomUniform.input1, "Minimum"));
-        addToInflow(makePeg(&m_randomUniform.input2, "Maximum"));
+    RandomUniform::RandomUniform()
+        : BorrowingNumberObject(&m_randomUniform) {
+
+        addToInflow(makePeg(&m_randomUniform.minimum, "Minimum"));
+        addToInflow(makePeg(&m_randomUniform.maximum, "Maximum"));
         addToOutflow(makePeg(&m_randomUniform));
         setBody(makeSimpleBody("Random Uniform", 0xcfc800ff));
     }
+
+    void RandomUniform::serialize(Serializer& s) const {
+        serializePegs(s);
+    }
+
+    void RandomUniform::deserialize(Deserializer& d) {
+        deserializePegs(d);
+    }
+
     RegisterFactoryObject(RandomUniform, "RandomUniform");
     REGISTER_SERIALIZABLE(RandomUniform, "RandomUniform");
 
-    RandomNormal::RandomNormal(){
-        addToInflow(makePeg(&m_randomNormal.input1, "Mean"));
-        addToInflow(makePeg(&m_randomNormal.input2, "Standard Deviation"));
+    RandomNormal::RandomNormal()
+        : BorrowingNumberObject(&m_randomNormal) {
+
+        addToInflow(makePeg(&m_randomNormal.mean, "Mean"));
+        addToInflow(makePeg(&m_randomNormal.deviation, "Standard Deviation"));
         addToOutflow(makePeg(&m_randomNormal));
         setBody(makeSimpleBody("Random Normal", 0xcfc800ff));
     }
+
+    void RandomNormal::serialize(Serializer& s) const {
+        serializePegs(s);
+    }
+
+    void RandomNormal::deserialize(Deserializer& d) {
+        deserializePegs(d);
+    }
+
     RegisterFactoryObject(RandomNormal, "RandomNormal");
     REGISTER_SERIALIZABLE(RandomNormal, "RandomNormal");
 
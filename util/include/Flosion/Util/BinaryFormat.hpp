@@ -0,0 +1,233 @@
+#pragma once
+
+#include <Flosion/Util/ByteOrder.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+    /**
+     * Building blocks of Flosion's versioned binary format, as used for
+     * saving panels. All values are little-endian, so the data has the same
+     * layout on every platform.
+     *
+     * A container starts with a header, holding the magic bytes "FLOS", the
+     * u32 format version, the u32 number of sections and a reserved u32. It
+     * is followed by the section table, holding for each section its u32 kind,
+     * a reserved u32, and the u64 offset and u64 size of the section in bytes.
+     * Sections start at offsets which are multiples of 8. What a section
+     * contains depends on its kind, and readers ignore kinds they don't know.
+     *
+     * Within a section, scalars are stored as they are and strings as their
+     * u64 length followed by their bytes. Spans store a tag, the tag of their
+     * elements, their u64 length, and then all their elements contiguously.
+     * Ids are preceded by a tag as well, so that mismatched reads are caught.
+     *
+     * Readers advance a position towards an end, and throw std::runtime_error
+     * if the data is truncated, malformed, or of a different format version.
+     * Lengths are checked against the remaining data before anything is
+     * allocated, so that bogus lengths can't cause huge allocations.
+     */
+    namespace binary {
+
+        enum class Tag : std::uint8_t {
+            Bool = 0x02,
+            Uint8 = 0x03,
+            Uint16 = 0x04,
+            Uint32 = 0x05,
+            Uint64 = 0x06,
+            Int8 = 0x07,
+            Int16 = 0x08,
+            Int32 = 0x09,
+            Int64 = 0x0A,
+            Float32 = 0x0B,
+            Float64 = 0x0C,
+            UTF8String = 0x0D,
+
+            ArrayOf = 0x20
+
+            // NOTE: tags from 0x30 onwards are free to be used for ids
+        };
+
+        template<typename T>
+        struct TypeTag {};
+
+        template<> struct TypeTag<bool> { static constexpr Tag value = Tag::Bool; };
+        template<> struct TypeTag<std::uint8_t> { static constexpr Tag value = Tag::Uint8; };
+        template<> struct TypeTag<std::uint16_t> { static constexpr Tag value = Tag::Uint16; };
+        template<> struct TypeTag<std::uint32_t> { static constexpr Tag value = Tag::Uint32; };
+        template<> struct TypeTag<std::uint64_t> { static constexpr Tag value = Tag::Uint64; };
+        template<> struct TypeTag<std::int8_t> { static constexpr Tag value = Tag::Int8; };
+        template<> struct TypeTag<std::int16_t> { static constexpr Tag value = Tag::Int16; };
+        template<> struct TypeTag<std::int32_t> { static constexpr Tag value = Tag::Int32; };
+        template<> struct TypeTag<std::int64_t> { static constexpr Tag value = Tag::Int64; };
+        template<> struct TypeTag<float> { static constexpr Tag value = Tag::Float32; };
+        template<> struct TypeTag<double> { static constexpr Tag value = Tag::Float64; };
+        // NOTE: strings have no type tag because they are not stored contiguously
+
+        // bools are stored as single bytes
+        template<typename T>
+        using StoredType = std::conditional_t<std::is_same_v<T, bool>, std::uint8_t, T>;
+
+        // Appends the given number of bytes and returns a pointer to them
+        std::byte* grow(std::vector<std::byte>& v, std::size_t numBytes);
+
+        // Consumes the given number of bytes and returns a pointer to them
+        const std::byte* consume(const std::byte*& pos, const std::byte* end, std::uint64_t numBytes);
+
+        // Consumes the given number of elements of the given size
+        const std::byte* consumeElements(const std::byte*& pos, const std::byte* end, std::uint64_t count, std::size_t elementSize);
+
+        void writeTag(std::vector<std::byte>& v, Tag);
+        Tag readTag(const std::byte*& pos, const std::byte* end);
+        void expectTag(const std::byte*& pos, const std::byte* end, Tag);
+
+        template<typename T>
+        void writeScalar(std::vector<std::byte>& v, const T& x);
+
+        template<typename T>
+        T readScalar(const std::byte*& pos, const std::byte* end);
+
+        void writeString(std::vector<std::byte>& v, std::string_view);
+        std::string readString(const std::byte*& pos, const std::byte* end);
+
+        template<typename T>
+        void writeSpan(std::vector<std::byte>& v, const T* src, std::uint64_t len);
+
+        // Reads the tags of a span and returns its length
+        std::uint64_t readSpanHeader(const std::byte*& pos, const std::byte* end, Tag elementTag);
+
+        // Returns the length of the span at the given position, whatever its elements are
+        std::uint64_t peekSpanLength(const std::byte* pos, const std::byte* end);
+
+        // Reads a span which must have exactly the given length
+        template<typename T>
+        void readSpan(const std::byte*& pos, const std::byte* end, T* dst, std::uint64_t len);
+
+        // Reads a span of any length
+        template<typename T>
+        std::vector<T> readVec(const std::byte*& pos, const std::byte* end);
+
+        void writeStringSpan(std::vector<std::byte>& v, const std::string* src, std::uint64_t len);
+        void readStringSpan(const std::byte*& pos, const std::byte* end, std::string* dst, std::uint64_t len);
+        std::vector<std::string> readStringVec(const std::byte*& pos, const std::byte* end);
+
+        // Writes an id, preceded by the given tag
+        void writeID(std::vector<std::byte>& v, Tag, std::uint64_t id);
+        std::uint64_t readID(const std::byte*& pos, const std::byte* end, Tag);
+
+        /**
+         * A table of chunks stores the u64 number of chunks, then for each
+         * chunk the u64 offset and u64 size of its data relative to the start
+         * of the table, and then the data of all chunks.
+         */
+        std::size_t chunksSize(const std::vector<std::vector<std::byte>>& chunks) noexcept;
+
+        void writeChunks(std::vector<std::byte>& v, const std::vector<std::vector<std::byte>>& chunks);
+
+        // Locates the chunks of a table which spans exactly the given range,
+        // without copying them
+        std::vector<std::pair<const std::byte*, const std::byte*>> readChunks(const std::byte* begin, const std::byte* end);
+
+        struct SectionWriter {
+            std::uint32_t kind;
+
+            // The exact number of bytes appended by write
+            std::uint64_t size;
+
+            std::function<void(std::vector<std::byte>&)> write;
+        };
+
+        // Writes the header, the section table and all sections
+        std::vector<std::byte> writeContainer(std::uint32_t version, const std::vector<SectionWriter>& sections);
+
+        struct Section {
+            std::uint32_t kind;
+            const std::byte* begin;
+            const std::byte* end;
+        };
+
+        // Locates the sections of a container of the given version, without copying them
+        std::vector<Section> readContainer(const std::byte* data, std::size_t size, std::uint32_t version);
+
+    } // namespace binary
+
+} // namespace util
+
+namespace util {
+
+    namespace binary {
+
+        template<typename T>
+        inline void writeScalar(std::vector<std::byte>& v, const T& x) {
+            const auto y = static_cast<StoredType<T>>(x);
+            storeLittleEndian(grow(v, sizeof(y)), &y, 1);
+        }
+
+        template<typename T>
+        inline T readScalar(const std::byte*& pos, const std::byte* end) {
+            auto y = StoredType<T>{};
+            loadLittleEndian(&y, consume(pos, end, sizeof(y)), 1);
+            if constexpr (std::is_same_v<T, bool>) {
+                return y != 0;
+            } else {
+                return y;
+            }
+        }
+
+        template<typename T>
+        inline void writeSpan(std::vector<std::byte>& v, const T* src, std::uint64_t len) {
+            writeTag(v, Tag::ArrayOf);
+            writeTag(v, TypeTag<T>::value);
+            writeScalar(v, len);
+            if constexpr (std::is_same_v<T, bool>) {
+                for (std::uint64_t i = 0; i < len; ++i) {
+                    writeScalar(v, src[i]);
+                }
+            } else {
+                storeLittleEndian(grow(v, len * sizeof(T)), src, len);
+            }
+        }
+
+        template<typename T>
+        inline void readSpan(const std::byte*& pos, const std::byte* end, T* dst, std::uint64_t len) {
+            if (readSpanHeader(pos, end, TypeTag<T>::value) != len) {
+                throw std::runtime_error("Unexpected span length");
+            }
+            const auto src = consumeElements(pos, end, len, sizeof(StoredType<T>));
+            if constexpr (std::is_same_v<T, bool>) {
+                for (std::uint64_t i = 0; i < len; ++i) {
+                    dst[i] = (src[i] != std::byte{0});
+                }
+            } else {
+                loadLittleEndian(dst, src, len);
+            }
+        }
+
+        template<typename T>
+        inline std::vector<T> readVec(const std::byte*& pos, const std::byte* end) {
+            const auto len = readSpanHeader(pos, end, TypeTag<T>::value);
+            const auto src = consumeElements(pos, end, len, sizeof(StoredType<T>));
+            auto vec = std::vector<T>(static_cast<std::size_t>(len));
+            if constexpr (std::is_same_v<T, bool>) {
+                // NOTE: std::vector<bool> has no data()
+                for (std::uint64_t i = 0; i < len; ++i) {
+                    vec[i] = (src[i] != std::byte{0});
+                }
+            } else {
+                loadLittleEndian(vec.data(), src, len);
+            }
+            return vec;
+        }
+
+    } // namespace binary
+
+} // namespace util
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// NOTE: std::endian is C++20
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    #define FLOSION_BIG_ENDIAN 1
+#else
+    #define FLOSION_BIG_ENDIAN 0
+#endif
+
+namespace util {
+
+    constexpr bool hostIsLittleEndian = (FLOSION_BIG_ENDIAN == 0);
+
+    /**
+     * Copies an array of arithmetic values to raw bytes in little-endian
+     * byte order. On little-endian hosts, this is a single memcpy.
+     */
+    template<typename T>
+    void storeLittleEndian(std::byte* dst, const T* src, std::size_t count) noexcept {
+        static_assert(std::is_arithmetic_v<T>);
+        // NOTE: empty arrays may be null, which memcpy doesn't allow
+        if (count == 0) {
+            return;
+        }
+        std::memcpy(dst, src, count * sizeof(T));
+        if constexpr (!hostIsLittleEndian && sizeof(T) > 1) {
+            for (std::size_t i = 0; i < count; ++i) {
+                std::reverse(dst + i * sizeof(T), dst + (i + 1) * sizeof(T));
+            }
+        }
+    }
+
+    /**
+     * Copies little-endian raw bytes to an array of arithmetic values.
+     * The source needn't be aligned.
+     */
+    template<typename T>
+    void loadLittleEndian(T* dst, const std::byte* src, std::size_t count) noexcept {
+        static_assert(std::is_arithmetic_v<T>);
+        if (count == 0) {
+            return;
+        }
+        std::memcpy(dst, src, count * sizeof(T));
+        if constexpr (!hostIsLittleEndian && sizeof(T) > 1) {
+            const auto dstBytes = reinterpret_cast<std::byte*>(dst);
+            for (std::size_t i = 0; i < count; ++i) {
+                std::reverse(dstBytes + i * sizeof(T), dstBytes + (i + 1) * sizeof(T));
+            }
+        }
+    }
+
+} // namespace util
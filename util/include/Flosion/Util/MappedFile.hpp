@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace util {
+
+    /**
+     * A read-only view of an entire file, mapped into memory.
+     * Pages are only read from disk as they are accessed, so
+     * large files can be opened without copying them.
+     * Throws std::runtime_error if the file can't be opened or mapped.
+     */
+    class MappedFile {
+    public:
+        MappedFile(const std::filesystem::path&);
+        ~MappedFile();
+
+        MappedFile(MappedFile&&) = delete;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(MappedFile&&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // The contents of the file, which are valid for as long as the
+        // MappedFile exists. This is null if the file is empty.
+        const std::byte* data() const noexcept;
+
+        std::size_t size() const noexcept;
+
+    private:
+        const std::byte* m_data;
+        std::size_t m_size;
+
+        // NOTE: only used on Windows, where the mapping is
+        // a separate handle from the file
+        void* m_mapping;
+    };
+
+} // namespace util
@@ -1,9 +1,194 @@
 #pragma once
 
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <random>
 
 namespace util {
 
+    // TODO: remove once nothing uses it any more. This engine is shared
+    // by every caller without synchronization, and must not be used
+    // while rendering.
     std::default_random_engine& getRandomEngine();
 
+    /**
+     * Mixes the bits of a 64-bit integer such that any change to the input
+     * changes every bit of the output with probability one half
+     * (the finalizer of SplitMix64).
+     */
+    constexpr std::uint64_t mix64(std::uint64_t z) noexcept {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * Returns the next seed of a process-wide sequence, from which every
+     * node with random behaviour takes its seed when it is created.
+     * The sequence starts from a random base, unless it is restarted
+     * with resetSeeds(), after which creating the same nodes in the same
+     * order gives them the same seeds. Thread-safe.
+     */
+    std::uint64_t nextSeed() noexcept;
+
+    void resetSeeds(std::uint64_t base) noexcept;
+
+    /**
+     * CounterRNG is a counter-based random number generator: the n-th number
+     * of the stream with a given key is a pure function of the key and n.
+     * Its state is thus only 16 bytes, which is small enough to be kept in
+     * every state of a node, streams can be skipped in constant time, and
+     * blocks of numbers are computed independently of one another.
+     * It meets the requirements of UniformRandomBitGenerator, so that it may
+     * also be used with the distributions of <random>.
+     */
+    class CounterRNG {
+    public:
+        using result_type = std::uint64_t;
+
+        /**
+         * Creates an unseeded generator. Keys derived with keyFor() are never
+         * zero, which allows unseeded generators to be recognized.
+         */
+        constexpr CounterRNG() noexcept
+            : m_key(0)
+            , m_counter(0) {
+
+        }
+
+        constexpr explicit CounterRNG(std::uint64_t key, std::uint64_t counter = 0) noexcept
+            : m_key(key)
+            , m_counter(counter) {
+
+        }
+
+        /**
+         * Derives the key of one of many independent streams of the given seed.
+         */
+        static constexpr std::uint64_t keyFor(std::uint64_t seed, std::uint64_t stream) noexcept {
+            return mix64(seed ^ mix64(stream + 0x9e3779b97f4a7c15ull)) | 1;
+        }
+
+        /**
+         * The number at the given position of the stream with the given key.
+         */
+        static constexpr std::uint64_t at(std::uint64_t key, std::uint64_t counter) noexcept {
+            return mix64(counter * 0x9e3779b97f4a7c15ull + key);
+        }
+
+        static constexpr result_type min() noexcept {
+            return 0;
+        }
+
+        static constexpr result_type max() noexcept {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        result_type operator()() noexcept {
+            return at(m_key, m_counter++);
+        }
+
+        bool isSeeded() const noexcept {
+            return m_key != 0;
+        }
+
+        std::uint64_t key() const noexcept {
+            return m_key;
+        }
+
+        std::uint64_t counter() const noexcept {
+            return m_counter;
+        }
+
+        void discard(std::uint64_t n) noexcept {
+            m_counter += n;
+        }
+
+        /**
+         * A uniformly distributed number in [0, 1).
+         */
+        double uniform() noexcept {
+            return toUnit((*this)());
+        }
+
+        /**
+         * A normally distributed number with mean 0 and standard deviation 1.
+         * This uses two numbers of the stream.
+         */
+        double normal() noexcept {
+            const auto u1 = toUnitOpen((*this)());
+            const auto u2 = toUnit((*this)());
+            return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+        }
+
+        /**
+         * Writes n uniformly distributed numbers in [min, max) to dst, using
+         * n numbers of the stream. The result is the same as that of calling
+         * uniform() n times, up to rounding.
+         */
+        void fillUniform(float* dst, std::size_t n, float min = 0.0f, float max = 1.0f) noexcept;
+        void fillUniform(double* dst, std::size_t n, double min = 0.0, double max = 1.0) noexcept;
+
+        /**
+         * Writes n normally distributed numbers with the given mean and
+         * standard deviation to dst, using n rounded up to an even number
+         * of numbers of the stream. Both values of each Box-Muller pair
+         * are used, and so the result differs from calling normal() n times.
+         */
+        void fillNormal(float* dst, std::size_t n, float mean = 0.0f, float stddev = 1.0f) noexcept;
+        void fillNormal(double* dst, std::size_t n, double mean = 0.0, double stddev = 1.0) noexcept;
+
+        // Maps the 53 upper bits to [0, 1)
+        static constexpr double toUnit(std::uint64_t x) noexcept {
+            return static_cast<double>(x >> 11) * 0x1.0p-53;
+        }
+
+        // Maps the 53 upper bits to (0, 1]
+        static constexpr double toUnitOpen(std::uint64_t x) noexcept {
+            return static_cast<double>((x >> 11) + 1) * 0x1.0p-53;
+        }
+
+    private:
+        std::uint64_t m_key;
+        std::uint64_t m_counter;
+    };
+
+    /**
+     * RandomSeed is the seed of a node with random behaviour. Each state of the
+     * node takes a stream of its own from the seed the first time it needs
+     * random numbers, so that the states are independent of one another
+     * and of other threads, and that renders are reproducible if states
+     * are created in the same order.
+     * The seed is taken from nextSeed() unless it is set explicitly.
+     */
+    class RandomSeed {
+    public:
+        RandomSeed() noexcept;
+
+        RandomSeed(const RandomSeed&) = delete;
+        RandomSeed& operator=(const RandomSeed&) = delete;
+
+        std::uint64_t get() const noexcept;
+
+        /**
+         * Changes the seed and restarts the sequence of streams. States
+         * which already have a stream keep it until they are destroyed.
+         */
+        void set(std::uint64_t seed) noexcept;
+
+        /**
+         * Returns the next stream of the seed.
+         */
+        CounterRNG makeStream() const noexcept;
+
+    private:
+        std::atomic<std::uint64_t> m_seed;
+
+        // The number of streams handed out so far
+        mutable std::atomic<std::uint64_t> m_numStreams;
+    };
+
 } // namespace util
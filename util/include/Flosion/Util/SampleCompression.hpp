@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace util {
+
+    /**
+     * Losslessly compresses interleaved 16-bit samples, in the manner of FLAC.
+     * The samples are split into blocks of frames, and each channel of each
+     * block is predicted by whichever fixed polynomial of order 0 to 4 fits it
+     * best. The prediction residuals are then Rice coded. Blocks are independent
+     * of each other and are encoded in parallel.
+     */
+    std::vector<std::byte> compressSamples(const std::int16_t* samples, std::size_t numFrames, std::size_t numChannels);
+
+    /**
+     * Restores the interleaved samples from the output of compressSamples,
+     * decoding blocks in parallel.
+     * Throws std::runtime_error if the data is malformed.
+     */
+    std::vector<std::int16_t> decompressSamples(const std::byte* src, std::size_t len);
+
+} // namespace util
@@ -0,0 +1,252 @@
+#include <Flosion/Util/BinaryFormat.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <numeric>
+
+namespace util {
+
+    namespace binary {
+
+        namespace {
+
+            constexpr std::array<std::byte, 4> magic = {
+                std::byte{'F'}, std::byte{'L'}, std::byte{'O'}, std::byte{'S'}
+            };
+
+            constexpr std::size_t headerSize = 16;
+            constexpr std::size_t sectionEntrySize = 24;
+            constexpr std::size_t sectionAlignment = 8;
+
+            std::uint64_t alignUp(std::uint64_t n) noexcept {
+                return (n + sectionAlignment - 1) / sectionAlignment * sectionAlignment;
+            }
+
+        } // anonymous namespace
+
+        std::byte* grow(std::vector<std::byte>& v, std::size_t numBytes) {
+            const auto offset = v.size();
+            v.resize(offset + numBytes);
+            return v.data() + offset;
+        }
+
+        const std::byte* consume(const std::byte*& pos, const std::byte* end, std::uint64_t numBytes) {
+            assert(pos <= end);
+            if (static_cast<std::uint64_t>(end - pos) < numBytes) {
+                throw std::runtime_error("Truncated binary data");
+            }
+            const auto p = pos;
+            pos += numBytes;
+            return p;
+        }
+
+        const std::byte* consumeElements(const std::byte*& pos, const std::byte* end, std::uint64_t count, std::size_t elementSize) {
+            assert(pos <= end);
+            assert(elementSize > 0);
+            // NOTE: the remaining size is divided rather than the count multiplied,
+            // which could overflow for bogus counts
+            if (static_cast<std::uint64_t>(end - pos) / elementSize < count) {
+                throw std::runtime_error("Truncated binary data");
+            }
+            return consume(pos, end, count * elementSize);
+        }
+
+        void writeTag(std::vector<std::byte>& v, Tag t) {
+            static_assert(sizeof(Tag) == 1);
+            v.push_back(static_cast<std::byte>(t));
+        }
+
+        Tag readTag(const std::byte*& pos, const std::byte* end) {
+            static_assert(sizeof(Tag) == 1);
+            return static_cast<Tag>(*consume(pos, end, 1));
+        }
+
+        void expectTag(const std::byte*& pos, const std::byte* end, Tag t) {
+            if (readTag(pos, end) != t) {
+                throw std::runtime_error("Unexpected tag in binary data");
+            }
+        }
+
+        void writeString(std::vector<std::byte>& v, std::string_view sv) {
+            writeScalar(v, static_cast<std::uint64_t>(sv.size()));
+            if (!sv.empty()) {
+                std::memcpy(grow(v, sv.size()), sv.data(), sv.size());
+            }
+        }
+
+        std::string readString(const std::byte*& pos, const std::byte* end) {
+            const auto len = readScalar<std::uint64_t>(pos, end);
+            const auto data = reinterpret_cast<const char*>(consume(pos, end, len));
+            return std::string(data, static_cast<std::size_t>(len));
+        }
+
+        std::uint64_t readSpanHeader(const std::byte*& pos, const std::byte* end, Tag elementTag) {
+            expectTag(pos, end, Tag::ArrayOf);
+            expectTag(pos, end, elementTag);
+            return readScalar<std::uint64_t>(pos, end);
+        }
+
+        std::uint64_t peekSpanLength(const std::byte* pos, const std::byte* end) {
+            expectTag(pos, end, Tag::ArrayOf);
+            readTag(pos, end); // Array element type is consumed but not checked
+            return readScalar<std::uint64_t>(pos, end);
+        }
+
+        void writeStringSpan(std::vector<std::byte>& v, const std::string* src, std::uint64_t len) {
+            writeTag(v, Tag::ArrayOf);
+            writeTag(v, Tag::UTF8String);
+            writeScalar(v, len);
+            for (std::uint64_t i = 0; i < len; ++i) {
+                writeString(v, src[i]);
+            }
+        }
+
+        void readStringSpan(const std::byte*& pos, const std::byte* end, std::string* dst, std::uint64_t len) {
+            if (readSpanHeader(pos, end, Tag::UTF8String) != len) {
+                throw std::runtime_error("Unexpected span length");
+            }
+            for (std::uint64_t i = 0; i < len; ++i) {
+                dst[i] = readString(pos, end);
+            }
+        }
+
+        std::vector<std::string> readStringVec(const std::byte*& pos, const std::byte* end) {
+            const auto len = readSpanHeader(pos, end, Tag::UTF8String);
+            // NOTE: each string takes at least the 8 bytes of its length
+            if (static_cast<std::uint64_t>(end - pos) / 8 < len) {
+                throw std::runtime_error("Truncated binary data");
+            }
+            auto vec = std::vector<std::string>{};
+            vec.reserve(static_cast<std::size_t>(len));
+            for (std::uint64_t i = 0; i < len; ++i) {
+                vec.push_back(readString(pos, end));
+            }
+            return vec;
+        }
+
+        void writeID(std::vector<std::byte>& v, Tag t, std::uint64_t id) {
+            writeTag(v, t);
+            writeScalar(v, id);
+        }
+
+        std::uint64_t readID(const std::byte*& pos, const std::byte* end, Tag t) {
+            expectTag(pos, end, t);
+            return readScalar<std::uint64_t>(pos, end);
+        }
+
+        std::size_t chunksSize(const std::vector<std::vector<std::byte>>& chunks) noexcept {
+            return std::accumulate(
+                begin(chunks),
+                end(chunks),
+                8 + 16 * chunks.size(),
+                [](std::size_t acc, const std::vector<std::byte>& v){ return acc + v.size(); }
+            );
+        }
+
+        void writeChunks(std::vector<std::byte>& v, const std::vector<std::vector<std::byte>>& chunks) {
+            writeScalar(v, static_cast<std::uint64_t>(chunks.size()));
+            auto offset = static_cast<std::uint64_t>(8 + 16 * chunks.size());
+            for (const auto& c : chunks) {
+                writeScalar(v, offset);
+                writeScalar(v, static_cast<std::uint64_t>(c.size()));
+                offset += c.size();
+            }
+            for (const auto& c : chunks) {
+                // NOTE: empty chunks may be null, which memcpy doesn't allow
+                if (!c.empty()) {
+                    std::memcpy(grow(v, c.size()), c.data(), c.size());
+                }
+            }
+        }
+
+        std::vector<std::pair<const std::byte*, const std::byte*>> readChunks(const std::byte* begin, const std::byte* end) {
+            auto pos = begin;
+            const auto size = static_cast<std::uint64_t>(end - begin);
+            const auto n = readScalar<std::uint64_t>(pos, end);
+            if (static_cast<std::uint64_t>(end - pos) / 16 < n) {
+                throw std::runtime_error("Truncated binary data");
+            }
+            auto chunks = std::vector<std::pair<const std::byte*, const std::byte*>>{};
+            chunks.reserve(static_cast<std::size_t>(n));
+            for (std::uint64_t i = 0; i < n; ++i) {
+                const auto offset = readScalar<std::uint64_t>(pos, end);
+                const auto len = readScalar<std::uint64_t>(pos, end);
+                if (offset > size || len > size - offset) {
+                    throw std::runtime_error("Invalid chunk in binary data");
+                }
+                chunks.push_back({ begin + offset, begin + offset + len });
+            }
+            return chunks;
+        }
+
+        std::vector<std::byte> writeContainer(std::uint32_t version, const std::vector<SectionWriter>& sections) {
+            auto offsets = std::vector<std::uint64_t>(sections.size());
+            auto totalSize = alignUp(headerSize + sections.size() * sectionEntrySize);
+            for (std::size_t i = 0; i < sections.size(); ++i) {
+                offsets[i] = totalSize;
+                totalSize = alignUp(totalSize + sections[i].size);
+            }
+
+            auto ret = std::vector<std::byte>{};
+            ret.reserve(static_cast<std::size_t>(totalSize));
+
+            // header and section table
+            std::memcpy(grow(ret, magic.size()), magic.data(), magic.size());
+            writeScalar(ret, version);
+            writeScalar(ret, static_cast<std::uint32_t>(sections.size()));
+            writeScalar(ret, std::uint32_t{ 0 });
+            for (std::size_t i = 0; i < sections.size(); ++i) {
+                writeScalar(ret, sections[i].kind);
+                writeScalar(ret, std::uint32_t{ 0 });
+                writeScalar(ret, offsets[i]);
+                writeScalar(ret, sections[i].size);
+            }
+
+            // sections, each padded up to the next one
+            for (std::size_t i = 0; i < sections.size(); ++i) {
+                ret.resize(static_cast<std::size_t>(offsets[i]));
+                sections[i].write(ret);
+                assert(ret.size() == offsets[i] + sections[i].size);
+            }
+            ret.resize(static_cast<std::size_t>(totalSize));
+
+            return ret;
+        }
+
+        std::vector<Section> readContainer(const std::byte* data, std::size_t size, std::uint32_t version) {
+            const auto dataEnd = data + size;
+            auto pos = data;
+
+            if (size < headerSize || !std::equal(magic.begin(), magic.end(), data)) {
+                throw std::runtime_error("Not a Flosion binary");
+            }
+            pos += magic.size();
+            if (readScalar<std::uint32_t>(pos, dataEnd) != version) {
+                throw std::runtime_error("Unknown binary format version");
+            }
+            const auto numSections = readScalar<std::uint32_t>(pos, dataEnd);
+            readScalar<std::uint32_t>(pos, dataEnd); // reserved
+
+            if (static_cast<std::uint64_t>(dataEnd - pos) / sectionEntrySize < numSections) {
+                throw std::runtime_error("Truncated binary data");
+            }
+            auto sections = std::vector<Section>{};
+            sections.reserve(numSections);
+            for (std::uint32_t i = 0; i < numSections; ++i) {
+                const auto kind = readScalar<std::uint32_t>(pos, dataEnd);
+                readScalar<std::uint32_t>(pos, dataEnd); // reserved
+                const auto offset = readScalar<std::uint64_t>(pos, dataEnd);
+                const auto sectionSize = readScalar<std::uint64_t>(pos, dataEnd);
+                if (offset > size || sectionSize > size - offset) {
+                    throw std::runtime_error("Invalid section in binary data");
+                }
+                sections.push_back({ kind, data + offset, data + offset + sectionSize });
+            }
+            return sections;
+        }
+
+    } // namespace binary
+
+} // namespace util
@@ -0,0 +1,115 @@
+#include <Flosion/Util/MappedFile.hpp>
+
+#include <stdexcept>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace util {
+
+#ifdef _WIN32
+
+    MappedFile::MappedFile(const std::filesystem::path& path)
+        : m_data(nullptr)
+        , m_size(0)
+        , m_mapping(nullptr) {
+
+        const auto file = CreateFileW(
+            path.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr
+        );
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Failed to open file");
+        }
+        auto size = LARGE_INTEGER{};
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            throw std::runtime_error("Failed to get the size of a file");
+        }
+        m_size = static_cast<std::size_t>(size.QuadPart);
+        if (m_size == 0) {
+            CloseHandle(file);
+            return;
+        }
+        // NOTE: the mapping keeps the file open
+        m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!m_mapping) {
+            throw std::runtime_error("Failed to map file");
+        }
+        m_data = static_cast<const std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_data) {
+            CloseHandle(m_mapping);
+            throw std::runtime_error("Failed to map file");
+        }
+    }
+
+    MappedFile::~MappedFile() {
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+        }
+    }
+
+#else
+
+    MappedFile::MappedFile(const std::filesystem::path& path)
+        : m_data(nullptr)
+        , m_size(0)
+        , m_mapping(nullptr) {
+
+        const auto fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open file");
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Failed to get the size of a file");
+        }
+        m_size = static_cast<std::size_t>(st.st_size);
+        if (m_size == 0) {
+            ::close(fd);
+            return;
+        }
+        // NOTE: the mapping stays valid after the file is closed
+        const auto p = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            throw std::runtime_error("Failed to map file");
+        }
+        m_data = static_cast<const std::byte*>(p);
+    }
+
+    MappedFile::~MappedFile() {
+        if (m_data) {
+            ::munmap(const_cast<std::byte*>(m_data), m_size);
+        }
+    }
+
+#endif
+
+    const std::byte* MappedFile::data() const noexcept {
+        return m_data;
+    }
+
+    std::size_t MappedFile::size() const noexcept {
+        return m_size;
+    }
+
+} // namespace util
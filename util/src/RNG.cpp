@@ -8,4 +8,103 @@ namespace util {
         return eng;
     }
 
+    namespace {
+
+        std::atomic<std::uint64_t>& seedBase(){
+            static std::atomic<std::uint64_t> base{[]{
+                auto dev = std::random_device{};
+                return (static_cast<std::uint64_t>(dev()) << 32) ^ static_cast<std::uint64_t>(dev());
+            }()};
+            return base;
+        }
+
+        std::atomic<std::uint64_t> s_seedCount{0};
+
+        template<typename T>
+        void fillNormalImpl(std::uint64_t key, std::uint64_t counter, T* dst, std::size_t n, T mean, T stddev) noexcept {
+            const auto pair = [&](std::size_t i, T& a, T& b){
+                const auto u1 = static_cast<T>(CounterRNG::toUnitOpen(CounterRNG::at(key, counter + i)));
+                const auto u2 = static_cast<T>(CounterRNG::toUnit(CounterRNG::at(key, counter + i + 1)));
+                const auto r = stddev * std::sqrt(T{-2} * std::log(u1));
+                const auto theta = T{6.283185307179586} * u2;
+                a = mean + r * std::cos(theta);
+                b = mean + r * std::sin(theta);
+            };
+            std::size_t i = 0;
+            for (; i + 1 < n; i += 2){
+                pair(i, dst[i], dst[i + 1]);
+            }
+            if (i < n){
+                T unused;
+                pair(i, dst[i], unused);
+            }
+        }
+
+    } // anonymous namespace
+
+    std::uint64_t nextSeed() noexcept {
+        const auto i = s_seedCount.fetch_add(1, std::memory_order_relaxed);
+        return mix64(seedBase().load(std::memory_order_relaxed) + i * 0x9e3779b97f4a7c15ull);
+    }
+
+    void resetSeeds(std::uint64_t base) noexcept {
+        seedBase().store(base, std::memory_order_relaxed);
+        s_seedCount.store(0, std::memory_order_relaxed);
+    }
+
+    RandomSeed::RandomSeed() noexcept {
+        set(nextSeed());
+    }
+
+    std::uint64_t RandomSeed::get() const noexcept {
+        return m_seed.load(std::memory_order_relaxed);
+    }
+
+    void RandomSeed::set(std::uint64_t seed) noexcept {
+        m_seed.store(seed, std::memory_order_relaxed);
+        m_numStreams.store(0, std::memory_order_relaxed);
+    }
+
+    CounterRNG RandomSeed::makeStream() const noexcept {
+        const auto i = m_numStreams.fetch_add(1, std::memory_order_relaxed);
+        return CounterRNG{CounterRNG::keyFor(m_seed.load(std::memory_order_relaxed), i)};
+    }
+
+    // NOTE: the loops below have no dependencies between iterations, and
+    // convert through signed integers, which SIMD instructions can convert.
+    // The float loop is vectorized with SSE2 already, while converting
+    // 64-bit integers to doubles takes AVX-512.
+
+    void CounterRNG::fillUniform(float* dst, std::size_t n, float min, float max) noexcept {
+        const auto k = m_key;
+        const auto c = m_counter;
+        const auto scale = (max - min) * 0x1.0p-24f;
+        for (std::size_t i = 0; i < n; ++i){
+            const auto x = static_cast<std::int32_t>(at(k, c + i) >> 40);
+            dst[i] = min + scale * static_cast<float>(x);
+        }
+        m_counter += n;
+    }
+
+    void CounterRNG::fillUniform(double* dst, std::size_t n, double min, double max) noexcept {
+        const auto k = m_key;
+        const auto c = m_counter;
+        const auto scale = (max - min) * 0x1.0p-53;
+        for (std::size_t i = 0; i < n; ++i){
+            const auto x = static_cast<std::int64_t>(at(k, c + i) >> 11);
+            dst[i] = min + scale * static_cast<double>(x);
+        }
+        m_counter += n;
+    }
+
+    void CounterRNG::fillNormal(float* dst, std::size_t n, float mean, float stddev) noexcept {
+        fillNormalImpl(m_key, m_counter, dst, n, mean, stddev);
+        m_counter += n + (n % 2);
+    }
+
+    void CounterRNG::fillNormal(double* dst, std::size_t n, double mean, double stddev) noexcept {
+        fillNormalImpl(m_key, m_counter, dst, n, mean, stddev);
+        m_counter += n + (n % 2);
+    }
+
 } // namespace util
@@ -0,0 +1,400 @@
+#include <Flosion/Util/SampleCompression.hpp>
+
+#include <Flosion/Util/ByteOrder.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace util {
+
+    namespace detail {
+
+        // Layout of compressed samples. All values are little-endian.
+        //
+        // Header: u8 version, u32 number of channels, u32 frames per block
+        //     and u64 number of frames
+        // Block table: the u64 end offset of each block, relative to the first block
+        // Blocks: for each channel, u8 predictor order, u8 Rice parameter, the
+        //     first (order) samples as they are, and then the Rice codes of the
+        //     residuals of all other samples, padded to a whole byte
+
+        constexpr std::uint8_t version = 1;
+        constexpr std::size_t framesPerBlock = 4096;
+        constexpr std::size_t maxOrder = 4;
+        constexpr unsigned maxRiceParameter = 24;
+
+        // Values whose Rice code would start with at least this many ones are
+        // instead stored as this many ones followed by the value in 32 bits
+        constexpr unsigned escapeLength = 24;
+
+        // The number of blocks per thread below which starting threads isn't worth it
+        constexpr std::size_t minBlocksPerThread = 8;
+
+        template<typename T>
+        void write(std::vector<std::byte>& v, T x) {
+            const auto offset = v.size();
+            v.resize(offset + sizeof(T));
+            storeLittleEndian(v.data() + offset, &x, 1);
+        }
+
+        template<typename T>
+        T read(const std::byte*& pos, const std::byte* end) {
+            if (static_cast<std::size_t>(end - pos) < sizeof(T)) {
+                throw std::runtime_error("Truncated sample data");
+            }
+            auto x = T{};
+            loadLittleEndian(&x, pos, 1);
+            pos += sizeof(T);
+            return x;
+        }
+
+        class BitWriter {
+        public:
+            BitWriter(std::vector<std::byte>& out) noexcept
+                : m_out(out)
+                , m_bits(0)
+                , m_numBits(0) {
+
+            }
+
+            // Writes the lowest n bits of x, most significant bit first
+            void write(std::uint32_t x, unsigned n) {
+                assert(n <= 32);
+                m_bits = (m_bits << n) | (x & ((std::uint64_t{1} << n) - 1));
+                m_numBits += n;
+                while (m_numBits >= 8) {
+                    m_numBits -= 8;
+                    m_out.push_back(static_cast<std::byte>((m_bits >> m_numBits) & 0xFF));
+                }
+                m_bits &= (std::uint64_t{1} << m_numBits) - 1;
+            }
+
+            // Pads the bits written so far to a whole byte
+            void flush() {
+                if (m_numBits > 0) {
+                    write(0, 8 - m_numBits);
+                }
+            }
+
+        private:
+            std::vector<std::byte>& m_out;
+            std::uint64_t m_bits;
+            unsigned m_numBits;
+        };
+
+        class BitReader {
+        public:
+            BitReader(const std::byte* pos, const std::byte* end) noexcept
+                : m_pos(pos)
+                , m_end(end)
+                , m_bits(0)
+                , m_numBits(0) {
+
+            }
+
+            std::uint32_t read(unsigned n) {
+                assert(n <= 32);
+                while (m_numBits < n) {
+                    if (m_pos == m_end) {
+                        throw std::runtime_error("Truncated sample data");
+                    }
+                    m_bits = (m_bits << 8) | std::to_integer<std::uint64_t>(*m_pos++);
+                    m_numBits += 8;
+                }
+                m_numBits -= n;
+                const auto x = static_cast<std::uint32_t>((m_bits >> m_numBits) & ((std::uint64_t{1} << n) - 1));
+                m_bits &= (std::uint64_t{1} << m_numBits) - 1;
+                return x;
+            }
+
+            // Reads ones up to and including the next zero, or until the given
+            // number of ones have been read, and returns the number of ones
+            unsigned readOnes(unsigned limit) {
+                auto n = 0u;
+                while (n < limit) {
+                    if (m_numBits == 0) {
+                        if (m_pos == m_end) {
+                            throw std::runtime_error("Truncated sample data");
+                        }
+                        m_bits = std::to_integer<std::uint64_t>(*m_pos++);
+                        m_numBits = 8;
+                    }
+                    --m_numBits;
+                    if (((m_bits >> m_numBits) & 1) == 0) {
+                        break;
+                    }
+                    ++n;
+                }
+                m_bits &= (std::uint64_t{1} << m_numBits) - 1;
+                return n;
+            }
+
+            // The position of the next whole byte. Any remaining
+            // bits of the current byte are padding.
+            const std::byte* position() const noexcept {
+                return m_pos;
+            }
+
+        private:
+            const std::byte* m_pos;
+            const std::byte* const m_end;
+            std::uint64_t m_bits;
+            unsigned m_numBits;
+        };
+
+        // The prediction of x[i] from the preceding samples by the fixed
+        // polynomial predictor of the given order, as used by FLAC
+        std::int64_t predict(const std::int32_t* x, std::size_t i, std::size_t order) noexcept {
+            switch (order) {
+            case 0:
+                return 0;
+            case 1:
+                return x[i - 1];
+            case 2:
+                return 2 * std::int64_t{x[i - 1]} - x[i - 2];
+            case 3:
+                return 3 * std::int64_t{x[i - 1]} - 3 * std::int64_t{x[i - 2]} + x[i - 3];
+            default:
+                assert(order == 4);
+                return 4 * std::int64_t{x[i - 1]} - 6 * std::int64_t{x[i - 2]} + 4 * std::int64_t{x[i - 3]} - x[i - 4];
+            }
+        }
+
+        // Maps residuals of small magnitude to small unsigned values
+        std::uint32_t zigzag(std::int32_t r) noexcept {
+            return (static_cast<std::uint32_t>(r) << 1) ^ static_cast<std::uint32_t>(r >> 31);
+        }
+
+        std::int32_t unzigzag(std::uint32_t u) noexcept {
+            return static_cast<std::int32_t>(u >> 1) ^ -static_cast<std::int32_t>(u & 1);
+        }
+
+        void encodeChannel(const std::int32_t* x, std::size_t n, std::vector<std::byte>& out) {
+            // Pick the order whose residuals are smallest overall. The residuals
+            // of each order are the differences of those of the order below.
+            auto order = std::size_t{0};
+            if (n > maxOrder) {
+                auto sums = std::array<std::uint64_t, maxOrder + 1>{};
+                for (std::size_t i = maxOrder; i < n; ++i) {
+                    const auto r0 = std::int64_t{x[i]};
+                    const auto r1 = r0 - x[i - 1];
+                    const auto r2 = r1 - (std::int64_t{x[i - 1]} - x[i - 2]);
+                    const auto r3 = r2 - (std::int64_t{x[i - 1]} - 2 * std::int64_t{x[i - 2]} + x[i - 3]);
+                    const auto r4 = r3 - (std::int64_t{x[i - 1]} - 3 * std::int64_t{x[i - 2]} + 3 * std::int64_t{x[i - 3]} - x[i - 4]);
+                    sums[0] += static_cast<std::uint64_t>(r0 < 0 ? -r0 : r0);
+                    sums[1] += static_cast<std::uint64_t>(r1 < 0 ? -r1 : r1);
+                    sums[2] += static_cast<std::uint64_t>(r2 < 0 ? -r2 : r2);
+                    sums[3] += static_cast<std::uint64_t>(r3 < 0 ? -r3 : r3);
+                    sums[4] += static_cast<std::uint64_t>(r4 < 0 ? -r4 : r4);
+                }
+                order = static_cast<std::size_t>(std::min_element(sums.begin(), sums.end()) - sums.begin());
+            }
+
+            auto residuals = std::vector<std::uint32_t>(n - order);
+            auto sum = std::uint64_t{0};
+            for (std::size_t i = order; i < n; ++i) {
+                const auto u = zigzag(static_cast<std::int32_t>(x[i] - predict(x, i, order)));
+                residuals[i - order] = u;
+                sum += u;
+            }
+
+            // Pick the Rice parameter closest to the logarithm of the mean residual
+            const auto count = static_cast<std::uint64_t>(residuals.size());
+            auto k = 0u;
+            while (k < maxRiceParameter && (count << (k + 1)) < sum) {
+                ++k;
+            }
+
+            write(out, static_cast<std::uint8_t>(order));
+            write(out, static_cast<std::uint8_t>(k));
+            for (std::size_t i = 0; i < order; ++i) {
+                write(out, static_cast<std::int16_t>(x[i]));
+            }
+            auto bw = BitWriter{out};
+            for (const auto u : residuals) {
+                const auto q = u >> k;
+                if (q < escapeLength) {
+                    // q ones followed by a zero, then the low bits.
+                    // NOTE: these are written separately, since together
+                    // they may need more than 32 bits
+                    bw.write((std::uint32_t{1} << (q + 1)) - 2, q + 1);
+                    bw.write(u & ((std::uint32_t{1} << k) - 1), k);
+                } else {
+                    bw.write((std::uint32_t{1} << escapeLength) - 1, escapeLength);
+                    bw.write(u, 32);
+                }
+            }
+            bw.flush();
+        }
+
+        const std::byte* decodeChannel(const std::byte* pos, const std::byte* end, std::int32_t* x, std::size_t n) {
+            const auto order = static_cast<std::size_t>(read<std::uint8_t>(pos, end));
+            const auto k = static_cast<unsigned>(read<std::uint8_t>(pos, end));
+            if (order > maxOrder || order > n || k > maxRiceParameter) {
+                throw std::runtime_error("Invalid sample data");
+            }
+            for (std::size_t i = 0; i < order; ++i) {
+                x[i] = read<std::int16_t>(pos, end);
+            }
+            auto br = BitReader{pos, end};
+            for (std::size_t i = order; i < n; ++i) {
+                const auto q = br.readOnes(escapeLength);
+                const auto u = q < escapeLength ? ((q << k) | br.read(k)) : br.read(32);
+                const auto v = predict(x, i, order) + unzigzag(u);
+                if (v < std::numeric_limits<std::int16_t>::min() || v > std::numeric_limits<std::int16_t>::max()) {
+                    throw std::runtime_error("Invalid sample data");
+                }
+                x[i] = static_cast<std::int32_t>(v);
+            }
+            return br.position();
+        }
+
+        std::vector<std::byte> encodeBlock(const std::int16_t* samples, std::size_t numFrames, std::size_t numChannels) {
+            auto out = std::vector<std::byte>{};
+            out.reserve(numFrames * numChannels * sizeof(std::int16_t));
+            auto x = std::vector<std::int32_t>(numFrames);
+            for (std::size_t c = 0; c < numChannels; ++c) {
+                for (std::size_t i = 0; i < numFrames; ++i) {
+                    x[i] = samples[i * numChannels + c];
+                }
+                encodeChannel(x.data(), numFrames, out);
+            }
+            return out;
+        }
+
+        void decodeBlock(const std::byte* pos, const std::byte* end, std::int16_t* samples, std::size_t numFrames, std::size_t numChannels) {
+            auto x = std::vector<std::int32_t>(numFrames);
+            for (std::size_t c = 0; c < numChannels; ++c) {
+                pos = decodeChannel(pos, end, x.data(), numFrames);
+                for (std::size_t i = 0; i < numFrames; ++i) {
+                    samples[i * numChannels + c] = static_cast<std::int16_t>(x[i]);
+                }
+            }
+            if (pos != end) {
+                throw std::runtime_error("Invalid sample data");
+            }
+        }
+
+        // Calls f(i) for every i in [0, n), spread across as many threads as are useful
+        template<typename F>
+        void parallelFor(std::size_t n, const F& f) {
+            const auto hardwareThreads = static_cast<std::size_t>(std::thread::hardware_concurrency());
+            const auto numThreads = std::min(std::max(hardwareThreads, std::size_t{1}), n / minBlocksPerThread);
+            if (numThreads <= 1) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    f(i);
+                }
+                return;
+            }
+            // NOTE: the destructors of these futures wait for their threads,
+            // and get() rethrows any exception thrown by them
+            auto futures = std::vector<std::future<void>>{};
+            for (std::size_t t = 1; t < numThreads; ++t) {
+                futures.push_back(std::async(std::launch::async, [&, t](){
+                    for (auto i = t; i < n; i += numThreads) {
+                        f(i);
+                    }
+                }));
+            }
+            for (std::size_t i = 0; i < n; i += numThreads) {
+                f(i);
+            }
+            for (auto& fu : futures) {
+                fu.get();
+            }
+        }
+
+    } // namespace detail
+
+    std::vector<std::byte> compressSamples(const std::int16_t* samples, std::size_t numFrames, std::size_t numChannels) {
+        using namespace detail;
+        assert(numChannels > 0 || numFrames == 0);
+        assert(numChannels <= std::numeric_limits<std::uint32_t>::max());
+
+        const auto numBlocks = (numFrames + framesPerBlock - 1) / framesPerBlock;
+        auto blocks = std::vector<std::vector<std::byte>>(numBlocks);
+        parallelFor(numBlocks, [&](std::size_t i){
+            const auto first = i * framesPerBlock;
+            const auto frames = std::min(framesPerBlock, numFrames - first);
+            blocks[i] = encodeBlock(samples + first * numChannels, frames, numChannels);
+        });
+
+        auto out = std::vector<std::byte>{};
+        write(out, version);
+        write(out, static_cast<std::uint32_t>(numChannels));
+        write(out, static_cast<std::uint32_t>(framesPerBlock));
+        write(out, static_cast<std::uint64_t>(numFrames));
+        auto blockEnd = std::uint64_t{0};
+        for (const auto& b : blocks) {
+            blockEnd += b.size();
+            write(out, blockEnd);
+        }
+        out.reserve(out.size() + blockEnd);
+        for (const auto& b : blocks) {
+            out.insert(out.end(), b.begin(), b.end());
+        }
+        return out;
+    }
+
+    std::vector<std::int16_t> decompressSamples(const std::byte* src, std::size_t len) {
+        using namespace detail;
+        const auto end = src + len;
+        auto pos = src;
+
+        if (read<std::uint8_t>(pos, end) != version) {
+            throw std::runtime_error("Unknown sample data version");
+        }
+        const auto numChannels = static_cast<std::size_t>(read<std::uint32_t>(pos, end));
+        const auto blockSize = static_cast<std::size_t>(read<std::uint32_t>(pos, end));
+        const auto numFrames = read<std::uint64_t>(pos, end);
+        if (numFrames > 0 && (numChannels == 0 || blockSize == 0)) {
+            throw std::runtime_error("Invalid sample data");
+        }
+        // NOTE: every sample takes at least one bit, which bounds the
+        // allocation below for malformed data
+        if (numChannels > 0 && numFrames > len * 8 / numChannels) {
+            throw std::runtime_error("Invalid sample data");
+        }
+
+        const auto numBlocks = numFrames == 0 ? std::size_t{0} : static_cast<std::size_t>((numFrames - 1) / blockSize + 1);
+        if (static_cast<std::size_t>(end - pos) / sizeof(std::uint64_t) < numBlocks) {
+            throw std::runtime_error("Truncated sample data");
+        }
+        auto blockEnds = std::vector<std::uint64_t>(numBlocks);
+        for (auto& e : blockEnds) {
+            e = read<std::uint64_t>(pos, end);
+        }
+        const auto blocksBegin = pos;
+        const auto blocksSize = static_cast<std::uint64_t>(end - blocksBegin);
+        auto prevEnd = std::uint64_t{0};
+        for (const auto& e : blockEnds) {
+            if (e < prevEnd) {
+                throw std::runtime_error("Invalid sample data");
+            }
+            prevEnd = e;
+        }
+        if (prevEnd != blocksSize) {
+            throw std::runtime_error("Invalid sample data");
+        }
+
+        auto samples = std::vector<std::int16_t>(static_cast<std::size_t>(numFrames) * numChannels);
+        parallelFor(numBlocks, [&](std::size_t i){
+            const auto first = i * blockSize;
+            const auto frames = std::min(blockSize, static_cast<std::size_t>(numFrames) - first);
+            decodeBlock(
+                blocksBegin + (i == 0 ? 0 : blockEnds[i - 1]),
+                blocksBegin + blockEnds[i],
+                samples.data() + first * numChannels,
+                frames,
+                numChannels
+            );
+        });
+        return samples;
+    }
+
+} // namespace util